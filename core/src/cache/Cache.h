@@ -11,22 +11,35 @@
 
 #pragma once
 
-#include "LRU.h"
 #include "utils/Log.h"
 
+#include <algorithm>
 #include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
 #include <mutex>
-#include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace milvus {
 namespace cache {
 
+// Byte-sized cache split into shards, each guarded by its own mutex.
+//
+// Replacement follows 2Q: a new item enters the probation queue and is promoted to the protected queue on
+// its second access. Eviction takes the oldest probation items first, so items touched only once (a table
+// scan, a preload) are dropped before the hot working set. Keys evicted from probation are remembered for
+// a while, an item loaded again soon after goes straight to the protected queue.
+//
+// Items whose key contains a pinned tag are never evicted.
 template <typename ItemObj>
 class Cache {
  public:
     // mem_capacity, units:GB
-    Cache(int64_t capacity_gb, uint64_t cache_max_count);
+    Cache(int64_t capacity_gb, uint64_t cache_max_count, uint64_t shard_count = DEFAULT_SHARD_COUNT);
     ~Cache() = default;
 
     int64_t
@@ -69,6 +82,13 @@ class Cache {
     void
     erase(const std::string& key);
 
+    // keep every item whose key contains tag in cache
+    void
+    pin(const std::string& tag);
+
+    void
+    unpin(const std::string& tag);
+
     void
     print();
 
@@ -76,16 +96,59 @@ class Cache {
     clear();
 
  private:
+    static constexpr uint64_t DEFAULT_SHARD_COUNT = 16;
+
+    struct Entry {
+        ItemObj item_;
+        int64_t size_ = 0;
+        uint64_t tick_ = 0;
+        bool protected_ = false;
+        bool pinned_ = false;
+        std::list<std::string>::iterator pos_;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, Entry> entries_;
+        // front is the most recently used
+        std::list<std::string> probation_;
+        std::list<std::string> protected_;
+        // keys recently evicted from probation
+        std::list<std::string> ghost_;
+        std::unordered_map<std::string, std::list<std::string>::iterator> ghost_map_;
+    };
+
+    Shard&
+    shard(const std::string& key);
+
+    bool
+    is_pinned(const std::string& key);
+
+    // caller holds the shard lock
+    void
+    remove_entry(Shard& shard, typename std::unordered_map<std::string, Entry>::iterator it, bool to_ghost);
+
+    // evict the oldest unpinned item of a queue over all shards, return released bytes or -1 if none
+    int64_t
+    evict_one(bool from_probation);
+
     void
     free_memory();
 
  private:
-    int64_t usage_;
+    std::atomic<int64_t> usage_;
+    std::atomic<int64_t> probation_usage_;
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> tick_;
     int64_t capacity_;
+    uint64_t max_count_;
     double freemem_percent_;
 
-    LRU<std::string, ItemObj> lru_;
-    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::mutex evict_mutex_;
+
+    std::vector<std::string> pinned_tags_;
+    std::mutex pin_mutex_;
 };
 
 }  // namespace cache
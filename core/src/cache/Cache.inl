@@ -14,10 +14,27 @@ namespace cache {
 
 constexpr double DEFAULT_THRESHHOLD_PERCENT = 0.85;
 
+// share of the capacity the probation queue may hold before it is evicted first
+constexpr double PROBATION_PERCENT = 0.25;
+
+// number of evicted probation keys remembered per shard
+constexpr size_t GHOST_CAPACITY_PER_SHARD = 128;
+
 template <typename ItemObj>
-Cache<ItemObj>::Cache(int64_t capacity, uint64_t cache_max_count)
-    : usage_(0), capacity_(capacity), freemem_percent_(DEFAULT_THRESHHOLD_PERCENT), lru_(cache_max_count) {
-    //    AGENT_LOG_DEBUG << "Construct Cache with capacity " << std::to_string(mem_capacity)
+Cache<ItemObj>::Cache(int64_t capacity, uint64_t cache_max_count, uint64_t shard_count)
+    : usage_(0),
+      probation_usage_(0),
+      count_(0),
+      tick_(0),
+      capacity_(capacity),
+      max_count_(cache_max_count),
+      freemem_percent_(DEFAULT_THRESHHOLD_PERCENT) {
+    if (shard_count == 0) {
+        shard_count = 1;
+    }
+    for (uint64_t i = 0; i < shard_count; ++i) {
+        shards_.emplace_back(std::make_unique<Shard>());
+    }
 }
 
 template <typename ItemObj>
@@ -32,26 +49,45 @@ Cache<ItemObj>::set_capacity(int64_t capacity) {
 template <typename ItemObj>
 size_t
 Cache<ItemObj>::size() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return lru_.size();
+    size_t count = 0;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex_);
+        count += shard->entries_.size();
+    }
+    return count;
 }
 
 template <typename ItemObj>
 bool
 Cache<ItemObj>::exists(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return lru_.exists(key);
+    auto& s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex_);
+    return s.entries_.find(key) != s.entries_.end();
 }
 
 template <typename ItemObj>
 ItemObj
 Cache<ItemObj>::get(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!lru_.exists(key)) {
+    auto& s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex_);
+    auto it = s.entries_.find(key);
+    if (it == s.entries_.end()) {
         return nullptr;
     }
 
-    return lru_.get(key);
+    auto& entry = it->second;
+    entry.tick_ = ++tick_;
+    if (entry.protected_) {
+        s.protected_.splice(s.protected_.begin(), s.protected_, entry.pos_);
+    } else {
+        // second access, the item has proved it is not a one-off
+        s.probation_.erase(entry.pos_);
+        s.protected_.push_front(key);
+        entry.pos_ = s.protected_.begin();
+        entry.protected_ = true;
+        probation_usage_ -= entry.size_;
+    }
+    return entry.item_;
 }
 
 template <typename ItemObj>
@@ -61,39 +97,59 @@ Cache<ItemObj>::insert(const std::string& key, const ItemObj& item) {
         return;
     }
 
-    //    if(item->size() > capacity_) {
-    //        SERVER_LOG_ERROR << "Item size " << item->size()
-    //                        << " is too large to insert into cache, capacity " << capacity_;
-    //        return;
-    //    }
-
-    // calculate usage
+    int64_t item_size = item->Size();
+    bool promote = false;
+    auto& s = shard(key);
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<std::mutex> lock(s.mutex_);
 
-        // if key already exist, subtract old item size
-        if (lru_.exists(key)) {
-            const ItemObj& old_item = lru_.get(key);
-            usage_ -= old_item->Size();
+        // a replaced item keeps its place in the protected queue, a recently evicted one earns it
+        auto it = s.entries_.find(key);
+        if (it != s.entries_.end()) {
+            promote = it->second.protected_;
+            remove_entry(s, it, false);
+        }
+        auto ghost = s.ghost_map_.find(key);
+        if (ghost != s.ghost_map_.end()) {
+            promote = true;
+            s.ghost_.erase(ghost->second);
+            s.ghost_map_.erase(ghost);
         }
-
-        // plus new item size
-        usage_ += item->Size();
     }
 
-    // if usage exceed capacity, free some items
-    if (usage_ > capacity_) {
+    // reserve the space before freeing memory, so that room is made for the new item
+    usage_ += item_size;
+    ++count_;
+    if (usage_ > capacity_ || count_ > max_count_) {
         SERVER_LOG_DEBUG << "Current usage " << usage_ << " exceeds cache capacity " << capacity_
                          << ", start free memory";
         free_memory();
     }
 
-    // insert new item
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<std::mutex> lock(s.mutex_);
 
-        lru_.put(key, item);
-        SERVER_LOG_DEBUG << "Insert " << key << " size: " << item->Size() << " bytes into cache, usage: " << usage_
+        // the same key may have been inserted by another thread meanwhile
+        auto it = s.entries_.find(key);
+        if (it != s.entries_.end()) {
+            remove_entry(s, it, false);
+        }
+
+        Entry entry;
+        entry.item_ = item;
+        entry.size_ = item_size;
+        entry.tick_ = ++tick_;
+        entry.protected_ = promote;
+        entry.pinned_ = is_pinned(key);
+        auto& queue = promote ? s.protected_ : s.probation_;
+        queue.push_front(key);
+        entry.pos_ = queue.begin();
+        if (!promote) {
+            probation_usage_ += item_size;
+        }
+        s.entries_.emplace(key, std::move(entry));
+
+        SERVER_LOG_DEBUG << "Insert " << key << " size: " << item_size << " bytes into cache, usage: " << usage_
                          << " bytes," << " capacity: " << capacity_ << " bytes";
     }
 }
@@ -101,34 +157,174 @@ Cache<ItemObj>::insert(const std::string& key, const ItemObj& item) {
 template <typename ItemObj>
 void
 Cache<ItemObj>::erase(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!lru_.exists(key)) {
+    auto& s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex_);
+    auto it = s.entries_.find(key);
+    if (it == s.entries_.end()) {
         return;
     }
 
-    const ItemObj& old_item = lru_.get(key);
-    usage_ -= old_item->Size();
+    int64_t item_size = it->second.size_;
+    remove_entry(s, it, false);
 
-    SERVER_LOG_DEBUG << "Erase " << key << " size: " << old_item->Size() << " bytes from cache, usage: " << usage_
+    SERVER_LOG_DEBUG << "Erase " << key << " size: " << item_size << " bytes from cache, usage: " << usage_
                      << " bytes," << " capacity: " << capacity_ << " bytes";
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::pin(const std::string& tag) {
+    if (tag.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pin_mutex_);
+        if (std::find(pinned_tags_.begin(), pinned_tags_.end(), tag) != pinned_tags_.end()) {
+            return;
+        }
+        pinned_tags_.push_back(tag);
+    }
+
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex_);
+        for (auto& pair : shard->entries_) {
+            pair.second.pinned_ = is_pinned(pair.first);
+        }
+    }
+    SERVER_LOG_DEBUG << "Pin cache items tagged " << tag;
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::unpin(const std::string& tag) {
+    {
+        std::lock_guard<std::mutex> lock(pin_mutex_);
+        auto iter = std::find(pinned_tags_.begin(), pinned_tags_.end(), tag);
+        if (iter == pinned_tags_.end()) {
+            return;
+        }
+        pinned_tags_.erase(iter);
+    }
+
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex_);
+        for (auto& pair : shard->entries_) {
+            pair.second.pinned_ = is_pinned(pair.first);
+        }
+    }
+    SERVER_LOG_DEBUG << "Unpin cache items tagged " << tag;
 
-    lru_.erase(key);
+    // the unpinned items may be what kept the cache over its capacity
+    free_memory();
 }
 
 template <typename ItemObj>
 void
 Cache<ItemObj>::clear() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    lru_.clear();
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex_);
+        shard->entries_.clear();
+        shard->probation_.clear();
+        shard->protected_.clear();
+        shard->ghost_.clear();
+        shard->ghost_map_.clear();
+    }
     usage_ = 0;
+    probation_usage_ = 0;
+    count_ = 0;
     SERVER_LOG_DEBUG << "Clear cache !";
 }
 
+template <typename ItemObj>
+typename Cache<ItemObj>::Shard&
+Cache<ItemObj>::shard(const std::string& key) {
+    return *shards_[std::hash<std::string>()(key) % shards_.size()];
+}
+
+template <typename ItemObj>
+bool
+Cache<ItemObj>::is_pinned(const std::string& key) {
+    std::lock_guard<std::mutex> lock(pin_mutex_);
+    for (auto& tag : pinned_tags_) {
+        if (key.find(tag) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::remove_entry(Shard& shard, typename std::unordered_map<std::string, Entry>::iterator it,
+                             bool to_ghost) {
+    auto& entry = it->second;
+    if (entry.protected_) {
+        shard.protected_.erase(entry.pos_);
+    } else {
+        shard.probation_.erase(entry.pos_);
+        probation_usage_ -= entry.size_;
+    }
+    usage_ -= entry.size_;
+    --count_;
+
+    if (to_ghost && !entry.protected_) {
+        shard.ghost_.push_front(it->first);
+        shard.ghost_map_[it->first] = shard.ghost_.begin();
+        if (shard.ghost_.size() > GHOST_CAPACITY_PER_SHARD) {
+            shard.ghost_map_.erase(shard.ghost_.back());
+            shard.ghost_.pop_back();
+        }
+    }
+    shard.entries_.erase(it);
+}
+
+template <typename ItemObj>
+int64_t
+Cache<ItemObj>::evict_one(bool from_probation) {
+    Shard* victim_shard = nullptr;
+    std::string victim_key;
+    uint64_t victim_tick = UINT64_MAX;
+
+    // the tail of each shard queue is its oldest item, pick the oldest of them
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex_);
+        auto& queue = from_probation ? shard->probation_ : shard->protected_;
+        for (auto rit = queue.rbegin(); rit != queue.rend(); ++rit) {
+            auto& entry = shard->entries_[*rit];
+            if (entry.pinned_) {
+                continue;
+            }
+            if (entry.tick_ < victim_tick) {
+                victim_shard = shard.get();
+                victim_key = *rit;
+                victim_tick = entry.tick_;
+            }
+            break;
+        }
+    }
+
+    if (victim_shard == nullptr) {
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(victim_shard->mutex_);
+    auto it = victim_shard->entries_.find(victim_key);
+    if (it == victim_shard->entries_.end() || it->second.tick_ != victim_tick) {
+        return 0;  // touched meanwhile, let the caller pick again
+    }
+
+    int64_t released_size = it->second.size_;
+    remove_entry(*victim_shard, it, true);
+    return released_size;
+}
+
 /* free memory space when CACHE occupation exceed its capacity */
 template <typename ItemObj>
 void
 Cache<ItemObj>::free_memory() {
-    if (usage_ <= capacity_)
+    std::lock_guard<std::mutex> lock(evict_mutex_);
+    if (usage_ <= capacity_ && count_ <= max_count_)
         return;
 
     int64_t threshhold = capacity_ * freemem_percent_;
@@ -137,48 +333,43 @@ Cache<ItemObj>::free_memory() {
         delta_size = 1;  // ensure at least one item erased
     }
 
-    std::set<std::string> key_array;
     int64_t released_size = 0;
-
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-
-        auto it = lru_.rbegin();
-        while (it != lru_.rend() && released_size < delta_size) {
-            auto& key = it->first;
-            auto& obj_ptr = it->second;
-
-            key_array.emplace(key);
-            released_size += obj_ptr->Size();
-            ++it;
+    while (released_size < delta_size || count_ > max_count_) {
+        // 2Q: evict from probation while it holds more than its share, otherwise from the protected queue
+        bool from_probation = probation_usage_ > capacity_ * PROBATION_PERCENT;
+        int64_t size = evict_one(from_probation);
+        if (size < 0) {
+            size = evict_one(!from_probation);
         }
+        if (size < 0) {
+            SERVER_LOG_WARNING << "Cache usage " << usage_ << " bytes exceeds capacity " << capacity_
+                               << " bytes, but all remaining items are pinned";
+            break;
+        }
+        released_size += size;
     }
 
     SERVER_LOG_DEBUG << "to be released memory size: " << released_size;
 
-    for (auto& key : key_array) {
-        erase(key);
-    }
-
     print();
 }
 
 template <typename ItemObj>
 void
 Cache<ItemObj>::print() {
-    size_t cache_count = 0;
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        cache_count = lru_.size();
-#if 0
-        for (auto it = lru_.begin(); it != lru_.end(); ++it) {
-            SERVER_LOG_DEBUG << it->first;
+    size_t cache_count = size();
+    size_t pinned_count = 0;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex_);
+        for (auto& pair : shard->entries_) {
+            pinned_count += pair.second.pinned_ ? 1 : 0;
         }
-#endif
     }
 
     SERVER_LOG_DEBUG << "[Cache item count]: " << cache_count;
+    SERVER_LOG_DEBUG << "[Cache pinned item count]: " << pinned_count;
     SERVER_LOG_DEBUG << "[Cache usage]: " << usage_ << " bytes";
+    SERVER_LOG_DEBUG << "[Cache probation usage]: " << probation_usage_ << " bytes";
     SERVER_LOG_DEBUG << "[Cache capacity]: " << capacity_ << " bytes";
 }
 
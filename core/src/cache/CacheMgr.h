@@ -14,9 +14,18 @@
 #include "Cache.h"
 #include "metrics/Metrics.h"
 #include "utils/Log.h"
+#include "utils/Status.h"
+#include "utils/StringHelpFunctions.h"
 
+#include <algorithm>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace milvus {
 namespace cache {
@@ -36,9 +45,22 @@ class CacheMgr {
     virtual void
     InsertItem(const std::string& key, const ItemObj& data);
 
+    // Return the cached item of key, or load it by loader on a miss. While a load of key is in flight,
+    // other callers wait for it and share its result instead of loading the same data again.
+    virtual Status
+    GetOrLoadItem(const std::string& key, const std::function<Status(ItemObj&)>& loader, bool to_cache,
+                  ItemObj& item);
+
     virtual void
     EraseItem(const std::string& key);
 
+    // items whose key contains tag survive eviction until unpinned
+    virtual void
+    PinItems(const std::string& tag);
+
+    virtual void
+    UnpinItems(const std::string& tag);
+
     virtual void
     PrintInfo();
 
@@ -54,14 +76,33 @@ class CacheMgr {
     void
     SetCapacity(int64_t capacity);
 
+    // partitions of a table, set by the db so the partitions of a pinned table are pinned together with it
+    using PartitionsResolver = std::function<std::vector<std::string>(const std::string& table_id)>;
+
+    static void
+    SetPartitionsResolver(const PartitionsResolver& resolver);
+
  protected:
     CacheMgr();
 
     virtual ~CacheMgr();
 
+    // pin the items of the tables in a comma separated list, and unpin the tables no longer listed
+    void
+    SetPinnedTables(const std::string& tables);
+
  protected:
     using CachePtr = std::shared_ptr<Cache<ItemObj>>;
     CachePtr cache_;
+    std::vector<std::string> pinned_tags_;
+    std::mutex pinned_mutex_;
+    static PartitionsResolver partitions_resolver_;
+    static std::mutex resolver_mutex_;
+
+ private:
+    using LoadResult = std::pair<Status, ItemObj>;
+    std::unordered_map<std::string, std::shared_future<LoadResult>> loading_;
+    std::mutex loading_mutex_;
 };
 
 }  // namespace cache
@@ -12,6 +12,12 @@
 namespace milvus {
 namespace cache {
 
+template <typename ItemObj>
+typename CacheMgr<ItemObj>::PartitionsResolver CacheMgr<ItemObj>::partitions_resolver_;
+
+template <typename ItemObj>
+std::mutex CacheMgr<ItemObj>::resolver_mutex_;
+
 template <typename ItemObj>
 CacheMgr<ItemObj>::CacheMgr() {
 }
@@ -65,6 +71,65 @@ CacheMgr<ItemObj>::InsertItem(const std::string& key, const ItemObj& data) {
     server::Metrics::GetInstance().CacheAccessTotalIncrement();
 }
 
+template <typename ItemObj>
+Status
+CacheMgr<ItemObj>::GetOrLoadItem(const std::string& key, const std::function<Status(ItemObj&)>& loader,
+                                 bool to_cache, ItemObj& item) {
+    item = GetItem(key);
+    if (item != nullptr) {
+        return Status::OK();
+    }
+
+    std::shared_future<LoadResult> future;
+    std::shared_ptr<std::promise<LoadResult>> promise;
+    {
+        std::lock_guard<std::mutex> lock(loading_mutex_);
+        auto iter = loading_.find(key);
+        if (iter != loading_.end()) {
+            future = iter->second;
+        } else {
+            // the previous load of this key may have finished between the lookup above and taking the lock
+            if (cache_ != nullptr && (item = cache_->get(key)) != nullptr) {
+                return Status::OK();
+            }
+            promise = std::make_shared<std::promise<LoadResult>>();
+            future = promise->get_future().share();
+            loading_[key] = future;
+        }
+    }
+
+    if (promise == nullptr) {
+        server::Metrics::GetInstance().CacheLoadWaitTotalIncrement();
+        const LoadResult& result = future.get();
+        item = result.second;
+        if (result.first.ok() && to_cache && item != nullptr && !ItemExists(key)) {
+            InsertItem(key, item);
+        }
+        return result.first;
+    }
+
+    Status status;
+    ItemObj loaded = nullptr;
+    try {
+        status = loader(loaded);
+    } catch (std::exception& e) {
+        status = Status(SERVER_UNEXPECTED_ERROR, e.what());
+    }
+    if (status.ok() && to_cache && loaded != nullptr) {
+        InsertItem(key, loaded);
+    }
+    server::Metrics::GetInstance().CacheLoadTotalIncrement();
+
+    {
+        std::lock_guard<std::mutex> lock(loading_mutex_);
+        loading_.erase(key);
+    }
+    promise->set_value(std::make_pair(status, loaded));
+
+    item = loaded;
+    return status;
+}
+
 template <typename ItemObj>
 void
 CacheMgr<ItemObj>::EraseItem(const std::string& key) {
@@ -77,6 +142,77 @@ CacheMgr<ItemObj>::EraseItem(const std::string& key) {
     server::Metrics::GetInstance().CacheAccessTotalIncrement();
 }
 
+template <typename ItemObj>
+void
+CacheMgr<ItemObj>::PinItems(const std::string& tag) {
+    if (cache_ == nullptr) {
+        SERVER_LOG_ERROR << "Cache doesn't exist";
+        return;
+    }
+
+    cache_->pin(tag);
+}
+
+template <typename ItemObj>
+void
+CacheMgr<ItemObj>::UnpinItems(const std::string& tag) {
+    if (cache_ == nullptr) {
+        SERVER_LOG_ERROR << "Cache doesn't exist";
+        return;
+    }
+
+    cache_->unpin(tag);
+}
+
+template <typename ItemObj>
+void
+CacheMgr<ItemObj>::SetPinnedTables(const std::string& tables) {
+    if (cache_ == nullptr) {
+        SERVER_LOG_ERROR << "Cache doesn't exist";
+        return;
+    }
+
+    PartitionsResolver resolver;
+    {
+        std::lock_guard<std::mutex> lock(resolver_mutex_);
+        resolver = partitions_resolver_;
+    }
+
+    // cache keys are table file locations: <path>/tables/<table_id>/<segment>/<file>, a partition is a table
+    // of its own under the tables folder
+    std::vector<std::string> table_ids;
+    server::StringHelpFunctions::SplitStringByDelimeter(tables, ",", table_ids);
+    std::vector<std::string> tags;
+    for (auto& table_id : table_ids) {
+        if (!table_id.empty()) {
+            tags.push_back("/tables/" + table_id + "/");
+            if (resolver) {
+                for (auto& partition_id : resolver(table_id)) {
+                    tags.push_back("/tables/" + partition_id + "/");
+                }
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(pinned_mutex_);
+    for (auto& tag : tags) {
+        cache_->pin(tag);
+    }
+    for (auto& tag : pinned_tags_) {
+        if (std::find(tags.begin(), tags.end(), tag) == tags.end()) {
+            cache_->unpin(tag);
+        }
+    }
+    pinned_tags_.swap(tags);
+}
+
+template <typename ItemObj>
+void
+CacheMgr<ItemObj>::SetPartitionsResolver(const PartitionsResolver& resolver) {
+    std::lock_guard<std::mutex> lock(resolver_mutex_);
+    partitions_resolver_ = resolver;
+}
+
 template <typename ItemObj>
 void
 CacheMgr<ItemObj>::PrintInfo() {
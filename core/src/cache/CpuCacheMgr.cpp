@@ -35,6 +35,22 @@ CpuCacheMgr::CpuCacheMgr() {
     float cpu_cache_threshold;
     config.GetCacheConfigCpuCacheThreshold(cpu_cache_threshold);
     cache_->set_freemem_percent(cpu_cache_threshold);
+
+    std::string pinned_tables;
+    config.GetCacheConfigPinnedTables(pinned_tables);
+    SetPinnedTables(pinned_tables);
+
+    config.GenUniqueIdentityID("CpuCacheMgr", identity_);
+    server::ConfigCallBackF lambda = [this](const std::string& value) -> Status {
+        SetPinnedTables(value);
+        return Status::OK();
+    };
+    config.RegisterCallBack(server::CONFIG_CACHE, server::CONFIG_CACHE_PINNED_TABLES, identity_, lambda);
+}
+
+CpuCacheMgr::~CpuCacheMgr() {
+    server::Config& config = server::Config::GetInstance();
+    config.CancelCallBack(server::CONFIG_CACHE, server::CONFIG_CACHE_PINNED_TABLES, identity_);
 }
 
 CpuCacheMgr*
@@ -25,12 +25,17 @@ class CpuCacheMgr : public CacheMgr<DataObjPtr> {
     CpuCacheMgr();
 
  public:
+    ~CpuCacheMgr();
+
     // TODO(myh): use smart pointer instead
     static CpuCacheMgr*
     GetInstance();
 
     DataObjPtr
     GetIndex(const std::string& key);
+
+ private:
+    std::string identity_;
 };
 
 }  // namespace cache
@@ -49,11 +49,21 @@ GpuCacheMgr::GpuCacheMgr() {
     float gpu_mem_threshold;
     config.GetGpuResourceConfigCacheThreshold(gpu_mem_threshold);
     cache_->set_freemem_percent(gpu_mem_threshold);
+
+    std::string pinned_tables;
+    config.GetCacheConfigPinnedTables(pinned_tables);
+    SetPinnedTables(pinned_tables);
+    server::ConfigCallBackF pin_lambda = [this](const std::string& value) -> Status {
+        SetPinnedTables(value);
+        return Status::OK();
+    };
+    config.RegisterCallBack(server::CONFIG_CACHE, server::CONFIG_CACHE_PINNED_TABLES, identity_, pin_lambda);
 }
 
 GpuCacheMgr::~GpuCacheMgr() {
     server::Config& config = server::Config::GetInstance();
     config.CancelCallBack(server::CONFIG_GPU_RESOURCE, server::CONFIG_GPU_RESOURCE_ENABLE, identity_);
+    config.CancelCallBack(server::CONFIG_CACHE, server::CONFIG_CACHE_PINNED_TABLES, identity_);
 }
 
 GpuCacheMgr*
@@ -17,7 +17,9 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "segment/Vectors.h"
@@ -34,12 +36,27 @@ class VectorsFormat {
     virtual void
     write(const storage::FSHandlerPtr& fs_ptr, const segment::VectorsPtr& vectors) = 0;
 
+    // write the uid file only, for vectors whose raw data was merged to disk already
+    virtual void
+    write_uids(const storage::FSHandlerPtr& fs_ptr, const segment::VectorsPtr& vectors) = 0;
+
+    // append the raw vectors of the segment in src_fs_ptr to the raw vector file called name in fs_ptr,
+    // chunk by chunk and without the sorted offsets in deleted_offsets, the uids kept are passed to add_uids
+    virtual void
+    merge(const storage::FSHandlerPtr& fs_ptr, const std::string& name, const storage::FSHandlerPtr& src_fs_ptr,
+          const std::vector<int32_t>& deleted_offsets,
+          const std::function<void(const segment::doc_id_t*, size_t)>& add_uids, size_t& merged_bytes) = 0;
+
     virtual void
     read_uids(const storage::FSHandlerPtr& fs_ptr, std::vector<segment::doc_id_t>& uids) = 0;
 
     virtual void
     read_vectors(const storage::FSHandlerPtr& fs_ptr, off_t offset, size_t num_bytes,
                  std::vector<uint8_t>& raw_vectors) = 0;
+
+    // read all raw vectors into the buffer returned by alloc, which is given their size in bytes
+    virtual void
+    read_vectors(const storage::FSHandlerPtr& fs_ptr, const std::function<uint8_t*(size_t)>& alloc) = 0;
 };
 
 using VectorsFormatPtr = std::shared_ptr<VectorsFormat>;
@@ -21,6 +21,7 @@
 
 #include "DefaultDeletedDocsFormat.h"
 #include "DefaultIdBloomFilterFormat.h"
+#include "DefaultIdIndexFormat.h"
 #include "DefaultVectorsFormat.h"
 
 namespace milvus {
@@ -30,6 +31,7 @@ DefaultCodec::DefaultCodec() {
     vectors_format_ptr_ = std::make_shared<DefaultVectorsFormat>();
     deleted_docs_format_ptr_ = std::make_shared<DefaultDeletedDocsFormat>();
     id_bloom_filter_format_ptr_ = std::make_shared<DefaultIdBloomFilterFormat>();
+    id_index_format_ptr_ = std::make_shared<DefaultIdIndexFormat>();
 }
 
 VectorsFormatPtr
@@ -47,5 +49,10 @@ DefaultCodec::GetIdBloomFilterFormat() {
     return id_bloom_filter_format_ptr_;
 }
 
+IdIndexFormatPtr
+DefaultCodec::GetIdIndexFormat() {
+    return id_index_format_ptr_;
+}
+
 }  // namespace codec
 }  // namespace milvus
@@ -0,0 +1,156 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "codecs/default/DefaultIdIndexFormat.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/filesystem.hpp>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils/Exception.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace codec {
+
+namespace {
+
+// read() and write() may transfer fewer bytes than asked, loop until all are done.
+// errno is 0 if the file ends early
+bool
+ReadAll(int fd, void* data, size_t num_bytes) {
+    errno = 0;
+    size_t done = 0;
+    while (done < num_bytes) {
+        auto ret = ::read(fd, static_cast<uint8_t*>(data) + done, num_bytes - done);
+        if (ret <= 0) {
+            return false;
+        }
+        done += ret;
+    }
+    return true;
+}
+
+bool
+WriteAll(int fd, const void* data, size_t num_bytes) {
+    size_t done = 0;
+    while (done < num_bytes) {
+        auto ret = ::write(fd, static_cast<const uint8_t*>(data) + done, num_bytes - done);
+        if (ret == -1) {
+            return false;
+        }
+        done += ret;
+    }
+    return true;
+}
+
+std::string
+ReadError() {
+    return errno == 0 ? std::string("unexpected end of file") : std::string(std::strerror(errno));
+}
+
+}  // namespace
+
+// File layout: [count][count sorted uids][count offsets]
+void
+DefaultIdIndexFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::IdIndexPtr& id_index_ptr) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string id_index_file_path = dir_path + "/" + id_index_filename_;
+
+    int fd = open(id_index_file_path.c_str(), O_RDONLY, 00664);
+    if (fd == -1) {
+        // segments written by older versions have no id index, not an error for callers which can rebuild it
+        std::string err_msg = "Failed to open file: " + id_index_file_path + ", error: " + std::strerror(errno);
+        if (errno == ENOENT) {
+            ENGINE_LOG_DEBUG << err_msg;
+        } else {
+            ENGINE_LOG_ERROR << err_msg;
+        }
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+
+    size_t count;
+    if (!ReadAll(fd, &count, sizeof(size_t))) {
+        std::string err_msg = "Failed to read from file: " + id_index_file_path + ", error: " + ReadError();
+        ::close(fd);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_CANNOT_READ_FILE, err_msg);
+    }
+
+    std::vector<segment::doc_id_t> sorted_uids(count);
+    std::vector<segment::offset_t> offsets(count);
+    if (!ReadAll(fd, sorted_uids.data(), count * sizeof(segment::doc_id_t)) ||
+        !ReadAll(fd, offsets.data(), count * sizeof(segment::offset_t))) {
+        std::string err_msg = "Failed to read from file: " + id_index_file_path + ", error: " + ReadError();
+        ::close(fd);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_CANNOT_READ_FILE, err_msg);
+    }
+
+    if (::close(fd) == -1) {
+        std::string err_msg = "Failed to close file: " + id_index_file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_CANNOT_READ_FILE, err_msg);
+    }
+
+    id_index_ptr = std::make_shared<segment::IdIndex>(std::move(sorted_uids), std::move(offsets));
+}
+
+void
+DefaultIdIndexFormat::write(const storage::FSHandlerPtr& fs_ptr, const segment::IdIndexPtr& id_index_ptr) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string id_index_file_path = dir_path + "/" + id_index_filename_;
+
+    // Write to a temp file first, so a concurrent reader never sees a partially written index
+    const std::string temp_path = dir_path + "/" + "temp_id_index";
+    int fd = open(temp_path.c_str(), O_WRONLY | O_TRUNC | O_CREAT, 00664);
+    if (fd == -1) {
+        std::string err_msg = "Failed to open file: " + temp_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+
+    size_t count = id_index_ptr->GetCount();
+    if (!WriteAll(fd, &count, sizeof(size_t)) ||
+        !WriteAll(fd, id_index_ptr->GetSortedUids().data(), count * sizeof(segment::doc_id_t)) ||
+        !WriteAll(fd, id_index_ptr->GetOffsets().data(), count * sizeof(segment::offset_t))) {
+        ::close(fd);
+        std::string err_msg = "Failed to write to file: " + temp_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+
+    if (::close(fd) == -1) {
+        std::string err_msg = "Failed to close file: " + temp_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+
+    boost::filesystem::rename(temp_path, id_index_file_path);
+}
+
+}  // namespace codec
+}  // namespace milvus
@@ -20,6 +20,9 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 
@@ -30,45 +33,121 @@
 namespace milvus {
 namespace codec {
 
+namespace {
+
+// file opened for reading or merging, closed when going out of scope
+class FileDescriptor {
+ public:
+    FileDescriptor(const std::string& file_path, int flags) : file_path_(file_path) {
+        fd_ = open(file_path.c_str(), flags, 00664);
+        if (fd_ == -1) {
+            std::string err_msg = "Failed to open file: " + file_path_ + ", error: " + std::strerror(errno);
+            ENGINE_LOG_ERROR << err_msg;
+            throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+        }
+    }
+
+    ~FileDescriptor() {
+        ::close(fd_);
+    }
+
+    // return false if the file ends before any byte is read
+    bool
+    ReadSome(void* data, size_t num_bytes) {
+        size_t read_bytes = 0;
+        while (read_bytes < num_bytes) {
+            auto ret = ::read(fd_, static_cast<uint8_t*>(data) + read_bytes, num_bytes - read_bytes);
+            if (ret == -1) {
+                std::string err_msg = "Failed to read from file: " + file_path_ + ", error: " + std::strerror(errno);
+                ENGINE_LOG_ERROR << err_msg;
+                throw Exception(SERVER_WRITE_ERROR, err_msg);
+            }
+            if (ret == 0) {
+                if (read_bytes == 0) {
+                    return false;
+                }
+                std::string err_msg = "Unexpected end of file: " + file_path_;
+                ENGINE_LOG_ERROR << err_msg;
+                throw Exception(SERVER_WRITE_ERROR, err_msg);
+            }
+            read_bytes += ret;
+        }
+        return true;
+    }
+
+    void
+    Read(void* data, size_t num_bytes) {
+        if (num_bytes > 0 && !ReadSome(data, num_bytes)) {
+            std::string err_msg = "Unexpected end of file: " + file_path_;
+            ENGINE_LOG_ERROR << err_msg;
+            throw Exception(SERVER_WRITE_ERROR, err_msg);
+        }
+    }
+
+    void
+    Write(const void* data, size_t num_bytes) {
+        size_t written_bytes = 0;
+        while (written_bytes < num_bytes) {
+            auto ret = ::write(fd_, static_cast<const uint8_t*>(data) + written_bytes, num_bytes - written_bytes);
+            if (ret == -1) {
+                std::string err_msg = "Failed to write to file: " + file_path_ + ", error: " + std::strerror(errno);
+                ENGINE_LOG_ERROR << err_msg;
+                throw Exception(SERVER_WRITE_ERROR, err_msg);
+            }
+            written_bytes += ret;
+        }
+    }
+
+    void
+    Seek(off_t offset) {
+        if (lseek(fd_, offset, SEEK_SET) == -1) {
+            std::string err_msg = "Failed to seek file: " + file_path_ + ", error: " + std::strerror(errno);
+            ENGINE_LOG_ERROR << err_msg;
+            throw Exception(SERVER_WRITE_ERROR, err_msg);
+        }
+    }
+
+ private:
+    std::string file_path_;
+    int fd_ = -1;
+};
+
+}  // namespace
+
+DefaultVectorsFormat::DefaultVectorsFormat(size_t merge_chunk_size) : merge_chunk_size_(merge_chunk_size) {
+}
+
 void
 DefaultVectorsFormat::read_vectors_internal(const std::string& file_path, off_t offset, size_t num,
                                             std::vector<uint8_t>& raw_vectors) {
-    int rv_fd = open(file_path.c_str(), O_RDONLY, 00664);
-    if (rv_fd == -1) {
-        std::string err_msg = "Failed to open file: " + file_path + ", error: " + std::strerror(errno);
-        ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
-    }
+    auto alloc = [&](size_t num_bytes) -> uint8_t* {
+        raw_vectors.resize(num_bytes / sizeof(uint8_t));
+        return raw_vectors.data();
+    };
+    read_vectors_internal(file_path, offset, num, alloc);
+}
+
+void
+DefaultVectorsFormat::read_vectors_internal(const std::string& file_path, off_t offset, size_t num,
+                                            const std::function<uint8_t*(size_t)>& alloc) {
+    FileDescriptor rv_fd(file_path, O_RDONLY);
 
     size_t num_bytes;
-    if (::read(rv_fd, &num_bytes, sizeof(size_t)) == -1) {
-        std::string err_msg = "Failed to read from file: " + file_path + ", error: " + std::strerror(errno);
-        ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
-    }
+    rv_fd.Read(&num_bytes, sizeof(size_t));
 
     num = std::min(num, num_bytes - offset);
 
     offset += sizeof(size_t);  // Beginning of file is num_bytes
-    int off = lseek(rv_fd, offset, SEEK_SET);
-    if (off == -1) {
-        std::string err_msg = "Failed to seek file: " + file_path + ", error: " + std::strerror(errno);
-        ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
-    }
+    rv_fd.Seek(offset);
 
-    raw_vectors.resize(num / sizeof(uint8_t));
-    if (::read(rv_fd, raw_vectors.data(), num) == -1) {
-        std::string err_msg = "Failed to read from file: " + file_path + ", error: " + std::strerror(errno);
+    uint8_t* raw_vectors = alloc(num);
+    if (raw_vectors == nullptr && num > 0) {
+        std::string err_msg = "Failed to allocate " + std::to_string(num) + " bytes for file: " + file_path;
         ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
+        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
     }
 
-    if (::close(rv_fd) == -1) {
-        std::string err_msg = "Failed to close file: " + file_path + ", error: " + std::strerror(errno);
-        ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
-    }
+    rv_fd.Read(raw_vectors, num);
 }
 
 void
@@ -101,6 +180,53 @@ DefaultVectorsFormat::read_uids_internal(const std::string& file_path, std::vect
     }
 }
 
+void
+DefaultVectorsFormat::write_uids_internal(const std::string& file_path, const std::vector<segment::doc_id_t>& uids) {
+    int uid_fd = open(file_path.c_str(), O_WRONLY | O_TRUNC | O_CREAT, 00664);
+    if (uid_fd == -1) {
+        std::string err_msg = "Failed to open file: " + file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+    size_t uid_num_bytes = uids.size() * sizeof(segment::doc_id_t);
+    if (::write(uid_fd, &uid_num_bytes, sizeof(size_t)) == -1) {
+        std::string err_msg = "Failed to write to file" + file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+    if (::write(uid_fd, uids.data(), uid_num_bytes) == -1) {
+        std::string err_msg = "Failed to write to file" + file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+    if (::close(uid_fd) == -1) {
+        std::string err_msg = "Failed to close file: " + file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+}
+
+std::string
+DefaultVectorsFormat::find_file(const std::string& dir_path, const std::string& extension) {
+    if (!boost::filesystem::is_directory(dir_path)) {
+        std::string err_msg = "Directory: " + dir_path + "does not exist";
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
+    }
+
+    boost::filesystem::path target_path(dir_path);
+    typedef boost::filesystem::directory_iterator d_it;
+    d_it it_end;
+    d_it it(target_path);
+    for (; it != it_end; ++it) {
+        const auto& path = it->path();
+        if (path.extension().string() == extension) {
+            return path.string();
+        }
+    }
+    return "";
+}
+
 void
 DefaultVectorsFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::VectorsPtr& vectors_read) {
     const std::lock_guard<std::mutex> lock(mutex_);
@@ -170,28 +296,7 @@ DefaultVectorsFormat::write(const storage::FSHandlerPtr& fs_ptr, const segment::
 
     rc.RecordSection("write rv done");
 
-    int uid_fd = open(uid_file_path.c_str(), O_WRONLY | O_TRUNC | O_CREAT, 00664);
-    if (uid_fd == -1) {
-        std::string err_msg = "Failed to open file: " + uid_file_path + ", error: " + std::strerror(errno);
-        ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
-    }
-    size_t uid_num_bytes = vectors->GetUids().size() * sizeof(segment::doc_id_t);
-    if (::write(uid_fd, &uid_num_bytes, sizeof(size_t)) == -1) {
-        std::string err_msg = "Failed to write to file" + rv_file_path + ", error: " + std::strerror(errno);
-        ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
-    }
-    if (::write(uid_fd, vectors->GetUids().data(), uid_num_bytes) == -1) {
-        std::string err_msg = "Failed to write to file" + uid_file_path + ", error: " + std::strerror(errno);
-        ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
-    }
-    if (::close(uid_fd) == -1) {
-        std::string err_msg = "Failed to close file: " + uid_file_path + ", error: " + std::strerror(errno);
-        ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
-    }
+    write_uids_internal(uid_file_path, vectors->GetUids());
 
     rc.RecordSection("write uids done");
 }
@@ -245,5 +350,119 @@ DefaultVectorsFormat::read_vectors(const storage::FSHandlerPtr& fs_ptr, off_t of
     }
 }
 
+void
+DefaultVectorsFormat::read_vectors(const storage::FSHandlerPtr& fs_ptr, const std::function<uint8_t*(size_t)>& alloc) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    if (!boost::filesystem::is_directory(dir_path)) {
+        std::string err_msg = "Directory: " + dir_path + "does not exist";
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
+    }
+
+    boost::filesystem::path target_path(dir_path);
+    typedef boost::filesystem::directory_iterator d_it;
+    d_it it_end;
+    d_it it(target_path);
+    for (; it != it_end; ++it) {
+        const auto& path = it->path();
+        if (path.extension().string() == raw_vector_extension_) {
+            read_vectors_internal(path.string(), 0, INT64_MAX, alloc);
+        }
+    }
+}
+
+void
+DefaultVectorsFormat::write_uids(const storage::FSHandlerPtr& fs_ptr, const segment::VectorsPtr& vectors) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string uid_file_path = dir_path + "/" + vectors->GetName() + user_id_extension_;
+    write_uids_internal(uid_file_path, vectors->GetUids());
+}
+
+void
+DefaultVectorsFormat::merge(const storage::FSHandlerPtr& fs_ptr, const std::string& name,
+                            const storage::FSHandlerPtr& src_fs_ptr, const std::vector<int32_t>& deleted_offsets,
+                            const std::function<void(const segment::doc_id_t*, size_t)>& add_uids,
+                            size_t& merged_bytes) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    merged_bytes = 0;
+    std::string src_dir_path = src_fs_ptr->operation_ptr_->GetDirectory();
+    auto src_rv_path = find_file(src_dir_path, raw_vector_extension_);
+    auto src_uid_path = find_file(src_dir_path, user_id_extension_);
+    if (src_rv_path.empty() || src_uid_path.empty()) {
+        std::string err_msg = "No raw vectors to merge in " + src_dir_path;
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
+    }
+
+    FileDescriptor rv_fd(src_rv_path, O_RDONLY);
+    FileDescriptor uid_fd(src_uid_path, O_RDONLY);
+    size_t rv_num_bytes = 0, uid_num_bytes = 0;
+    rv_fd.Read(&rv_num_bytes, sizeof(size_t));
+    uid_fd.Read(&uid_num_bytes, sizeof(size_t));
+    size_t count = uid_num_bytes / sizeof(segment::doc_id_t);
+
+    // the size at the head of the destination file counts the vectors appended so far, the file is created
+    // even if the source is empty, so merging only empty segments still gives a valid segment
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    FileDescriptor dst_fd(dir_path + "/" + name + raw_vector_extension_, O_RDWR | O_CREAT);
+    size_t dst_num_bytes = 0;
+    if (!dst_fd.ReadSome(&dst_num_bytes, sizeof(size_t))) {
+        dst_num_bytes = 0;
+        dst_fd.Seek(0);
+        dst_fd.Write(&dst_num_bytes, sizeof(size_t));
+    }
+    if (count == 0) {
+        return;
+    }
+    size_t code_length = rv_num_bytes / count;
+    dst_fd.Seek(sizeof(size_t) + dst_num_bytes);
+
+    size_t chunk_count = std::max<size_t>(1, merge_chunk_size_ / std::max<size_t>(1, code_length));
+    std::vector<uint8_t> chunk(chunk_count * code_length);
+    std::vector<segment::doc_id_t> chunk_uids(chunk_count);
+
+    auto skip = std::lower_bound(deleted_offsets.begin(), deleted_offsets.end(), 0);
+    for (size_t chunk_begin = 0; chunk_begin < count; chunk_begin += chunk_count) {
+        size_t rows = std::min(chunk_count, count - chunk_begin);
+        rv_fd.Read(chunk.data(), rows * code_length);
+        uid_fd.Read(chunk_uids.data(), rows * sizeof(segment::doc_id_t));
+
+        // move the runs between deleted offsets to the front of the chunk
+        size_t kept = 0;
+        size_t run_begin = 0;
+        while (run_begin < rows) {
+            size_t run_end = rows;
+            if (skip != deleted_offsets.end() && static_cast<size_t>(*skip) < chunk_begin + rows) {
+                run_end = *skip - chunk_begin;
+                ++skip;
+            }
+            if (run_end > run_begin) {
+                auto run_length = run_end - run_begin;
+                if (kept != run_begin) {
+                    memmove(chunk.data() + kept * code_length, chunk.data() + run_begin * code_length,
+                            run_length * code_length);
+                    memmove(chunk_uids.data() + kept, chunk_uids.data() + run_begin,
+                            run_length * sizeof(segment::doc_id_t));
+                }
+                kept += run_length;
+            }
+            run_begin = run_end + 1;
+        }
+
+        dst_fd.Write(chunk.data(), kept * code_length);
+        add_uids(chunk_uids.data(), kept);
+        dst_num_bytes += kept * code_length;
+        merged_bytes += kept * code_length;
+    }
+
+    dst_fd.Seek(0);
+    dst_fd.Write(&dst_num_bytes, sizeof(size_t));
+}
+
 }  // namespace codec
 }  // namespace milvus
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <functional>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -29,7 +30,10 @@ namespace codec {
 
 class DefaultVectorsFormat : public VectorsFormat {
  public:
-    DefaultVectorsFormat() = default;
+    // bytes of raw vectors read and written at a time when merging segments
+    static constexpr size_t DEFAULT_MERGE_CHUNK_SIZE = 64UL * 1024 * 1024;
+
+    explicit DefaultVectorsFormat(size_t merge_chunk_size = DEFAULT_MERGE_CHUNK_SIZE);
 
     void
     read(const storage::FSHandlerPtr& fs_ptr, segment::VectorsPtr& vectors_read) override;
@@ -37,6 +41,14 @@ class DefaultVectorsFormat : public VectorsFormat {
     void
     write(const storage::FSHandlerPtr& fs_ptr, const segment::VectorsPtr& vectors) override;
 
+    void
+    write_uids(const storage::FSHandlerPtr& fs_ptr, const segment::VectorsPtr& vectors) override;
+
+    void
+    merge(const storage::FSHandlerPtr& fs_ptr, const std::string& name, const storage::FSHandlerPtr& src_fs_ptr,
+          const std::vector<int32_t>& deleted_offsets,
+          const std::function<void(const segment::doc_id_t*, size_t)>& add_uids, size_t& merged_bytes) override;
+
     void
     read_uids(const storage::FSHandlerPtr& fs_ptr, std::vector<segment::doc_id_t>& uids) override;
 
@@ -44,6 +56,9 @@ class DefaultVectorsFormat : public VectorsFormat {
     read_vectors(const storage::FSHandlerPtr& fs_ptr, off_t offset, size_t num_bytes,
                  std::vector<uint8_t>& raw_vectors) override;
 
+    void
+    read_vectors(const storage::FSHandlerPtr& fs_ptr, const std::function<uint8_t*(size_t)>& alloc) override;
+
     // No copy and move
     DefaultVectorsFormat(const DefaultVectorsFormat&) = delete;
     DefaultVectorsFormat(DefaultVectorsFormat&&) = delete;
@@ -57,11 +72,22 @@ class DefaultVectorsFormat : public VectorsFormat {
     void
     read_vectors_internal(const std::string&, off_t, size_t, std::vector<uint8_t>&);
 
+    void
+    read_vectors_internal(const std::string&, off_t, size_t, const std::function<uint8_t*(size_t)>&);
+
     void
     read_uids_internal(const std::string&, std::vector<segment::doc_id_t>&);
 
+    void
+    write_uids_internal(const std::string&, const std::vector<segment::doc_id_t>&);
+
+    // path of the file with the extension in the directory, empty if there is none
+    std::string
+    find_file(const std::string& dir_path, const std::string& extension);
+
  private:
     std::mutex mutex_;
+    size_t merge_chunk_size_;
 
     const std::string raw_vector_extension_ = ".rv";
     const std::string user_id_extension_ = ".uid";
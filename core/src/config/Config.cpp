@@ -143,6 +143,9 @@ Config::ValidateConfig() {
     int64_t auto_flush_interval;
     CONFIG_CHECK(GetDBConfigAutoFlushInterval(auto_flush_interval));
 
+    int64_t merge_io_limit;
+    CONFIG_CHECK(GetDBConfigMergeIoLimit(merge_io_limit));
+
     /* storage config */
     std::string storage_primary_path;
     CONFIG_CHECK(GetStorageConfigPrimaryPath(storage_primary_path));
@@ -192,6 +195,9 @@ Config::ValidateConfig() {
     bool cache_insert_data;
     CONFIG_CHECK(GetCacheConfigCacheInsertData(cache_insert_data));
 
+    std::string cache_pinned_tables;
+    CONFIG_CHECK(GetCacheConfigPinnedTables(cache_pinned_tables));
+
     /* engine config */
     int64_t engine_use_blas_threshold;
     CONFIG_CHECK(GetEngineConfigUseBlasThreshold(engine_use_blas_threshold));
@@ -202,6 +208,30 @@ Config::ValidateConfig() {
     bool engine_use_avx512;
     CONFIG_CHECK(GetEngineConfigUseAVX512(engine_use_avx512));
 
+    int64_t engine_search_concurrency;
+    CONFIG_CHECK(GetEngineConfigSearchConcurrency(engine_search_concurrency));
+
+    int64_t engine_search_batch_window;
+    CONFIG_CHECK(GetEngineConfigSearchBatchWindow(engine_search_batch_window));
+
+    bool engine_search_unflushed;
+    CONFIG_CHECK(GetEngineConfigSearchUnflushed(engine_search_unflushed));
+
+    bool engine_shared_quantizer;
+    CONFIG_CHECK(GetEngineConfigSharedQuantizer(engine_shared_quantizer));
+
+    int64_t build_index_concurrency;
+    CONFIG_CHECK(GetEngineConfigBuildIndexConcurrency(build_index_concurrency));
+
+    int64_t build_index_threads;
+    CONFIG_CHECK(GetEngineConfigBuildIndexThreads(build_index_threads));
+
+    int64_t build_index_chunk_size;
+    CONFIG_CHECK(GetEngineConfigBuildIndexChunkSize(build_index_chunk_size));
+
+    int64_t build_index_checkpoint_interval;
+    CONFIG_CHECK(GetEngineConfigBuildIndexCheckpointInterval(build_index_checkpoint_interval));
+
 #ifdef MILVUS_GPU_VERSION
     int64_t engine_gpu_search_threshold;
     CONFIG_CHECK(GetEngineConfigGpuSearchThreshold(engine_gpu_search_threshold));
@@ -245,6 +275,12 @@ Config::ValidateConfig() {
     std::string wal_path;
     CONFIG_CHECK(GetWalConfigWalPath(wal_path));
 
+    std::string wal_durability;
+    CONFIG_CHECK(GetWalConfigDurability(wal_durability));
+
+    int64_t wal_sync_interval;
+    CONFIG_CHECK(GetWalConfigSyncInterval(wal_sync_interval));
+
     return Status::OK();
 }
 
@@ -263,6 +299,7 @@ Config::ResetDefaultConfig() {
     CONFIG_CHECK(SetDBConfigArchiveDiskThreshold(CONFIG_DB_ARCHIVE_DISK_THRESHOLD_DEFAULT));
     CONFIG_CHECK(SetDBConfigArchiveDaysThreshold(CONFIG_DB_ARCHIVE_DAYS_THRESHOLD_DEFAULT));
     CONFIG_CHECK(SetDBConfigAutoFlushInterval(CONFIG_DB_AUTO_FLUSH_INTERVAL_DEFAULT));
+    CONFIG_CHECK(SetDBConfigMergeIoLimit(CONFIG_DB_MERGE_IO_LIMIT_DEFAULT));
 
     /* storage config */
     CONFIG_CHECK(SetStorageConfigPrimaryPath(CONFIG_STORAGE_PRIMARY_PATH_DEFAULT));
@@ -284,17 +321,28 @@ Config::ResetDefaultConfig() {
     CONFIG_CHECK(SetCacheConfigCpuCacheThreshold(CONFIG_CACHE_CPU_CACHE_THRESHOLD_DEFAULT));
     CONFIG_CHECK(SetCacheConfigInsertBufferSize(CONFIG_CACHE_INSERT_BUFFER_SIZE_DEFAULT));
     CONFIG_CHECK(SetCacheConfigCacheInsertData(CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT));
+    CONFIG_CHECK(SetCacheConfigPinnedTables(CONFIG_CACHE_PINNED_TABLES_DEFAULT));
 
     /* engine config */
     CONFIG_CHECK(SetEngineConfigUseBlasThreshold(CONFIG_ENGINE_USE_BLAS_THRESHOLD_DEFAULT));
     CONFIG_CHECK(SetEngineConfigOmpThreadNum(CONFIG_ENGINE_OMP_THREAD_NUM_DEFAULT));
     CONFIG_CHECK(SetEngineConfigUseAVX512(CONFIG_ENGINE_USE_AVX512_DEFAULT));
+    CONFIG_CHECK(SetEngineConfigSearchConcurrency(CONFIG_ENGINE_SEARCH_CONCURRENCY_DEFAULT));
+    CONFIG_CHECK(SetEngineConfigSearchBatchWindow(CONFIG_ENGINE_SEARCH_BATCH_WINDOW_DEFAULT));
+    CONFIG_CHECK(SetEngineConfigSearchUnflushed(CONFIG_ENGINE_SEARCH_UNFLUSHED_DEFAULT));
+    CONFIG_CHECK(SetEngineConfigSharedQuantizer(CONFIG_ENGINE_SHARED_QUANTIZER_DEFAULT));
+    CONFIG_CHECK(SetEngineConfigBuildIndexConcurrency(CONFIG_ENGINE_BUILD_INDEX_CONCURRENCY_DEFAULT));
+    CONFIG_CHECK(SetEngineConfigBuildIndexThreads(CONFIG_ENGINE_BUILD_INDEX_THREADS_DEFAULT));
+    CONFIG_CHECK(SetEngineConfigBuildIndexChunkSize(CONFIG_ENGINE_BUILD_INDEX_CHUNK_SIZE_DEFAULT));
+    CONFIG_CHECK(SetEngineConfigBuildIndexCheckpointInterval(CONFIG_ENGINE_BUILD_INDEX_CHECKPOINT_INTERVAL_DEFAULT));
 
     /* wal config */
     CONFIG_CHECK(SetWalConfigEnable(CONFIG_WAL_ENABLE_DEFAULT));
     CONFIG_CHECK(SetWalConfigRecoveryErrorIgnore(CONFIG_WAL_RECOVERY_ERROR_IGNORE_DEFAULT));
     CONFIG_CHECK(SetWalConfigBufferSize(CONFIG_WAL_BUFFER_SIZE_DEFAULT));
     CONFIG_CHECK(SetWalConfigWalPath(CONFIG_WAL_WAL_PATH_DEFAULT));
+    CONFIG_CHECK(SetWalConfigDurability(CONFIG_WAL_DURABILITY_DEFAULT));
+    CONFIG_CHECK(SetWalConfigSyncInterval(CONFIG_WAL_SYNC_INTERVAL_DEFAULT));
 #ifdef MILVUS_GPU_VERSION
     CONFIG_CHECK(SetEngineConfigGpuSearchThreshold(CONFIG_ENGINE_GPU_SEARCH_THRESHOLD_DEFAULT));
 #endif
@@ -355,6 +403,8 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetDBConfigPreloadTable(value);
         } else if (child_key == CONFIG_DB_AUTO_FLUSH_INTERVAL) {
             status = SetDBConfigAutoFlushInterval(value);
+        } else if (child_key == CONFIG_DB_MERGE_IO_LIMIT) {
+            status = SetDBConfigMergeIoLimit(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -395,6 +445,8 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetCacheConfigCpuCacheThreshold(value);
         } else if (child_key == CONFIG_CACHE_CACHE_INSERT_DATA) {
             status = SetCacheConfigCacheInsertData(value);
+        } else if (child_key == CONFIG_CACHE_PINNED_TABLES) {
+            status = SetCacheConfigPinnedTables(value);
         } else if (child_key == CONFIG_CACHE_INSERT_BUFFER_SIZE) {
             status = SetCacheConfigInsertBufferSize(value);
         } else {
@@ -407,6 +459,22 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetEngineConfigOmpThreadNum(value);
         } else if (child_key == CONFIG_ENGINE_USE_AVX512) {
             status = SetEngineConfigUseAVX512(value);
+        } else if (child_key == CONFIG_ENGINE_SEARCH_CONCURRENCY) {
+            status = SetEngineConfigSearchConcurrency(value);
+        } else if (child_key == CONFIG_ENGINE_SEARCH_BATCH_WINDOW) {
+            status = SetEngineConfigSearchBatchWindow(value);
+        } else if (child_key == CONFIG_ENGINE_SEARCH_UNFLUSHED) {
+            status = SetEngineConfigSearchUnflushed(value);
+        } else if (child_key == CONFIG_ENGINE_SHARED_QUANTIZER) {
+            status = SetEngineConfigSharedQuantizer(value);
+        } else if (child_key == CONFIG_ENGINE_BUILD_INDEX_CONCURRENCY) {
+            status = SetEngineConfigBuildIndexConcurrency(value);
+        } else if (child_key == CONFIG_ENGINE_BUILD_INDEX_THREADS) {
+            status = SetEngineConfigBuildIndexThreads(value);
+        } else if (child_key == CONFIG_ENGINE_BUILD_INDEX_CHUNK_SIZE) {
+            status = SetEngineConfigBuildIndexChunkSize(value);
+        } else if (child_key == CONFIG_ENGINE_BUILD_INDEX_CHECKPOINT_INTERVAL) {
+            status = SetEngineConfigBuildIndexCheckpointInterval(value);
 #ifdef MILVUS_GPU_VERSION
         } else if (child_key == CONFIG_ENGINE_GPU_SEARCH_THRESHOLD) {
             status = SetEngineConfigGpuSearchThreshold(value);
@@ -445,6 +513,10 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetWalConfigBufferSize(value);
         } else if (child_key == CONFIG_WAL_WAL_PATH) {
             status = SetWalConfigWalPath(value);
+        } else if (child_key == CONFIG_WAL_DURABILITY) {
+            status = SetWalConfigDurability(value);
+        } else if (child_key == CONFIG_WAL_SYNC_INTERVAL) {
+            status = SetWalConfigSyncInterval(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -847,6 +919,20 @@ Config::CheckDBConfigAutoFlushInterval(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckDBConfigMergeIoLimit(const std::string& value) {
+    auto exist_error = !ValidationUtil::ValidateStringIsNumber(value).ok();
+    fiu_do_on("check_config_merge_io_limit_fail", exist_error = true);
+
+    if (exist_error) {
+        std::string msg = "Invalid db configuration merge_io_limit: " + value +
+                          ". Possible reason: db_config.merge_io_limit is not a natural number.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    return Status::OK();
+}
+
 /* storage config */
 Status
 Config::CheckStorageConfigPrimaryPath(const std::string& value) {
@@ -1088,6 +1174,22 @@ Config::CheckCacheConfigCacheInsertData(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckCacheConfigPinnedTables(const std::string& value) {
+    fiu_return_on("check_config_pinned_tables_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    std::vector<std::string> tables;
+    StringHelpFunctions::SplitStringByDelimeter(value, ",", tables);
+    for (auto& table : tables) {
+        if (!table.empty() && !ValidationUtil::ValidateTableName(table).ok()) {
+            std::string msg = "Invalid pinned table: " + table +
+                              ". Possible reason: cache_config.pinned_tables is not a comma separated table list.";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
 /* engine config */
 Status
 Config::CheckEngineConfigUseBlasThreshold(const std::string& value) {
@@ -1132,6 +1234,146 @@ Config::CheckEngineConfigUseAVX512(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckEngineConfigSearchConcurrency(const std::string& value) {
+    fiu_return_on("check_config_search_concurrency_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid search concurrency: " + value +
+                          ". Possible reason: engine_config.search_concurrency is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    int64_t search_concurrency = std::stoll(value);
+    int64_t sys_thread_cnt = 8;
+    CommonUtil::GetSystemAvailableThreads(sys_thread_cnt);
+    if (search_concurrency <= 0 || search_concurrency > sys_thread_cnt) {
+        std::string msg = "Invalid search concurrency: " + value +
+                          ". Possible reason: engine_config.search_concurrency is zero or exceeds system cpu cores.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigSearchBatchWindow(const std::string& value) {
+    fiu_return_on("check_config_search_batch_window_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid search batch window: " + value +
+                          ". Possible reason: engine_config.search_batch_window is not a natural number.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    int64_t search_batch_window = std::stoll(value);
+    if (search_batch_window > CONFIG_ENGINE_SEARCH_BATCH_WINDOW_MAX) {
+        std::string msg = "Invalid search batch window: " + value +
+                          ". Possible reason: engine_config.search_batch_window exceeds " +
+                          std::to_string(CONFIG_ENGINE_SEARCH_BATCH_WINDOW_MAX) + " milliseconds.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigSearchUnflushed(const std::string& value) {
+    fiu_return_on("check_config_search_unflushed_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsBool(value).ok()) {
+        std::string msg = "Invalid search unflushed option: " + value +
+                          ". Possible reason: engine_config.search_unflushed is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigSharedQuantizer(const std::string& value) {
+    fiu_return_on("check_config_shared_quantizer_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsBool(value).ok()) {
+        std::string msg = "Invalid shared quantizer option: " + value +
+                          ". Possible reason: engine_config.shared_quantizer is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigBuildIndexConcurrency(const std::string& value) {
+    fiu_return_on("check_config_build_index_concurrency_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid build index concurrency: " + value +
+                          ". Possible reason: engine_config.build_index_concurrency is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    int64_t build_index_concurrency = std::stoll(value);
+    int64_t sys_thread_cnt = 8;
+    CommonUtil::GetSystemAvailableThreads(sys_thread_cnt);
+    if (build_index_concurrency <= 0 || build_index_concurrency > sys_thread_cnt) {
+        std::string msg =
+            "Invalid build index concurrency: " + value +
+            ". Possible reason: engine_config.build_index_concurrency is zero or exceeds system cpu cores.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigBuildIndexThreads(const std::string& value) {
+    fiu_return_on("check_config_build_index_threads_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid build index threads: " + value +
+                          ". Possible reason: engine_config.build_index_threads is not a non-negative integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    int64_t build_index_threads = std::stoll(value);
+    int64_t sys_thread_cnt = 8;
+    CommonUtil::GetSystemAvailableThreads(sys_thread_cnt);
+    if (build_index_threads > sys_thread_cnt) {
+        std::string msg = "Invalid build index threads: " + value +
+                          ". Possible reason: engine_config.build_index_threads exceeds system cpu cores.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigBuildIndexChunkSize(const std::string& value) {
+    fiu_return_on("check_config_build_index_chunk_size_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid build index chunk size: " + value +
+                          ". Possible reason: engine_config.build_index_chunk_size is not a natural number.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    int64_t build_index_chunk_size = std::stoll(value);
+    if (build_index_chunk_size > CONFIG_ENGINE_BUILD_INDEX_CHUNK_SIZE_MAX) {
+        std::string msg = "Invalid build index chunk size: " + value +
+                          ". Possible reason: engine_config.build_index_chunk_size exceeds " +
+                          std::to_string(CONFIG_ENGINE_BUILD_INDEX_CHUNK_SIZE_MAX) + " MB.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigBuildIndexCheckpointInterval(const std::string& value) {
+    fiu_return_on("check_config_build_index_checkpoint_interval_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid build index checkpoint interval: " + value +
+                          ". Possible reason: engine_config.build_index_checkpoint_interval is not a natural number.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 #ifdef MILVUS_GPU_VERSION
 
 Status
@@ -1345,6 +1587,31 @@ Config::CheckWalConfigWalPath(const std::string& value) {
     return ValidationUtil::ValidateStoragePath(value);
 }
 
+Status
+Config::CheckWalConfigDurability(const std::string& value) {
+    fiu_return_on("check_config_wal_durability_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (value != "none" && value != "flush" && value != "fsync" && value != "fsync_interval") {
+        std::string msg = "Invalid wal durability: " + value +
+                          ". Possible reason: wal_config.durability is not one of none, flush, fsync, fsync_interval.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckWalConfigSyncInterval(const std::string& value) {
+    auto exist_error = !ValidationUtil::ValidateStringIsNumber(value).ok() || std::stoll(value) <= 0;
+    fiu_do_on("check_config_wal_sync_interval_fail", exist_error = true);
+
+    if (exist_error) {
+        std::string msg = "Invalid wal sync interval: " + value +
+                          ". Possible reason: wal_config.sync_interval is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ConfigNode&
 Config::GetConfigRoot() {
@@ -1512,6 +1779,14 @@ Config::GetDBConfigAutoFlushInterval(int64_t& value) {
     return Status::OK();
 }
 
+Status
+Config::GetDBConfigMergeIoLimit(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_DB, CONFIG_DB_MERGE_IO_LIMIT, CONFIG_DB_MERGE_IO_LIMIT_DEFAULT);
+    CONFIG_CHECK(CheckDBConfigMergeIoLimit(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
 /* storage config */
 Status
 Config::GetStorageConfigPrimaryPath(std::string& value) {
@@ -1622,6 +1897,14 @@ Config::GetCacheConfigCacheInsertData(bool& value) {
     return Status::OK();
 }
 
+Status
+Config::GetCacheConfigPinnedTables(std::string& value) {
+    std::string str = GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_PINNED_TABLES, CONFIG_CACHE_PINNED_TABLES_DEFAULT);
+    CONFIG_CHECK(CheckCacheConfigPinnedTables(str));
+    value = str;
+    return Status::OK();
+}
+
 /* engine config */
 Status
 Config::GetEngineConfigUseBlasThreshold(int64_t& value) {
@@ -1649,6 +1932,80 @@ Config::GetEngineConfigUseAVX512(bool& value) {
     return Status::OK();
 }
 
+Status
+Config::GetEngineConfigSearchConcurrency(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_CONCURRENCY, CONFIG_ENGINE_SEARCH_CONCURRENCY_DEFAULT);
+    CONFIG_CHECK(CheckEngineConfigSearchConcurrency(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigSearchBatchWindow(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_BATCH_WINDOW, CONFIG_ENGINE_SEARCH_BATCH_WINDOW_DEFAULT);
+    CONFIG_CHECK(CheckEngineConfigSearchBatchWindow(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigSearchUnflushed(bool& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_UNFLUSHED, CONFIG_ENGINE_SEARCH_UNFLUSHED_DEFAULT);
+    CONFIG_CHECK(CheckEngineConfigSearchUnflushed(str));
+    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+    value = (str == "true" || str == "on" || str == "yes" || str == "1");
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigSharedQuantizer(bool& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SHARED_QUANTIZER, CONFIG_ENGINE_SHARED_QUANTIZER_DEFAULT);
+    CONFIG_CHECK(CheckEngineConfigSharedQuantizer(str));
+    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+    value = (str == "true" || str == "on" || str == "yes" || str == "1");
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigBuildIndexConcurrency(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_BUILD_INDEX_CONCURRENCY,
+                                   CONFIG_ENGINE_BUILD_INDEX_CONCURRENCY_DEFAULT);
+    CONFIG_CHECK(CheckEngineConfigBuildIndexConcurrency(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigBuildIndexThreads(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_BUILD_INDEX_THREADS, CONFIG_ENGINE_BUILD_INDEX_THREADS_DEFAULT);
+    CONFIG_CHECK(CheckEngineConfigBuildIndexThreads(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigBuildIndexChunkSize(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_BUILD_INDEX_CHUNK_SIZE, CONFIG_ENGINE_BUILD_INDEX_CHUNK_SIZE_DEFAULT);
+    CONFIG_CHECK(CheckEngineConfigBuildIndexChunkSize(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigBuildIndexCheckpointInterval(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_BUILD_INDEX_CHECKPOINT_INTERVAL,
+                                   CONFIG_ENGINE_BUILD_INDEX_CHECKPOINT_INTERVAL_DEFAULT);
+    CONFIG_CHECK(CheckEngineConfigBuildIndexCheckpointInterval(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
 #ifdef MILVUS_GPU_VERSION
 
 Status
@@ -1804,6 +2161,22 @@ Config::GetWalConfigWalPath(std::string& wal_path) {
     return Status::OK();
 }
 
+Status
+Config::GetWalConfigDurability(std::string& value) {
+    std::string str = GetConfigStr(CONFIG_WAL, CONFIG_WAL_DURABILITY, CONFIG_WAL_DURABILITY_DEFAULT);
+    CONFIG_CHECK(CheckWalConfigDurability(str));
+    value = str;
+    return Status::OK();
+}
+
+Status
+Config::GetWalConfigSyncInterval(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_WAL, CONFIG_WAL_SYNC_INTERVAL, CONFIG_WAL_SYNC_INTERVAL_DEFAULT);
+    CONFIG_CHECK(CheckWalConfigSyncInterval(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
 Status
 Config::GetServerRestartRequired(bool& required) {
     required = restart_required_;
@@ -1874,6 +2247,12 @@ Config::SetDBConfigAutoFlushInterval(const std::string& value) {
     return SetConfigValueInMem(CONFIG_DB, CONFIG_DB_AUTO_FLUSH_INTERVAL, value);
 }
 
+Status
+Config::SetDBConfigMergeIoLimit(const std::string& value) {
+    CONFIG_CHECK(CheckDBConfigMergeIoLimit(value));
+    return SetConfigValueInMem(CONFIG_DB, CONFIG_DB_MERGE_IO_LIMIT, value);
+}
+
 /* storage config */
 Status
 Config::SetStorageConfigPrimaryPath(const std::string& value) {
@@ -1971,6 +2350,13 @@ Config::SetCacheConfigCacheInsertData(const std::string& value) {
     return ExecCallBacks(CONFIG_CACHE, CONFIG_CACHE_CACHE_INSERT_DATA, value);
 }
 
+Status
+Config::SetCacheConfigPinnedTables(const std::string& value) {
+    CONFIG_CHECK(CheckCacheConfigPinnedTables(value));
+    CONFIG_CHECK(SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_PINNED_TABLES, value));
+    return ExecCallBacks(CONFIG_CACHE, CONFIG_CACHE_PINNED_TABLES, value);
+}
+
 /* engine config */
 Status
 Config::SetEngineConfigUseBlasThreshold(const std::string& value) {
@@ -1991,6 +2377,54 @@ Config::SetEngineConfigUseAVX512(const std::string& value) {
     return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_USE_AVX512, value);
 }
 
+Status
+Config::SetEngineConfigSearchConcurrency(const std::string& value) {
+    CONFIG_CHECK(CheckEngineConfigSearchConcurrency(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_CONCURRENCY, value);
+}
+
+Status
+Config::SetEngineConfigSearchBatchWindow(const std::string& value) {
+    CONFIG_CHECK(CheckEngineConfigSearchBatchWindow(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_BATCH_WINDOW, value);
+}
+
+Status
+Config::SetEngineConfigSearchUnflushed(const std::string& value) {
+    CONFIG_CHECK(CheckEngineConfigSearchUnflushed(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_UNFLUSHED, value);
+}
+
+Status
+Config::SetEngineConfigSharedQuantizer(const std::string& value) {
+    CONFIG_CHECK(CheckEngineConfigSharedQuantizer(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SHARED_QUANTIZER, value);
+}
+
+Status
+Config::SetEngineConfigBuildIndexConcurrency(const std::string& value) {
+    CONFIG_CHECK(CheckEngineConfigBuildIndexConcurrency(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_BUILD_INDEX_CONCURRENCY, value);
+}
+
+Status
+Config::SetEngineConfigBuildIndexThreads(const std::string& value) {
+    CONFIG_CHECK(CheckEngineConfigBuildIndexThreads(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_BUILD_INDEX_THREADS, value);
+}
+
+Status
+Config::SetEngineConfigBuildIndexChunkSize(const std::string& value) {
+    CONFIG_CHECK(CheckEngineConfigBuildIndexChunkSize(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_BUILD_INDEX_CHUNK_SIZE, value);
+}
+
+Status
+Config::SetEngineConfigBuildIndexCheckpointInterval(const std::string& value) {
+    CONFIG_CHECK(CheckEngineConfigBuildIndexCheckpointInterval(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_BUILD_INDEX_CHECKPOINT_INTERVAL, value);
+}
+
 /* tracing config */
 Status
 Config::SetTracingConfigJsonConfigPath(const std::string& value) {
@@ -2023,6 +2457,18 @@ Config::SetWalConfigWalPath(const std::string& value) {
     return SetConfigValueInMem(CONFIG_WAL, CONFIG_WAL_WAL_PATH, value);
 }
 
+Status
+Config::SetWalConfigDurability(const std::string& value) {
+    CONFIG_CHECK(CheckWalConfigDurability(value));
+    return SetConfigValueInMem(CONFIG_WAL, CONFIG_WAL_DURABILITY, value);
+}
+
+Status
+Config::SetWalConfigSyncInterval(const std::string& value) {
+    CONFIG_CHECK(CheckWalConfigSyncInterval(value));
+    return SetConfigValueInMem(CONFIG_WAL, CONFIG_WAL_SYNC_INTERVAL, value);
+}
+
 #ifdef MILVUS_GPU_VERSION
 Status
 Config::SetEngineConfigGpuSearchThreshold(const std::string& value) {
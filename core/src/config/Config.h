@@ -61,6 +61,8 @@ static const char* CONFIG_DB_PRELOAD_TABLE = "preload_table";
 static const char* CONFIG_DB_PRELOAD_TABLE_DEFAULT = "";
 static const char* CONFIG_DB_AUTO_FLUSH_INTERVAL = "auto_flush_interval";
 static const char* CONFIG_DB_AUTO_FLUSH_INTERVAL_DEFAULT = "1";
+static const char* CONFIG_DB_MERGE_IO_LIMIT = "merge_io_limit";
+static const char* CONFIG_DB_MERGE_IO_LIMIT_DEFAULT = "4";
 
 /* storage config */
 static const char* CONFIG_STORAGE = "storage_config";
@@ -91,6 +93,8 @@ static const char* CONFIG_CACHE_INSERT_BUFFER_SIZE = "insert_buffer_size";
 static const char* CONFIG_CACHE_INSERT_BUFFER_SIZE_DEFAULT = "1";
 static const char* CONFIG_CACHE_CACHE_INSERT_DATA = "cache_insert_data";
 static const char* CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT = "false";
+static const char* CONFIG_CACHE_PINNED_TABLES = "pinned_tables";
+static const char* CONFIG_CACHE_PINNED_TABLES_DEFAULT = "";
 
 /* metric config */
 static const char* CONFIG_METRIC = "metric_config";
@@ -109,6 +113,24 @@ static const char* CONFIG_ENGINE_OMP_THREAD_NUM = "omp_thread_num";
 static const char* CONFIG_ENGINE_OMP_THREAD_NUM_DEFAULT = "0";
 static const char* CONFIG_ENGINE_USE_AVX512 = "use_avx512";
 static const char* CONFIG_ENGINE_USE_AVX512_DEFAULT = "true";
+static const char* CONFIG_ENGINE_SEARCH_CONCURRENCY = "search_concurrency";
+static const char* CONFIG_ENGINE_SEARCH_CONCURRENCY_DEFAULT = "1";
+static const char* CONFIG_ENGINE_SEARCH_BATCH_WINDOW = "search_batch_window";
+static const char* CONFIG_ENGINE_SEARCH_BATCH_WINDOW_DEFAULT = "0";
+static const int64_t CONFIG_ENGINE_SEARCH_BATCH_WINDOW_MAX = 1000;
+static const char* CONFIG_ENGINE_SEARCH_UNFLUSHED = "search_unflushed";
+static const char* CONFIG_ENGINE_SEARCH_UNFLUSHED_DEFAULT = "false";
+static const char* CONFIG_ENGINE_SHARED_QUANTIZER = "shared_quantizer";
+static const char* CONFIG_ENGINE_SHARED_QUANTIZER_DEFAULT = "false";
+static const char* CONFIG_ENGINE_BUILD_INDEX_CONCURRENCY = "build_index_concurrency";
+static const char* CONFIG_ENGINE_BUILD_INDEX_CONCURRENCY_DEFAULT = "1";
+static const char* CONFIG_ENGINE_BUILD_INDEX_THREADS = "build_index_threads";
+static const char* CONFIG_ENGINE_BUILD_INDEX_THREADS_DEFAULT = "0";
+static const char* CONFIG_ENGINE_BUILD_INDEX_CHUNK_SIZE = "build_index_chunk_size";
+static const char* CONFIG_ENGINE_BUILD_INDEX_CHUNK_SIZE_DEFAULT = "0";
+static const int64_t CONFIG_ENGINE_BUILD_INDEX_CHUNK_SIZE_MAX = 65536;
+static const char* CONFIG_ENGINE_BUILD_INDEX_CHECKPOINT_INTERVAL = "build_index_checkpoint_interval";
+static const char* CONFIG_ENGINE_BUILD_INDEX_CHECKPOINT_INTERVAL_DEFAULT = "60";
 static const char* CONFIG_ENGINE_GPU_SEARCH_THRESHOLD = "gpu_search_threshold";
 static const char* CONFIG_ENGINE_GPU_SEARCH_THRESHOLD_DEFAULT = "1000";
 
@@ -146,6 +168,10 @@ static const int64_t CONFIG_WAL_BUFFER_SIZE_MAX = 4096;
 static const int64_t CONFIG_WAL_BUFFER_SIZE_MIN = 64;
 static const char* CONFIG_WAL_WAL_PATH = "wal_path";
 static const char* CONFIG_WAL_WAL_PATH_DEFAULT = "/tmp/milvus/wal";
+static const char* CONFIG_WAL_DURABILITY = "durability";
+static const char* CONFIG_WAL_DURABILITY_DEFAULT = "flush";
+static const char* CONFIG_WAL_SYNC_INTERVAL = "sync_interval";
+static const char* CONFIG_WAL_SYNC_INTERVAL_DEFAULT = "1000";
 
 class Config {
  private:
@@ -221,6 +247,8 @@ class Config {
     CheckDBConfigArchiveDaysThreshold(const std::string& value);
     Status
     CheckDBConfigAutoFlushInterval(const std::string& value);
+    Status
+    CheckDBConfigMergeIoLimit(const std::string& value);
 
     /* storage config */
     Status
@@ -257,6 +285,8 @@ class Config {
     CheckCacheConfigInsertBufferSize(const std::string& value);
     Status
     CheckCacheConfigCacheInsertData(const std::string& value);
+    Status
+    CheckCacheConfigPinnedTables(const std::string& value);
 
     /* engine config */
     Status
@@ -265,6 +295,22 @@ class Config {
     CheckEngineConfigOmpThreadNum(const std::string& value);
     Status
     CheckEngineConfigUseAVX512(const std::string& value);
+    Status
+    CheckEngineConfigSearchConcurrency(const std::string& value);
+    Status
+    CheckEngineConfigSearchBatchWindow(const std::string& value);
+    Status
+    CheckEngineConfigSearchUnflushed(const std::string& value);
+    Status
+    CheckEngineConfigSharedQuantizer(const std::string& value);
+    Status
+    CheckEngineConfigBuildIndexConcurrency(const std::string& value);
+    Status
+    CheckEngineConfigBuildIndexThreads(const std::string& value);
+    Status
+    CheckEngineConfigBuildIndexChunkSize(const std::string& value);
+    Status
+    CheckEngineConfigBuildIndexCheckpointInterval(const std::string& value);
 
 #ifdef MILVUS_GPU_VERSION
     Status
@@ -296,6 +342,10 @@ class Config {
     CheckWalConfigBufferSize(const std::string& value);
     Status
     CheckWalConfigWalPath(const std::string& value);
+    Status
+    CheckWalConfigDurability(const std::string& value);
+    Status
+    CheckWalConfigSyncInterval(const std::string& value);
 
     std::string
     GetConfigStr(const std::string& parent_key, const std::string& child_key, const std::string& default_value = "");
@@ -332,6 +382,8 @@ class Config {
     GetDBConfigPreloadTable(std::string& value);
     Status
     GetDBConfigAutoFlushInterval(int64_t& value);
+    Status
+    GetDBConfigMergeIoLimit(int64_t& value);
 
     /* storage config */
     Status
@@ -368,6 +420,8 @@ class Config {
     GetCacheConfigInsertBufferSize(int64_t& value);
     Status
     GetCacheConfigCacheInsertData(bool& value);
+    Status
+    GetCacheConfigPinnedTables(std::string& value);
 
     /* engine config */
     Status
@@ -376,6 +430,22 @@ class Config {
     GetEngineConfigOmpThreadNum(int64_t& value);
     Status
     GetEngineConfigUseAVX512(bool& value);
+    Status
+    GetEngineConfigSearchConcurrency(int64_t& value);
+    Status
+    GetEngineConfigSearchBatchWindow(int64_t& value);
+    Status
+    GetEngineConfigSearchUnflushed(bool& value);
+    Status
+    GetEngineConfigSharedQuantizer(bool& value);
+    Status
+    GetEngineConfigBuildIndexConcurrency(int64_t& value);
+    Status
+    GetEngineConfigBuildIndexThreads(int64_t& value);
+    Status
+    GetEngineConfigBuildIndexChunkSize(int64_t& value);
+    Status
+    GetEngineConfigBuildIndexCheckpointInterval(int64_t& value);
 
 #ifdef MILVUS_GPU_VERSION
     Status
@@ -407,6 +477,10 @@ class Config {
     GetWalConfigBufferSize(int64_t& value);
     Status
     GetWalConfigWalPath(std::string& value);
+    Status
+    GetWalConfigDurability(std::string& value);
+    Status
+    GetWalConfigSyncInterval(int64_t& value);
 
     Status
     GetServerRestartRequired(bool& required);
@@ -435,6 +509,8 @@ class Config {
     SetDBConfigArchiveDaysThreshold(const std::string& value);
     Status
     SetDBConfigAutoFlushInterval(const std::string& value);
+    Status
+    SetDBConfigMergeIoLimit(const std::string& value);
 
     /* storage config */
     Status
@@ -471,6 +547,8 @@ class Config {
     SetCacheConfigInsertBufferSize(const std::string& value);
     Status
     SetCacheConfigCacheInsertData(const std::string& value);
+    Status
+    SetCacheConfigPinnedTables(const std::string& value);
 
     /* engine config */
     Status
@@ -479,6 +557,22 @@ class Config {
     SetEngineConfigOmpThreadNum(const std::string& value);
     Status
     SetEngineConfigUseAVX512(const std::string& value);
+    Status
+    SetEngineConfigSearchConcurrency(const std::string& value);
+    Status
+    SetEngineConfigSearchBatchWindow(const std::string& value);
+    Status
+    SetEngineConfigSearchUnflushed(const std::string& value);
+    Status
+    SetEngineConfigSharedQuantizer(const std::string& value);
+    Status
+    SetEngineConfigBuildIndexConcurrency(const std::string& value);
+    Status
+    SetEngineConfigBuildIndexThreads(const std::string& value);
+    Status
+    SetEngineConfigBuildIndexChunkSize(const std::string& value);
+    Status
+    SetEngineConfigBuildIndexCheckpointInterval(const std::string& value);
 
     /* tracing config */
     Status
@@ -493,6 +587,10 @@ class Config {
     SetWalConfigBufferSize(const std::string& value);
     Status
     SetWalConfigWalPath(const std::string& value);
+    Status
+    SetWalConfigDurability(const std::string& value);
+    Status
+    SetWalConfigSyncInterval(const std::string& value);
 
 #ifdef MILVUS_GPU_VERSION
     Status
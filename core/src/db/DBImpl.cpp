@@ -28,8 +28,11 @@
 #include "Utils.h"
 #include "cache/CpuCacheMgr.h"
 #include "cache/GpuCacheMgr.h"
+#include "config/Config.h"
 #include "db/IDGenerator.h"
+#include "db/WalApplier.h"
 #include "engine/EngineFactory.h"
+#include "engine/IndexModelMgr.h"
 #include "insert/MemMenagerFactory.h"
 #include "meta/MetaConsts.h"
 #include "meta/MetaFactory.h"
@@ -39,14 +42,17 @@
 #include "scheduler/job/BuildIndexJob.h"
 #include "scheduler/job/DeleteJob.h"
 #include "scheduler/job/SearchJob.h"
+#include "scheduler/task/SearchTask.h"
 #include "segment/SegmentReader.h"
 #include "segment/SegmentWriter.h"
+#include "utils/CommonUtil.h"
 #include "utils/Exception.h"
 #include "utils/Log.h"
 #include "utils/StringHelpFunctions.h"
 #include "utils/TimeRecorder.h"
 #include "utils/ValidationUtil.h"
 #include "wal/WalDefinations.h"
+#include "wrapper/VecIndex.h"
 
 namespace milvus {
 namespace engine {
@@ -56,15 +62,73 @@ namespace {
 constexpr uint64_t METRIC_ACTION_INTERVAL = 1;
 constexpr uint64_t COMPACT_ACTION_INTERVAL = 1;
 constexpr uint64_t INDEX_ACTION_INTERVAL = 1;
+constexpr uint64_t WAL_REPLAY_LOG_INTERVAL = 10;  // seconds
 
 static const Status SHUTDOWN_ERROR = Status(DB_ERROR, "Milvus server is shutdown!");
 
+// the largest topk searched in the files, the over-fetch for unflushed searches doesn't go beyond it
+constexpr uint64_t MAX_FETCH_TOPK = 2048;
+
+// merge the k results of unflushed vectors into the fetch_k results of files, remove the ids deleted but not
+// applied to the segments yet and the ids found both in memory and on disk, and keep the top k of the rest
+void
+MergeMemoryResults(uint64_t nq, uint64_t k, uint64_t fetch_k, bool ascending, const ResultIds& mem_ids,
+                   const ResultDistances& mem_distances, const std::set<IDNumber>& deleted_ids, ResultIds& result_ids,
+                   ResultDistances& result_distances) {
+    if (nq == 0) {
+        return;
+    }
+
+    // rows of the merged results are fetch_k wide, only the first k of each memory row are read
+    ResultIds src_ids(nq * fetch_k, -1);
+    ResultDistances src_distances(nq * fetch_k, 0.0f);
+    if (!mem_ids.empty()) {
+        for (uint64_t i = 0; i < nq; ++i) {
+            std::copy_n(mem_ids.begin() + i * k, k, src_ids.begin() + i * fetch_k);
+            std::copy_n(mem_distances.begin() + i * k, k, src_distances.begin() + i * fetch_k);
+        }
+        scheduler::XSearchTask::MergeTopkToResultSet(src_ids, src_distances, k, nq, fetch_k, ascending, result_ids,
+                                                     result_distances);
+    }
+
+    ResultIds ids(nq * k, -1);
+    ResultDistances distances(nq * k, 0.0f);
+    size_t res_k = result_ids.size() / nq;
+    for (uint64_t i = 0; i < nq; ++i) {
+        std::set<IDNumber> seen;
+        size_t pos = i * k;
+        for (size_t j = i * res_k; j < (i + 1) * res_k && pos < (i + 1) * k; ++j) {
+            IDNumber id = result_ids[j];
+            if (id < 0 || deleted_ids.find(id) != deleted_ids.end() || !seen.insert(id).second) {
+                continue;
+            }
+            ids[pos] = id;
+            distances[pos] = result_distances[j];
+            ++pos;
+        }
+    }
+    result_ids.swap(ids);
+    result_distances.swap(distances);
+}
+
+// apply the pinned tables to the caches again, so the partitions created since are pinned with their tables
+void
+RefreshPinnedTables() {
+    server::Config& config = server::Config::GetInstance();
+    std::string pinned_tables;
+    config.GetCacheConfigPinnedTables(pinned_tables);
+    if (!pinned_tables.empty()) {
+        config.SetCacheConfigPinnedTables(pinned_tables);
+    }
+}
+
 }  // namespace
 
 DBImpl::DBImpl(const DBOptions& options)
     : options_(options), initialized_(false), merge_thread_pool_(1, 1), index_thread_pool_(1, 1) {
     meta_ptr_ = MetaFactory::Build(options.meta_, options.mode_);
     mem_mgr_ = MemManagerFactory::Build(meta_ptr_, options_);
+    merge_mgr_ptr_ = std::make_shared<MergeManager>(meta_ptr_, options_);
 
     if (options_.wal_enable_) {
         wal::MXLogConfiguration mxlog_config;
@@ -72,9 +136,31 @@ DBImpl::DBImpl(const DBOptions& options)
         // 2 buffers in the WAL
         mxlog_config.buffer_size = options_.buffer_size_ / 2;
         mxlog_config.mxlog_path = options_.mxlog_path_;
+        if (options_.wal_durability_ == "none") {
+            mxlog_config.durability = wal::MXLogDurability::None;
+        } else if (options_.wal_durability_ == "fsync") {
+            mxlog_config.durability = wal::MXLogDurability::Fsync;
+        } else if (options_.wal_durability_ == "fsync_interval") {
+            mxlog_config.durability = wal::MXLogDurability::FsyncInterval;
+        } else {
+            mxlog_config.durability = wal::MXLogDurability::Flush;
+        }
+        mxlog_config.sync_interval = options_.wal_sync_interval_;
         wal_mgr_ = std::make_shared<wal::WalManager>(mxlog_config);
     }
 
+    if (options_.search_batch_window_ > 0) {
+        auto query_func = [this](const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                                 const std::vector<std::string>& partition_tags, uint64_t k,
+                                 const milvus::json& extra_params, const VectorsData& vectors, ResultIds& result_ids,
+                                 ResultDistances& result_distances) {
+            return QueryHelper(context, table_id, partition_tags, k, extra_params, vectors, result_ids,
+                               result_distances);
+        };
+        query_batcher_ = std::make_shared<QueryBatcher>(options_.search_batch_window_, options_.search_batch_max_nq_,
+                                                        query_func);
+    }
+
     SetIdentity("DBImpl");
     AddCacheInsertDataListener();
 
@@ -98,6 +184,19 @@ DBImpl::Start() {
     // ENGINE_LOG_TRACE << "DB service start";
     initialized_.store(true, std::memory_order_release);
 
+    // the caches pin the partitions of a pinned table together with it
+    auto meta_ptr = meta_ptr_;
+    cache::CpuCacheMgr::SetPartitionsResolver([meta_ptr](const std::string& table_id) {
+        std::vector<meta::TableSchema> partition_array;
+        meta_ptr->ShowPartitions(table_id, partition_array);
+        std::vector<std::string> partition_ids;
+        for (auto& schema : partition_array) {
+            partition_ids.push_back(schema.table_id_);
+        }
+        return partition_ids;
+    });
+    RefreshPinnedTables();
+
     // wal
     if (options_.wal_enable_) {
         auto error_code = DB_ERROR;
@@ -109,17 +208,9 @@ DBImpl::Start() {
         }
 
         // recovery
-        while (1) {
-            wal::MXLogRecord record;
-            auto error_code = wal_mgr_->GetNextRecovery(record);
-            if (error_code != WAL_SUCCESS) {
-                throw Exception(error_code, "Wal recovery error!");
-            }
-            if (record.type == wal::MXLogType::None) {
-                break;
-            }
-
-            ExecWalRecord(record);
+        auto status = ReplayWal();
+        if (!status.ok()) {
+            throw Exception(status.code(), status.message());
         }
 
         // for distribute version, some nodes are read only
@@ -167,6 +258,8 @@ DBImpl::Stop() {
         meta_ptr_->CleanUpShadowFiles();
     }
 
+    cache::CpuCacheMgr::SetPartitionsResolver(nullptr);
+
     // ENGINE_LOG_TRACE << "DB service stop";
     return Status::OK();
 }
@@ -430,7 +523,11 @@ DBImpl::CreatePartition(const std::string& table_id, const std::string& partitio
 
     uint64_t lsn = 0;
     meta_ptr_->GetTableFlushLSN(table_id, lsn);
-    return meta_ptr_->CreatePartition(table_id, partition_name, partition_tag, lsn);
+    auto status = meta_ptr_->CreatePartition(table_id, partition_name, partition_tag, lsn);
+    if (status.ok()) {
+        RefreshPinnedTables();
+    }
+    return status;
 }
 
 Status
@@ -505,12 +602,16 @@ DBImpl::InsertVectors(const std::string& table_id, const std::string& partition_
             return status;
         }
 
+        bool succeed = true;
         if (!vectors.float_data_.empty()) {
-            wal_mgr_->Insert(table_id, partition_tag, vectors.id_array_, vectors.float_data_);
+            succeed = wal_mgr_->Insert(table_id, partition_tag, vectors.id_array_, vectors.float_data_);
         } else if (!vectors.binary_data_.empty()) {
-            wal_mgr_->Insert(table_id, partition_tag, vectors.id_array_, vectors.binary_data_);
+            succeed = wal_mgr_->Insert(table_id, partition_tag, vectors.id_array_, vectors.binary_data_);
         }
         bg_task_swn_.Notify();
+        if (!succeed) {
+            return Status(DB_ERROR, "Failed to write insert record into WAL");
+        }
 
     } else {
         wal::MXLogRecord record;
@@ -552,8 +653,11 @@ DBImpl::DeleteVectors(const std::string& table_id, IDNumbers vector_ids) {
 
     Status status;
     if (options_.wal_enable_) {
-        wal_mgr_->DeleteById(table_id, vector_ids);
+        bool succeed = wal_mgr_->DeleteById(table_id, vector_ids);
         bg_task_swn_.Notify();
+        if (!succeed) {
+            return Status(DB_ERROR, "Failed to write delete record into WAL");
+        }
 
     } else {
         wal::MXLogRecord record;
@@ -766,11 +870,13 @@ DBImpl::CompactFile(const std::string& table_id, const meta::TableFileSchema& fi
     utils::GetParentPath(file.location_, segment_dir_to_merge);
 
     ENGINE_LOG_DEBUG << "Compacting begin...";
-    segment_writer_ptr->Merge(segment_dir_to_merge, compacted_file.file_id_);
+    status = segment_writer_ptr->Merge(segment_dir_to_merge, compacted_file.file_id_);
 
     // Serialize
-    ENGINE_LOG_DEBUG << "Serializing compacted segment...";
-    status = segment_writer_ptr->Serialize();
+    if (status.ok()) {
+        ENGINE_LOG_DEBUG << "Serializing compacted segment...";
+        status = segment_writer_ptr->Serialize();
+    }
     if (!status.ok()) {
         ENGINE_LOG_ERROR << "Failed to serialize compacted segment: " << status.message();
         compacted_file.file_type_ = meta::TableFileSchema::TO_DELETE;
@@ -799,19 +905,42 @@ DBImpl::CompactFile(const std::string& table_id, const meta::TableFileSchema& fi
         compacted_file.file_type_ = meta::TableFileSchema::TO_DELETE;
     }
 
-    files_to_update.emplace_back(compacted_file);
-
-    // Set all files in segment to TO_DELETE
     auto& segment_id = file.segment_id_;
     meta::TableFilesSchema segment_files;
     status = meta_ptr_->GetTableFilesBySegmentId(segment_id, segment_files);
     if (!status.ok()) {
         return status;
     }
+
+    // If the segment has an ivf index, compact its inverted lists instead of building the index again
+    if (compacted_file.file_type_ == meta::TableFileSchema::TO_INDEX) {
+        for (auto& f : segment_files) {
+            if (f.file_type_ != meta::TableFileSchema::INDEX || f.engine_type_ != compacted_file.engine_type_ ||
+                !utils::IsCompactableIndexType(f.engine_type_)) {
+                continue;
+            }
+
+            meta::TableFileSchema compacted_index_file;
+            auto index_status = CompactIndexFile(f, compacted_file, compacted_index_file);
+            if (index_status.ok()) {
+                compacted_file.file_type_ = meta::TableFileSchema::BACKUP;
+                files_to_update.emplace_back(compacted_index_file);
+            } else {
+                ENGINE_LOG_WARNING << "Failed to compact index of segment " << segment_id
+                                   << ", the index will be rebuilt: " << index_status.message();
+            }
+            break;
+        }
+    }
+
+    files_to_update.emplace_back(compacted_file);
+
+    // Set all files in segment to TO_DELETE
     for (auto& f : segment_files) {
         f.file_type_ = meta::TableFileSchema::FILE_TYPE::TO_DELETE;
         files_to_update.emplace_back(f);
     }
+    merge_mgr_ptr_->EraseSegment(file.table_id_, segment_id);
 
     ENGINE_LOG_DEBUG << "Compacted segment " << compacted_file.segment_id_ << " from "
                      << std::to_string(file.file_size_) << " bytes to " << std::to_string(compacted_file.file_size_)
@@ -824,6 +953,96 @@ DBImpl::CompactFile(const std::string& table_id, const meta::TableFileSchema& fi
     return status;
 }
 
+Status
+DBImpl::CompactIndexFile(const meta::TableFileSchema& index_file, const meta::TableFileSchema& compacted_file,
+                         meta::TableFileSchema& compacted_index_file) {
+    std::string segment_dir;
+    utils::GetParentPath(index_file.location_, segment_dir);
+    segment::SegmentReader segment_reader(segment_dir);
+
+    std::vector<segment::doc_id_t> uids;
+    auto status = segment_reader.LoadUids(uids);
+    if (!status.ok()) {
+        return status;
+    }
+    segment::DeletedDocsPtr deleted_docs;
+    status = segment_reader.LoadDeletedDocs(deleted_docs);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // SegmentWriter::Merge keeps the remaining vectors in order, so the new offset of a vector is
+    // its old offset minus the number of deleted offsets before it
+    std::vector<int64_t> offset_map(uids.size(), 0);
+    for (auto& offset : deleted_docs->GetDeletedDocs()) {
+        if (offset < 0 || offset >= static_cast<segment::offset_t>(offset_map.size())) {
+            return Status(DB_ERROR, "Deleted offset out of range in segment " + segment_dir);
+        }
+        offset_map[offset] = -1;
+    }
+    std::vector<segment::doc_id_t> compacted_uids;
+    compacted_uids.reserve(uids.size());
+    for (size_t i = 0; i < uids.size(); ++i) {
+        if (offset_map[i] >= 0) {
+            offset_map[i] = compacted_uids.size();
+            compacted_uids.push_back(uids[i]);
+        }
+    }
+
+    std::string compacted_segment_dir;
+    utils::GetParentPath(compacted_file.location_, compacted_segment_dir);
+    segment::SegmentReader compacted_reader(compacted_segment_dir);
+    std::vector<segment::doc_id_t> segment_uids;
+    status = compacted_reader.LoadUids(segment_uids);
+    if (!status.ok()) {
+        return status;
+    }
+    if (segment_uids != compacted_uids) {
+        return Status(DB_ERROR, "Compacted segment does not match the deleted docs of " + segment_dir);
+    }
+
+    // load from disk, the cached index may be in use by searches
+    auto index = read_index(index_file.location_);
+    if (index == nullptr) {
+        return Status(DB_ERROR, "Failed to load index from " + index_file.location_);
+    }
+    status = index->Compact(offset_map);
+    if (!status.ok()) {
+        return status;
+    }
+    if (index->Count() != static_cast<int64_t>(segment_uids.size())) {
+        return Status(DB_ERROR, "Compacted index count does not match segment " + compacted_segment_dir);
+    }
+    index->SetUids(segment_uids);
+
+    compacted_index_file.table_id_ = compacted_file.table_id_;
+    compacted_index_file.segment_id_ = compacted_file.segment_id_;
+    compacted_index_file.date_ = compacted_file.date_;
+    compacted_index_file.file_type_ = meta::TableFileSchema::NEW_INDEX;
+    status = meta_ptr_->CreateTableFile(compacted_index_file);
+    if (!status.ok()) {
+        return status;
+    }
+
+    status = write_index(index, compacted_index_file.location_);
+    if (!status.ok()) {
+        compacted_index_file.file_type_ = meta::TableFileSchema::TO_DELETE;
+        auto mark_status = meta_ptr_->UpdateTableFile(compacted_index_file);
+        if (mark_status.ok()) {
+            ENGINE_LOG_DEBUG << "Mark file: " << compacted_index_file.file_id_ << " to to_delete";
+        }
+        return status;
+    }
+
+    compacted_index_file.file_type_ = meta::TableFileSchema::INDEX;
+    compacted_index_file.file_size_ = server::CommonUtil::GetFileSize(compacted_index_file.location_);
+    compacted_index_file.row_count_ = segment_uids.size();
+
+    ENGINE_LOG_DEBUG << "Compacted index file " << index_file.file_id_ << " to " << compacted_index_file.file_id_
+                     << " with " << compacted_index_file.row_count_ << " rows";
+    return Status::OK();
+}
+
 Status
 DBImpl::GetVectorByID(const std::string& table_id, const IDNumber& vector_id, VectorsData& vector) {
     if (!initialized_.load(std::memory_order_acquire)) {
@@ -968,18 +1187,24 @@ DBImpl::GetVectorByIdHelper(const std::string& table_id, IDNumber vector_id, Vec
 
         // Check if the id is present in bloom filter.
         if (id_bloom_filter_ptr->Check(vector_id)) {
-            // Load uids and check if the id is indeed present. If yes, find its offset.
-            std::vector<int64_t> offsets;
-            std::vector<segment::doc_id_t> uids;
-            auto status = segment_reader.LoadUids(uids);
-            if (!status.ok()) {
-                return status;
+            // Check if the id is indeed present by the id index. If yes, find its offset.
+            // The id index is cached along with the index, load it from segment only when not cached.
+            Status status;
+            segment::IdIndexPtr id_index_ptr;
+            auto cached_index =
+                std::static_pointer_cast<VecIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(file.location_));
+            if (cached_index != nullptr) {
+                id_index_ptr = cached_index->GetIdIndex();
+            }
+            if (id_index_ptr == nullptr) {
+                status = segment_reader.LoadIdIndex(id_index_ptr);
+                if (!status.ok()) {
+                    return status;
+                }
             }
 
-            auto found = std::find(uids.begin(), uids.end(), vector_id);
-            if (found != uids.end()) {
-                auto offset = std::distance(uids.begin(), found);
-
+            segment::offset_t offset;
+            if (id_index_ptr->Get(vector_id, offset)) {
                 // Check whether the id has been deleted
                 segment::DeletedDocsPtr deleted_docs_ptr;
                 status = segment_reader.LoadDeletedDocs(deleted_docs_ptr);
@@ -1102,50 +1327,99 @@ Status
 DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string& table_id,
               const std::vector<std::string>& partition_tags, uint64_t k, const milvus::json& extra_params,
               const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances) {
-    auto query_ctx = context->Child("Query");
-
     if (!initialized_.load(std::memory_order_acquire)) {
         return SHUTDOWN_ERROR;
     }
 
-    Status status;
-    std::vector<size_t> ids;
-    meta::TableFilesSchema files_array;
+    if (query_batcher_ != nullptr && query_batcher_->Batchable(vectors)) {
+        return query_batcher_->Query(context, table_id, partition_tags, k, extra_params, vectors, result_ids,
+                                     result_distances);
+    }
 
+    return QueryHelper(context, table_id, partition_tags, k, extra_params, vectors, result_ids, result_distances);
+}
+
+Status
+DBImpl::QueryHelper(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                    const std::vector<std::string>& partition_tags, uint64_t k, const milvus::json& extra_params,
+                    const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances) {
+    auto query_ctx = context->Child("Query");
+
+    Status status;
+    std::vector<std::string> table_names;
     if (partition_tags.empty()) {
         // no partition tag specified, means search in whole table
-        // get all table files from parent table
-        status = GetFilesToSearch(table_id, ids, files_array);
-        if (!status.ok()) {
-            return status;
-        }
+        table_names.push_back(table_id);
 
         std::vector<meta::TableSchema> partition_array;
         status = meta_ptr_->ShowPartitions(table_id, partition_array);
         for (auto& schema : partition_array) {
-            status = GetFilesToSearch(schema.table_id_, ids, files_array);
-        }
-
-        if (files_array.empty()) {
-            return Status::OK();
+            table_names.push_back(schema.table_id_);
         }
     } else {
-        // get files from specified partitions
+        // search in specified partitions
         std::set<std::string> partition_name_array;
         GetPartitionsByTags(table_id, partition_tags, partition_name_array);
+        table_names.assign(partition_name_array.begin(), partition_name_array.end());
+    }
+
+    // vectors in memory are searched before the files are listed, a segment flushed in between is found twice
+    // rather than missed, the duplicates are removed by MergeMemoryResults()
+    bool search_memory = options_.search_unflushed_ && vectors.id_array_.empty();
+    ResultIds mem_ids;
+    ResultDistances mem_distances;
+    std::set<IDNumber> deleted_ids;
+    bool ascending = true;
+    uint64_t fetch_k = k;
+    if (search_memory) {
+        meta::TableSchema table_schema;
+        table_schema.table_id_ = table_id;
+        status = meta_ptr_->DescribeTable(table_schema);
+        if (!status.ok()) {
+            return status;
+        }
+        ascending = (table_schema.metric_type_ != static_cast<int32_t>(MetricType::IP));
 
-        for (auto& partition_name : partition_name_array) {
-            status = GetFilesToSearch(partition_name, ids, files_array);
+        for (auto& name : table_names) {
+            status = mem_mgr_->Search(name, k, vectors, ascending, mem_ids, mem_distances, deleted_ids);
+            if (!status.ok()) {
+                return status;
+            }
         }
 
-        if (files_array.empty()) {
-            return Status::OK();
+        // the files are searched for more than k, so k hits remain after the merge drops some: a pending delete
+        // drops a hit from memory and one from the files, a memory hit drops its duplicate in the files
+        fetch_k = k + 2 * deleted_ids.size() + (mem_ids.empty() ? 0 : k);
+        fetch_k = std::max(k, std::min(fetch_k, MAX_FETCH_TOPK));
+    }
+
+    std::vector<size_t> ids;
+    meta::TableFilesSchema files_array;
+    for (auto& name : table_names) {
+        status = GetFilesToSearch(name, ids, files_array);
+        if (!status.ok() && name == table_id) {
+            return status;
         }
     }
 
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
-    status = QueryAsync(query_ctx, table_id, files_array, k, extra_params, vectors, result_ids, result_distances);
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
+    if (files_array.empty() && mem_ids.empty()) {
+        return Status::OK();
+    }
+
+    if (!files_array.empty()) {
+        cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
+        status = QueryAsync(query_ctx, table_id, files_array, fetch_k, extra_params, vectors, result_ids,
+                            result_distances);
+        cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    if (search_memory) {
+        MergeMemoryResults(vectors.vector_count_, k, fetch_k, ascending, mem_ids, mem_distances, deleted_ids,
+                           result_ids, result_distances);
+    }
 
     query_ctx->GetTraceContext()->GetSpan()->Finish();
 
@@ -1372,13 +1646,14 @@ DBImpl::StartMergeTask() {
 }
 
 Status
-DBImpl::MergeFiles(const std::string& table_id, const meta::TableFilesSchema& files) {
+DBImpl::MergeFiles(const std::string& table_id, const meta::TableFilesSchema& files,
+                   meta::TableFileSchema& merged_file) {
     // const std::lock_guard<std::mutex> lock(flush_merge_compact_mutex_);
 
-    ENGINE_LOG_DEBUG << "Merge files for table: " << table_id;
+    ENGINE_LOG_DEBUG << "Merge " << files.size() << " files for table: " << table_id;
 
     // step 1: create table file
-    meta::TableFileSchema table_file;
+    meta::TableFileSchema& table_file = merged_file;
     table_file.table_id_ = table_id;
     table_file.file_type_ = meta::TableFileSchema::NEW_MERGE;
     Status status = meta_ptr_->CreateTableFile(table_file);
@@ -1404,19 +1679,20 @@ DBImpl::MergeFiles(const std::string& table_id, const meta::TableFilesSchema& fi
         server::CollectMergeFilesMetrics metrics;
         std::string segment_dir_to_merge;
         utils::GetParentPath(file.location_, segment_dir_to_merge);
-        segment_writer_ptr->Merge(segment_dir_to_merge, table_file.file_id_);
+        status = segment_writer_ptr->Merge(segment_dir_to_merge, table_file.file_id_);
+        if (!status.ok()) {
+            break;
+        }
         auto file_schema = file;
         file_schema.file_type_ = meta::TableFileSchema::TO_DELETE;
         updated.push_back(file_schema);
-        auto size = segment_writer_ptr->Size();
-        if (size >= file_schema.index_file_size_) {
-            break;
-        }
     }
 
     // step 3: serialize to disk
     try {
-        status = segment_writer_ptr->Serialize();
+        if (status.ok()) {
+            status = segment_writer_ptr->Serialize();
+        }
         fiu_do_on("DBImpl.MergeFiles.Serialize_ThrowException", throw std::exception());
         fiu_do_on("DBImpl.MergeFiles.Serialize_ErrorStatus", status = Status(DB_ERROR, ""));
     } catch (std::exception& ex) {
@@ -1465,24 +1741,45 @@ Status
 DBImpl::BackgroundMergeFiles(const std::string& table_id) {
     const std::lock_guard<std::mutex> lock(flush_merge_compact_mutex_);
 
-    meta::TableFilesSchema raw_files;
-    auto status = meta_ptr_->FilesToMerge(table_id, raw_files);
+    MergeFilesGroups groups;
+    auto status = merge_mgr_ptr_->PickFiles(table_id, groups);
     if (!status.ok()) {
         ENGINE_LOG_ERROR << "Failed to get merge files for table: " << table_id;
         return status;
     }
 
-    if (raw_files.size() < options_.merge_trigger_number_) {
-        ENGINE_LOG_TRACE << "Files number not greater equal than merge trigger number, skip merge action";
+    if (groups.empty()) {
+        ENGINE_LOG_TRACE << "No files to merge by merge policy, skip merge action";
         return Status::OK();
     }
 
-    status = OngoingFileChecker::GetInstance().MarkOngoingFiles(raw_files);
-    MergeFiles(table_id, raw_files);
-    status = OngoingFileChecker::GetInstance().UnmarkOngoingFiles(raw_files);
+    // the io budget is per table, so a large table can't starve the others of merging
+    uint64_t merged_bytes = 0;
+    for (auto& files : groups) {
+        uint64_t group_bytes = 0;
+        for (auto& file : files) {
+            group_bytes += file.file_size_;
+        }
 
-    if (!initialized_.load(std::memory_order_acquire)) {
-        ENGINE_LOG_DEBUG << "Server will shutdown, skip merge action for table: " << table_id;
+        // at least one group is merged in a round, the others are left to later rounds once the limit is reached
+        if (options_.merge_io_limit_ > 0 && merged_bytes > 0 && merged_bytes + group_bytes > options_.merge_io_limit_) {
+            ENGINE_LOG_DEBUG << "Merge io limit reached, defer merge action for table: " << table_id;
+            break;
+        }
+
+        status = OngoingFileChecker::GetInstance().MarkOngoingFiles(files);
+        meta::TableFileSchema merged_file;
+        status = MergeFiles(table_id, files, merged_file);
+        if (status.ok()) {
+            merge_mgr_ptr_->RecordMerge(table_id, files, merged_file);
+        }
+        OngoingFileChecker::GetInstance().UnmarkOngoingFiles(files);
+        merged_bytes += group_bytes;
+
+        if (!initialized_.load(std::memory_order_acquire)) {
+            ENGINE_LOG_DEBUG << "Server will shutdown, skip merge action for table: " << table_id;
+            break;
+        }
     }
 
     return Status::OK();
@@ -1693,6 +1990,8 @@ DBImpl::DropTableRecursively(const std::string& table_id) {
     status = mem_mgr_->EraseMemVector(table_id);  // not allow insert
     status = meta_ptr_->DropTable(table_id);      // soft delete table
     index_failed_checker_.CleanFailedIndexFileOfTable(table_id);
+    merge_mgr_ptr_->DropTable(table_id);
+    IndexModelMgr::GetInstance().Evict(utils::GetTableIndexModelPath(options_.meta_, table_id));
 
     // scheduler will determine when to delete table files
     auto nres = scheduler::ResMgrInst::GetInstance()->GetNumOfComputeResource();
@@ -1995,6 +2294,56 @@ DBImpl::ExecWalRecord(const wal::MXLogRecord& record) {
     return status;
 }
 
+Status
+DBImpl::ReplayWal() {
+    uint64_t total_size = wal_mgr_->GetRecoverySize();
+    if (total_size == 0) {
+        return Status::OK();
+    }
+    ENGINE_LOG_INFO << "Start to replay " << total_size << " bytes of wal";
+
+    WalApplier applier(std::thread::hardware_concurrency(),
+                       [this](const wal::MXLogRecord& record) { return ExecWalRecord(record); }, mem_mgr_,
+                       options_.insert_buffer_size_);
+    wal_mgr_->SetReadRelease([&applier]() { applier.WaitPending(); });
+
+    auto start = std::chrono::steady_clock::now();
+    auto next_log_time = start + std::chrono::seconds(WAL_REPLAY_LOG_INTERVAL);
+    while (true) {
+        wal::MXLogRecord record;
+        auto error_code = wal_mgr_->GetNextRecovery(record);
+        if (error_code != WAL_SUCCESS) {
+            applier.WaitPending();
+            wal_mgr_->SetReadRelease(nullptr);
+            return Status(error_code, "Wal recovery error!");
+        }
+        if (record.type == wal::MXLogType::None) {
+            break;
+        }
+
+        auto status = applier.Apply(record);
+        if (!status.ok()) {
+            ENGINE_LOG_ERROR << "Failed to replay wal record " << record.lsn << ": " << status.message();
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= next_log_time) {
+            next_log_time = now + std::chrono::seconds(WAL_REPLAY_LOG_INTERVAL);
+            double done_size = total_size - std::min(total_size, wal_mgr_->GetRecoverySize());
+            double seconds = std::chrono::duration<double>(now - start).count();
+            double speed = done_size / seconds;
+            ENGINE_LOG_INFO << "Replayed " << done_size / total_size * 100 << "% of wal, "
+                            << speed / ONE_MB << " MB/s, about " << (total_size - done_size) / speed << " s left";
+        }
+    }
+    applier.WaitPending();
+    wal_mgr_->SetReadRelease(nullptr);
+
+    std::chrono::duration<double> diff = std::chrono::steady_clock::now() - start;
+    ENGINE_LOG_INFO << "Finished replaying wal in " << diff.count() << " s";
+    return Status::OK();
+}
+
 void
 DBImpl::BackgroundWalTask() {
     server::SystemInfo::GetInstance().Init();
@@ -2007,12 +2356,19 @@ DBImpl::BackgroundWalTask() {
         next_auto_flush_time = get_next_auto_flush_time();
     }
 
+    // records of different tables are applied in parallel, flushes wait for the records before them
+    WalApplier applier(std::thread::hardware_concurrency(),
+                       [this](const wal::MXLogRecord& record) { return ExecWalRecord(record); }, mem_mgr_,
+                       options_.insert_buffer_size_);
+    // queued records point into the wal buffer, wait for them before the reader reuses it
+    wal_mgr_->SetReadRelease([&applier]() { applier.WaitPending(); });
+
     wal::MXLogRecord record;
 
     auto auto_flush = [&]() {
         record.type = wal::MXLogType::Flush;
         record.table_id.clear();
-        ExecWalRecord(record);
+        applier.Apply(record);
 
         StartMetricTask();
         StartMergeTask();
@@ -2034,7 +2390,7 @@ DBImpl::BackgroundWalTask() {
         }
 
         if (record.type != wal::MXLogType::None) {
-            ExecWalRecord(record);
+            applier.Apply(record);
             if (record.type == wal::MXLogType::Flush) {
                 // user req flush
                 flush_task_swn_.Notify();
@@ -2061,6 +2417,9 @@ DBImpl::BackgroundWalTask() {
             }
         }
     }
+
+    applier.WaitPending();
+    wal_mgr_->SetReadRelease(nullptr);
 }
 
 void
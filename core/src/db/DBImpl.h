@@ -26,8 +26,10 @@
 #include "db/DB.h"
 #include "db/IndexFailedChecker.h"
 #include "db/OngoingFileChecker.h"
+#include "db/QueryBatcher.h"
 #include "db/Types.h"
 #include "db/insert/MemManager.h"
+#include "db/merge/MergeManager.h"
 #include "utils/ThreadPool.h"
 #include "wal/WalManager.h"
 
@@ -152,6 +154,11 @@ class DBImpl : public DB, public server::CacheConfigHandler {
     OnCacheInsertDataChanged(bool value) override;
 
  private:
+    Status
+    QueryHelper(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                const std::vector<std::string>& partition_tags, uint64_t k, const milvus::json& extra_params,
+                const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances);
+
     Status
     QueryAsync(const std::shared_ptr<server::Context>& context, const std::string& table_id,
                const meta::TableFilesSchema& files, uint64_t k, const milvus::json& extra_params,
@@ -175,7 +182,7 @@ class DBImpl : public DB, public server::CacheConfigHandler {
     StartMergeTask();
 
     Status
-    MergeFiles(const std::string& table_id, const meta::TableFilesSchema& files);
+    MergeFiles(const std::string& table_id, const meta::TableFilesSchema& files, meta::TableFileSchema& merged_file);
     Status
     BackgroundMergeFiles(const std::string& table_id);
     void
@@ -190,6 +197,10 @@ class DBImpl : public DB, public server::CacheConfigHandler {
     CompactFile(const std::string& table_id, const meta::TableFileSchema& file,
                 meta::TableFilesSchema& files_to_update);
 
+    Status
+    CompactIndexFile(const meta::TableFileSchema& index_file, const meta::TableFileSchema& compacted_file,
+                     meta::TableFileSchema& compacted_index_file);
+
     /*
     Status
     SyncMemData(std::set<std::string>& sync_table_ids);
@@ -227,6 +238,10 @@ class DBImpl : public DB, public server::CacheConfigHandler {
     Status
     ExecWalRecord(const wal::MXLogRecord& record);
 
+    // apply the wal records left since the last flush
+    Status
+    ReplayWal();
+
     void
     BackgroundWalTask();
 
@@ -239,10 +254,13 @@ class DBImpl : public DB, public server::CacheConfigHandler {
 
     meta::MetaPtr meta_ptr_;
     MemManagerPtr mem_mgr_;
+    MergeManagerPtr merge_mgr_ptr_;
 
     std::shared_ptr<wal::WalManager> wal_mgr_;
     std::thread bg_wal_thread_;
 
+    QueryBatcherPtr query_batcher_;
+
     struct SimpleWaitNotify {
         bool notified_ = false;
         std::mutex mutex_;
@@ -65,6 +65,8 @@ struct DBOptions {
     typedef enum { SINGLE = 0, CLUSTER_READONLY, CLUSTER_WRITABLE } MODE;
 
     uint16_t merge_trigger_number_ = 2;
+    // bytes of files merged for a table in one background merge round, 0 means no limit
+    uint64_t merge_io_limit_ = 4 * ONE_GB;
     DBMetaOptions meta_;
     int mode_ = MODE::SINGLE;
 
@@ -73,11 +75,29 @@ struct DBOptions {
 
     int64_t auto_flush_interval_ = 1;
 
+    // search batch relative configurations, batching is disabled when window is 0,
+    // set the window only when searches are executed concurrently, or no query could join a batch
+    int64_t search_batch_window_ = 0;  // milliseconds
+    uint64_t search_batch_max_nq_ = 1024;
+
+    // search the vectors in insert buffer besides the flushed files
+    bool search_unflushed_ = false;
+
+    // train IVF quantizer once per table and share it between segments
+    bool shared_quantizer_ = false;
+
+    // build cpu ivf indexes from raw vectors read chunk by chunk instead of loaded at once, disabled when 0,
+    // progress is saved at the interval so a restarted build goes on from there
+    int64_t build_index_chunk_size_ = 0;            // bytes
+    int64_t build_index_checkpoint_interval_ = 60;  // seconds
+
     // wal relative configurations
     bool wal_enable_ = true;
     bool recovery_error_ignore_ = true;
     int64_t buffer_size_ = 256;
     std::string mxlog_path_ = "/tmp/milvus/wal/";
+    std::string wal_durability_ = "flush";  // none, flush, fsync or fsync_interval
+    int64_t wal_sync_interval_ = 1000;      // milliseconds, for fsync_interval
 };  // Options
 
 }  // namespace engine
@@ -0,0 +1,163 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/QueryBatcher.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace milvus {
+namespace engine {
+
+QueryBatcher::QueryBatcher(int64_t window_ms, uint64_t max_nq, QueryFunc query_func)
+    : window_ms_(window_ms), max_nq_(max_nq), query_func_(std::move(query_func)) {
+}
+
+bool
+QueryBatcher::Batchable(const VectorsData& vectors) const {
+    // query by id is not batched, the id array is resolved per file
+    if (window_ms_ <= 0 || vectors.vector_count_ == 0 || vectors.vector_count_ >= max_nq_) {
+        return false;
+    }
+    return !vectors.float_data_.empty() || !vectors.binary_data_.empty();
+}
+
+std::string
+QueryBatcher::BatchKey(const std::string& table_id, const std::vector<std::string>& partition_tags, uint64_t k,
+                       const milvus::json& extra_params, const VectorsData& vectors) {
+    std::vector<std::string> tags = partition_tags;
+    std::sort(tags.begin(), tags.end());
+
+    std::string key = table_id + "|" + std::to_string(k) + "|" + extra_params.dump() + "|";
+    for (auto& tag : tags) {
+        key += tag + ",";
+    }
+
+    // vector type and size must match, otherwise the data can not be concatenated
+    if (!vectors.float_data_.empty()) {
+        key += "|f" + std::to_string(vectors.float_data_.size() / vectors.vector_count_);
+    } else {
+        key += "|b" + std::to_string(vectors.binary_data_.size() / vectors.vector_count_);
+    }
+    return key;
+}
+
+Status
+QueryBatcher::Query(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                    const std::vector<std::string>& partition_tags, uint64_t k, const milvus::json& extra_params,
+                    const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances) {
+    std::string key = BatchKey(table_id, partition_tags, k, extra_params, vectors);
+    QueryItem item = {context, &vectors, &result_ids, &result_distances};
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto iter = open_batches_.find(key);
+    if (iter != open_batches_.end()) {
+        QueryBatchPtr batch = iter->second;
+        if (batch->nq_ + vectors.vector_count_ <= max_nq_) {
+            // join the open batch and wait for its leader to execute it
+            batch->items_.push_back(item);
+            batch->nq_ += vectors.vector_count_;
+            if (batch->nq_ >= max_nq_) {
+                batch->closed_ = true;
+                open_batches_.erase(iter);
+                cv_.notify_all();
+            }
+
+            cv_.wait(lock, [&] { return batch->done_; });
+            return batch->status_;
+        }
+
+        // no room left, let its leader execute it now
+        batch->closed_ = true;
+        open_batches_.erase(iter);
+        cv_.notify_all();
+    }
+
+    // start a new batch and lead it
+    QueryBatchPtr batch = std::make_shared<QueryBatch>();
+    batch->items_.push_back(item);
+    batch->nq_ = vectors.vector_count_;
+    open_batches_[key] = batch;
+
+    cv_.wait_for(lock, std::chrono::milliseconds(window_ms_), [&] { return batch->closed_; });
+    if (!batch->closed_) {
+        batch->closed_ = true;
+        open_batches_.erase(key);
+    }
+    lock.unlock();
+
+    Status status = ExecuteBatch(table_id, partition_tags, k, extra_params, batch);
+
+    lock.lock();
+    batch->status_ = status;
+    batch->done_ = true;
+    cv_.notify_all();
+    return status;
+}
+
+Status
+QueryBatcher::ExecuteBatch(const std::string& table_id, const std::vector<std::string>& partition_tags, uint64_t k,
+                           const milvus::json& extra_params, const QueryBatchPtr& batch) {
+    // batch is closed, items can be accessed without lock
+    auto& items = batch->items_;
+    if (items.size() == 1) {
+        return query_func_(items[0].context_, table_id, partition_tags, k, extra_params, *items[0].vectors_,
+                           *items[0].result_ids_, *items[0].result_distances_);
+    }
+
+    // every query of the batch gets a span of its own covering the shared search, the search itself runs
+    // under the span of the leader
+    std::vector<std::shared_ptr<server::Context>> batch_contexts;
+    for (auto& query_item : items) {
+        batch_contexts.push_back(query_item.context_->Child("QueryBatch"));
+    }
+
+    VectorsData merged;
+    merged.vector_count_ = batch->nq_;
+    for (auto& query_item : items) {
+        const VectorsData& vectors = *query_item.vectors_;
+        merged.float_data_.insert(merged.float_data_.end(), vectors.float_data_.begin(), vectors.float_data_.end());
+        merged.binary_data_.insert(merged.binary_data_.end(), vectors.binary_data_.begin(),
+                                   vectors.binary_data_.end());
+    }
+
+    ENGINE_LOG_DEBUG << "Query batch of table " << table_id << " coalesces " << items.size()
+                     << " queries, total nq: " << batch->nq_;
+
+    ResultIds result_ids;
+    ResultDistances result_distances;
+    auto status = query_func_(batch_contexts[0], table_id, partition_tags, k, extra_params, merged, result_ids,
+                              result_distances);
+    for (auto& batch_context : batch_contexts) {
+        batch_context->GetTraceContext()->GetSpan()->Finish();
+    }
+    if (!status.ok() || result_ids.empty()) {
+        return status;
+    }
+
+    // result row width may be less than k if the table has fewer rows
+    size_t width = result_ids.size() / batch->nq_;
+    size_t offset = 0;
+    for (auto& query_item : items) {
+        size_t count = query_item.vectors_->vector_count_ * width;
+        query_item.result_ids_->assign(result_ids.begin() + offset, result_ids.begin() + offset + count);
+        query_item.result_distances_->assign(result_distances.begin() + offset,
+                                             result_distances.begin() + offset + count);
+        offset += count;
+    }
+
+    return Status::OK();
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,89 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "db/Types.h"
+#include "server/context/Context.h"
+#include "utils/Json.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace engine {
+
+// Coalesce concurrent small-nq queries which have same table, partitions, topk and search parameters
+// into one multi-query search, then split the result back to each caller.
+// The first query of a batch waits for at most window_ms for others to join, a batch is closed
+// earlier once its nq reaches max_nq. Each query of a batch traces the shared search under its own context.
+class QueryBatcher {
+ public:
+    using QueryFunc = std::function<Status(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                                           const std::vector<std::string>& partition_tags, uint64_t k,
+                                           const milvus::json& extra_params, const VectorsData& vectors,
+                                           ResultIds& result_ids, ResultDistances& result_distances)>;
+
+    QueryBatcher(int64_t window_ms, uint64_t max_nq, QueryFunc query_func);
+
+    bool
+    Batchable(const VectorsData& vectors) const;
+
+    Status
+    Query(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+          const std::vector<std::string>& partition_tags, uint64_t k, const milvus::json& extra_params,
+          const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances);
+
+ private:
+    struct QueryItem {
+        std::shared_ptr<server::Context> context_;
+        const VectorsData* vectors_;
+        ResultIds* result_ids_;
+        ResultDistances* result_distances_;
+    };
+
+    struct QueryBatch {
+        std::vector<QueryItem> items_;
+        uint64_t nq_ = 0;
+        bool closed_ = false;
+        bool done_ = false;
+        Status status_;
+    };
+    using QueryBatchPtr = std::shared_ptr<QueryBatch>;
+
+    static std::string
+    BatchKey(const std::string& table_id, const std::vector<std::string>& partition_tags, uint64_t k,
+             const milvus::json& extra_params, const VectorsData& vectors);
+
+    Status
+    ExecuteBatch(const std::string& table_id, const std::vector<std::string>& partition_tags, uint64_t k,
+                 const milvus::json& extra_params, const QueryBatchPtr& batch);
+
+ private:
+    int64_t window_ms_;
+    uint64_t max_nq_;
+    QueryFunc query_func_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::unordered_map<std::string, QueryBatchPtr> open_batches_;
+};
+
+using QueryBatcherPtr = std::shared_ptr<QueryBatcher>;
+
+}  // namespace engine
+}  // namespace milvus
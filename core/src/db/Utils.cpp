@@ -210,6 +210,11 @@ GetParentPath(const std::string& path, std::string& parent_path) {
     return Status::OK();
 }
 
+std::string
+GetTableIndexModelPath(const DBMetaOptions& options, const std::string& table_id) {
+    return options.path_ + TABLES_FOLDER + table_id + "/index_model";
+}
+
 bool
 IsSameIndex(const TableIndex& index1, const TableIndex& index2) {
     return index1.engine_type_ == index2.engine_type_ && index1.extra_params_ == index2.extra_params_ &&
@@ -221,6 +226,12 @@ IsRawIndexType(int32_t type) {
     return (type == (int32_t)EngineType::FAISS_IDMAP) || (type == (int32_t)EngineType::FAISS_BIN_IDMAP);
 }
 
+bool
+IsCompactableIndexType(int32_t type) {
+    return (type == (int32_t)EngineType::FAISS_IVFFLAT) || (type == (int32_t)EngineType::FAISS_IVFSQ8) ||
+           (type == (int32_t)EngineType::FAISS_PQ) || (type == (int32_t)EngineType::FAISS_BIN_IVFFLAT);
+}
+
 bool
 IsBinaryIndexType(int32_t index_type) {
     return (index_type == (int32_t)engine::EngineType::FAISS_BIN_IDMAP) ||
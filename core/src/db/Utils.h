@@ -42,12 +42,20 @@ DeleteSegment(const DBMetaOptions& options, meta::TableFileSchema& table_file);
 Status
 GetParentPath(const std::string& path, std::string& parent_path);
 
+// location of the index model shared by the segments of a table
+std::string
+GetTableIndexModelPath(const DBMetaOptions& options, const std::string& table_id);
+
 bool
 IsSameIndex(const TableIndex& index1, const TableIndex& index2);
 
 bool
 IsRawIndexType(int32_t type);
 
+// index types whose built index can be compacted without training again
+bool
+IsCompactableIndexType(int32_t type);
+
 static bool
 IsBinaryIndexType(int32_t index_type);
 
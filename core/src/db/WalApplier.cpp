@@ -0,0 +1,114 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/WalApplier.h"
+
+#include <string>
+#include <utility>
+
+#include "utils/Log.h"
+
+namespace milvus {
+namespace engine {
+
+WalApplier::WalApplier(uint64_t worker_count, ApplyFunc apply_func, MemManagerPtr mem_mgr,
+                       uint64_t insert_buffer_size)
+    : apply_func_(std::move(apply_func)),
+      mem_mgr_(std::move(mem_mgr)),
+      insert_buffer_size_(insert_buffer_size),
+      pending_size_(0) {
+    if (worker_count == 0) {
+        worker_count = 1;
+    }
+    for (uint64_t i = 0; i < worker_count; ++i) {
+        queues_.push_back(std::make_shared<server::BlockingQueue<ItemPtr>>());
+    }
+    for (uint64_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back(&WalApplier::WorkerLoop, this, i);
+    }
+}
+
+WalApplier::~WalApplier() {
+    for (auto& queue : queues_) {
+        queue->Put(nullptr);
+    }
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+Status
+WalApplier::Apply(const wal::MXLogRecord& record) {
+    uint64_t record_size = record.data_size + record.length * sizeof(IDNumber);
+    if (IsBarrier(record, record_size)) {
+        WaitPending();
+        return apply_func_(record);
+    }
+
+    // the record points into the wal buffer, the reader waits for pending records before reusing it
+    auto item = std::make_shared<Item>();
+    item->record_ = record;
+
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        ++pending_count_;
+        pending_size_ += record_size;
+    }
+    auto index = std::hash<std::string>()(record.table_id) % queues_.size();
+    queues_[index]->Put(item);
+    return Status::OK();
+}
+
+void
+WalApplier::WaitPending() {
+    std::unique_lock<std::mutex> lock(pending_mutex_);
+    pending_cv_.wait(lock, [&] { return pending_count_ == 0; });
+}
+
+bool
+WalApplier::IsBarrier(const wal::MXLogRecord& record, uint64_t record_size) {
+    if (record.type == wal::MXLogType::Flush || record.table_id.empty()) {
+        return true;
+    }
+
+    // an insert over the buffer limit flushes all tables inside the worker, which must not happen while
+    // other workers still hold records before it.
+    // read pending size first, the bytes applied in between are counted twice rather than missed
+    uint64_t mem_size = pending_size_;
+    mem_size += mem_mgr_->GetCurrentMem() + record_size;
+    return mem_size > insert_buffer_size_;
+}
+
+void
+WalApplier::WorkerLoop(uint64_t index) {
+    auto& queue = queues_[index];
+    while (true) {
+        auto item = queue->Take();
+        if (item == nullptr) {
+            break;
+        }
+
+        auto status = apply_func_(item->record_);
+        if (!status.ok()) {
+            ENGINE_LOG_ERROR << "Failed to apply wal record " << item->record_.lsn << " of table "
+                             << item->record_.table_id << ": " << status.message();
+        }
+
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        pending_size_ -= item->record_.data_size + item->record_.length * sizeof(IDNumber);
+        if (--pending_count_ == 0) {
+            pending_cv_.notify_all();
+        }
+    }
+}
+
+}  // namespace engine
+}  // namespace milvus
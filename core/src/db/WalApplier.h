@@ -0,0 +1,82 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "db/Types.h"
+#include "db/insert/MemManager.h"
+#include "db/wal/WalDefinations.h"
+#include "utils/BlockingQueue.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace engine {
+
+// Apply wal records with a pool of workers. Records of one table always go to the same worker, so they
+// are applied in lsn order; partition records carry the parent table id and stay ordered with deletes.
+// Flush records, records without table id and records that would fill the insert buffer are barriers:
+// all queued records are applied first, then the barrier on the caller thread. So a flush never writes
+// a flushed lsn covering records still in the queues.
+class WalApplier {
+ public:
+    using ApplyFunc = std::function<Status(const wal::MXLogRecord& record)>;
+
+    WalApplier(uint64_t worker_count, ApplyFunc apply_func, MemManagerPtr mem_mgr, uint64_t insert_buffer_size);
+
+    ~WalApplier();
+
+    // the record is queued without copying, its ids and data must stay valid until WaitPending() returns
+    // return the status of a barrier record, queued records log their own errors
+    Status
+    Apply(const wal::MXLogRecord& record);
+
+    // wait until all queued records are applied
+    void
+    WaitPending();
+
+ private:
+    struct Item {
+        wal::MXLogRecord record_;
+    };
+    using ItemPtr = std::shared_ptr<Item>;
+
+    bool
+    IsBarrier(const wal::MXLogRecord& record, uint64_t record_size);
+
+    void
+    WorkerLoop(uint64_t index);
+
+ private:
+    ApplyFunc apply_func_;
+    MemManagerPtr mem_mgr_;
+    uint64_t insert_buffer_size_;
+
+    std::vector<std::shared_ptr<server::BlockingQueue<ItemPtr>>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex pending_mutex_;
+    std::condition_variable pending_cv_;
+    uint64_t pending_count_ = 0;
+    std::atomic<uint64_t> pending_size_;  // bytes queued but not applied yet
+};
+
+using WalApplierPtr = std::shared_ptr<WalApplier>;
+
+}  // namespace engine
+}  // namespace milvus
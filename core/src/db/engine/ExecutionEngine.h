@@ -108,8 +108,19 @@ class ExecutionEngine {
     Search(int64_t n, const std::vector<int64_t>& ids, int64_t k, const milvus::json& extra_params, float* distances,
            int64_t* labels, bool hybrid) = 0;
 
+    // with model_location set, ivf indexes are built from the model shared by the table at that location
     virtual std::shared_ptr<ExecutionEngine>
-    BuildIndex(const std::string& location, EngineType engine_type) = 0;
+    BuildIndex(const std::string& location, EngineType engine_type, const std::string& model_location = "") = 0;
+
+    // whether BuildIndexInChunks supports the engine type, the raw vectors needn't be loaded before it
+    virtual bool
+    CanBuildInChunks(EngineType engine_type) = 0;
+
+    // BuildIndex with the raw vectors read from the segment chunk_size bytes at a time instead of loaded,
+    // the progress is saved every checkpoint_interval seconds and a later build of the file goes on from there
+    virtual std::shared_ptr<ExecutionEngine>
+    BuildIndexInChunks(const std::string& location, EngineType engine_type, const std::string& model_location,
+                       int64_t chunk_size, int64_t checkpoint_interval) = 0;
 
     virtual Status
     Cache() = 0;
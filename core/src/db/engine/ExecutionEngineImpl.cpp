@@ -14,6 +14,12 @@
 #include <faiss/utils/ConcurrentBitset.h>
 #include <fiu-local.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <numeric>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -22,6 +28,7 @@
 #include "cache/GpuCacheMgr.h"
 #include "config/Config.h"
 #include "db/Utils.h"
+#include "db/engine/IndexModelMgr.h"
 #include "knowhere/common/Config.h"
 #include "metrics/Metrics.h"
 #include "scheduler/Utils.h"
@@ -42,6 +49,13 @@ namespace engine {
 
 namespace {
 
+constexpr int64_t MIN_POINTS_PER_CENTROID = 39;
+constexpr int64_t MAX_POINTS_PER_CENTROID = 256;
+constexpr int64_t MAX_CODEBOOK_POINTS = 65536;
+
+// progress of a chunked build is kept next to the raw file, with the key of what is built
+constexpr const char* BUILD_CHECKPOINT_SUFFIX = ".build";
+
 Status
 MappingMetricType(MetricType metric_type, milvus::json& conf) {
     switch (metric_type) {
@@ -78,6 +92,65 @@ IsBinaryIndexType(IndexType type) {
     return type == IndexType::FAISS_BIN_IDMAP || type == IndexType::FAISS_BIN_IVFLAT_CPU;
 }
 
+// rows of a training sample, as many as faiss takes: max_points_per_centroid per centroid for k-means and
+// 256 per code for the pq/sq codebooks
+int64_t
+TrainSampleCount(const milvus::json& conf, int64_t count) {
+    int64_t nlist = conf[knowhere::IndexParams::nlist];
+    int64_t points = MAX_POINTS_PER_CENTROID;
+    if (conf.contains(knowhere::IndexParams::max_points_per_centroid)) {
+        points = conf[knowhere::IndexParams::max_points_per_centroid];
+    }
+    return std::min(count, std::max(nlist * points, MAX_CODEBOOK_POINTS));
+}
+
+// rows already added to the index restored from the checkpoint, 0 if there is none saved under the key
+int64_t
+RestoreBuildCheckpoint(const std::string& path, const std::string& key, const VecIndexPtr& index) {
+    std::ifstream key_file(path + ".key");
+    if (!key_file) {
+        return 0;
+    }
+    std::string saved_key((std::istreambuf_iterator<char>(key_file)), std::istreambuf_iterator<char>());
+    if (saved_key != key) {
+        // left by a build with other parameters
+        std::remove(path.c_str());
+        std::remove((path + ".key").c_str());
+        return 0;
+    }
+
+    auto status = index->Restore(path);
+    if (!status.ok()) {
+        ENGINE_LOG_WARNING << "Failed to restore build checkpoint " << path << ": " << status.message();
+        return 0;
+    }
+    return index->Count();
+}
+
+void
+SaveBuildCheckpoint(const std::string& path, const std::string& key, const VecIndexPtr& index) {
+    // the key is written first, so a checkpoint is never found next to the key of another build
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream key_file(tmp_path);
+        key_file << key;
+        if (!key_file) {
+            ENGINE_LOG_WARNING << "Failed to save build checkpoint key " << path;
+            return;
+        }
+    }
+    if (std::rename(tmp_path.c_str(), (path + ".key").c_str()) != 0) {
+        ENGINE_LOG_WARNING << "Failed to save build checkpoint key " << path;
+        return;
+    }
+
+    auto status = index->Checkpoint(tmp_path);
+    if (!status.ok() || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        ENGINE_LOG_WARNING << "Failed to save build checkpoint " << path << ": " << status.message();
+        std::remove(tmp_path.c_str());
+    }
+}
+
 }  // namespace
 
 class CachedQuantizer : public cache::DataObj {
@@ -367,6 +440,12 @@ ExecutionEngineImpl::Serialize() {
         status = Status(DB_ERROR, msg);
     }
 
+    if (status.ok() && !build_checkpoint_.empty()) {
+        std::remove(build_checkpoint_.c_str());
+        std::remove((build_checkpoint_ + ".key").c_str());
+        build_checkpoint_.clear();
+    }
+
     return status;
 }
 
@@ -402,136 +481,180 @@ ExecutionEngineImpl::Load(bool to_cache) {
 
 Status
 ExecutionEngineImpl::Load(bool to_cache) {
-    // TODO(zhiru): refactor
+    // concurrent loads of the same file share one disk read, the others wait for it in the cache manager
+    auto loader = [&](cache::DataObjPtr& obj) -> Status {
+        auto status = LoadFromDisk();
+        obj = std::static_pointer_cast<cache::DataObj>(index_);
+        return status;
+    };
 
-    index_ = std::static_pointer_cast<VecIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(location_));
-    bool already_in_cache = (index_ != nullptr);
-    if (!already_in_cache) {
-        std::string segment_dir;
-        utils::GetParentPath(location_, segment_dir);
-        auto segment_reader_ptr = std::make_shared<segment::SegmentReader>(segment_dir);
-
-        if (utils::IsRawIndexType((int32_t)index_type_)) {
-            index_ = index_type_ == EngineType::FAISS_IDMAP ? GetVecIndexFactory(IndexType::FAISS_IDMAP)
-                                                            : GetVecIndexFactory(IndexType::FAISS_BIN_IDMAP);
-            milvus::json conf{{knowhere::meta::DEVICEID, gpu_num_}, {knowhere::meta::DIM, dim_}};
-            MappingMetricType(metric_type_, conf);
-            auto adapter = AdapterMgr::GetInstance().GetAdapter(index_->GetType());
-            ENGINE_LOG_DEBUG << "Index params: " << conf.dump();
-            if (!adapter->CheckTrain(conf)) {
-                throw Exception(DB_ERROR, "Illegal index params");
-            }
+    cache::DataObjPtr obj;
+    auto status = cache::CpuCacheMgr::GetInstance()->GetOrLoadItem(location_, loader, to_cache, obj);
+    index_ = std::static_pointer_cast<VecIndex>(obj);
+    return status;
+}
 
-            auto status = segment_reader_ptr->Load();
-            if (!status.ok()) {
-                std::string msg = "Failed to load segment from " + location_;
-                ENGINE_LOG_ERROR << msg;
-                return Status(DB_ERROR, msg);
-            }
+Status
+ExecutionEngineImpl::LoadFromDisk() {
+    // TODO(zhiru): refactor
+    std::string segment_dir;
+    utils::GetParentPath(location_, segment_dir);
+    auto segment_reader_ptr = std::make_shared<segment::SegmentReader>(segment_dir);
+
+    if (utils::IsRawIndexType((int32_t)index_type_)) {
+        index_ = index_type_ == EngineType::FAISS_IDMAP ? GetVecIndexFactory(IndexType::FAISS_IDMAP)
+                                                        : GetVecIndexFactory(IndexType::FAISS_BIN_IDMAP);
+        milvus::json conf{{knowhere::meta::DEVICEID, gpu_num_}, {knowhere::meta::DIM, dim_}};
+        MappingMetricType(metric_type_, conf);
+        auto adapter = AdapterMgr::GetInstance().GetAdapter(index_->GetType());
+        ENGINE_LOG_DEBUG << "Index params: " << conf.dump();
+        if (!adapter->CheckTrain(conf)) {
+            throw Exception(DB_ERROR, "Illegal index params");
+        }
 
-            segment::SegmentPtr segment_ptr;
-            segment_reader_ptr->GetSegment(segment_ptr);
-            auto& vectors = segment_ptr->vectors_ptr_;
-            auto& deleted_docs = segment_ptr->deleted_docs_ptr_->GetDeletedDocs();
+        std::vector<segment::doc_id_t> vectors_uids;
+        auto status = segment_reader_ptr->LoadUids(vectors_uids);
+        if (!status.ok()) {
+            std::string msg = "Failed to load uids from " + location_;
+            ENGINE_LOG_ERROR << msg;
+            return Status(DB_ERROR, msg);
+        }
+        int64_t vector_count = vectors_uids.size();
+        index_->SetUids(vectors_uids);
+        ENGINE_LOG_DEBUG << "set uids " << index_->GetUids().size() << " for index " << location_;
 
-            auto vectors_uids = vectors->GetUids();
-            index_->SetUids(vectors_uids);
-            ENGINE_LOG_DEBUG << "set uids " << index_->GetUids().size() << " for index " << location_;
+        segment::DeletedDocsPtr deleted_docs_ptr;
+        status = segment_reader_ptr->LoadDeletedDocs(deleted_docs_ptr);
+        if (!status.ok()) {
+            return status;
+        }
 
-            auto vectors_data = vectors->GetData();
+        segment::IdIndexPtr id_index_ptr;
+        status = segment_reader_ptr->LoadIdIndex(id_index_ptr);
+        if (!status.ok()) {
+            return status;
+        }
+        index_->SetIdIndex(id_index_ptr);
 
-            faiss::ConcurrentBitsetPtr concurrent_bitset_ptr =
-                std::make_shared<faiss::ConcurrentBitset>(vectors->GetCount());
-            for (auto& offset : deleted_docs) {
-                if (!concurrent_bitset_ptr->test(offset)) {
-                    concurrent_bitset_ptr->set(offset);
-                }
+        faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(vector_count);
+        for (auto& offset : deleted_docs_ptr->GetDeletedDocs()) {
+            if (!concurrent_bitset_ptr->test(offset)) {
+                concurrent_bitset_ptr->set(offset);
             }
+        }
 
-            ErrorCode ec = KNOWHERE_UNEXPECTED_ERROR;
-            if (index_type_ == EngineType::FAISS_IDMAP) {
-                std::vector<float> float_vectors;
-                float_vectors.resize(vectors_data.size() / sizeof(float));
-                memcpy(float_vectors.data(), vectors_data.data(), vectors_data.size());
-                ec = std::static_pointer_cast<BFIndex>(index_)->Build(conf);
-                if (ec != KNOWHERE_SUCCESS) {
-                    return status;
-                }
-                status = std::static_pointer_cast<BFIndex>(index_)->AddWithoutIds(vectors->GetCount(),
-                                                                                  float_vectors.data(), Config());
-                status = std::static_pointer_cast<BFIndex>(index_)->SetBlacklist(concurrent_bitset_ptr);
-
-                int64_t index_size = vectors->GetCount() * dim_ * sizeof(float);
-                int64_t bitset_size = vectors->GetCount() / 8;
-                index_->set_size(index_size + bitset_size);
-            } else if (index_type_ == EngineType::FAISS_BIN_IDMAP) {
-                ec = std::static_pointer_cast<BinBFIndex>(index_)->Build(conf);
-                if (ec != KNOWHERE_SUCCESS) {
-                    return status;
+        // raw vectors are read from the segment file straight into the storage of the flat index,
+        // no intermediate copy is kept
+        ErrorCode ec = KNOWHERE_UNEXPECTED_ERROR;
+        if (index_type_ == EngineType::FAISS_IDMAP) {
+            auto bf_index = std::static_pointer_cast<BFIndex>(index_);
+            ec = bf_index->Build(conf);
+            if (ec != KNOWHERE_SUCCESS) {
+                return Status(DB_ERROR, "Failed to build raw index for " + location_);
+            }
+            auto alloc = [&](size_t num_bytes) -> uint8_t* {
+                if (num_bytes != static_cast<size_t>(vector_count * dim_ * sizeof(float))) {
+                    ENGINE_LOG_ERROR << "Raw vectors size " << num_bytes << " mismatch with uids count "
+                                     << vector_count << " in " << location_;
+                    return nullptr;
                 }
-                status = std::static_pointer_cast<BinBFIndex>(index_)->AddWithoutIds(vectors->GetCount(),
-                                                                                     vectors_data.data(), Config());
-                status = std::static_pointer_cast<BinBFIndex>(index_)->SetBlacklist(concurrent_bitset_ptr);
-
-                int64_t index_size = vectors->GetCount() * dim_ * sizeof(uint8_t);
-                int64_t bitset_size = vectors->GetCount() / 8;
-                index_->set_size(index_size + bitset_size);
+                return reinterpret_cast<uint8_t*>(bf_index->AllocRawVectors(vector_count));
+            };
+            status = segment_reader_ptr->LoadVectors(alloc);
+            if (!status.ok()) {
+                return status;
+            }
+            status = bf_index->SetBlacklist(concurrent_bitset_ptr);
+
+            int64_t index_size = vector_count * dim_ * sizeof(float);
+            int64_t bitset_size = vector_count / 8;
+            index_->set_size(index_size + bitset_size + id_index_ptr->Size());
+        } else if (index_type_ == EngineType::FAISS_BIN_IDMAP) {
+            auto bin_bf_index = std::static_pointer_cast<BinBFIndex>(index_);
+            ec = bin_bf_index->Build(conf);
+            if (ec != KNOWHERE_SUCCESS) {
+                return Status(DB_ERROR, "Failed to build raw index for " + location_);
             }
+            auto alloc = [&](size_t num_bytes) -> uint8_t* {
+                if (num_bytes != static_cast<size_t>(vector_count * dim_ / 8)) {
+                    ENGINE_LOG_ERROR << "Raw vectors size " << num_bytes << " mismatch with uids count "
+                                     << vector_count << " in " << location_;
+                    return nullptr;
+                }
+                return bin_bf_index->AllocRawVectors(vector_count);
+            };
+            status = segment_reader_ptr->LoadVectors(alloc);
             if (!status.ok()) {
                 return status;
             }
+            status = bin_bf_index->SetBlacklist(concurrent_bitset_ptr);
 
-            ENGINE_LOG_DEBUG << "Finished loading raw data from segment " << segment_dir;
+            int64_t index_size = vector_count * dim_ * sizeof(uint8_t);
+            int64_t bitset_size = vector_count / 8;
+            index_->set_size(index_size + bitset_size + id_index_ptr->Size());
+        }
+        if (!status.ok()) {
+            return status;
+        }
 
-        } else {
-            try {
-                double physical_size = PhysicalSize();
-                server::CollectExecutionEngineMetrics metrics(physical_size);
-                index_ = read_index(location_);
+        ENGINE_LOG_DEBUG << "Finished loading raw data from segment " << segment_dir;
 
-                if (index_ == nullptr) {
-                    std::string msg = "Failed to load index from " + location_;
+    } else {
+        try {
+            double physical_size = PhysicalSize();
+            server::CollectExecutionEngineMetrics metrics(physical_size);
+            index_ = read_index(location_);
+
+            if (index_ == nullptr) {
+                std::string msg = "Failed to load index from " + location_;
+                ENGINE_LOG_ERROR << msg;
+                return Status(DB_ERROR, msg);
+            } else {
+                segment::DeletedDocsPtr deleted_docs_ptr;
+                auto status = segment_reader_ptr->LoadDeletedDocs(deleted_docs_ptr);
+                if (!status.ok()) {
+                    std::string msg = "Failed to load deleted docs from " + location_;
                     ENGINE_LOG_ERROR << msg;
                     return Status(DB_ERROR, msg);
-                } else {
-                    segment::DeletedDocsPtr deleted_docs_ptr;
-                    auto status = segment_reader_ptr->LoadDeletedDocs(deleted_docs_ptr);
-                    if (!status.ok()) {
-                        std::string msg = "Failed to load deleted docs from " + location_;
-                        ENGINE_LOG_ERROR << msg;
-                        return Status(DB_ERROR, msg);
-                    }
-                    auto& deleted_docs = deleted_docs_ptr->GetDeletedDocs();
-
-                    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr =
-                        std::make_shared<faiss::ConcurrentBitset>(index_->Count());
-                    for (auto& offset : deleted_docs) {
-                        if (!concurrent_bitset_ptr->test(offset)) {
-                            concurrent_bitset_ptr->set(offset);
-                        }
+                }
+                auto& deleted_docs = deleted_docs_ptr->GetDeletedDocs();
+
+                faiss::ConcurrentBitsetPtr concurrent_bitset_ptr =
+                    std::make_shared<faiss::ConcurrentBitset>(index_->Count());
+                for (auto& offset : deleted_docs) {
+                    if (!concurrent_bitset_ptr->test(offset)) {
+                        concurrent_bitset_ptr->set(offset);
                     }
+                }
 
-                    index_->SetBlacklist(concurrent_bitset_ptr);
+                index_->SetBlacklist(concurrent_bitset_ptr);
 
-                    std::vector<segment::doc_id_t> uids;
-                    segment_reader_ptr->LoadUids(uids);
-                    index_->SetUids(uids);
-                    ENGINE_LOG_DEBUG << "set uids " << index_->GetUids().size() << " for index " << location_;
+                std::vector<segment::doc_id_t> uids;
+                segment_reader_ptr->LoadUids(uids);
+                index_->SetUids(uids);
+                ENGINE_LOG_DEBUG << "set uids " << index_->GetUids().size() << " for index " << location_;
 
-                    ENGINE_LOG_DEBUG << "Finished loading index file from segment " << segment_dir;
+                segment::IdIndexPtr id_index_ptr;
+                status = segment_reader_ptr->LoadIdIndex(id_index_ptr);
+                if (!status.ok()) {
+                    std::string msg = "Failed to load id index from " + location_;
+                    ENGINE_LOG_ERROR << msg;
+                    return Status(DB_ERROR, msg);
                 }
-            } catch (std::exception& e) {
-                ENGINE_LOG_ERROR << e.what();
-                return Status(DB_ERROR, e.what());
+                index_->SetIdIndex(id_index_ptr);
+                // the id index is cached along with the index
+                index_->set_size(index_->Size() + id_index_ptr->Size());
+
+                ENGINE_LOG_DEBUG << "Finished loading index file from segment " << segment_dir;
             }
+        } catch (std::exception& e) {
+            ENGINE_LOG_ERROR << e.what();
+            return Status(DB_ERROR, e.what());
         }
     }
 
-    if (!already_in_cache && to_cache) {
-        Cache();
-    }
     return Status::OK();
-}  // namespace engine
+}
 
 Status
 ExecutionEngineImpl::CopyToGpu(uint64_t device_id, bool hybrid) {
@@ -599,7 +722,12 @@ ExecutionEngineImpl::CopyToGpu(uint64_t device_id, bool hybrid) {
         }
 
         try {
+            auto id_index = index_->GetIdIndex();
             index_ = index_->CopyToGpu(device_id);
+            index_->SetIdIndex(id_index);
+            if (id_index != nullptr) {
+                index_->set_size(index_->Size() + id_index->Size());
+            }
             ENGINE_LOG_DEBUG << "CPU to GPU" << device_id;
         } catch (std::exception& e) {
             ENGINE_LOG_ERROR << e.what();
@@ -640,7 +768,12 @@ ExecutionEngineImpl::CopyToCpu() {
         }
 
         try {
+            auto id_index = index_->GetIdIndex();
             index_ = index_->CopyToCpu();
+            index_->SetIdIndex(id_index);
+            if (id_index != nullptr) {
+                index_->set_size(index_->Size() + id_index->Size());
+            }
             ENGINE_LOG_DEBUG << "GPU to CPU";
         } catch (std::exception& e) {
             ENGINE_LOG_ERROR << e.what();
@@ -714,8 +847,62 @@ ExecutionEngineImpl::Merge(const std::string& location) {
 }
 */
 
+VecIndexPtr
+ExecutionEngineImpl::GetIndexModel(const std::string& model_location, EngineType engine_type,
+                                   const VecIndexPtr& to_index, const milvus::json& conf, int64_t count,
+                                   int64_t chunk_rows) {
+    auto type = to_index->GetType();
+    if (type != IndexType::FAISS_IVFFLAT_CPU && type != IndexType::FAISS_IVFSQ8_CPU &&
+        type != IndexType::FAISS_IVFPQ_CPU) {
+        return nullptr;
+    }
+
+    // the shared model keeps nlist asked by user instead of the one tuned to the row count of each segment,
+    // so that nprobe means the same for all segments
+    milvus::json train_conf = conf;
+    if (index_params_.contains(knowhere::IndexParams::nlist)) {
+        train_conf[knowhere::IndexParams::nlist] = index_params_[knowhere::IndexParams::nlist];
+    }
+    int64_t nlist = train_conf[knowhere::IndexParams::nlist];
+
+    milvus::json key = index_params_;
+    key["index_type"] = static_cast<int32_t>(type);
+    key[knowhere::meta::DIM] = conf[knowhere::meta::DIM];
+    key[knowhere::Metric::TYPE] = conf[knowhere::Metric::TYPE];
+
+    auto train_func = [&](VecIndexPtr& model) -> Status {
+        // a segment too small for k-means builds alone, the model is trained from a larger one
+        if (count < nlist * MIN_POINTS_PER_CENTROID) {
+            return Status(DB_ERROR, "Too few vectors to train index model");
+        }
+
+        int64_t sample_count = TrainSampleCount(train_conf, count);
+        std::vector<float> samples;
+        auto status = SampleRawVectors(count, sample_count, chunk_rows, samples);
+        if (!status.ok()) {
+            return status;
+        }
+
+        model = CreatetVecIndex(engine_type);
+        if (model == nullptr || model->GetType() != type) {
+            return Status(DB_ERROR, "Unsupported index model type");
+        }
+        train_conf[knowhere::meta::ROWS] = sample_count;
+        return model->Train(sample_count, samples.data(), train_conf);
+    };
+
+    VecIndexPtr model;
+    auto status = IndexModelMgr::GetInstance().GetModel(model_location, key.dump(), train_func, model);
+    if (!status.ok()) {
+        ENGINE_LOG_DEBUG << "No index model for " << location_ << ": " << status.message();
+        return nullptr;
+    }
+    return model;
+}
+
 ExecutionEnginePtr
-ExecutionEngineImpl::BuildIndex(const std::string& location, EngineType engine_type) {
+ExecutionEngineImpl::BuildIndex(const std::string& location, EngineType engine_type,
+                                const std::string& model_location) {
     ENGINE_LOG_DEBUG << "Build index file: " << location << " from: " << location_;
 
     auto from_index = std::dynamic_pointer_cast<BFIndex>(index_);
@@ -746,7 +933,16 @@ ExecutionEngineImpl::BuildIndex(const std::string& location, EngineType engine_t
     std::vector<segment::doc_id_t> uids;
     faiss::ConcurrentBitsetPtr blacklist;
     if (from_index) {
-        status = to_index->BuildAll(Count(), from_index->GetRawVectors(), from_index->GetRawIds(), conf);
+        VecIndexPtr model;
+        if (!model_location.empty()) {
+            model = GetIndexModel(model_location, engine_type, to_index, conf, Count(), 0);
+        }
+        if (model != nullptr) {
+            status = to_index->BuildWithModel(model, Count(), from_index->GetRawVectors(), from_index->GetRawIds(),
+                                              conf);
+        } else {
+            status = to_index->BuildAll(Count(), from_index->GetRawVectors(), from_index->GetRawIds(), conf);
+        }
         uids = from_index->GetUids();
         from_index->GetBlacklist(blacklist);
     } else if (bin_from_index) {
@@ -769,6 +965,204 @@ ExecutionEngineImpl::BuildIndex(const std::string& location, EngineType engine_t
     return std::make_shared<ExecutionEngineImpl>(to_index, location, engine_type, metric_type_, index_params_);
 }
 
+bool
+ExecutionEngineImpl::CanBuildInChunks(EngineType engine_type) {
+    try {
+        auto to_index = CreatetVecIndex(engine_type);
+        if (to_index == nullptr) {
+            return false;
+        }
+        auto type = to_index->GetType();
+        return type == IndexType::FAISS_IVFFLAT_CPU || type == IndexType::FAISS_IVFSQ8_CPU ||
+               type == IndexType::FAISS_IVFPQ_CPU;
+    } catch (std::exception& ex) {
+        return false;
+    }
+}
+
+ExecutionEnginePtr
+ExecutionEngineImpl::BuildIndexInChunks(const std::string& location, EngineType engine_type,
+                                        const std::string& model_location, int64_t chunk_size,
+                                        int64_t checkpoint_interval) {
+    ENGINE_LOG_DEBUG << "Build index file: " << location << " from: " << location_ << " in chunks of " << chunk_size
+                     << " bytes";
+
+    // only uids and deleted docs are loaded, the raw vectors are read chunk by chunk
+    std::string segment_dir;
+    utils::GetParentPath(location_, segment_dir);
+    segment::SegmentReader segment_reader(segment_dir);
+    std::vector<segment::doc_id_t> uids;
+    auto status = segment_reader.LoadUids(uids);
+    if (!status.ok()) {
+        throw Exception(DB_ERROR, "Failed to load uids from " + location_);
+    }
+    segment::DeletedDocsPtr deleted_docs_ptr;
+    status = segment_reader.LoadDeletedDocs(deleted_docs_ptr);
+    if (!status.ok()) {
+        throw Exception(DB_ERROR, status.message());
+    }
+    int64_t count = uids.size();
+    if (count == 0) {
+        throw Exception(DB_ERROR, "No vectors to build index from " + location_);
+    }
+
+    auto to_index = CreatetVecIndex(engine_type);
+    if (!to_index) {
+        throw Exception(DB_ERROR, "Unsupported index type");
+    }
+
+    milvus::json conf = index_params_;
+    conf[knowhere::meta::DIM] = dim_;
+    conf[knowhere::meta::ROWS] = count;
+    conf[knowhere::meta::DEVICEID] = gpu_num_;
+    MappingMetricType(metric_type_, conf);
+    ENGINE_LOG_DEBUG << "Index params: " << conf.dump();
+    auto adapter = AdapterMgr::GetInstance().GetAdapter(to_index->GetType());
+    if (!adapter->CheckTrain(conf)) {
+        throw Exception(DB_ERROR, "Illegal index params");
+    }
+    ENGINE_LOG_DEBUG << "Index config: " << conf.dump();
+
+    int64_t row_size = dim_ * sizeof(float);
+    int64_t chunk_rows = std::max(chunk_size / row_size, (int64_t)1);
+
+    // checkpoints are local files, they are not kept with s3 storage
+    bool s3_enable = false;
+    server::Config& config = server::Config::GetInstance();
+    config.GetStorageConfigS3Enable(s3_enable);
+    std::string checkpoint = s3_enable ? "" : location_ + BUILD_CHECKPOINT_SUFFIX;
+    milvus::json key = conf;
+    key["index_type"] = static_cast<int32_t>(to_index->GetType());
+
+    int64_t added = checkpoint.empty() ? 0 : RestoreBuildCheckpoint(checkpoint, key.dump(), to_index);
+    if (added > count) {
+        ENGINE_LOG_WARNING << "Build checkpoint of " << location_ << " mismatch with raw vectors, discard it";
+        to_index = CreatetVecIndex(engine_type);
+        added = 0;
+    }
+    if (added > 0) {
+        ENGINE_LOG_DEBUG << "Build index file: " << location << " goes on from row " << added;
+    }
+
+    VecIndexPtr model;
+    if (added == 0) {
+        if (!model_location.empty()) {
+            model = GetIndexModel(model_location, engine_type, to_index, conf, count, chunk_rows);
+        }
+        if (model == nullptr) {
+            int64_t sample_count = TrainSampleCount(conf, count);
+            std::vector<float> samples;
+            status = SampleRawVectors(count, sample_count, chunk_rows, samples);
+            if (status.ok()) {
+                milvus::json train_conf = conf;
+                train_conf[knowhere::meta::ROWS] = sample_count;
+                status = to_index->Train(sample_count, samples.data(), train_conf);
+            }
+            if (!status.ok()) {
+                throw Exception(DB_ERROR, status.message());
+            }
+        }
+    }
+
+    auto last_checkpoint = std::chrono::steady_clock::now();
+    std::vector<uint8_t> chunk;
+    std::vector<int64_t> ids;
+    for (int64_t begin = added; begin < count; begin += chunk_rows) {
+        int64_t rows = std::min(chunk_rows, count - begin);
+        status = ReadRawVectors(begin, rows, chunk);
+        if (!status.ok()) {
+            throw Exception(DB_ERROR, status.message());
+        }
+        ids.resize(rows);
+        std::iota(ids.begin(), ids.end(), begin);
+
+        auto vectors = reinterpret_cast<const float*>(chunk.data());
+        if (begin == 0 && model != nullptr) {
+            status = to_index->BuildWithModel(model, rows, vectors, ids.data(), conf);
+        } else {
+            status = to_index->Add(rows, vectors, ids.data(), conf);
+        }
+        if (!status.ok()) {
+            throw Exception(DB_ERROR, status.message());
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (!checkpoint.empty() && begin + rows < count &&
+            now - last_checkpoint >= std::chrono::seconds(checkpoint_interval)) {
+            SaveBuildCheckpoint(checkpoint, key.dump(), to_index);
+            last_checkpoint = std::chrono::steady_clock::now();
+            fiu_do_on("ExecutionEngineImpl.BuildIndexInChunks.interrupt", throw Exception(DB_ERROR, "interrupted"));
+        }
+    }
+
+    to_index->SetUids(uids);
+    ENGINE_LOG_DEBUG << "Set " << to_index->GetUids().size() << "uids for " << location;
+    if (!deleted_docs_ptr->GetDeletedDocs().empty()) {
+        auto blacklist = std::make_shared<faiss::ConcurrentBitset>(count);
+        for (auto& offset : deleted_docs_ptr->GetDeletedDocs()) {
+            blacklist->set(offset);
+        }
+        to_index->SetBlacklist(blacklist);
+        ENGINE_LOG_DEBUG << "Set blacklist for index " << location;
+    }
+
+    ENGINE_LOG_DEBUG << "Finish build index file: " << location << " size: " << to_index->Size();
+    auto engine = std::make_shared<ExecutionEngineImpl>(to_index, location, engine_type, metric_type_, index_params_);
+    engine->build_checkpoint_ = checkpoint;
+    return engine;
+}
+
+Status
+ExecutionEngineImpl::ReadRawVectors(int64_t begin, int64_t rows, std::vector<uint8_t>& data) {
+    std::string segment_dir;
+    utils::GetParentPath(location_, segment_dir);
+    segment::SegmentReader segment_reader(segment_dir);
+
+    size_t row_size = dim_ * sizeof(float);
+    auto status = segment_reader.LoadVectors(begin * row_size, rows * row_size, data);
+    if (!status.ok()) {
+        return status;
+    }
+    if (data.size() != rows * row_size) {
+        return Status(DB_ERROR, "Raw vectors of " + location_ + " end before row " + std::to_string(begin + rows));
+    }
+    return Status::OK();
+}
+
+Status
+ExecutionEngineImpl::SampleRawVectors(int64_t count, int64_t sample_count, int64_t chunk_rows,
+                                      std::vector<float>& samples) {
+    int64_t step = count / sample_count;
+    samples.resize(sample_count * dim_);
+
+    auto from_index = std::dynamic_pointer_cast<BFIndex>(index_);
+    if (from_index != nullptr && from_index->Count() == count) {
+        const float* raw_vectors = from_index->GetRawVectors();
+        for (int64_t i = 0; i < sample_count; ++i) {
+            memcpy(samples.data() + i * dim_, raw_vectors + i * step * dim_, dim_ * sizeof(float));
+        }
+        return Status::OK();
+    }
+
+    // not loaded, the sampled rows falling in one chunk are read at once, up to the last of them,
+    // a step longer than a chunk reads the sampled row alone
+    int64_t chunk_samples = std::max(chunk_rows / step, int64_t(1));
+    std::vector<uint8_t> chunk;
+    for (int64_t i = 0; i < sample_count;) {
+        int64_t begin = i * step;
+        int64_t n = std::min(chunk_samples, sample_count - i);
+        auto status = ReadRawVectors(begin, (n - 1) * step + 1, chunk);
+        if (!status.ok()) {
+            return status;
+        }
+        auto raw_vectors = reinterpret_cast<const float*>(chunk.data());
+        for (int64_t j = 0; j < n; ++j, ++i) {
+            memcpy(samples.data() + i * dim_, raw_vectors + j * step * dim_, dim_ * sizeof(float));
+        }
+    }
+    return Status::OK();
+}
+
 // map offsets to ids
 void
 MapUids(const std::vector<segment::doc_id_t>& uids, int64_t* labels, size_t num) {
@@ -958,21 +1352,17 @@ ExecutionEngineImpl::Search(int64_t n, const std::vector<int64_t>& ids, int64_t
     }
      */
 
+    // index copied between devices or loaded without id index, build it once and keep it with the index
+    auto id_index = index_->GetIdIndex();
+    if (id_index == nullptr) {
+        id_index = std::make_shared<segment::IdIndex>(uids);
+        index_->SetIdIndex(id_index);
+    }
+
     // There is only one id in ids
     for (auto& id : ids) {
-        //        if (id_bloom_filter_ptr->Check(id)) {
-        //            if (uids.empty()) {
-        //                segment_reader.LoadUids(uids);
-        //            }
-        //            auto found = std::find(uids.begin(), uids.end(), id);
-        //            if (found != uids.end()) {
-        //                auto offset = std::distance(uids.begin(), found);
-        //                offsets.emplace_back(offset);
-        //            }
-        //        }
-        auto found = std::find(uids.begin(), uids.end(), id);
-        if (found != uids.end()) {
-            auto offset = std::distance(uids.begin(), found);
+        segment::offset_t offset;
+        if (id_index->Get(id, offset)) {
             offsets.emplace_back(offset);
         }
     }
@@ -90,7 +90,14 @@ class ExecutionEngineImpl : public ExecutionEngine {
            int64_t* labels, bool hybrid) override;
 
     ExecutionEnginePtr
-    BuildIndex(const std::string& location, EngineType engine_type) override;
+    BuildIndex(const std::string& location, EngineType engine_type, const std::string& model_location = "") override;
+
+    bool
+    CanBuildInChunks(EngineType engine_type) override;
+
+    ExecutionEnginePtr
+    BuildIndexInChunks(const std::string& location, EngineType engine_type, const std::string& model_location,
+                       int64_t chunk_size, int64_t checkpoint_interval) override;
 
     Status
     Cache() override;
@@ -123,6 +130,22 @@ class ExecutionEngineImpl : public ExecutionEngine {
     VecIndexPtr
     Load(const std::string& location);
 
+    // the model shared by the segments of the table, nullptr if the index can't use one
+    VecIndexPtr
+    GetIndexModel(const std::string& model_location, EngineType engine_type, const VecIndexPtr& to_index,
+                  const milvus::json& conf, int64_t count, int64_t chunk_rows);
+
+    // rows [begin, begin + rows) of the raw vectors in the segment
+    Status
+    ReadRawVectors(int64_t begin, int64_t rows, std::vector<uint8_t>& data);
+
+    // sample_count rows evenly spread over the count raw vectors, read chunk_rows at a time if not loaded
+    Status
+    SampleRawVectors(int64_t count, int64_t sample_count, int64_t chunk_rows, std::vector<float>& samples);
+
+    Status
+    LoadFromDisk();
+
     void
     HybridLoad() const;
 
@@ -139,6 +162,9 @@ class ExecutionEngineImpl : public ExecutionEngine {
 
     milvus::json index_params_;
     int64_t gpu_num_ = 0;
+
+    // progress of the chunked build of the index, removed once the index is serialized
+    std::string build_checkpoint_;
 };
 
 }  // namespace engine
@@ -0,0 +1,192 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/engine/IndexModelMgr.h"
+
+#include <boost/filesystem.hpp>
+
+#include "config/Config.h"
+#include "storage/disk/DiskIOReader.h"
+#include "storage/disk/DiskIOWriter.h"
+#include "storage/s3/S3ClientWrapper.h"
+#include "storage/s3/S3IOReader.h"
+#include "storage/s3/S3IOWriter.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+bool
+S3Enabled() {
+    bool s3_enable = false;
+    server::Config& config = server::Config::GetInstance();
+    config.GetStorageConfigS3Enable(s3_enable);
+    return s3_enable;
+}
+
+std::string
+KeyLocation(const std::string& location) {
+    return location + ".key";
+}
+
+bool
+ModelExists(const std::string& location) {
+    if (S3Enabled()) {
+        return storage::S3ClientWrapper::GetInstance().HeadObject(location).ok();
+    }
+    return boost::filesystem::exists(location);
+}
+
+bool
+ReadModelKey(const std::string& location, std::string& key) {
+    std::shared_ptr<storage::IOReader> reader_ptr;
+    if (S3Enabled()) {
+        reader_ptr = std::make_shared<storage::S3IOReader>();
+    } else {
+        if (!boost::filesystem::exists(KeyLocation(location))) {
+            return false;
+        }
+        reader_ptr = std::make_shared<storage::DiskIOReader>();
+    }
+
+    reader_ptr->open(KeyLocation(location));
+    size_t length = reader_ptr->length();
+    if (length == 0) {
+        reader_ptr->close();
+        return false;
+    }
+    key.resize(length);
+    reader_ptr->read(&key[0], length);
+    reader_ptr->close();
+    return true;
+}
+
+void
+WriteModelKey(const std::string& location, std::string key) {
+    std::shared_ptr<storage::IOWriter> writer_ptr;
+    if (S3Enabled()) {
+        writer_ptr = std::make_shared<storage::S3IOWriter>();
+    } else {
+        writer_ptr = std::make_shared<storage::DiskIOWriter>();
+    }
+
+    writer_ptr->open(KeyLocation(location));
+    writer_ptr->write(&key[0], key.size());
+    writer_ptr->close();
+}
+
+Status
+StoreModel(const VecIndexPtr& model, const std::string& location) {
+    if (S3Enabled()) {
+        return write_index(model, location);
+    }
+
+    // a model loaded before is mapped from the file, replace the file instead of overwriting it
+    std::string temp_location = location + ".tmp";
+    auto status = write_index(model, temp_location);
+    if (!status.ok()) {
+        return status;
+    }
+    boost::system::error_code ec;
+    boost::filesystem::rename(temp_location, location, ec);
+    if (ec) {
+        return Status(DB_ERROR, "Failed to rename " + temp_location + ": " + ec.message());
+    }
+    return Status::OK();
+}
+
+}  // namespace
+
+Status
+IndexModelMgr::GetModel(const std::string& location, const std::string& key, const TrainFunc& train_func,
+                        VecIndexPtr& model) {
+    auto entry = GetEntry(location);
+    std::lock_guard<std::mutex> lock(entry->mutex_);
+
+    if (entry->model_ != nullptr && entry->key_ == key && ModelExists(location)) {
+        model = entry->model_;
+        return Status::OK();
+    }
+
+    // trained before restart
+    std::string stored_key;
+    if (ReadModelKey(location, stored_key) && stored_key == key) {
+        try {
+            auto stored_model = read_index(location);
+            if (stored_model != nullptr) {
+                ENGINE_LOG_DEBUG << "Load index model: " << location;
+                entry->key_ = key;
+                entry->model_ = stored_model;
+                model = stored_model;
+                return Status::OK();
+            }
+        } catch (std::exception& ex) {
+            ENGINE_LOG_WARNING << "Failed to load index model " << location << ": " << ex.what();
+        }
+    }
+
+    entry->model_ = nullptr;
+    TimeRecorder rc("Train index model " + location);
+    VecIndexPtr trained_model;
+    auto status = train_func(trained_model);
+    if (!status.ok()) {
+        return status;
+    }
+    rc.RecordSection("train");
+
+    // the key is written last, a model partially written is trained again
+    status = StoreModel(trained_model, location);
+    if (status.ok()) {
+        try {
+            WriteModelKey(location, key);
+        } catch (std::exception& ex) {
+            status = Status(DB_ERROR, ex.what());
+        }
+    }
+    if (!status.ok()) {
+        // still shared by this process, segments built after restart train a new one
+        ENGINE_LOG_WARNING << "Failed to store index model " << location << ": " << status.message();
+    }
+    rc.ElapseFromBegin("done");
+
+    entry->key_ = key;
+    entry->model_ = trained_model;
+    model = trained_model;
+    return Status::OK();
+}
+
+void
+IndexModelMgr::Evict(const std::string& location) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.erase(location);
+}
+
+void
+IndexModelMgr::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+IndexModelMgr::ModelEntryPtr
+IndexModelMgr::GetEntry(const std::string& location) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entry = entries_[location];
+    if (entry == nullptr) {
+        entry = std::make_shared<ModelEntry>();
+    }
+    return entry;
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,68 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "utils/Status.h"
+#include "wrapper/VecIndex.h"
+
+namespace milvus {
+namespace engine {
+
+// Index models shared by the segments of a table. A model is an ivf index holding the trained quantizer and
+// codebooks but no vectors. It is persisted in the table folder together with a key describing the index
+// parameters it was trained with, a model whose key doesn't match is trained again.
+class IndexModelMgr {
+ public:
+    using TrainFunc = std::function<Status(VecIndexPtr& model)>;
+
+    static IndexModelMgr&
+    GetInstance() {
+        static IndexModelMgr instance;
+        return instance;
+    }
+
+    // load the model stored at location, or train it with train_func and store it if there is none for key,
+    // concurrent calls for one location train it only once
+    Status
+    GetModel(const std::string& location, const std::string& key, const TrainFunc& train_func, VecIndexPtr& model);
+
+    // forget the model of a dropped table, a table created again with the same name trains its own
+    void
+    Evict(const std::string& location);
+
+    void
+    Clear();
+
+ private:
+    struct ModelEntry {
+        std::mutex mutex_;
+        std::string key_;
+        VecIndexPtr model_;
+    };
+    using ModelEntryPtr = std::shared_ptr<ModelEntry>;
+
+    ModelEntryPtr
+    GetEntry(const std::string& location);
+
+ private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, ModelEntryPtr> entries_;
+};
+
+}  // namespace engine
+}  // namespace milvus
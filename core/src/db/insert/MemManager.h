@@ -23,6 +23,7 @@ namespace engine {
 
 class MemManager {
  public:
+    // vectors and ids are added without copying, they only need to stay valid during the call
     virtual Status
     InsertVectors(const std::string& table_id, int64_t length, const IDNumber* vector_ids, int64_t dim,
                   const float* vectors, uint64_t lsn, std::set<std::string>& flushed_tables) = 0;
@@ -46,6 +47,12 @@ class MemManager {
     //    virtual Status
     //    Serialize(std::set<std::string>& table_ids) = 0;
 
+    // search the vectors not flushed yet, results are merged into result_ids/result_distances,
+    // ids deleted but not applied to disk yet are added to deleted_ids
+    virtual Status
+    Search(const std::string& table_id, uint64_t k, const VectorsData& vectors, bool ascending, ResultIds& result_ids,
+           ResultDistances& result_distances, std::set<IDNumber>& deleted_ids) = 0;
+
     virtual Status
     EraseMemVector(const std::string& table_id) = 0;
 
@@ -11,6 +11,7 @@
 
 #include "db/insert/MemManagerImpl.h"
 
+#include <algorithm>
 #include <thread>
 
 #include "VectorSource.h"
@@ -31,6 +32,15 @@ MemManagerImpl::GetMemByTable(const std::string& table_id) {
     return mem_id_map_[table_id];
 }
 
+MemTablePtr
+MemManagerImpl::LockMemByTable(const std::string& table_id, std::unique_lock<std::mutex>& table_lock) {
+    // lock the table before releasing mutex_, ToImmutable() can not take it away in between
+    std::unique_lock<std::mutex> lock(mutex_);
+    MemTablePtr mem = GetMemByTable(table_id);
+    table_lock = mem->Lock();
+    return mem;
+}
+
 Status
 MemManagerImpl::InsertVectors(const std::string& table_id, int64_t length, const IDNumber* vector_ids, int64_t dim,
                               const float* vectors, uint64_t lsn, std::set<std::string>& flushed_tables) {
@@ -44,15 +54,8 @@ MemManagerImpl::InsertVectors(const std::string& table_id, int64_t length, const
         }
     }
 
-    VectorsData vectors_data;
-    vectors_data.vector_count_ = length;
-    vectors_data.float_data_.resize(length * dim);
-    memcpy(vectors_data.float_data_.data(), vectors, length * dim * sizeof(float));
-    vectors_data.id_array_.resize(length);
-    memcpy(vectors_data.id_array_.data(), vector_ids, length * sizeof(IDNumber));
-    VectorSourcePtr source = std::make_shared<VectorSource>(vectors_data);
-
-    std::unique_lock<std::mutex> lock(mutex_);
+    // vectors are added before return, no need to copy them
+    VectorSourcePtr source = std::make_shared<VectorSource>(length, vector_ids, vectors);
 
     return InsertVectorsNoLock(table_id, source, lsn);
 }
@@ -70,22 +73,16 @@ MemManagerImpl::InsertVectors(const std::string& table_id, int64_t length, const
         }
     }
 
-    VectorsData vectors_data;
-    vectors_data.vector_count_ = length;
-    vectors_data.binary_data_.resize(length * dim);
-    memcpy(vectors_data.binary_data_.data(), vectors, length * dim * sizeof(uint8_t));
-    vectors_data.id_array_.resize(length);
-    memcpy(vectors_data.id_array_.data(), vector_ids, length * sizeof(IDNumber));
-    VectorSourcePtr source = std::make_shared<VectorSource>(vectors_data);
-
-    std::unique_lock<std::mutex> lock(mutex_);
+    // vectors are added before return, no need to copy them
+    VectorSourcePtr source = std::make_shared<VectorSource>(length, vector_ids, vectors);
 
     return InsertVectorsNoLock(table_id, source, lsn);
 }
 
 Status
 MemManagerImpl::InsertVectorsNoLock(const std::string& table_id, const VectorSourcePtr& source, uint64_t lsn) {
-    MemTablePtr mem = GetMemByTable(table_id);
+    std::unique_lock<std::mutex> table_lock;
+    MemTablePtr mem = LockMemByTable(table_id, table_lock);
     mem->SetLSN(lsn);
 
     auto status = mem->Add(source);
@@ -94,8 +91,8 @@ MemManagerImpl::InsertVectorsNoLock(const std::string& table_id, const VectorSou
 
 Status
 MemManagerImpl::DeleteVector(const std::string& table_id, IDNumber vector_id, uint64_t lsn) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    MemTablePtr mem = GetMemByTable(table_id);
+    std::unique_lock<std::mutex> table_lock;
+    MemTablePtr mem = LockMemByTable(table_id, table_lock);
     mem->SetLSN(lsn);
     auto status = mem->Delete(vector_id);
     return status;
@@ -103,8 +100,8 @@ MemManagerImpl::DeleteVector(const std::string& table_id, IDNumber vector_id, ui
 
 Status
 MemManagerImpl::DeleteVectors(const std::string& table_id, int64_t length, const IDNumber* vector_ids, uint64_t lsn) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    MemTablePtr mem = GetMemByTable(table_id);
+    std::unique_lock<std::mutex> table_lock;
+    MemTablePtr mem = LockMemByTable(table_id, table_lock);
     mem->SetLSN(lsn);
 
     IDNumbers ids;
@@ -135,6 +132,7 @@ MemManagerImpl::Flush(const std::string& table_id, bool apply_delete) {
     {
         std::unique_lock<std::mutex> lock(mutex_);
         immu_mem_list_.swap(temp_immutable_list);
+        flushing_mem_list_.insert(flushing_mem_list_.end(), temp_immutable_list.begin(), temp_immutable_list.end());
     }
 
     std::unique_lock<std::mutex> lock(serialization_mtx_);
@@ -144,10 +142,12 @@ MemManagerImpl::Flush(const std::string& table_id, bool apply_delete) {
         auto status = mem->Serialize(max_lsn, apply_delete);
         if (!status.ok()) {
             ENGINE_LOG_ERROR << "Flush table " << mem->GetTableId() << " failed";
+            RemoveFlushingTables(temp_immutable_list);
             return status;
         }
         ENGINE_LOG_DEBUG << "Flushed table: " << mem->GetTableId();
     }
+    RemoveFlushingTables(temp_immutable_list);
 
     return Status::OK();
 }
@@ -160,6 +160,7 @@ MemManagerImpl::Flush(std::set<std::string>& table_ids, bool apply_delete) {
     {
         std::unique_lock<std::mutex> lock(mutex_);
         immu_mem_list_.swap(temp_immutable_list);
+        flushing_mem_list_.insert(flushing_mem_list_.end(), temp_immutable_list.begin(), temp_immutable_list.end());
     }
 
     std::unique_lock<std::mutex> lock(serialization_mtx_);
@@ -170,11 +171,13 @@ MemManagerImpl::Flush(std::set<std::string>& table_ids, bool apply_delete) {
         auto status = mem->Serialize(max_lsn, apply_delete);
         if (!status.ok()) {
             ENGINE_LOG_ERROR << "Flush table " << mem->GetTableId() << " failed";
+            RemoveFlushingTables(temp_immutable_list);
             return status;
         }
         table_ids.insert(mem->GetTableId());
         ENGINE_LOG_DEBUG << "Flushed table: " << mem->GetTableId();
     }
+    RemoveFlushingTables(temp_immutable_list);
 
     meta_->SetGlobalLastLSN(max_lsn);
 
@@ -186,6 +189,8 @@ MemManagerImpl::ToImmutable(const std::string& table_id) {
     std::unique_lock<std::mutex> lock(mutex_);
     auto memIt = mem_id_map_.find(table_id);
     if (memIt != mem_id_map_.end()) {
+        // wait for the ongoing insert or delete
+        auto table_lock = memIt->second->Lock();
         if (!memIt->second->Empty()) {
             immu_mem_list_.push_back(memIt->second);
             mem_id_map_.erase(memIt);
@@ -203,6 +208,7 @@ MemManagerImpl::ToImmutable() {
     std::unique_lock<std::mutex> lock(mutex_);
     MemIdMap temp_map;
     for (auto& kv : mem_id_map_) {
+        auto table_lock = kv.second->Lock();
         if (kv.second->Empty()) {
             // empty table without any deletes, no need to serialize
             temp_map.insert(kv);
@@ -236,13 +242,54 @@ MemManagerImpl::EraseMemVector(const std::string& table_id) {
     return Status::OK();
 }
 
+Status
+MemManagerImpl::Search(const std::string& table_id, uint64_t k, const VectorsData& vectors, bool ascending,
+                       ResultIds& result_ids, ResultDistances& result_distances, std::set<IDNumber>& deleted_ids) {
+    MemList tables;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto memIt = mem_id_map_.find(table_id);
+        if (memIt != mem_id_map_.end()) {
+            tables.push_back(memIt->second);
+        }
+        for (auto& mem : immu_mem_list_) {
+            if (mem->GetTableId() == table_id) {
+                tables.push_back(mem);
+            }
+        }
+        for (auto& mem : flushing_mem_list_) {
+            if (mem->GetTableId() == table_id) {
+                tables.push_back(mem);
+            }
+        }
+    }
+
+    // don't hold mutex_ while searching, inserts into other tables go on
+    for (auto& mem : tables) {
+        auto status = mem->Search(k, vectors, ascending, result_ids, result_distances);
+        if (!status.ok()) {
+            return status;
+        }
+        mem->GetDeletedIds(deleted_ids);
+    }
+
+    return Status::OK();
+}
+
 size_t
 MemManagerImpl::GetCurrentMutableMem() {
+    MemList tables;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (auto& kv : mem_id_map_) {
+            tables.push_back(kv.second);
+        }
+    }
+
+    // don't hold mutex_ while waiting for the tables being written
     size_t total_mem = 0;
-    std::unique_lock<std::mutex> lock(mutex_);
-    for (auto& kv : mem_id_map_) {
-        auto memTable = kv.second;
-        total_mem += memTable->GetCurrentMem();
+    for (auto& mem_table : tables) {
+        total_mem += mem_table->GetCurrentMem();
     }
     return total_mem;
 }
@@ -274,6 +321,17 @@ MemManagerImpl::GetMaxLSN(const MemList& tables) {
     return max_lsn;
 }
 
+void
+MemManagerImpl::RemoveFlushingTables(const MemList& tables) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (auto& table : tables) {
+        auto iter = std::find(flushing_mem_list_.begin(), flushing_mem_list_.end(), table);
+        if (iter != flushing_mem_list_.end()) {
+            flushing_mem_list_.erase(iter);
+        }
+    }
+}
+
 void
 MemManagerImpl::OnInsertBufferSizeChanged(int64_t value) {
     options_.insert_buffer_size_ = value * ONE_GB;
@@ -63,6 +63,10 @@ class MemManagerImpl : public MemManager, public server::CacheConfigHandler {
     //    Status
     //    Serialize(std::set<std::string>& table_ids) override;
 
+    Status
+    Search(const std::string& table_id, uint64_t k, const VectorsData& vectors, bool ascending, ResultIds& result_ids,
+           ResultDistances& result_distances, std::set<IDNumber>& deleted_ids) override;
+
     Status
     EraseMemVector(const std::string& table_id) override;
 
@@ -83,6 +87,10 @@ class MemManagerImpl : public MemManager, public server::CacheConfigHandler {
     MemTablePtr
     GetMemByTable(const std::string& table_id);
 
+    // get the table and lock it, inserts and deletes on different tables run in parallel
+    MemTablePtr
+    LockMemByTable(const std::string& table_id, std::unique_lock<std::mutex>& table_lock);
+
     Status
     InsertVectorsNoLock(const std::string& table_id, const VectorSourcePtr& source, uint64_t lsn);
 
@@ -95,8 +103,13 @@ class MemManagerImpl : public MemManager, public server::CacheConfigHandler {
     uint64_t
     GetMaxLSN(const MemList& tables);
 
+    void
+    RemoveFlushingTables(const MemList& tables);
+
     MemIdMap mem_id_map_;
     MemList immu_mem_list_;
+    // tables being serialized, still searchable until they are visible on disk
+    MemList flushing_mem_list_;
     meta::MetaPtr meta_;
     DBOptions options_;
     std::mutex mutex_;
@@ -17,13 +17,16 @@
 
 #include <algorithm>
 #include <chrono>
+#include <future>
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <thread>
 
 #include "db/OngoingFileChecker.h"
 #include "db/Utils.h"
+#include "scheduler/task/SearchTask.h"
 #include "utils/Log.h"
+#include "utils/ThreadPool.h"
 
 namespace milvus {
 namespace engine {
@@ -160,18 +163,17 @@ MemTable::GetCurrentMem() {
 
 Status
 MemTable::ApplyDeletes() {
-    // Applying deletes to other segments on disk and their corresponding cache:
+    // Applying deletes to other segments on disk and their corresponding cache, segments are processed in parallel:
     // For each segment in table:
-    //     Load its bloom filter
-    //     For each id in delete list:
-    //         If present, add the uid to segment's uid list
-    // For each segment
-    //     Get its cache if exists
-    //     Load its uids file.
-    //     Scan the uids, if any uid in segment's uid list exists:
-    //         add its offset to deletedDoc
-    //         remove the id from bloom filter
-    //         set black list in cache
+    //     Get its bloom filter from cache, or load it, skip the segment if none of the ids to delete is present
+    //     Get its id index from cache, or load it
+    //     Join the sorted ids to delete with the sorted uids of id index to get the offsets to delete
+    // For each segment with offsets to delete:
+    //     Get the segment files from meta
+    // For each segment with offsets to delete:
+    //     Add the offsets to deletedDoc
+    //     Remove the ids from the bloom filter found above
+    //     Set black list and bloom filter in cache
     //     Serialize segment's deletedDoc TODO(zhiru): append directly to previous file for now, may have duplicates
     //     Serialize bloom filter
 
@@ -179,8 +181,6 @@ MemTable::ApplyDeletes() {
 
     auto start_total = std::chrono::high_resolution_clock::now();
 
-    //    auto start = std::chrono::high_resolution_clock::now();
-
     std::vector<int> file_types{meta::TableFileSchema::FILE_TYPE::RAW, meta::TableFileSchema::FILE_TYPE::TO_INDEX,
                                 meta::TableFileSchema::FILE_TYPE::BACKUP};
     meta::TableFilesSchema table_files;
@@ -191,207 +191,258 @@ MemTable::ApplyDeletes() {
         return Status(DB_ERROR, err_msg);
     }
 
-    OngoingFileChecker::GetInstance().MarkOngoingFiles(table_files);
+    if (table_files.empty()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        doc_ids_to_delete_.clear();
+        return Status::OK();
+    }
 
-    std::unordered_map<size_t, std::vector<segment::doc_id_t>> ids_to_check_map;
+    OngoingFileChecker::GetInstance().MarkOngoingFiles(table_files);
 
-    for (size_t i = 0; i < table_files.size(); ++i) {
-        auto& table_file = table_files[i];
-        std::string segment_dir;
-        utils::GetParentPath(table_file.location_, segment_dir);
+    // std::set is ordered, the ids to delete are sorted already
+    std::vector<segment::doc_id_t> ids_to_delete(doc_ids_to_delete_.begin(), doc_ids_to_delete_.end());
 
-        segment::SegmentReader segment_reader(segment_dir);
-        segment::IdBloomFilterPtr id_bloom_filter_ptr;
-        segment_reader.LoadBloomFilter(id_bloom_filter_ptr);
+    size_t thread_count = std::min<size_t>(table_files.size(), std::max(1U, std::thread::hardware_concurrency()));
+    ThreadPool pool(thread_count, table_files.size());
 
-        for (auto& id : doc_ids_to_delete_) {
-            if (id_bloom_filter_ptr->Check(id)) {
-                ids_to_check_map[i].emplace_back(id);
-            }
-        }
+    std::vector<SegmentDeletes> segment_deletes(table_files.size());
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i < table_files.size(); ++i) {
+        futures.emplace_back(
+            pool.enqueue([&, i]() { FindDeletes(table_files[i], ids_to_delete, segment_deletes[i]); }));
+    }
+    for (auto& future : futures) {
+        future.wait();
     }
 
     meta::TableFilesSchema files_to_check;
-    for (auto& kv : ids_to_check_map) {
-        files_to_check.emplace_back(table_files[kv.first]);
-    }
+    std::vector<size_t> segments_to_apply;
+    for (size_t i = 0; i < table_files.size(); ++i) {
+        if (!segment_deletes[i].status_.ok()) {
+            ENGINE_LOG_ERROR << "Failed to find deletes in segment " << table_files[i].segment_id_ << ": "
+                             << segment_deletes[i].status_.message();
+            continue;
+        }
+        if (segment_deletes[i].offsets_.empty()) {
+            continue;
+        }
 
-    OngoingFileChecker::GetInstance().UnmarkOngoingFiles(table_files);
+        status = meta_->GetTableFilesBySegmentId(table_files[i].segment_id_, segment_deletes[i].segment_files_);
+        if (!status.ok()) {
+            ENGINE_LOG_ERROR << "Failed to get files of segment " << table_files[i].segment_id_ << ": "
+                             << status.message();
+            continue;
+        }
+        files_to_check.emplace_back(table_files[i]);
+        segments_to_apply.emplace_back(i);
+    }
 
     OngoingFileChecker::GetInstance().MarkOngoingFiles(files_to_check);
+    OngoingFileChecker::GetInstance().UnmarkOngoingFiles(table_files);
 
     auto time0 = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> diff0 = time0 - start_total;
-    ENGINE_LOG_DEBUG << "Found " << ids_to_check_map.size() << " segment to apply deletes in " << diff0.count() << " s";
-
-    meta::TableFilesSchema table_files_to_update;
-
-    for (auto& kv : ids_to_check_map) {
-        auto& table_file = table_files[kv.first];
-        ENGINE_LOG_DEBUG << "Applying deletes in segment: " << table_file.segment_id_;
-
-        auto time1 = std::chrono::high_resolution_clock::now();
+    ENGINE_LOG_DEBUG << "Found " << segments_to_apply.size() << " segment to apply deletes in " << diff0.count()
+                     << " s";
 
-        std::string segment_dir;
-        utils::GetParentPath(table_file.location_, segment_dir);
-        segment::SegmentReader segment_reader(segment_dir);
+    futures.clear();
+    for (auto i : segments_to_apply) {
+        futures.emplace_back(pool.enqueue([&, i]() { WriteDeletes(table_files[i], segment_deletes[i]); }));
+    }
+    for (auto& future : futures) {
+        future.wait();
+    }
 
-        auto& segment_id = table_file.segment_id_;
-        meta::TableFilesSchema segment_files;
-        status = meta_->GetTableFilesBySegmentId(segment_id, segment_files);
-        if (!status.ok()) {
-            break;
+    // Update table file row count
+    meta::TableFilesSchema table_files_to_update;
+    for (auto i : segments_to_apply) {
+        auto& deletes = segment_deletes[i];
+        if (!deletes.status_.ok()) {
+            ENGINE_LOG_ERROR << "Failed to apply deletes in segment " << table_files[i].segment_id_ << ": "
+                             << deletes.status_.message();
+            continue;
         }
-
-        // Get all index that contains blacklist in cache
-        std::vector<VecIndexPtr> indexes;
-        std::vector<faiss::ConcurrentBitsetPtr> blacklists;
-        for (auto& file : segment_files) {
-            auto index =
-                std::static_pointer_cast<VecIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(file.location_));
-            faiss::ConcurrentBitsetPtr blacklist = nullptr;
-            if (index != nullptr) {
-                index->GetBlacklist(blacklist);
-                if (blacklist != nullptr) {
-                    indexes.emplace_back(index);
-                    blacklists.emplace_back(blacklist);
-                }
+        for (auto& file : deletes.segment_files_) {
+            if (file.file_type_ == meta::TableFileSchema::RAW || file.file_type_ == meta::TableFileSchema::TO_INDEX ||
+                file.file_type_ == meta::TableFileSchema::INDEX || file.file_type_ == meta::TableFileSchema::BACKUP) {
+                file.row_count_ -= deletes.offsets_.size();
+                table_files_to_update.emplace_back(file);
             }
         }
+    }
 
-        std::vector<segment::doc_id_t> uids;
-        status = segment_reader.LoadUids(uids);
-        if (!status.ok()) {
-            break;
-        }
-        segment::IdBloomFilterPtr id_bloom_filter_ptr;
-        status = segment_reader.LoadBloomFilter(id_bloom_filter_ptr);
-        if (!status.ok()) {
-            break;
-        }
-
-        auto& ids_to_check = kv.second;
-
-        segment::DeletedDocsPtr deleted_docs = std::make_shared<segment::DeletedDocs>();
-
-        auto time2 = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> diff1 = time2 - time1;
-        ENGINE_LOG_DEBUG << "Loading uids and deleted docs took " << diff1.count() << " s";
-
-        std::sort(ids_to_check.begin(), ids_to_check.end());
-
-        auto time3 = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> diff2 = time3 - time2;
-        ENGINE_LOG_DEBUG << "Sorting " << ids_to_check.size() << " ids took " << diff2.count() << " s";
-
-        size_t delete_count = 0;
-        auto find_diff = std::chrono::duration<double>::zero();
-        auto set_diff = std::chrono::duration<double>::zero();
-
-        for (size_t i = 0; i < uids.size(); ++i) {
-            auto find_start = std::chrono::high_resolution_clock::now();
-
-            auto found = std::binary_search(ids_to_check.begin(), ids_to_check.end(), uids[i]);
+    auto time1 = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> diff1 = time1 - time0;
+    ENGINE_LOG_DEBUG << "Applied deletes to " << segments_to_apply.size() << " segments in " << diff1.count() << " s";
 
-            auto find_end = std::chrono::high_resolution_clock::now();
-            find_diff += (find_end - find_start);
+    status = meta_->UpdateTableFilesRowCount(table_files_to_update);
 
-            if (found) {
-                auto set_start = std::chrono::high_resolution_clock::now();
+    if (!status.ok()) {
+        std::string err_msg = "Failed to apply deletes: " + status.ToString();
+        ENGINE_LOG_ERROR << err_msg;
+        OngoingFileChecker::GetInstance().UnmarkOngoingFiles(files_to_check);
+        return Status(DB_ERROR, err_msg);
+    }
 
-                delete_count++;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        doc_ids_to_delete_.clear();
+    }
 
-                deleted_docs->AddDeletedDoc(i);
+    auto end_total = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> diff2 = end_total - time1;
+    ENGINE_LOG_DEBUG << "Update deletes to meta in table " << table_id_ << " in " << diff2.count() << " s";
+    std::chrono::duration<double> diff_total = end_total - start_total;
+    ENGINE_LOG_DEBUG << "Finished applying deletes in table " << table_id_ << " in " << diff_total.count() << " s";
 
-                if (id_bloom_filter_ptr->Check(uids[i])) {
-                    id_bloom_filter_ptr->Remove(uids[i]);
-                }
+    OngoingFileChecker::GetInstance().UnmarkOngoingFiles(files_to_check);
 
-                for (auto& blacklist : blacklists) {
-                    if (!blacklist->test(i)) {
-                        blacklist->set(i);
-                    }
-                }
+    return Status::OK();
+}
 
-                auto set_end = std::chrono::high_resolution_clock::now();
-                set_diff += (set_end - set_start);
-            }
+void
+MemTable::FindDeletes(const meta::TableFileSchema& table_file, const std::vector<segment::doc_id_t>& ids_to_delete,
+                      SegmentDeletes& deletes) {
+    std::string segment_dir;
+    utils::GetParentPath(table_file.location_, segment_dir);
+    segment::SegmentReader segment_reader(segment_dir);
+
+    // the bloom filter and the id index are cached along with the index
+    auto cached_index =
+        std::static_pointer_cast<VecIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(table_file.location_));
+
+    // filter by bloom filter first, ids already deleted were removed from it, so deleting them again is a no-op
+    segment::IdBloomFilterPtr id_bloom_filter_ptr;
+    if (cached_index != nullptr) {
+        id_bloom_filter_ptr = cached_index->GetBloomFilter();
+    }
+    if (id_bloom_filter_ptr == nullptr) {
+        deletes.status_ = segment_reader.LoadBloomFilter(id_bloom_filter_ptr);
+        if (!deletes.status_.ok()) {
+            return;
         }
+        if (cached_index != nullptr) {
+            cached_index->SetBloomFilter(id_bloom_filter_ptr);
+        }
+    }
+    deletes.id_bloom_filter_ptr_ = id_bloom_filter_ptr;
 
-        ENGINE_LOG_DEBUG << "Finding " << ids_to_check.size() << " uids in " << uids.size() << " uids took "
-                         << find_diff.count() << " s in total";
-        ENGINE_LOG_DEBUG << "Setting deleted docs and bloom filter took " << set_diff.count() << " s in total";
-
-        auto time4 = std::chrono::high_resolution_clock::now();
-
-        for (auto i = 0; i < indexes.size(); ++i) {
-            indexes[i]->SetBlacklist(blacklists[i]);
+    std::vector<segment::doc_id_t> candidates;
+    for (auto& id : ids_to_delete) {
+        if (id_bloom_filter_ptr->Check(id)) {
+            candidates.emplace_back(id);
         }
+    }
+    if (candidates.empty()) {
+        return;
+    }
 
-        //        start = std::chrono::high_resolution_clock::now();
+    // the id index is loaded only if the segment may contain any of the ids
+    segment::IdIndexPtr id_index_ptr;
+    if (cached_index != nullptr) {
+        id_index_ptr = cached_index->GetIdIndex();
+    }
+    if (id_index_ptr == nullptr) {
+        deletes.status_ = segment_reader.LoadIdIndex(id_index_ptr);
+        if (!deletes.status_.ok()) {
+            return;
+        }
+    }
 
-        segment::Segment tmp_segment;
-        segment::SegmentWriter segment_writer(segment_dir);
-        status = segment_writer.WriteDeletedDocs(deleted_docs);
-        if (!status.ok()) {
+    // both sides are sorted, join them in one pass, skipping over the uids by binary search
+    auto& sorted_uids = id_index_ptr->GetSortedUids();
+    auto& offsets = id_index_ptr->GetOffsets();
+    auto uid_iter = sorted_uids.begin();
+    for (auto& id : candidates) {
+        uid_iter = std::lower_bound(uid_iter, sorted_uids.end(), id);
+        if (uid_iter == sorted_uids.end()) {
             break;
         }
+        if (*uid_iter == id) {
+            deletes.ids_.emplace_back(id);
+        }
+        for (; uid_iter != sorted_uids.end() && *uid_iter == id; ++uid_iter) {
+            deletes.offsets_.emplace_back(offsets[std::distance(sorted_uids.begin(), uid_iter)]);
+        }
+    }
+}
 
-        auto time5 = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> diff4 = time5 - time4;
-        ENGINE_LOG_DEBUG << "Appended " << deleted_docs->GetSize()
-                         << " offsets to deleted docs in segment: " << table_file.segment_id_ << " in " << diff4.count()
-                         << " s";
+void
+MemTable::WriteDeletes(const meta::TableFileSchema& table_file, SegmentDeletes& deletes) {
+    ENGINE_LOG_DEBUG << "Applying " << deletes.offsets_.size() << " deletes in segment: " << table_file.segment_id_;
 
-        //        start = std::chrono::high_resolution_clock::now();
+    std::string segment_dir;
+    utils::GetParentPath(table_file.location_, segment_dir);
 
-        status = segment_writer.WriteBloomFilter(id_bloom_filter_ptr);
-        if (!status.ok()) {
-            break;
+    // the bloom filter found by FindDeletes(), it may be shared with the cached index
+    auto& id_bloom_filter_ptr = deletes.id_bloom_filter_ptr_;
+    for (auto& id : deletes.ids_) {
+        if (id_bloom_filter_ptr->Check(id)) {
+            id_bloom_filter_ptr->Remove(id);
+        }
+    }
+
+    // Set blacklist and bloom filter of every index in cache
+    std::vector<VecIndexPtr> cached_indexes;
+    for (auto& file : deletes.segment_files_) {
+        auto index = std::static_pointer_cast<VecIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(file.location_));
+        if (index == nullptr) {
+            continue;
         }
-        auto time6 = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> diff5 = time6 - time5;
-        ENGINE_LOG_DEBUG << "Updated bloom filter in segment: " << table_file.segment_id_ << " in " << diff5.count()
-                         << " s";
+        index->SetBloomFilter(id_bloom_filter_ptr);
+        cached_indexes.emplace_back(index);
 
-        // Update table file row count
-        for (auto& file : segment_files) {
-            if (file.file_type_ == meta::TableFileSchema::RAW || file.file_type_ == meta::TableFileSchema::TO_INDEX ||
-                file.file_type_ == meta::TableFileSchema::INDEX || file.file_type_ == meta::TableFileSchema::BACKUP) {
-                file.row_count_ -= delete_count;
-                table_files_to_update.emplace_back(file);
+        faiss::ConcurrentBitsetPtr blacklist = nullptr;
+        index->GetBlacklist(blacklist);
+        if (blacklist == nullptr) {
+            continue;
+        }
+        for (auto offset : deletes.offsets_) {
+            if (!blacklist->test(offset)) {
+                blacklist->set(offset);
             }
         }
-        auto time7 = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> diff6 = time7 - time6;
-        diff6 = time6 - time5;
-        ENGINE_LOG_DEBUG << "Update table file row count in vector of segment: " << table_file.segment_id_ << " in "
-                         << diff6.count() << " s";
+        index->SetBlacklist(blacklist);
     }
 
-    auto time7 = std::chrono::high_resolution_clock::now();
-
-    status = meta_->UpdateTableFilesRowCount(table_files_to_update);
-
-    if (!status.ok()) {
-        std::string err_msg = "Failed to apply deletes: " + status.ToString();
-        ENGINE_LOG_ERROR << err_msg;
-        return Status(DB_ERROR, err_msg);
+    segment::DeletedDocsPtr deleted_docs = std::make_shared<segment::DeletedDocs>(deletes.offsets_);
+    segment::SegmentWriter segment_writer(segment_dir);
+    deletes.status_ = segment_writer.WriteDeletedDocs(deleted_docs);
+    if (deletes.status_.ok()) {
+        deletes.status_ = segment_writer.WriteBloomFilter(id_bloom_filter_ptr);
     }
 
-    doc_ids_to_delete_.clear();
-
-    auto end_total = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> diff7 = end_total - time7;
-    ENGINE_LOG_DEBUG << "Update deletes to meta in table " << table_id_ << " in " << diff7.count() << " s";
-    std::chrono::duration<double> diff_total = end_total - start_total;
-    ENGINE_LOG_DEBUG << "Finished applying deletes in table " << table_id_ << " in " << diff_total.count() << " s";
-
-    OngoingFileChecker::GetInstance().UnmarkOngoingFiles(files_to_check);
+    // the ids removed from the cached bloom filter didn't reach the disk, it is loaded again next time
+    if (!deletes.status_.ok()) {
+        for (auto& index : cached_indexes) {
+            index->SetBloomFilter(nullptr);
+        }
+    }
+}
 
+Status
+MemTable::Search(uint64_t k, const VectorsData& vectors, bool ascending, ResultIds& result_ids,
+                 ResultDistances& result_distances) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& mem_table_file : mem_table_file_list_) {
+        ResultIds file_ids;
+        ResultDistances file_distances;
+        auto status = mem_table_file->Search(k, vectors, file_ids, file_distances);
+        if (!status.ok()) {
+            return status;
+        }
+        scheduler::XSearchTask::MergeTopkToResultSet(file_ids, file_distances, k, vectors.vector_count_, k,
+                                                     ascending, result_ids, result_distances);
+    }
     return Status::OK();
 }
 
+void
+MemTable::GetDeletedIds(std::set<segment::doc_id_t>& doc_ids) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    doc_ids.insert(doc_ids_to_delete_.begin(), doc_ids_to_delete_.end());
+}
+
 uint64_t
 MemTable::GetLSN() {
     return lsn_;
@@ -402,6 +453,11 @@ MemTable::SetLSN(uint64_t lsn) {
     lsn_ = lsn;
 }
 
+std::unique_lock<std::mutex>
+MemTable::Lock() {
+    return std::unique_lock<std::mutex>(mutex_);
+}
+
 void
 MemTable::OnCacheInsertDataChanged(bool value) {
     options_.insert_cache_immediately_ = value;
@@ -65,14 +65,43 @@ class MemTable : public server::CacheConfigHandler {
     void
     SetLSN(uint64_t lsn);
 
+    // brute-force search all buffered vectors and merge into result_ids/result_distances
+    Status
+    Search(uint64_t k, const VectorsData& vectors, bool ascending, ResultIds& result_ids,
+           ResultDistances& result_distances);
+
+    // ids deleted but not yet applied to the segments on disk
+    void
+    GetDeletedIds(std::set<segment::doc_id_t>& doc_ids);
+
+    // hold the lock while calling Add(), Delete() or Empty() from different threads
+    std::unique_lock<std::mutex>
+    Lock();
+
  protected:
     void
     OnCacheInsertDataChanged(bool value) override;
 
  private:
+    // deletes found in a segment on disk
+    struct SegmentDeletes {
+        std::vector<segment::doc_id_t> ids_;
+        std::vector<segment::offset_t> offsets_;
+        segment::IdBloomFilterPtr id_bloom_filter_ptr_;
+        meta::TableFilesSchema segment_files_;
+        Status status_;
+    };
+
     Status
     ApplyDeletes();
 
+    void
+    FindDeletes(const meta::TableFileSchema& table_file, const std::vector<segment::doc_id_t>& ids_to_delete,
+                SegmentDeletes& deletes);
+
+    void
+    WriteDeletes(const meta::TableFileSchema& table_file, SegmentDeletes& deletes);
+
  private:
     const std::string table_id_;
 
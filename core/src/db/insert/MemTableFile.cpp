@@ -11,6 +11,10 @@
 
 #include "db/insert/MemTableFile.h"
 
+#include <faiss/utils/BinaryDistance.h>
+#include <faiss/utils/distances.h>
+#include <faiss/utils/hamming.h>
+
 #include <algorithm>
 #include <cmath>
 #include <iterator>
@@ -218,6 +222,79 @@ MemTableFile::Serialize(uint64_t wal_lsn) {
     return status;
 }
 
+Status
+MemTableFile::Search(uint64_t k, const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances) {
+    segment::SegmentPtr segment_ptr;
+    segment_writer_ptr_->GetSegment(segment_ptr);
+    auto& data = segment_ptr->vectors_ptr_->GetData();
+    auto& uids = segment_ptr->vectors_ptr_->GetUids();
+
+    uint64_t nq = vectors.vector_count_;
+    size_t nb = uids.size();
+    size_t dim = table_file_schema_.dimension_;
+    auto metric_type = static_cast<MetricType>(table_file_schema_.metric_type_);
+    result_ids.assign(nq * k, -1);
+    result_distances.assign(nq * k, 0.0f);
+    if (nb == 0 || k == 0) {
+        return Status::OK();
+    }
+
+    // the heaps set offsets in buffer as labels, unfilled slots are -1
+    if (metric_type == MetricType::L2 || metric_type == MetricType::IP) {
+        if (vectors.float_data_.size() != nq * dim || data.size() != nb * dim * sizeof(float)) {
+            return Status(DB_ERROR, "Vector type or dimension mismatch");
+        }
+        auto xb = reinterpret_cast<const float*>(data.data());
+        if (metric_type == MetricType::L2) {
+            faiss::float_maxheap_array_t res = {nq, k, result_ids.data(), result_distances.data()};
+            faiss::knn_L2sqr(vectors.float_data_.data(), xb, dim, nq, nb, &res);
+        } else {
+            faiss::float_minheap_array_t res = {nq, k, result_ids.data(), result_distances.data()};
+            faiss::knn_inner_product(vectors.float_data_.data(), xb, dim, nq, nb, &res);
+        }
+    } else {
+        size_t code_size = dim / 8;
+        if (vectors.binary_data_.size() != nq * code_size || data.size() != nb * code_size) {
+            return Status(DB_ERROR, "Vector type or dimension mismatch");
+        }
+        if (metric_type == MetricType::HAMMING) {
+            std::vector<int32_t> int_distances(nq * k);
+            faiss::int_maxheap_array_t res = {nq, k, result_ids.data(), int_distances.data()};
+            faiss::hammings_knn_hc(&res, vectors.binary_data_.data(), data.data(), nb, code_size, 1);
+            std::copy(int_distances.begin(), int_distances.end(), result_distances.begin());
+        } else {
+            faiss::MetricType faiss_metric = faiss::METRIC_Jaccard;
+            if (metric_type == MetricType::TANIMOTO) {
+                faiss_metric = faiss::METRIC_Tanimoto;
+            } else if (metric_type == MetricType::SUBSTRUCTURE) {
+                faiss_metric = faiss::METRIC_Substructure;
+            } else if (metric_type == MetricType::SUPERSTRUCTURE) {
+                faiss_metric = faiss::METRIC_Superstructure;
+            }
+            faiss::float_maxheap_array_t res = {nq, k, result_ids.data(), result_distances.data()};
+            faiss::binary_distence_knn_hc(faiss_metric, &res, vectors.binary_data_.data(), data.data(), nb,
+                                          code_size, 1);
+            if (metric_type == MetricType::TANIMOTO) {
+                // same as IndexBinaryFlat
+                for (size_t i = 0; i < result_ids.size(); ++i) {
+                    if (result_ids[i] >= 0) {
+                        result_distances[i] = -log2(1 - result_distances[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    // map offsets to ids
+    for (auto& id : result_ids) {
+        if (id >= 0) {
+            id = uids[id];
+        }
+    }
+
+    return Status::OK();
+}
+
 const std::string&
 MemTableFile::GetSegmentId() const {
     return table_file_schema_.segment_id_;
@@ -57,6 +57,11 @@ class MemTableFile : public server::CacheConfigHandler {
     const std::string&
     GetSegmentId() const;
 
+    // brute-force search the vectors in buffer, results of each query are sorted as the metric requires,
+    // and padded with -1 if there are fewer than k vectors
+    Status
+    Search(uint64_t k, const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances);
+
  protected:
     void
     OnCacheInsertDataChanged(bool value) override;
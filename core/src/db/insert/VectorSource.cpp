@@ -23,6 +23,26 @@ namespace milvus {
 namespace engine {
 
 VectorSource::VectorSource(VectorsData vectors) : vectors_(std::move(vectors)) {
+    vector_count_ = vectors_.vector_count_;
+    if (!vectors_.id_array_.empty()) {
+        ids_ = vectors_.id_array_.data();
+    }
+    if (!vectors_.float_data_.empty()) {
+        data_ = reinterpret_cast<const uint8_t*>(vectors_.float_data_.data());
+    } else if (!vectors_.binary_data_.empty()) {
+        data_ = vectors_.binary_data_.data();
+        binary_ = true;
+    }
+    current_num_vectors_added = 0;
+}
+
+VectorSource::VectorSource(uint64_t vector_count, const IDNumber* vector_ids, const float* vectors)
+    : vector_count_(vector_count), ids_(vector_ids), data_(reinterpret_cast<const uint8_t*>(vectors)) {
+    current_num_vectors_added = 0;
+}
+
+VectorSource::VectorSource(uint64_t vector_count, const IDNumber* vector_ids, const uint8_t* vectors)
+    : vector_count_(vector_count), ids_(vector_ids), data_(vectors), binary_(true) {
     current_num_vectors_added = 0;
 }
 
@@ -30,62 +50,38 @@ Status
 VectorSource::Add(/*const ExecutionEnginePtr& execution_engine,*/ const segment::SegmentWriterPtr& segment_writer_ptr,
                   const meta::TableFileSchema& table_file_schema, const size_t& num_vectors_to_add,
                   size_t& num_vectors_added) {
-    uint64_t n = vectors_.vector_count_;
+    uint64_t n = vector_count_;
     server::CollectAddMetrics metrics(n, table_file_schema.dimension_);
 
     num_vectors_added =
         current_num_vectors_added + num_vectors_to_add <= n ? num_vectors_to_add : n - current_num_vectors_added;
-    IDNumbers vector_ids_to_add;
-    if (vectors_.id_array_.empty()) {
+    IDNumbers generated_ids;
+    const IDNumber* vector_ids_to_add = nullptr;
+    if (ids_ == nullptr) {
         SafeIDGenerator& id_generator = SafeIDGenerator::GetInstance();
-        Status status = id_generator.GetNextIDNumbers(num_vectors_added, vector_ids_to_add);
+        Status status = id_generator.GetNextIDNumbers(num_vectors_added, generated_ids);
         if (!status.ok()) {
             return status;
         }
+        vector_ids_to_add = generated_ids.data();
     } else {
-        vector_ids_to_add.resize(num_vectors_added);
-        for (size_t pos = current_num_vectors_added; pos < current_num_vectors_added + num_vectors_added; pos++) {
-            vector_ids_to_add[pos - current_num_vectors_added] = vectors_.id_array_[pos];
-        }
+        vector_ids_to_add = ids_ + current_num_vectors_added;
     }
 
     Status status;
-    if (!vectors_.float_data_.empty()) {
-        /*
-        status = execution_engine->AddWithIds(
-            num_vectors_added, vectors_.float_data_.data() + current_num_vectors_added * table_file_schema.dimension_,
-            vector_ids_to_add.data());
-        */
-        std::vector<uint8_t> vectors;
-        auto size = num_vectors_added * table_file_schema.dimension_ * sizeof(float);
-        vectors.resize(size);
-        memcpy(vectors.data(), vectors_.float_data_.data() + current_num_vectors_added * table_file_schema.dimension_,
-               size);
-        status = segment_writer_ptr->AddVectors(table_file_schema.file_id_, vectors, vector_ids_to_add);
-
-    } else if (!vectors_.binary_data_.empty()) {
-        /*
-        status = execution_engine->AddWithIds(
-            num_vectors_added,
-            vectors_.binary_data_.data() + current_num_vectors_added * SingleVectorSize(table_file_schema.dimension_),
-            vector_ids_to_add.data());
-        */
-        std::vector<uint8_t> vectors;
-        auto size = num_vectors_added * SingleVectorSize(table_file_schema.dimension_) * sizeof(uint8_t);
-        vectors.resize(size);
-        memcpy(
-            vectors.data(),
-            vectors_.binary_data_.data() + current_num_vectors_added * SingleVectorSize(table_file_schema.dimension_),
-            size);
-        status = segment_writer_ptr->AddVectors(table_file_schema.file_id_, vectors, vector_ids_to_add);
+    if (data_ != nullptr) {
+        // append straight from the source, no intermediate buffer
+        auto single_size = SingleVectorSize(table_file_schema.dimension_);
+        status = segment_writer_ptr->AddVectors(table_file_schema.file_id_,
+                                                data_ + current_num_vectors_added * single_size,
+                                                num_vectors_added * single_size, vector_ids_to_add, num_vectors_added);
     }
 
     // Clear vector data
     if (status.ok()) {
         current_num_vectors_added += num_vectors_added;
         // TODO(zhiru): remove
-        vector_ids_.insert(vector_ids_.end(), std::make_move_iterator(vector_ids_to_add.begin()),
-                           std::make_move_iterator(vector_ids_to_add.end()));
+        vector_ids_.insert(vector_ids_.end(), vector_ids_to_add, vector_ids_to_add + num_vectors_added);
     } else {
         ENGINE_LOG_ERROR << "VectorSource::Add failed: " + status.ToString();
     }
@@ -100,18 +96,15 @@ VectorSource::GetNumVectorsAdded() {
 
 size_t
 VectorSource::SingleVectorSize(uint16_t dimension) {
-    if (!vectors_.float_data_.empty()) {
-        return dimension * FLOAT_TYPE_SIZE;
-    } else if (!vectors_.binary_data_.empty()) {
-        return dimension / 8;
+    if (data_ == nullptr) {
+        return 0;
     }
-
-    return 0;
+    return binary_ ? dimension / 8 : dimension * FLOAT_TYPE_SIZE;
 }
 
 bool
 VectorSource::AllAdded() {
-    return (current_num_vectors_added == vectors_.vector_count_);
+    return (current_num_vectors_added == vector_count_);
 }
 
 IDNumbers
@@ -28,6 +28,11 @@ class VectorSource {
  public:
     explicit VectorSource(VectorsData vectors);
 
+    // the vectors and ids are not copied, they must stay valid until all vectors are added
+    VectorSource(uint64_t vector_count, const IDNumber* vector_ids, const float* vectors);
+
+    VectorSource(uint64_t vector_count, const IDNumber* vector_ids, const uint8_t* vectors);
+
     Status
     Add(/*const ExecutionEnginePtr& execution_engine,*/ const segment::SegmentWriterPtr& segment_writer_ptr,
         const meta::TableFileSchema& table_file_schema, const size_t& num_vectors_to_add, size_t& num_vectors_added);
@@ -48,6 +53,12 @@ class VectorSource {
     VectorsData vectors_;
     IDNumbers vector_ids_;
 
+    // point into vectors_, or to the data given by caller
+    uint64_t vector_count_ = 0;
+    const IDNumber* ids_ = nullptr;
+    const uint8_t* data_ = nullptr;
+    bool binary_ = false;
+
     size_t current_num_vectors_added;
 };  // VectorSource
 
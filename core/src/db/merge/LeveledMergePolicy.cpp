@@ -0,0 +1,82 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/merge/LeveledMergePolicy.h"
+
+#include <algorithm>
+
+namespace milvus {
+namespace engine {
+
+constexpr uint64_t LeveledMergePolicy::DEFAULT_FANOUT;
+constexpr uint64_t LeveledMergePolicy::DEFAULT_MAX_LEVEL;
+
+LeveledMergePolicy::LeveledMergePolicy(uint64_t fanout, uint64_t max_level)
+    : fanout_(std::max<uint64_t>(fanout, 2)), max_level_(std::max<uint64_t>(max_level, 1)) {
+}
+
+Status
+LeveledMergePolicy::Pick(const meta::TableFilesSchema& files, int64_t index_file_size, MergeFilesGroups& groups) {
+    groups.clear();
+
+    // upper bounds of file size of each level, level_bounds[0] is index_file_size
+    std::vector<int64_t> level_bounds{index_file_size};
+    for (uint64_t i = 1; i < max_level_; ++i) {
+        level_bounds.push_back(level_bounds.back() / fanout_);
+    }
+
+    // levels[i] holds files in [level_bounds[i + 1], level_bounds[i]), the last one holds all smaller files
+    std::vector<meta::TableFilesSchema> levels(max_level_);
+    std::vector<int64_t> level_sizes(max_level_, 0);
+    for (auto& file : files) {
+        uint64_t level = 0;
+        while (level + 1 < max_level_ && file.file_size_ < level_bounds[level + 1]) {
+            ++level;
+        }
+        levels[level].push_back(file);
+        level_sizes[level] += file.file_size_;
+    }
+
+    // smaller levels first, the merged files of a level belong to the level above
+    for (int64_t level = max_level_ - 1; level >= 0; --level) {
+        auto& level_files = levels[level];
+        int64_t bound = level_bounds[level];
+        if (level_files.size() < 2 || (level_sizes[level] < bound && level_files.size() < fanout_)) {
+            continue;
+        }
+
+        std::sort(level_files.begin(), level_files.end(),
+                  [](const meta::TableFileSchema& a, const meta::TableFileSchema& b) {
+                      return a.file_size_ < b.file_size_;
+                  });
+
+        // fill files of the level above, the rest stays in this level unless it is a group of fanout files
+        meta::TableFilesSchema group;
+        int64_t group_size = 0;
+        for (auto& file : level_files) {
+            group.push_back(file);
+            group_size += file.file_size_;
+            if (group_size >= bound) {
+                groups.emplace_back(std::move(group));
+                group.clear();
+                group_size = 0;
+            }
+        }
+        if (group.size() >= fanout_) {
+            groups.emplace_back(std::move(group));
+        }
+    }
+
+    return Status::OK();
+}
+
+}  // namespace engine
+}  // namespace milvus
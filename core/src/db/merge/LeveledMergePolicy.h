@@ -0,0 +1,39 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/merge/MergePolicy.h"
+
+namespace milvus {
+namespace engine {
+
+// Files are assigned to levels by size, level 1 holds files in [index_file_size / fanout, index_file_size), level 2
+// the ones fanout times smaller and so on, the last level holds all smaller files. A level is merged into files of the
+// level above once it holds enough bytes to fill one of them or has fanout files, so every vector is rewritten at most
+// once per level.
+class LeveledMergePolicy : public MergePolicy {
+ public:
+    explicit LeveledMergePolicy(uint64_t fanout = DEFAULT_FANOUT, uint64_t max_level = DEFAULT_MAX_LEVEL);
+
+    Status
+    Pick(const meta::TableFilesSchema& files, int64_t index_file_size, MergeFilesGroups& groups) override;
+
+ private:
+    static constexpr uint64_t DEFAULT_FANOUT = 10;
+    static constexpr uint64_t DEFAULT_MAX_LEVEL = 4;
+
+    uint64_t fanout_;
+    uint64_t max_level_;
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,123 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/merge/MergeManager.h"
+
+#include "db/merge/LeveledMergePolicy.h"
+#include "db/merge/SimpleMergePolicy.h"
+#include "db/merge/SizeTieredMergePolicy.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace engine {
+
+double
+MergeStats::WriteAmplification() const {
+    if (ingested_bytes_ == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(ingested_bytes_ + written_bytes_) / ingested_bytes_;
+}
+
+MergeManager::MergeManager(const meta::MetaPtr& meta, const DBOptions& options) : meta_(meta), options_(options) {
+}
+
+MergePolicyPtr
+MergeManager::CreatePolicy(int64_t table_flag, const DBOptions& options) {
+    if (table_flag & meta::FLAG_MASK_MERGE_LEVELED) {
+        return std::make_shared<LeveledMergePolicy>();
+    } else if (table_flag & meta::FLAG_MASK_MERGE_SIZE_TIERED) {
+        return std::make_shared<SizeTieredMergePolicy>(options.merge_trigger_number_);
+    }
+    return std::make_shared<SimpleMergePolicy>(options.merge_trigger_number_);
+}
+
+Status
+MergeManager::PickFiles(const std::string& table_id, MergeFilesGroups& groups) {
+    groups.clear();
+
+    meta::TableSchema table_schema;
+    table_schema.table_id_ = table_id;
+    auto status = meta_->DescribeTable(table_schema);
+    if (!status.ok()) {
+        return status;
+    }
+    if (!table_schema.owner_table_.empty()) {
+        meta::TableSchema owner_schema;
+        owner_schema.table_id_ = table_schema.owner_table_;
+        status = meta_->DescribeTable(owner_schema);
+        if (!status.ok()) {
+            return status;
+        }
+        table_schema.flag_ = owner_schema.flag_;
+    }
+
+    meta::TableFilesSchema files;
+    status = meta_->FilesToMerge(table_id, files);
+    if (!status.ok()) {
+        return status;
+    }
+
+    auto policy = CreatePolicy(table_schema.flag_, options_);
+    return policy->Pick(files, table_schema.index_file_size_, groups);
+}
+
+void
+MergeManager::RecordMerge(const std::string& table_id, const meta::TableFilesSchema& files,
+                          const meta::TableFileSchema& merged_file) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& stats = stats_[table_id];
+    auto& merged_segments = merged_segments_[table_id];
+    for (auto& file : files) {
+        stats.read_bytes_ += file.file_size_;
+        if (merged_segments.erase(file.segment_id_) == 0) {
+            stats.ingested_bytes_ += file.file_size_;
+        }
+    }
+    stats.written_bytes_ += merged_file.file_size_;
+    ++stats.merge_count_;
+    // only a raw file smaller than index_file_size can be merged again
+    if (merged_file.file_type_ == meta::TableFileSchema::RAW && merged_file.file_size_ < merged_file.index_file_size_) {
+        merged_segments.insert(merged_file.segment_id_);
+    }
+
+    ENGINE_LOG_DEBUG << "Merged " << files.size() << " files of table " << table_id << ", write amplification "
+                     << stats.WriteAmplification();
+}
+
+MergeStats
+MergeManager::GetStats(const std::string& table_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = stats_.find(table_id);
+    if (iter == stats_.end()) {
+        return MergeStats();
+    }
+    return iter->second;
+}
+
+void
+MergeManager::EraseSegment(const std::string& table_id, const std::string& segment_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = merged_segments_.find(table_id);
+    if (iter != merged_segments_.end()) {
+        iter->second.erase(segment_id);
+    }
+}
+
+void
+MergeManager::DropTable(const std::string& table_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.erase(table_id);
+    merged_segments_.erase(table_id);
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,81 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "db/Options.h"
+#include "db/merge/MergePolicy.h"
+#include "db/meta/Meta.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace engine {
+
+struct MergeStats {
+    uint64_t merge_count_ = 0;
+    // bytes of flushed segments merged for the first time
+    uint64_t ingested_bytes_ = 0;
+    uint64_t read_bytes_ = 0;
+    uint64_t written_bytes_ = 0;
+
+    // bytes written by flush and merges per byte flushed. A flushed segment is counted as ingested only the
+    // first time it is merged, flushed segments never merged are not counted at all
+    double
+    WriteAmplification() const;
+};
+
+// Picks files to merge with the merge policy of each table and keeps the merge statistics.
+// The policy is chosen by the merge flag of a table, partitions follow their owner table.
+class MergeManager {
+ public:
+    MergeManager(const meta::MetaPtr& meta, const DBOptions& options);
+
+    static MergePolicyPtr
+    CreatePolicy(int64_t table_flag, const DBOptions& options);
+
+    Status
+    PickFiles(const std::string& table_id, MergeFilesGroups& groups);
+
+    // files were merged into merged_file
+    void
+    RecordMerge(const std::string& table_id, const meta::TableFilesSchema& files,
+                const meta::TableFileSchema& merged_file);
+
+    MergeStats
+    GetStats(const std::string& table_id);
+
+    // the segment is deleted, e.g. replaced by compaction
+    void
+    EraseSegment(const std::string& table_id, const std::string& segment_id);
+
+    // forget the statistics and merged segments of a dropped table
+    void
+    DropTable(const std::string& table_id);
+
+ private:
+    meta::MetaPtr meta_;
+    DBOptions options_;
+
+    std::mutex mutex_;
+    std::map<std::string, MergeStats> stats_;
+    // segments written by merges per table, merging them again is write amplification
+    std::map<std::string, std::set<std::string>> merged_segments_;
+};
+
+using MergeManagerPtr = std::shared_ptr<MergeManager>;
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,38 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "db/meta/MetaTypes.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace engine {
+
+using MergeFilesGroups = std::vector<meta::TableFilesSchema>;
+
+// Decides which raw files of a table are merged together, each group picked is merged into one new segment.
+class MergePolicy {
+ public:
+    virtual ~MergePolicy() = default;
+
+    // files are the raw files smaller than index_file_size, in descending order of size
+    virtual Status
+    Pick(const meta::TableFilesSchema& files, int64_t index_file_size, MergeFilesGroups& groups) = 0;
+};
+
+using MergePolicyPtr = std::shared_ptr<MergePolicy>;
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,42 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/merge/SimpleMergePolicy.h"
+
+namespace milvus {
+namespace engine {
+
+SimpleMergePolicy::SimpleMergePolicy(uint64_t trigger_number) : trigger_number_(trigger_number) {
+}
+
+Status
+SimpleMergePolicy::Pick(const meta::TableFilesSchema& files, int64_t index_file_size, MergeFilesGroups& groups) {
+    groups.clear();
+    if (files.empty() || files.size() < trigger_number_) {
+        return Status::OK();
+    }
+
+    meta::TableFilesSchema group;
+    int64_t size = 0;
+    for (auto& file : files) {
+        group.push_back(file);
+        size += file.file_size_;
+        if (size >= index_file_size) {
+            break;
+        }
+    }
+    groups.emplace_back(group);
+
+    return Status::OK();
+}
+
+}  // namespace engine
+}  // namespace milvus
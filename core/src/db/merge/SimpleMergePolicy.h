@@ -0,0 +1,32 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/merge/MergePolicy.h"
+
+namespace milvus {
+namespace engine {
+
+// Once there are trigger_number files, merge the largest ones until index_file_size is reached.
+class SimpleMergePolicy : public MergePolicy {
+ public:
+    explicit SimpleMergePolicy(uint64_t trigger_number);
+
+    Status
+    Pick(const meta::TableFilesSchema& files, int64_t index_file_size, MergeFilesGroups& groups) override;
+
+ private:
+    uint64_t trigger_number_;
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,83 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/merge/SizeTieredMergePolicy.h"
+
+#include <algorithm>
+
+namespace milvus {
+namespace engine {
+
+constexpr uint64_t SizeTieredMergePolicy::DEFAULT_MAX_FILES;
+constexpr double SizeTieredMergePolicy::TIER_LOW;
+constexpr double SizeTieredMergePolicy::TIER_HIGH;
+constexpr int64_t SizeTieredMergePolicy::SMALL_FILE_RATIO;
+
+SizeTieredMergePolicy::SizeTieredMergePolicy(uint64_t min_files, uint64_t max_files)
+    : min_files_(std::max<uint64_t>(min_files, 2)), max_files_(std::max(max_files, min_files_)) {
+}
+
+Status
+SizeTieredMergePolicy::Pick(const meta::TableFilesSchema& files, int64_t index_file_size, MergeFilesGroups& groups) {
+    groups.clear();
+
+    meta::TableFilesSchema sorted_files = files;
+    std::sort(sorted_files.begin(), sorted_files.end(),
+              [](const meta::TableFileSchema& a, const meta::TableFileSchema& b) {
+                  return a.file_size_ < b.file_size_;
+              });
+
+    // sorted by size, a new tier starts when a file is out of the range of the current one
+    int64_t small_file_size = index_file_size / SMALL_FILE_RATIO;
+    std::vector<meta::TableFilesSchema> tiers;
+    int64_t tier_size = 0;
+    for (auto& file : sorted_files) {
+        if (!tiers.empty()) {
+            auto& tier = tiers.back();
+            double average = static_cast<double>(tier_size) / tier.size();
+            bool small = (file.file_size_ < small_file_size);
+            if (small || (file.file_size_ >= average * TIER_LOW && file.file_size_ <= average * TIER_HIGH)) {
+                tier.push_back(file);
+                tier_size += file.file_size_;
+                continue;
+            }
+        }
+        tiers.emplace_back(meta::TableFilesSchema{file});
+        tier_size = file.file_size_;
+    }
+
+    // split a tier into groups bounded by max_files and index_file_size, a group smaller than min_files waits
+    for (auto& tier : tiers) {
+        if (tier.size() < min_files_) {
+            continue;
+        }
+
+        meta::TableFilesSchema group;
+        int64_t group_size = 0;
+        for (auto& file : tier) {
+            group.push_back(file);
+            group_size += file.file_size_;
+            if (group.size() >= max_files_ || group_size >= index_file_size) {
+                groups.emplace_back(std::move(group));
+                group.clear();
+                group_size = 0;
+            }
+        }
+        if (group.size() >= min_files_) {
+            groups.emplace_back(std::move(group));
+        }
+    }
+
+    return Status::OK();
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,43 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/merge/MergePolicy.h"
+
+namespace milvus {
+namespace engine {
+
+// Groups files of similar size into tiers and merges a tier once it has min_files files, so a large file is not
+// rewritten again and again together with small ones. Files much smaller than index_file_size are put into one tier.
+class SizeTieredMergePolicy : public MergePolicy {
+ public:
+    explicit SizeTieredMergePolicy(uint64_t min_files, uint64_t max_files = DEFAULT_MAX_FILES);
+
+    Status
+    Pick(const meta::TableFilesSchema& files, int64_t index_file_size, MergeFilesGroups& groups) override;
+
+ private:
+    static constexpr uint64_t DEFAULT_MAX_FILES = 32;
+
+    // a file joins a tier if its size is within [low, high] times the average size of the tier
+    static constexpr double TIER_LOW = 0.5;
+    static constexpr double TIER_HIGH = 1.5;
+
+    // files smaller than index_file_size / SMALL_FILE_RATIO are all in the first tier
+    static constexpr int64_t SMALL_FILE_RATIO = 64;
+
+    uint64_t min_files_;
+    uint64_t max_files_;
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -32,6 +32,9 @@ constexpr char CURRENT_VERSION[] = MILVUS_VERSION;
 
 constexpr int64_t FLAG_MASK_NO_USERID = 0x1;
 constexpr int64_t FLAG_MASK_HAS_USERID = 0x1 << 1;
+// merge policy of the table, the simple policy is used if none is set
+constexpr int64_t FLAG_MASK_MERGE_SIZE_TIERED = 0x1 << 2;
+constexpr int64_t FLAG_MASK_MERGE_LEVELED = 0x1 << 3;
 
 using DateT = int;
 const DateT EmptyDate = -1;
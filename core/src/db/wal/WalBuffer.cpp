@@ -11,9 +11,12 @@
 
 #include "db/wal/WalBuffer.h"
 
+#include <algorithm>
 #include <cstring>
+#include <utility>
 
 #include "db/wal/WalDefinations.h"
+#include "utils/CRC32C.h"
 #include "utils/Log.h"
 
 namespace milvus {
@@ -36,6 +39,61 @@ ParserLsn(uint64_t lsn, uint32_t& file_no, uint32_t& offset) {
     offset = uint32_t(lsn & LSN_OFFSET_MASK);
 }
 
+// copy and checksum the record body piece by piece
+constexpr size_t CRC_CHUNK_SIZE = 64 * 1024;
+
+enum class RecordFormat { BAD, CURRENT, LEGACY };
+
+// a record ends at the offset of its lsn, in the file it was read from
+bool
+CheckRecordSize(const MXLogLegacyRecordHeader& head, uint32_t header_size, uint32_t read_limit, uint32_t file_no,
+                uint32_t offset) {
+    uint32_t lsn_file_no, end_offset;
+    ParserLsn(head.mxl_lsn, lsn_file_no, end_offset);
+    uint64_t record_size = (uint64_t)header_size + head.table_id_size + head.partition_tag_size +
+                           (uint64_t)head.vector_num * sizeof(IDNumber) + head.data_size;
+    return lsn_file_no == file_no && end_offset <= read_limit && end_offset >= offset &&
+           end_offset - offset == record_size;
+}
+
+// a record is good only if it is complete and its checksum matches, torn writes and garbage are rejected,
+// a record without magic is taken as legacy if its header is consistent, those records have no checksum
+RecordFormat
+CheckRecord(const char* buf, uint32_t read_limit, uint32_t file_no, uint32_t offset) {
+    if (read_limit < offset || read_limit - offset < SizeOfMXLogLegacyRecordHeader) {
+        return RecordFormat::BAD;
+    }
+
+    MXLogLegacyRecordHeader legacy_head;
+    uint32_t magic;
+    memcpy(&magic, buf, sizeof(magic));
+    if (magic != MXLOG_MAGIC) {
+        memcpy(&legacy_head, buf, SizeOfMXLogLegacyRecordHeader);
+        if (legacy_head.mxl_type >= (uint8_t)MXLogType::None ||
+            !CheckRecordSize(legacy_head, SizeOfMXLogLegacyRecordHeader, read_limit, file_no, offset)) {
+            return RecordFormat::BAD;
+        }
+        return RecordFormat::LEGACY;
+    }
+
+    if (read_limit - offset < SizeOfMXLogRecordHeader) {
+        return RecordFormat::BAD;
+    }
+    MXLogRecordHeader head;
+    memcpy(&head, buf, SizeOfMXLogRecordHeader);
+    memcpy(&legacy_head, buf + MXLogRecordCrcOffset, SizeOfMXLogLegacyRecordHeader);
+    if (head.mxl_version != MXLOG_VERSION ||
+        !CheckRecordSize(legacy_head, SizeOfMXLogRecordHeader, read_limit, file_no, offset)) {
+        return RecordFormat::BAD;
+    }
+
+    uint64_t record_size = (head.mxl_lsn & LSN_OFFSET_MASK) - offset;
+    if (CRC32C(buf + MXLogRecordCrcOffset, record_size - MXLogRecordCrcOffset) != head.mxl_crc) {
+        return RecordFormat::BAD;
+    }
+    return RecordFormat::CURRENT;
+}
+
 MXLogBuffer::MXLogBuffer(const std::string& mxlog_path, const uint32_t buffer_size)
     : mxlog_buffer_size_(buffer_size * UNIT_MB), mxlog_writer_(mxlog_path) {
 }
@@ -145,6 +203,7 @@ MXLogBuffer::Init(uint64_t start_lsn, uint64_t end_lsn) {
     }
 
     SetFileNoFrom(mxlog_buffer_reader_.file_no);
+    written_offset_ = mxlog_buffer_writer_.buf_offset;
 
     return true;
 }
@@ -153,6 +212,11 @@ void
 MXLogBuffer::Reset(uint64_t lsn) {
     WAL_LOG_DEBUG << "reset lsn " << lsn;
 
+    if (read_release_) {
+        read_release_();
+    }
+
+    std::lock_guard<std::mutex> file_lck(file_mutex_);
     buf_[0] = BufferPtr(new char[mxlog_buffer_size_]);
     buf_[1] = BufferPtr(new char[mxlog_buffer_size_]);
 
@@ -168,10 +232,16 @@ MXLogBuffer::Reset(uint64_t lsn) {
     mxlog_writer_.CloseFile();
     mxlog_writer_.SetFileName(ToFileName(mxlog_buffer_writer_.file_no));
     mxlog_writer_.SetFileOpenMode("w");
+    written_offset_ = 0;
 
     SetFileNoFrom(mxlog_buffer_reader_.file_no);
 }
 
+void
+MXLogBuffer::SetReadRelease(std::function<void()> read_release) {
+    read_release_ = std::move(read_release);
+}
+
 uint32_t
 MXLogBuffer::GetBufferSize() {
     return mxlog_buffer_size_;
@@ -194,6 +264,22 @@ MXLogBuffer::Append(MXLogRecord& record) {
     uint32_t record_size = RecordSize(record);
     if (SurplusSpace() < record_size) {
         // writer buffer has no space, switch wal file and write to a new buffer
+        std::lock_guard<std::mutex> file_lck(file_mutex_);
+
+        // the reader loads old wal files from disk, so the old file must be complete and durable
+        if (mxlog_buffer_writer_.buf_offset > written_offset_) {
+            uint32_t pending_size = mxlog_buffer_writer_.buf_offset - written_offset_;
+            char* pending_buf = buf_[mxlog_buffer_writer_.buf_idx].get() + written_offset_;
+            if (!mxlog_writer_.WriteAt(pending_buf, written_offset_, pending_size)) {
+                WAL_LOG_ERROR << "write wal file error " << mxlog_buffer_writer_.file_no;
+                return WAL_FILE_ERROR;
+            }
+        }
+        if (!mxlog_writer_.Sync()) {
+            WAL_LOG_ERROR << "sync wal file error " << mxlog_buffer_writer_.file_no;
+            return WAL_FILE_ERROR;
+        }
+
         std::unique_lock<std::mutex> lck(mutex_);
         if (mxlog_buffer_writer_.buf_idx == mxlog_buffer_reader_.buf_idx) {
             // swith writer buffer
@@ -203,6 +289,7 @@ MXLogBuffer::Append(MXLogRecord& record) {
         mxlog_buffer_writer_.file_no++;
         mxlog_buffer_writer_.buf_offset = 0;
         lck.unlock();
+        written_offset_ = 0;
 
         // Reborn means close old wal file and open new wal file
         if (!mxlog_writer_.ReBorn(ToFileName(mxlog_buffer_writer_.file_no), "w")) {
@@ -216,6 +303,9 @@ MXLogBuffer::Append(MXLogRecord& record) {
     uint32_t current_write_offset = mxlog_buffer_writer_.buf_offset;
 
     MXLogRecordHeader head;
+    head.mxl_magic = MXLOG_MAGIC;
+    head.mxl_version = MXLOG_VERSION;
+    head.mxl_crc = 0;
     BuildLsn(mxlog_buffer_writer_.file_no, mxlog_buffer_writer_.buf_offset + (uint32_t)record_size, head.mxl_lsn);
     head.mxl_type = (uint8_t)record.type;
     head.table_id_size = (uint16_t)record.table_id.size();
@@ -223,40 +313,77 @@ MXLogBuffer::Append(MXLogRecord& record) {
     head.vector_num = record.length;
     head.data_size = record.data_size;
 
+    // checksum each piece right after it is copied, while it is still in cache
+    uint32_t crc = CRC32C(reinterpret_cast<const char*>(&head) + MXLogRecordCrcOffset,
+                          SizeOfMXLogRecordHeader - MXLogRecordCrcOffset);
     memcpy(current_write_buf + current_write_offset, &head, SizeOfMXLogRecordHeader);
+    char* head_buf = current_write_buf + current_write_offset;
     current_write_offset += SizeOfMXLogRecordHeader;
 
+    auto copy_data = [&](const void* data, size_t size) {
+        const char* src = static_cast<const char*>(data);
+        while (size > 0) {
+            size_t chunk_size = std::min(size, CRC_CHUNK_SIZE);
+            memcpy(current_write_buf + current_write_offset, src, chunk_size);
+            crc = CRC32C(current_write_buf + current_write_offset, chunk_size, crc);
+            current_write_offset += chunk_size;
+            src += chunk_size;
+            size -= chunk_size;
+        }
+    };
+
     if (!record.table_id.empty()) {
-        memcpy(current_write_buf + current_write_offset, record.table_id.data(), record.table_id.size());
-        current_write_offset += record.table_id.size();
+        copy_data(record.table_id.data(), record.table_id.size());
     }
 
     if (!record.partition_tag.empty()) {
-        memcpy(current_write_buf + current_write_offset, record.partition_tag.data(), record.partition_tag.size());
-        current_write_offset += record.partition_tag.size();
+        copy_data(record.partition_tag.data(), record.partition_tag.size());
     }
     if (record.ids != nullptr && record.length > 0) {
-        memcpy(current_write_buf + current_write_offset, record.ids, record.length * sizeof(IDNumber));
-        current_write_offset += record.length * sizeof(IDNumber);
+        copy_data(record.ids, record.length * sizeof(IDNumber));
     }
 
     if (record.data != nullptr && record.data_size > 0) {
-        memcpy(current_write_buf + current_write_offset, record.data, record.data_size);
-        current_write_offset += record.data_size;
+        copy_data(record.data, record.data_size);
     }
 
-    bool write_rst = mxlog_writer_.Write(current_write_buf + mxlog_buffer_writer_.buf_offset, record_size);
-    if (!write_rst) {
-        WAL_LOG_ERROR << "write wal file error";
-        return WAL_FILE_ERROR;
-    }
+    memcpy(head_buf + offsetof(MXLogRecordHeader, mxl_crc), &crc, sizeof(crc));
 
+    std::lock_guard<std::mutex> lck(mutex_);
     mxlog_buffer_writer_.buf_offset = current_write_offset;
 
     record.lsn = head.mxl_lsn;
     return WAL_SUCCESS;
 }
 
+ErrorCode
+MXLogBuffer::Flush(bool sync, uint64_t& written_lsn) {
+    std::lock_guard<std::mutex> file_lck(file_mutex_);
+
+    // records appended after the snapshot are written by the next flush
+    std::unique_lock<std::mutex> lck(mutex_);
+    uint32_t file_no = mxlog_buffer_writer_.file_no;
+    uint32_t buf_offset = mxlog_buffer_writer_.buf_offset;
+    char* write_buf = buf_[mxlog_buffer_writer_.buf_idx].get();
+    lck.unlock();
+
+    if (buf_offset > written_offset_) {
+        if (!mxlog_writer_.WriteAt(write_buf + written_offset_, written_offset_, buf_offset - written_offset_)) {
+            WAL_LOG_ERROR << "write wal file error " << file_no;
+            return WAL_FILE_ERROR;
+        }
+        written_offset_ = buf_offset;
+    }
+
+    if (sync && !mxlog_writer_.Sync()) {
+        WAL_LOG_ERROR << "sync wal file error " << file_no;
+        return WAL_FILE_ERROR;
+    }
+
+    BuildLsn(file_no, buf_offset, written_lsn);
+    return WAL_SUCCESS;
+}
+
 ErrorCode
 MXLogBuffer::Next(const uint64_t last_applied_lsn, MXLogRecord& record) {
     // init output
@@ -272,6 +399,13 @@ MXLogBuffer::Next(const uint64_t last_applied_lsn, MXLogRecord& record) {
     std::unique_lock<std::mutex> lck(mutex_);
     if (mxlog_buffer_reader_.file_no != mxlog_buffer_writer_.file_no) {
         if (mxlog_buffer_reader_.buf_offset == mxlog_buffer_reader_.max_offset) {  // last record
+            if (read_release_) {
+                // the writer may switch into the buffer once the reader leaves it
+                // only the reader moves the reader handler, the writer file No. never goes back
+                lck.unlock();
+                read_release_();
+                lck.lock();
+            }
             mxlog_buffer_reader_.file_no++;
             mxlog_buffer_reader_.buf_offset = 0;
             need_load_new = (mxlog_buffer_reader_.file_no != mxlog_buffer_writer_.file_no);
@@ -295,16 +429,34 @@ MXLogBuffer::Next(const uint64_t last_applied_lsn, MXLogRecord& record) {
         mxlog_buffer_reader_.max_offset = file_size;
     }
 
+    lck.lock();
+    uint32_t read_limit = (mxlog_buffer_reader_.file_no == mxlog_buffer_writer_.file_no)
+                              ? mxlog_buffer_writer_.buf_offset
+                              : mxlog_buffer_reader_.max_offset;
+    lck.unlock();
+
     char* current_read_buf = buf_[mxlog_buffer_reader_.buf_idx].get();
     uint64_t current_read_offset = mxlog_buffer_reader_.buf_offset;
 
-    MXLogRecordHeader* head = (MXLogRecordHeader*)(current_read_buf + current_read_offset);
+    auto format = CheckRecord(current_read_buf + current_read_offset, read_limit, mxlog_buffer_reader_.file_no,
+                              mxlog_buffer_reader_.buf_offset);
+    if (format == RecordFormat::BAD) {
+        WAL_LOG_WARNING << "bad wal record in file " << mxlog_buffer_reader_.file_no << " offset "
+                        << mxlog_buffer_reader_.buf_offset;
+        return WAL_DATA_ERROR;
+    }
+
+    // the fields of both formats are read from the legacy part of the header
+    if (format == RecordFormat::CURRENT) {
+        current_read_offset += MXLogRecordCrcOffset;
+    }
+    MXLogLegacyRecordHeader* head = (MXLogLegacyRecordHeader*)(current_read_buf + current_read_offset);
     record.type = (MXLogType)head->mxl_type;
     record.lsn = head->mxl_lsn;
     record.length = head->vector_num;
     record.data_size = head->data_size;
 
-    current_read_offset += SizeOfMXLogRecordHeader;
+    current_read_offset += SizeOfMXLogLegacyRecordHeader;
 
     if (head->table_id_size != 0) {
         record.table_id.assign(current_read_buf + current_read_offset, head->table_id_size);
@@ -348,17 +500,29 @@ bool
 MXLogBuffer::ResetWriteLsn(uint64_t lsn) {
     WAL_LOG_INFO << "reset write lsn " << lsn;
 
+    std::lock_guard<std::mutex> file_lck(file_mutex_);
     int32_t old_file_no = mxlog_buffer_writer_.file_no;
     ParserLsn(lsn, mxlog_buffer_writer_.file_no, mxlog_buffer_writer_.buf_offset);
     if (old_file_no == mxlog_buffer_writer_.file_no) {
+        written_offset_ = std::min(written_offset_, mxlog_buffer_writer_.buf_offset);
         WAL_LOG_DEBUG << "file No. is not changed";
         return true;
     }
 
+    // older wal files are complete on disk
+    written_offset_ = mxlog_buffer_writer_.buf_offset;
+
     std::unique_lock<std::mutex> lck(mutex_);
     if (mxlog_buffer_writer_.file_no == mxlog_buffer_reader_.file_no) {
         mxlog_buffer_writer_.buf_idx = mxlog_buffer_reader_.buf_idx;
+        lck.unlock();
         WAL_LOG_DEBUG << "file No. is the same as reader";
+
+        // the data is in the reader buffer already, only reopen the wal file
+        if (!mxlog_writer_.ReBorn(ToFileName(mxlog_buffer_writer_.file_no), "r+")) {
+            WAL_LOG_ERROR << "reborn file error " << mxlog_buffer_writer_.file_no;
+            return false;
+        }
         return true;
     }
     lck.unlock();
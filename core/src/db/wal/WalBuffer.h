@@ -12,6 +12,8 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -28,7 +30,13 @@ namespace wal {
 #pragma pack(push)
 #pragma pack(1)
 
+const uint32_t MXLOG_MAGIC = 0x474C584D;  // "MXLG"
+const uint8_t MXLOG_VERSION = 1;
+
 struct MXLogRecordHeader {
+    uint32_t mxl_magic;    // MXLOG_MAGIC, tells a record from garbage
+    uint8_t mxl_version;   // record format version
+    uint32_t mxl_crc;      // crc32c of the rest of the header and the record body
     uint64_t mxl_lsn;  // log sequence number (high 32 bits: file No. inc by 1, low 32 bits: offset in file, max 4GB)
     uint8_t mxl_type;  // record type, insert/delete/update/flush...
     uint16_t table_id_size;
@@ -38,6 +46,23 @@ struct MXLogRecordHeader {
 };
 
 const uint32_t SizeOfMXLogRecordHeader = sizeof(MXLogRecordHeader);
+// the checksum covers the record from here to its end
+const uint32_t MXLogRecordCrcOffset = offsetof(MXLogRecordHeader, mxl_lsn);
+
+// header of records written before records had a checksum, the same as MXLogRecordHeader from mxl_lsn on,
+// such records are still replayed so the wal of an older version isn't lost on upgrade
+struct MXLogLegacyRecordHeader {
+    uint64_t mxl_lsn;
+    uint8_t mxl_type;
+    uint16_t table_id_size;
+    uint16_t partition_tag_size;
+    uint32_t vector_num;
+    uint32_t data_size;
+};
+
+const uint32_t SizeOfMXLogLegacyRecordHeader = sizeof(MXLogLegacyRecordHeader);
+static_assert(SizeOfMXLogRecordHeader - MXLogRecordCrcOffset == SizeOfMXLogLegacyRecordHeader,
+              "MXLogRecordHeader must end with the legacy record header");
 
 #pragma pack(pop)
 
@@ -63,9 +88,16 @@ class MXLogBuffer {
     Reset(uint64_t lsn);
 
     // Note: record.lsn will be set inner
+    // the record is only copied into the buffer, call Flush() to write it into wal file
     ErrorCode
     Append(MXLogRecord& record);
 
+    // write all appended records into wal file, sync the file if required
+    // written_lsn is set to the lsn of the last written record
+    ErrorCode
+    Flush(bool sync, uint64_t& written_lsn);
+
+    // return WAL_DATA_ERROR if the next record is torn or corrupted, the read lsn stays before it
     ErrorCode
     Next(const uint64_t last_applied_lsn, MXLogRecord& record);
 
@@ -87,6 +119,11 @@ class MXLogBuffer {
     uint32_t
     SurplusSpace();
 
+    // called by the reader before its buffer is reused or reset, records returned by Next()
+    // point into the buffer and stay valid until then
+    void
+    SetReadRelease(std::function<void()> read_release);
+
  private:
     uint32_t
     RecordSize(const MXLogRecord& record);
@@ -95,10 +132,13 @@ class MXLogBuffer {
     uint32_t mxlog_buffer_size_;  // from config
     BufferPtr buf_[2];
     std::mutex mutex_;
+    std::mutex file_mutex_;       // protect mxlog_writer_ and written_offset_
+    uint32_t written_offset_ = 0;  // data before this offset of the writer file is in wal file
     uint32_t file_no_from_;
     MXLogBufferHandler mxlog_buffer_reader_;
     MXLogBufferHandler mxlog_buffer_writer_;
     MXLogFileHandler mxlog_writer_;
+    std::function<void()> read_release_;  // only used by the reader thread
 };
 
 using MXLogBufferPtr = std::shared_ptr<MXLogBuffer>;
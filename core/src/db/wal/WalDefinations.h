@@ -41,10 +41,19 @@ struct MXLogRecord {
     const void* data;
 };
 
+// when a write request returns, its records are
+//   None: copied into the wal buffer, written to file in background
+//   Flush: written to file (page cache)
+//   Fsync: written to file and synced to disk
+//   FsyncInterval: written to file, the file is synced every sync_interval milliseconds
+enum class MXLogDurability { None, Flush, Fsync, FsyncInterval };
+
 struct MXLogConfiguration {
     bool recovery_error_ignore;
     uint32_t buffer_size;
     std::string mxlog_path;
+    MXLogDurability durability = MXLogDurability::Flush;
+    uint32_t sync_interval = 1000;  // milliseconds
 };
 
 }  // namespace wal
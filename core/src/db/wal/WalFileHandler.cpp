@@ -71,6 +71,29 @@ MXLogFileHandler::Write(char* buf, uint32_t data_size, bool is_sync) {
     return (written_size == data_size);
 }
 
+bool
+MXLogFileHandler::WriteAt(const char* buf, uint32_t data_offset, uint32_t data_size) {
+    if (!OpenFile()) {
+        return false;
+    }
+    if (data_size == 0) {
+        return true;
+    }
+    if (fseek(p_file_, data_offset, SEEK_SET) != 0) {
+        return false;
+    }
+    uint32_t written_size = fwrite(buf, 1, data_size, p_file_);
+    return (written_size == data_size) && (fflush(p_file_) == 0);
+}
+
+bool
+MXLogFileHandler::Sync() {
+    if (p_file_ == nullptr) {
+        return true;
+    }
+    return fdatasync(fileno(p_file_)) == 0;
+}
+
 bool
 MXLogFileHandler::ReBorn(const std::string& file_name, const std::string& open_mode) {
     CloseFile();
@@ -14,7 +14,9 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
+#include <utility>
 
 #include "config/Config.h"
 #include "utils/CommonUtil.h"
@@ -32,6 +34,8 @@ WalManager::WalManager(const MXLogConfiguration& config) {
     mxlog_config_.recovery_error_ignore = config.recovery_error_ignore;
     mxlog_config_.buffer_size = config.buffer_size;
     mxlog_config_.mxlog_path = config.mxlog_path;
+    mxlog_config_.durability = config.durability;
+    mxlog_config_.sync_interval = std::max(config.sync_interval, (uint32_t)1);
 
     // check the path end with '/'
     if (mxlog_config_.mxlog_path.back() != '/') {
@@ -47,6 +51,7 @@ WalManager::WalManager(const MXLogConfiguration& config) {
 }
 
 WalManager::~WalManager() {
+    StopSyncThread();
 }
 
 ErrorCode
@@ -116,6 +121,12 @@ WalManager::Init(const meta::MetaPtr& meta) {
     mxlog_config_.buffer_size = p_buffer_->GetBufferSize();
 
     last_applied_lsn_ = applied_lsn;
+    if (error_code == WAL_SUCCESS) {
+        appended_lsn_ = applied_lsn;
+        written_lsn_ = applied_lsn;
+        synced_lsn_ = applied_lsn;
+        StartSyncThread();
+    }
     return error_code;
 }
 
@@ -124,6 +135,12 @@ WalManager::GetNextRecovery(MXLogRecord& record) {
     ErrorCode error_code = WAL_SUCCESS;
     while (true) {
         error_code = p_buffer_->Next(last_applied_lsn_, record);
+        if (error_code == WAL_DATA_ERROR) {
+            // a torn or corrupted record, the log ends before it
+            error_code = Truncate(p_buffer_->GetReadLsn());
+            record.type = MXLogType::None;
+            break;
+        }
         if (error_code != WAL_SUCCESS) {
             if (mxlog_config_.recovery_error_ignore) {
                 // reset and break recovery
@@ -154,6 +171,19 @@ WalManager::GetNextRecovery(MXLogRecord& record) {
     return error_code;
 }
 
+uint64_t
+WalManager::GetRecoverySize() {
+    uint64_t read_lsn = p_buffer_->GetReadLsn();
+    uint64_t end_lsn = last_applied_lsn_;
+    if (read_lsn >= end_lsn) {
+        return 0;
+    }
+
+    // a wal file holds one buffer of records at most
+    uint64_t file_count = (end_lsn >> 32) - (read_lsn >> 32);
+    return file_count * p_buffer_->GetBufferSize() + (end_lsn & 0xffffffff) - (read_lsn & 0xffffffff);
+}
+
 ErrorCode
 WalManager::GetNextRecord(MXLogRecord& record) {
     auto check_flush = [&]() -> bool {
@@ -254,6 +284,7 @@ WalManager::Insert(const std::string& table_id, const std::string& partition_tag
     record.table_id = table_id;
     record.partition_tag = partition_tag;
 
+    std::unique_lock<std::mutex> append_lck(append_mutex_);
     uint64_t new_lsn = 0;
     for (size_t i = 0; i < vector_num; i += record.length) {
         size_t surplus_space = p_buffer_->SurplusSpace();
@@ -288,10 +319,11 @@ WalManager::Insert(const std::string& table_id, const std::string& partition_tag
         it->second.wal_lsn = new_lsn;
     }
     lck.unlock();
+    append_lck.unlock();
 
     WAL_LOG_INFO << table_id << " insert in part " << partition_tag << " with lsn " << new_lsn;
 
-    return p_meta_handler_->SetMXLogInternalMeta(new_lsn);
+    return WaitDurable(new_lsn) == WAL_SUCCESS;
 }
 
 bool
@@ -310,6 +342,7 @@ WalManager::DeleteById(const std::string& table_id, const IDNumbers& vector_ids)
     record.table_id = table_id;
     record.partition_tag = "";
 
+    std::unique_lock<std::mutex> append_lck(append_mutex_);
     uint64_t new_lsn = 0;
     for (size_t i = 0; i < vector_num; i += record.length) {
         size_t surplus_space = p_buffer_->SurplusSpace();
@@ -340,10 +373,11 @@ WalManager::DeleteById(const std::string& table_id, const IDNumbers& vector_ids)
         it->second.wal_lsn = new_lsn;
     }
     lck.unlock();
+    append_lck.unlock();
 
     WAL_LOG_INFO << table_id << " delete rows by id, lsn " << new_lsn;
 
-    return p_meta_handler_->SetMXLogInternalMeta(new_lsn);
+    return WaitDurable(new_lsn) == WAL_SUCCESS;
 }
 
 uint64_t
@@ -390,6 +424,144 @@ WalManager::RemoveOldFiles(uint64_t flushed_lsn) {
     }
 }
 
+void
+WalManager::SetReadRelease(std::function<void()> read_release) {
+    if (p_buffer_ != nullptr) {
+        p_buffer_->SetReadRelease(std::move(read_release));
+    }
+}
+
+ErrorCode
+WalManager::Truncate(uint64_t lsn) {
+    WAL_LOG_WARNING << "drop wal records from lsn " << lsn << " to " << last_applied_lsn_;
+
+    // the sync thread starts again from the truncated position
+    StopSyncThread();
+
+    // new records overwrite the bad ones
+    if (!p_buffer_->ResetWriteLsn(lsn)) {
+        return WAL_FILE_ERROR;
+    }
+    if (!p_meta_handler_->SetMXLogInternalMeta(lsn, true)) {
+        return WAL_META_ERROR;
+    }
+
+    std::unique_lock<std::mutex> lck(mutex_);
+    last_applied_lsn_ = lsn;
+    for (auto& it : tables_) {
+        it.second.wal_lsn = std::min(it.second.wal_lsn, lsn);
+    }
+    lck.unlock();
+
+    appended_lsn_ = lsn;
+    written_lsn_ = lsn;
+    synced_lsn_ = lsn;
+    StartSyncThread();
+
+    return WAL_SUCCESS;
+}
+
+void
+WalManager::StartSyncThread() {
+    if (sync_thread_.joinable()) {
+        return;
+    }
+    sync_stop_ = false;
+    sync_error_ = WAL_SUCCESS;
+    sync_thread_ = std::thread(&WalManager::SyncWorker, this);
+}
+
+void
+WalManager::StopSyncThread() {
+    std::unique_lock<std::mutex> lck(sync_mutex_);
+    sync_stop_ = true;
+    lck.unlock();
+    sync_cv_.notify_one();
+
+    if (sync_thread_.joinable()) {
+        sync_thread_.join();
+    }
+}
+
+void
+WalManager::SyncWorker() {
+    auto durability = mxlog_config_.durability;
+    auto interval = std::chrono::milliseconds(mxlog_config_.sync_interval);
+    auto last_sync_time = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lck(sync_mutex_);
+    uint64_t meta_lsn = written_lsn_;
+    bool meta_synced = true;
+    auto has_pending = [&]() -> bool { return sync_stop_ || appended_lsn_ > written_lsn_; };
+
+    while (true) {
+        if (durability == MXLogDurability::None) {
+            // nobody waits for the records, write them every interval
+            sync_cv_.wait_for(lck, interval, [&]() -> bool { return sync_stop_; });
+        } else if (durability == MXLogDurability::FsyncInterval) {
+            sync_cv_.wait_until(lck, last_sync_time + interval, has_pending);
+        } else {
+            sync_cv_.wait(lck, has_pending);
+        }
+        bool stop = sync_stop_;
+        lck.unlock();
+
+        // writers blocked during the last write (and sync) are served together by this one
+        auto now = std::chrono::steady_clock::now();
+        bool sync = stop || durability == MXLogDurability::Fsync ||
+                    (durability == MXLogDurability::FsyncInterval && now >= last_sync_time + interval);
+
+        uint64_t lsn = 0;
+        auto error_code = p_buffer_->Flush(sync, lsn);
+        if (error_code == WAL_SUCCESS && (lsn != meta_lsn || (sync && !meta_synced))) {
+            if (p_meta_handler_->SetMXLogInternalMeta(lsn, sync)) {
+                meta_lsn = lsn;
+                meta_synced = sync;
+            } else {
+                WAL_LOG_ERROR << "write wal meta error, lsn " << lsn;
+                error_code = WAL_META_ERROR;
+            }
+        }
+        if (sync) {
+            last_sync_time = now;
+        }
+
+        lck.lock();
+        if (error_code != WAL_SUCCESS) {
+            sync_error_ = error_code;
+        } else {
+            written_lsn_ = std::max(written_lsn_, lsn);
+            if (sync) {
+                synced_lsn_ = written_lsn_;
+            }
+        }
+        durable_cv_.notify_all();
+
+        if (stop || error_code != WAL_SUCCESS) {
+            break;
+        }
+    }
+}
+
+ErrorCode
+WalManager::WaitDurable(uint64_t lsn) {
+    std::unique_lock<std::mutex> lck(sync_mutex_);
+    appended_lsn_ = std::max(appended_lsn_, lsn);
+    if (mxlog_config_.durability == MXLogDurability::None) {
+        return sync_error_;
+    }
+    sync_cv_.notify_one();
+
+    bool need_sync = (mxlog_config_.durability == MXLogDurability::Fsync);
+    auto is_durable = [&]() -> bool { return (need_sync ? synced_lsn_ : written_lsn_) >= lsn; };
+    durable_cv_.wait(lck, [&]() -> bool { return sync_error_ != WAL_SUCCESS || sync_stop_ || is_durable(); });
+
+    if (sync_error_ == WAL_SUCCESS && !is_durable()) {
+        return WAL_ERROR;
+    }
+    return sync_error_;
+}
+
 template bool
 WalManager::Insert<float>(const std::string& table_id, const std::string& partition_tag, const IDNumbers& vector_ids,
                           const std::vector<float>& vectors);
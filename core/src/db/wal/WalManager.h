@@ -12,8 +12,12 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -48,6 +52,13 @@ class WalManager {
     ErrorCode
     GetNextRecovery(MXLogRecord& record);
 
+    /*
+     * Get the size of records left to recover
+     * @retval bytes, estimated by wal file size
+     */
+    uint64_t
+    GetRecoverySize();
+
     /*
      * Get next record
      * @param record[out]: record
@@ -112,10 +123,36 @@ class WalManager {
     void
     RemoveOldFiles(uint64_t flushed_lsn);
 
+    /*
+     * Set the callback run before the buffer of read records is reused
+     * @param read_release: waits until the records got from GetNextRecovery/GetNextRecord are used up
+     */
+    void
+    SetReadRelease(std::function<void()> read_release);
+
  private:
     WalManager
     operator=(WalManager&);
 
+    // background thread writing appended records into wal file, one write (and sync) covers
+    // all the records appended since the last one
+    void
+    StartSyncThread();
+
+    void
+    StopSyncThread();
+
+    void
+    SyncWorker();
+
+    // drop the records after lsn, used when recovery meets a bad record
+    ErrorCode
+    Truncate(uint64_t lsn);
+
+    // block until the records before lsn reach the configured durability
+    ErrorCode
+    WaitDurable(uint64_t lsn);
+
     MXLogConfiguration mxlog_config_;
 
     MXLogBufferPtr p_buffer_;
@@ -129,6 +166,19 @@ class WalManager {
     std::map<std::string, TableLsn> tables_;
     std::atomic<uint64_t> last_applied_lsn_;
 
+    // serialize appending records into buffer
+    std::mutex append_mutex_;
+
+    std::thread sync_thread_;
+    std::mutex sync_mutex_;
+    std::condition_variable sync_cv_;     // wake up the sync thread
+    std::condition_variable durable_cv_;  // wake up the writers waiting for durability
+    uint64_t appended_lsn_ = 0;
+    uint64_t written_lsn_ = 0;
+    uint64_t synced_lsn_ = 0;
+    bool sync_stop_ = true;  // the sync thread is not running
+    ErrorCode sync_error_ = WAL_SUCCESS;
+
     // if multi-thread call Flush(), use list
     struct FlushInfo {
         std::string table_id_;
@@ -11,6 +11,8 @@
 
 #include "db/wal/WalMetaHandler.h"
 
+#include <unistd.h>
+
 #include <cstring>
 
 namespace milvus {
@@ -51,13 +53,16 @@ MXLogMetaHandler::GetMXLogInternalMeta(uint64_t& wal_lsn) {
 }
 
 bool
-MXLogMetaHandler::SetMXLogInternalMeta(uint64_t wal_lsn) {
+MXLogMetaHandler::SetMXLogInternalMeta(uint64_t wal_lsn, bool sync) {
     if (wal_meta_fp_ != nullptr) {
         uint64_t all_wal_lsn[3] = {latest_wal_lsn_, wal_lsn, wal_lsn};
         fseek(wal_meta_fp_, 0, SEEK_SET);
         auto rt_val = fwrite(&all_wal_lsn, sizeof(all_wal_lsn), 1, wal_meta_fp_);
         if (rt_val == 1) {
             fflush(wal_meta_fp_);
+            if (sync) {
+                fdatasync(fileno(wal_meta_fp_));
+            }
             latest_wal_lsn_ = wal_lsn;
             return true;
         }
@@ -36,7 +36,7 @@ class MXLogMetaHandler {
     GetMXLogInternalMeta(uint64_t& wal_lsn);
 
     bool
-    SetMXLogInternalMeta(uint64_t wal_lsn);
+    SetMXLogInternalMeta(uint64_t wal_lsn, bool sync = false);
 
  private:
     FILE* wal_meta_fp_;
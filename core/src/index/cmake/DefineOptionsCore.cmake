@@ -90,6 +90,9 @@ else ()
     define_option(KNOWHERE_BUILD_TESTS "Build the KNOWHERE googletest unit tests" OFF)
 endif (BUILD_UNIT_TEST)
 
+define_option(KNOWHERE_BUILD_HDF5_BENCHMARK "Build the FAISS benchmark on ann-benchmarks HDF5 data \
+(needs GPU version and HDF5 in /usr/local/hdf5)" OFF)
+
 #----------------------------------------------------------------------
 macro(config_summary)
     message(STATUS "---------------------------------------------------------------------")
@@ -47,11 +47,13 @@ void
 FaissBaseBinaryIndex::LoadImpl(const BinarySet& index_binary) {
     auto binary = index_binary.GetByName("BinaryIVF");
 
-    MemoryIOReader reader;
+    // inverted lists are referenced in place, the binary stays alive as long as the index
+    faiss::MappedIOReader reader;
     reader.total = binary->size;
-    reader.data_ = binary->data.get();
+    reader.data = binary->data.get();
+    reader.owner = binary->data;
 
-    faiss::IndexBinary* index = faiss::read_index_binary(&reader);
+    faiss::IndexBinary* index = faiss::read_index_binary(&reader, faiss::IO_FLAG_MMAP);
 
     index_.reset(index);
 }
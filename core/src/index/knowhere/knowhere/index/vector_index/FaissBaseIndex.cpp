@@ -50,11 +50,13 @@ void
 FaissBaseIndex::LoadImpl(const BinarySet& index_binary) {
     auto binary = index_binary.GetByName("IVF");
 
-    MemoryIOReader reader;
+    // inverted lists are referenced in place, the binary stays alive as long as the index
+    faiss::MappedIOReader reader;
     reader.total = binary->size;
-    reader.data_ = binary->data.get();
+    reader.data = binary->data.get();
+    reader.owner = binary->data;
 
-    faiss::Index* index = faiss::read_index(&reader);
+    faiss::Index* index = faiss::read_index(&reader, faiss::IO_FLAG_MMAP);
 
     index_.reset(index);
 
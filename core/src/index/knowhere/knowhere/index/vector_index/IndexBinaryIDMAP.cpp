@@ -15,6 +15,8 @@
 #include <faiss/MetaIndexes.h>
 #include <faiss/index_factory.h>
 
+#include <memory>
+#include <numeric>
 #include <string>
 
 #include "knowhere/adapter/VectorAdapter.h"
@@ -74,7 +76,7 @@ void
 BinaryIDMAP::search_impl(int64_t n, const uint8_t* data, int64_t k, float* distances, int64_t* labels,
                          const Config& cfg) {
     int32_t* pdistances = (int32_t*)distances;
-    index_->search(n, (uint8_t*)data, k, pdistances, labels, bitset_);
+    index_->search(n, (uint8_t*)data, k, pdistances, labels, std::atomic_load(&bitset_));
 }
 
 void
@@ -98,6 +100,27 @@ BinaryIDMAP::Train(const Config& config) {
     index_.reset(index);
 }
 
+uint8_t*
+BinaryIDMAP::AllocRawVectors(int64_t rows) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto id_index = dynamic_cast<faiss::IndexBinaryIDMap*>(index_.get());
+    auto flat_index = id_index ? dynamic_cast<faiss::IndexBinaryFlat*>(id_index->index) : nullptr;
+    if (flat_index == nullptr) {
+        KNOWHERE_THROW_MSG("index is not a binary flat id map");
+    }
+
+    flat_index->xb.resize(rows * flat_index->code_size);
+    flat_index->ntotal = rows;
+    id_index->id_map.resize(rows);
+    std::iota(id_index->id_map.begin(), id_index->id_map.end(), 0);
+    id_index->ntotal = rows;
+    return flat_index->xb.data();
+}
+
 int64_t
 BinaryIDMAP::Count() {
     return index_->ntotal;
@@ -165,7 +188,7 @@ BinaryIDMAP::GetVectorById(const DatasetPtr& dataset, const Config& config) {
     size_t p_x_size = sizeof(uint8_t) * elems;
     auto p_x = (uint8_t*)malloc(p_x_size);
 
-    index_->get_vector_by_id(1, p_data, p_x, bitset_);
+    index_->get_vector_by_id(1, p_data, p_x, std::atomic_load(&bitset_));
 
     auto ret_ds = std::make_shared<Dataset>();
     ret_ds->Set(meta::TENSOR, p_x);
@@ -189,7 +212,7 @@ BinaryIDMAP::SearchById(const DatasetPtr& dataset, const Config& config) {
     auto p_dist = (float*)malloc(p_dist_size);
 
     auto* pdistances = (int32_t*)p_dist;
-    index_->search_by_id(rows, p_data, config[meta::TOPK].get<int64_t>(), pdistances, p_id, bitset_);
+    index_->search_by_id(rows, p_data, config[meta::TOPK].get<int64_t>(), pdistances, p_id, std::atomic_load(&bitset_));
 
     auto ret_ds = std::make_shared<Dataset>();
     if (index_->metric_type == faiss::METRIC_Hamming) {
@@ -211,12 +234,12 @@ BinaryIDMAP::SearchById(const DatasetPtr& dataset, const Config& config) {
 
 void
 BinaryIDMAP::SetBlacklist(faiss::ConcurrentBitsetPtr list) {
-    bitset_ = std::move(list);
+    std::atomic_store(&bitset_, std::move(list));
 }
 
 void
 BinaryIDMAP::GetBlacklist(faiss::ConcurrentBitsetPtr& list) {
-    list = bitset_;
+    list = std::atomic_load(&bitset_);
 }
 
 }  // namespace knowhere
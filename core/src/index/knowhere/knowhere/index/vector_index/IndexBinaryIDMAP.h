@@ -45,6 +45,11 @@ class BinaryIDMAP : public VectorIndex, public FaissBaseBinaryIndex {
     void
     AddWithoutId(const DatasetPtr& dataset, const Config& config);
 
+    // size the index for rows vectors with ids 0..rows-1 and return its storage to be filled in place,
+    // so raw data is loaded without a copy through a dataset
+    uint8_t*
+    AllocRawVectors(int64_t rows);
+
     void
     Train(const Config& config);
 
@@ -15,11 +15,15 @@
 #include <faiss/IndexBinaryIVF.h>
 
 #include <chrono>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
 #include "knowhere/common/Log.h"
+#include "knowhere/index/vector_index/helpers/InvertedListsCompact.h"
 
 namespace knowhere {
 
@@ -91,7 +95,8 @@ BinaryIVF::search_impl(int64_t n, const uint8_t* data, int64_t k, float* distanc
     stdclock::time_point before = stdclock::now();
 
     // todo: remove static cast (zhiru)
-    static_cast<faiss::IndexBinary*>(index_.get())->search(n, (uint8_t*)data, k, pdistances, labels, bitset_);
+    static_cast<faiss::IndexBinary*>(index_.get())
+        ->search(n, (uint8_t*)data, k, pdistances, labels, std::atomic_load(&bitset_));
 
     stdclock::time_point after = stdclock::now();
     double search_cost = (std::chrono::duration<double, std::micro>(after - before)).count();
@@ -160,7 +165,7 @@ BinaryIVF::GetVectorById(const DatasetPtr& dataset, const Config& config) {
         size_t p_x_size = sizeof(uint8_t) * elems;
         auto p_x = (uint8_t*)malloc(p_x_size);
 
-        index_->get_vector_by_id(1, p_data, p_x, bitset_);
+        index_->get_vector_by_id(1, p_data, p_x, std::atomic_load(&bitset_));
 
         auto ret_ds = std::make_shared<Dataset>();
         ret_ds->Set(meta::TENSOR, p_x);
@@ -190,7 +195,8 @@ BinaryIVF::SearchById(const DatasetPtr& dataset, const Config& config) {
         auto p_dist = (float*)malloc(p_dist_size);
 
         int32_t* pdistances = (int32_t*)p_dist;
-        index_->search_by_id(rows, p_data, config[meta::TOPK].get<int64_t>(), pdistances, p_id, bitset_);
+        index_->search_by_id(rows, p_data, config[meta::TOPK].get<int64_t>(), pdistances, p_id,
+                             std::atomic_load(&bitset_));
 
         auto ret_ds = std::make_shared<Dataset>();
         if (index_->metric_type == faiss::METRIC_Hamming) {
@@ -217,12 +223,40 @@ BinaryIVF::SearchById(const DatasetPtr& dataset, const Config& config) {
 
 void
 BinaryIVF::SetBlacklist(faiss::ConcurrentBitsetPtr list) {
-    bitset_ = std::move(list);
+    std::atomic_store(&bitset_, std::move(list));
 }
 
 void
 BinaryIVF::GetBlacklist(faiss::ConcurrentBitsetPtr& list) {
-    list = bitset_;
+    list = std::atomic_load(&bitset_);
+}
+
+void
+BinaryIVF::Compact(const std::vector<int64_t>& offset_map) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto index_ivf = dynamic_cast<faiss::IndexBinaryIVF*>(index_.get());
+    if (index_ivf == nullptr) {
+        KNOWHERE_THROW_MSG("compact is only supported by cpu ivf index");
+    }
+
+    try {
+        int64_t ntotal = 0;
+        auto new_lists = CompactInvertedLists(index_ivf->invlists, offset_map, ntotal);
+        index_ivf->replace_invlists(new_lists, true);
+        index_ivf->ntotal = ntotal;
+        if (index_ivf->maintain_direct_map) {
+            index_ivf->make_direct_map(true);
+        }
+        std::atomic_store(&bitset_, faiss::ConcurrentBitsetPtr());
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
 }
 
 }  // namespace knowhere
@@ -67,6 +67,11 @@ class BinaryIVF : public VectorIndex, public FaissBaseBinaryIndex {
     void
     GetBlacklist(faiss::ConcurrentBitsetPtr& list);
 
+    // drop the vectors whose offset_map[offset] is negative and relabel the others with offset_map[offset],
+    // the quantizer and the codes of the kept vectors are reused as is
+    void
+    Compact(const std::vector<int64_t>& offset_map);
+
  protected:
     virtual std::shared_ptr<faiss::IVFSearchParameters>
     GenParams(const Config& config);
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <cassert>
 #include <iterator>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -81,47 +82,26 @@ IndexHNSW::Search(const DatasetPtr& dataset, const Config& config) {
     }
     GETTENSOR(dataset)
 
-    size_t id_size = sizeof(int64_t) * config[meta::TOPK].get<int64_t>();
-    size_t dist_size = sizeof(float) * config[meta::TOPK].get<int64_t>();
-    auto p_id = (int64_t*)malloc(id_size * rows);
-    auto p_dist = (float*)malloc(dist_size * rows);
-
-    index_->setEf(config[IndexParams::ef]);
-
-    using P = std::pair<float, int64_t>;
-    auto compare = [](const P& v1, const P& v2) { return v1.first < v2.first; };
-#pragma omp parallel for
-    for (unsigned int i = 0; i < rows; ++i) {
-        std::vector<P> ret;
-        const float* single_query = p_data + i * Dimension();
-
-        // if (normalize) {
-        //     std::vector<float> norm_vector(Dimension());
-        //     normalize_vector((float*)(single_query), norm_vector.data(), Dimension());
-        //     ret = index_->searchKnn((float*)(norm_vector.data()), config[meta::TOPK].get<int64_t>(), compare);
-        // } else {
-        //     ret = index_->searchKnn((float*)single_query, config[meta::TOPK].get<int64_t>(), compare);
-        // }
-        ret = index_->searchKnn((float*)single_query, config[meta::TOPK].get<int64_t>(), compare);
-
-        while (ret.size() < config[meta::TOPK]) {
-            ret.push_back(std::make_pair(-1, -1));
+    auto k = config[meta::TOPK].get<int64_t>();
+    size_t ef = config[IndexParams::ef].get<int64_t>();
+    auto p_id = (int64_t*)malloc(sizeof(int64_t) * k * rows);
+    auto p_dist = (float*)malloc(sizeof(float) * k * rows);
+
+    // ef goes with each call instead of being set on the shared index, so concurrent searches don't race on it
+    faiss::ConcurrentBitsetPtr bitset = std::atomic_load(&bitset_);
+#pragma omp parallel
+    {
+        hnswlib::HierarchicalNSW<float>::SearchBuffer buffer(*index_);
+#pragma omp for
+        for (int64_t i = 0; i < rows; ++i) {
+            float* single_dist = p_dist + i * k;
+            index_->searchKnn(p_data + i * dim, k, ef, bitset, single_dist, p_id + i * k, buffer);
+            if (normalize) {
+                for (int64_t j = 0; j < k; ++j) {
+                    single_dist[j] = 1 - single_dist[j];
+                }
+            }
         }
-        std::vector<float> dist;
-        std::vector<int64_t> ids;
-
-        if (normalize) {
-            std::transform(ret.begin(), ret.end(), std::back_inserter(dist),
-                           [](const std::pair<float, int64_t>& e) { return float(1 - e.first); });
-        } else {
-            std::transform(ret.begin(), ret.end(), std::back_inserter(dist),
-                           [](const std::pair<float, int64_t>& e) { return e.first; });
-        }
-        std::transform(ret.begin(), ret.end(), std::back_inserter(ids),
-                       [](const std::pair<float, int64_t>& e) { return e.second; });
-
-        memcpy(p_dist + i * config[meta::TOPK].get<int64_t>(), dist.data(), dist_size);
-        memcpy(p_id + i * config[meta::TOPK].get<int64_t>(), ids.data(), id_size);
     }
 
     auto ret_ds = std::make_shared<Dataset>();
@@ -204,4 +184,14 @@ IndexHNSW::Dimension() {
     return (*(size_t*)index_->dist_func_param_);
 }
 
+void
+IndexHNSW::SetBlacklist(faiss::ConcurrentBitsetPtr list) {
+    std::atomic_store(&bitset_, std::move(list));
+}
+
+void
+IndexHNSW::GetBlacklist(faiss::ConcurrentBitsetPtr& list) {
+    list = std::atomic_load(&bitset_);
+}
+
 }  // namespace knowhere
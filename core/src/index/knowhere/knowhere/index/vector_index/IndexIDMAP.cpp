@@ -22,6 +22,8 @@
 
 #endif
 
+#include <memory>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -78,7 +80,7 @@ IDMAP::Search(const DatasetPtr& dataset, const Config& config) {
 
 void
 IDMAP::search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels, const Config& cfg) {
-    index_->search(n, (float*)data, k, distances, labels, bitset_);
+    index_->search(n, (float*)data, k, distances, labels, std::atomic_load(&bitset_));
 }
 
 void
@@ -112,6 +114,27 @@ IDMAP::AddWithoutId(const DatasetPtr& dataset, const Config& config) {
     index_->add_with_ids(rows, (float*)p_data, new_ids.data());
 }
 
+float*
+IDMAP::AllocRawVectors(int64_t rows) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto id_index = dynamic_cast<faiss::IndexIDMap*>(index_.get());
+    auto flat_index = id_index ? dynamic_cast<faiss::IndexFlat*>(id_index->index) : nullptr;
+    if (flat_index == nullptr) {
+        KNOWHERE_THROW_MSG("index is not a flat id map");
+    }
+
+    flat_index->xb.resize(rows * flat_index->d);
+    flat_index->ntotal = rows;
+    id_index->id_map.resize(rows);
+    std::iota(id_index->id_map.begin(), id_index->id_map.end(), 0);
+    id_index->ntotal = rows;
+    return flat_index->xb.data();
+}
+
 int64_t
 IDMAP::Count() {
     return index_->ntotal;
@@ -198,7 +221,7 @@ IDMAP::GetVectorById(const DatasetPtr& dataset, const Config& config) {
     size_t p_x_size = sizeof(float) * elems;
     auto p_x = (float*)malloc(p_x_size);
 
-    index_->get_vector_by_id(1, p_data, p_x, bitset_);
+    index_->get_vector_by_id(1, p_data, p_x, std::atomic_load(&bitset_));
 
     auto ret_ds = std::make_shared<Dataset>();
     ret_ds->Set(meta::TENSOR, p_x);
@@ -223,7 +246,7 @@ IDMAP::SearchById(const DatasetPtr& dataset, const Config& config) {
     // todo: enable search by id (zhiru)
     //    auto blacklist = dataset->Get<faiss::ConcurrentBitsetPtr>("bitset");
     //    index_->searchById(rows, (float*)p_data, config[meta::TOPK].get<int64_t>(), p_dist, p_id, blacklist);
-    index_->search_by_id(rows, p_data, config[meta::TOPK].get<int64_t>(), p_dist, p_id, bitset_);
+    index_->search_by_id(rows, p_data, config[meta::TOPK].get<int64_t>(), p_dist, p_id, std::atomic_load(&bitset_));
 
     auto ret_ds = std::make_shared<Dataset>();
     ret_ds->Set(meta::IDS, p_id);
@@ -233,12 +256,12 @@ IDMAP::SearchById(const DatasetPtr& dataset, const Config& config) {
 
 void
 IDMAP::SetBlacklist(faiss::ConcurrentBitsetPtr list) {
-    bitset_ = std::move(list);
+    std::atomic_store(&bitset_, std::move(list));
 }
 
 void
 IDMAP::GetBlacklist(faiss::ConcurrentBitsetPtr& list) {
-    list = bitset_;
+    list = std::atomic_load(&bitset_);
 }
 
 }  // namespace knowhere
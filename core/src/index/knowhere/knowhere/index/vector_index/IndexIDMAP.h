@@ -54,6 +54,11 @@ class IDMAP : public VectorIndex, public FaissBaseIndex {
     void
     AddWithoutId(const DatasetPtr& dataset, const Config& config);
 
+    // size the index for rows vectors with ids 0..rows-1 and return its storage to be filled in place,
+    // so raw data is loaded without a copy through a dataset
+    float*
+    AllocRawVectors(int64_t rows);
+
     VectorIndexPtr
     CopyCpuToGpu(const int64_t& device_id, const Config& config);
 
@@ -18,13 +18,16 @@
 #include <faiss/clone_index.h>
 #include <faiss/index_factory.h>
 #include <faiss/index_io.h>
+#include <faiss/utils/random.h>
 #ifdef MILVUS_GPU_VERSION
 #include <faiss/gpu/GpuAutoTune.h>
 #include <faiss/gpu/GpuCloner.h>
 #endif
 
 #include <fiu-local.h>
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -37,6 +40,7 @@
 #include "knowhere/index/vector_index/IndexGPUIVF.h"
 #endif
 #include "knowhere/index/vector_index/IndexIVF.h"
+#include "knowhere/index/vector_index/helpers/InvertedListsCompact.h"
 
 namespace knowhere {
 
@@ -49,7 +53,7 @@ IVF::Train(const DatasetPtr& dataset, const Config& config) {
     faiss::Index* coarse_quantizer = new faiss::IndexFlatL2(dim);
     auto index = std::make_shared<faiss::IndexIVFFlat>(coarse_quantizer, dim, config[IndexParams::nlist].get<int64_t>(),
                                                        GetMetricType(config[Metric::TYPE].get<std::string>()));
-    index->train(rows, (float*)p_data);
+    TrainIndex(index.get(), rows, (const float*)p_data, config);
 
     // TODO(linxj): override here. train return model or not.
     return std::make_shared<IVFIndexModel>(index);
@@ -96,6 +100,48 @@ IVF::Load(const BinarySet& index_binary) {
     LoadImpl(index_binary);
 }
 
+int64_t
+IVF::SerializedSize() {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    return faiss::write_index_size(index_.get());
+}
+
+void
+IVF::SerializeTo(faiss::IOWriter* writer) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    faiss::write_index(index_.get(), writer);
+}
+
+void
+IVF::Checkpoint(const std::string& path) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    faiss::write_index(index_.get(), path.c_str());
+}
+
+void
+IVF::Restore(const std::string& path) {
+    // read without mmap, the inverted lists stay writable
+    std::shared_ptr<faiss::Index> index(faiss::read_index(path.c_str()));
+    if (dynamic_cast<faiss::IndexIVF*>(index.get()) == nullptr) {
+        KNOWHERE_THROW_MSG("checkpoint is not an ivf index");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    index_ = index;
+}
+
 DatasetPtr
 IVF::Search(const DatasetPtr& dataset, const Config& config) {
     if (!index_ || !index_->is_trained) {
@@ -150,6 +196,36 @@ IVF::set_index_model(IndexModelPtr model) {
     index_.reset(faiss::clone_index(rel_model->index_.get()));
 }
 
+void
+IVF::TrainIndex(faiss::IndexIVF* index, int64_t rows, const float* data, const Config& config, int64_t min_sample) {
+    static const int64_t SAMPLE_SEED = 1234;
+
+    auto& cp = index->cp;
+    if (config.contains(IndexParams::max_points_per_centroid)) {
+        cp.max_points_per_centroid = config[IndexParams::max_points_per_centroid].get<int64_t>();
+    }
+    if (config.contains(IndexParams::kmeans_batch_size)) {
+        cp.batch_size = config[IndexParams::kmeans_batch_size].get<int64_t>();
+    }
+
+    // k-means samples its input alone, but every row would still be assigned to train the residual codebooks
+    int64_t sample_rows = std::max(static_cast<int64_t>(index->nlist) * cp.max_points_per_centroid, min_sample);
+    if (rows <= sample_rows) {
+        index->train(rows, data);
+        return;
+    }
+
+    int64_t dim = index->d;
+    std::vector<int> perm(rows);
+    faiss::rand_perm(perm.data(), rows, SAMPLE_SEED);
+    std::vector<float> samples(sample_rows * dim);
+#pragma omp parallel for
+    for (int64_t i = 0; i < sample_rows; ++i) {
+        memcpy(samples.data() + i * dim, data + static_cast<int64_t>(perm[i]) * dim, dim * sizeof(float));
+    }
+    index->train(sample_rows, samples.data());
+}
+
 std::shared_ptr<faiss::IVFSearchParameters>
 IVF::GenParams(const Config& config) {
     auto params = std::make_shared<faiss::IVFSearchParameters>();
@@ -210,7 +286,7 @@ IVF::search_impl(int64_t n, const float* data, int64_t k, float* distances, int6
     auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
     ivf_index->nprobe = params->nprobe;
     stdclock::time_point before = stdclock::now();
-    ivf_index->search(n, (float*)data, k, distances, labels, bitset_);
+    ivf_index->search(n, (float*)data, k, distances, labels, std::atomic_load(&bitset_));
     stdclock::time_point after = stdclock::now();
     double search_cost = (std::chrono::duration<double, std::micro>(after - before)).count();
     KNOWHERE_LOG_DEBUG << "IVF search cost: " << search_cost
@@ -277,7 +353,7 @@ IVF::GetVectorById(const DatasetPtr& dataset, const Config& config) {
         auto p_x = (float*)malloc(p_x_size);
 
         auto index_ivf = std::static_pointer_cast<faiss::IndexIVF>(index_);
-        index_ivf->get_vector_by_id(1, p_data, p_x, bitset_);
+        index_ivf->get_vector_by_id(1, p_data, p_x, std::atomic_load(&bitset_));
 
         auto ret_ds = std::make_shared<Dataset>();
         ret_ds->Set(meta::TENSOR, p_x);
@@ -309,7 +385,8 @@ IVF::SearchById(const DatasetPtr& dataset, const Config& config) {
         // todo: enable search by id (zhiru)
         //        auto blacklist = dataset->Get<faiss::ConcurrentBitsetPtr>("bitset");
         auto index_ivf = std::static_pointer_cast<faiss::IndexIVF>(index_);
-        index_ivf->search_by_id(rows, p_data, config[meta::TOPK].get<int64_t>(), p_dist, p_id, bitset_);
+        index_ivf->search_by_id(rows, p_data, config[meta::TOPK].get<int64_t>(), p_dist, p_id,
+                                std::atomic_load(&bitset_));
 
         //    std::stringstream ss_res_id, ss_res_dist;
         //    for (int i = 0; i < 10; ++i) {
@@ -337,12 +414,40 @@ IVF::SearchById(const DatasetPtr& dataset, const Config& config) {
 
 void
 IVF::SetBlacklist(faiss::ConcurrentBitsetPtr list) {
-    bitset_ = std::move(list);
+    std::atomic_store(&bitset_, std::move(list));
 }
 
 void
 IVF::GetBlacklist(faiss::ConcurrentBitsetPtr& list) {
-    list = bitset_;
+    list = std::atomic_load(&bitset_);
+}
+
+void
+IVF::Compact(const std::vector<int64_t>& offset_map) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto index_ivf = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    if (index_ivf == nullptr) {
+        KNOWHERE_THROW_MSG("compact is only supported by cpu ivf index");
+    }
+
+    try {
+        int64_t ntotal = 0;
+        auto new_lists = CompactInvertedLists(index_ivf->invlists, offset_map, ntotal);
+        index_ivf->replace_invlists(new_lists, true);
+        index_ivf->ntotal = ntotal;
+        if (index_ivf->maintain_direct_map) {
+            index_ivf->make_direct_map(true);
+        }
+        std::atomic_store(&bitset_, faiss::ConcurrentBitsetPtr());
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
 }
 
 IVFIndexModel::IVFIndexModel(std::shared_ptr<faiss::Index> index) : FaissBaseIndex(std::move(index)) {
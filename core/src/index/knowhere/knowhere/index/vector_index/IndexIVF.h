@@ -13,12 +13,14 @@
 
 #include <memory>
 #include <mutex>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "FaissBaseIndex.h"
 #include "VectorIndex.h"
 #include "faiss/IndexIVF.h"
+#include "faiss/impl/io.h"
 #include "faiss/utils/ConcurrentBitset.h"
 
 namespace knowhere {
@@ -60,6 +62,21 @@ class IVF : public VectorIndex, public FaissBaseIndex {
     void
     Load(const BinarySet& index_binary) override;
 
+    // size of the binary SerializeTo() writes, the inverted lists are sized from their list sizes
+    int64_t
+    SerializedSize();
+
+    // write the binary of Serialize() through writer, without a copy of it in memory
+    void
+    SerializeTo(faiss::IOWriter* writer);
+
+    // save the index being built to a local file, Restore reads it back and more vectors can be added
+    void
+    Checkpoint(const std::string& path);
+
+    void
+    Restore(const std::string& path);
+
     int64_t
     Count() override;
 
@@ -84,7 +101,17 @@ class IVF : public VectorIndex, public FaissBaseIndex {
     void
     GetBlacklist(faiss::ConcurrentBitsetPtr& list);
 
+    // drop the vectors whose offset_map[offset] is negative and relabel the others with offset_map[offset],
+    // the quantizer and the codes of the kept vectors are reused as is
+    void
+    Compact(const std::vector<int64_t>& offset_map);
+
  protected:
+    // train the quantizer and codebooks on at most max_points_per_centroid rows per centroid, and not less than
+    // min_sample rows, sampled from data at random
+    static void
+    TrainIndex(faiss::IndexIVF* index, int64_t rows, const float* data, const Config& config, int64_t min_sample = 0);
+
     virtual std::shared_ptr<faiss::IVFSearchParameters>
     GenParams(const Config& config);
 
@@ -37,7 +37,8 @@ IVFPQ::Train(const DatasetPtr& dataset, const Config& config) {
     auto index = std::make_shared<faiss::IndexIVFPQ>(coarse_quantizer, dim, config[IndexParams::nlist].get<int64_t>(),
                                                      config[IndexParams::m].get<int64_t>(),
                                                      config[IndexParams::nbits].get<int64_t>());
-    index->train(rows, (float*)p_data);
+    // keep enough rows for the pq codebooks, which sample their own points per code
+    TrainIndex(index.get(), rows, (const float*)p_data, config, index->pq.ksub * index->pq.cp.max_points_per_centroid);
 
     return std::make_shared<IVFIndexModel>(index);
 }
@@ -38,7 +38,12 @@ IVFSQ::Train(const DatasetPtr& dataset, const Config& config) {
                << "SQ" << config[IndexParams::nbits];
     auto build_index =
         faiss::index_factory(dim, index_type.str().c_str(), GetMetricType(config[Metric::TYPE].get<std::string>()));
-    build_index->train(rows, (float*)p_data);
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(build_index);
+    if (ivf_index != nullptr) {
+        TrainIndex(ivf_index, rows, (const float*)p_data, config);
+    } else {
+        build_index->train(rows, (float*)p_data);
+    }
 
     std::shared_ptr<faiss::Index> ret_index;
     ret_index.reset(build_index);
@@ -24,6 +24,7 @@
 #endif
 
 #include <fiu-local.h>
+#include <memory>
 
 #include "knowhere/index/vector_index/IndexIDMAP.h"
 #include "knowhere/index/vector_index/IndexIVF.h"
@@ -88,7 +89,8 @@ NSG::Search(const DatasetPtr& dataset, const Config& config) {
 
     algo::SearchParams s_params;
     s_params.search_length = config[IndexParams::search_length];
-    index_->Search((float*)p_data, rows, dim, config[meta::TOPK].get<int64_t>(), p_dist, p_id, s_params);
+    index_->Search((float*)p_data, rows, dim, config[meta::TOPK].get<int64_t>(), p_dist, p_id, s_params,
+                   std::atomic_load(&bitset_));
 
     auto ret_ds = std::make_shared<Dataset>();
     ret_ds->Set(meta::IDS, p_id);
@@ -162,4 +164,14 @@ NSG::Seal() {
     // do nothing
 }
 
+void
+NSG::SetBlacklist(faiss::ConcurrentBitsetPtr list) {
+    std::atomic_store(&bitset_, std::move(list));
+}
+
+void
+NSG::GetBlacklist(faiss::ConcurrentBitsetPtr& list) {
+    list = std::atomic_load(&bitset_);
+}
+
 }  // namespace knowhere
@@ -13,8 +13,11 @@
 #include <SPTAG/AnnService/inc/Core/VectorSet.h>
 #include <SPTAG/AnnService/inc/Server/QueryParser.h>
 
+#include <algorithm>
 #include <array>
+#include <memory>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 #undef mkdir
@@ -214,6 +217,11 @@ CPUSPTAGRNG::Search(const DatasetPtr& dataset, const Config& config) {
         }
         std::cout << std::endl;
     }
+    faiss::ConcurrentBitsetPtr bitset = std::atomic_load(&bitset_);
+    if (bitset != nullptr) {
+        return SearchWithBlacklist(dataset, config, bitset);
+    }
+
     std::vector<SPTAG::QueryResult> query_results = ConvertToQueryResult(dataset, config);
 
 #pragma omp parallel for
@@ -226,6 +234,70 @@ CPUSPTAGRNG::Search(const DatasetPtr& dataset, const Config& config) {
     return ConvertToDataset(query_results);
 }
 
+DatasetPtr
+CPUSPTAGRNG::SearchWithBlacklist(const DatasetPtr& dataset, const Config& config,
+                                 const faiss::ConcurrentBitsetPtr& bitset) {
+    GETTENSOR(dataset)
+
+    auto k = config[meta::TOPK].get<int64_t>();
+    auto elems = rows * k;
+    auto p_id = (int64_t*)malloc(sizeof(int64_t) * elems);
+    auto p_dist = (float*)malloc(sizeof(float) * elems);
+    int64_t count = Count();
+
+    // the blacklist holds offsets which SPTAG only knows as metadata, so deleted neighbours are dropped
+    // after the search, fetching twice as many candidates until k survivors are found
+#pragma omp parallel for
+    for (int64_t i = 0; i < rows; ++i) {
+        int64_t fetch = k;
+        int64_t found = 0;
+        while (true) {
+            SPTAG::QueryResult query_result(&p_data[i * dim], fetch, true);
+            index_ptr_->SearchIndex(query_result);
+
+            found = 0;
+            for (int j = 0; j < query_result.GetResultNum() && found < k; ++j) {
+                auto result = query_result.GetResult(j);
+                if (result->VID < 0) {
+                    continue;
+                }
+                auto offset = *(int64_t*)query_result.GetMetadata(j).Data();
+                if (bitset->test(offset)) {
+                    continue;
+                }
+                p_id[i * k + found] = offset;
+                p_dist[i * k + found] = result->Dist;
+                ++found;
+            }
+
+            if (found >= k || fetch >= count) {
+                break;
+            }
+            fetch = std::min(fetch * 2, count);
+        }
+
+        for (; found < k; ++found) {
+            p_id[i * k + found] = -1;
+            p_dist[i * k + found] = -1;
+        }
+    }
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
+void
+CPUSPTAGRNG::SetBlacklist(faiss::ConcurrentBitsetPtr list) {
+    std::atomic_store(&bitset_, std::move(list));
+}
+
+void
+CPUSPTAGRNG::GetBlacklist(faiss::ConcurrentBitsetPtr& list) {
+    list = std::atomic_load(&bitset_);
+}
+
 int64_t
 CPUSPTAGRNG::Count() {
     return index_ptr_->GetNumSamples();
@@ -18,6 +18,7 @@
 #include <string>
 
 #include "VectorIndex.h"
+#include "faiss/utils/ConcurrentBitset.h"
 #include "knowhere/index/IndexModel.h"
 
 namespace knowhere {
@@ -58,14 +59,24 @@ class CPUSPTAGRNG : public VectorIndex {
     void
     Seal() override;
 
+    void
+    SetBlacklist(faiss::ConcurrentBitsetPtr list);
+
+    void
+    GetBlacklist(faiss::ConcurrentBitsetPtr& list);
+
  private:
     void
     SetParameters(const Config& config);
 
+    DatasetPtr
+    SearchWithBlacklist(const DatasetPtr& dataset, const Config& config, const faiss::ConcurrentBitsetPtr& bitset);
+
  private:
     PreprocessorPtr preprocessor_;
     std::shared_ptr<SPTAG::VectorIndex> index_ptr_;
     SPTAG::IndexAlgoType index_type_;
+    faiss::ConcurrentBitsetPtr bitset_ = nullptr;
 };
 
 using CPUSPTAGRNGPtr = std::shared_ptr<CPUSPTAGRNG>;
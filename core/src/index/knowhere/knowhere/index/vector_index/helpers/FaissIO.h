@@ -23,6 +23,9 @@ struct MemoryIOWriter : public faiss::IOWriter {
     size_t
     operator()(const void* ptr, size_t size, size_t nitems) override;
 
+    size_t
+    tell() override;
+
     template <typename T>
     size_t
     write(T* ptr, size_t size, size_t nitems = 1) {
@@ -32,6 +32,8 @@ constexpr const char* nprobe = "nprobe";
 constexpr const char* nlist = "nlist";
 constexpr const char* m = "m";          // PQ
 constexpr const char* nbits = "nbits";  // PQ/SQ
+constexpr const char* max_points_per_centroid = "max_points_per_centroid";  // training sample of k-means
+constexpr const char* kmeans_batch_size = "kmeans_batch_size";              // 0 for full batch k-means
 
 // NSG Params
 constexpr const char* knng = "knng";
@@ -0,0 +1,66 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "knowhere/index/vector_index/helpers/InvertedListsCompact.h"
+
+#include <memory>
+#include <string>
+
+#include "knowhere/common/Exception.h"
+
+namespace knowhere {
+
+faiss::ArrayInvertedLists*
+CompactInvertedLists(const faiss::InvertedLists* lists, const std::vector<int64_t>& offset_map, int64_t& ntotal) {
+    if (lists == nullptr) {
+        KNOWHERE_THROW_MSG("inverted lists are null");
+    }
+
+    auto code_size = lists->code_size;
+    auto new_lists = std::make_unique<faiss::ArrayInvertedLists>(lists->nlist, code_size);
+    auto map_size = static_cast<int64_t>(offset_map.size());
+
+    ntotal = 0;
+    std::vector<faiss::InvertedLists::idx_t> ids;
+    std::vector<uint8_t> codes;
+    for (size_t list_no = 0; list_no < lists->nlist; ++list_no) {
+        size_t list_size = lists->list_size(list_no);
+        if (list_size == 0) {
+            continue;
+        }
+
+        faiss::InvertedLists::ScopedIds old_ids(lists, list_no);
+        faiss::InvertedLists::ScopedCodes old_codes(lists, list_no);
+
+        ids.clear();
+        codes.clear();
+        for (size_t i = 0; i < list_size; ++i) {
+            auto offset = old_ids[i];
+            if (offset < 0 || offset >= map_size) {
+                KNOWHERE_THROW_MSG("inverted list id " + std::to_string(offset) + " out of offset map");
+            }
+            if (offset_map[offset] < 0) {
+                continue;
+            }
+            ids.push_back(offset_map[offset]);
+            codes.insert(codes.end(), old_codes.get() + i * code_size, old_codes.get() + (i + 1) * code_size);
+        }
+
+        if (!ids.empty()) {
+            new_lists->add_entries(list_no, ids.size(), ids.data(), codes.data());
+            ntotal += ids.size();
+        }
+    }
+
+    return new_lists.release();
+}
+
+}  // namespace knowhere
@@ -0,0 +1,27 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <faiss/InvertedLists.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace knowhere {
+
+// Copy inverted lists, dropping the entries whose offset_map[id] is negative and relabeling the others
+// with offset_map[id]. The ids stored in the lists must be segment offsets smaller than offset_map.size().
+// Returns the new lists, owned by the caller, and the number of entries kept.
+faiss::ArrayInvertedLists*
+CompactInvertedLists(const faiss::InvertedLists* lists, const std::vector<int64_t>& offset_map, int64_t& ntotal);
+
+}  // namespace knowhere
@@ -695,17 +695,17 @@ NsgIndex::FindUnconnectedNode(boost::dynamic_bitset<>& has_linked, int64_t& root
 
 void
 NsgIndex::Search(const float* query, const unsigned& nq, const unsigned& dim, const unsigned& k, float* dist,
-                 int64_t* ids, SearchParams& params) {
+                 int64_t* ids, SearchParams& params, const faiss::ConcurrentBitsetPtr& bitset) {
     std::vector<std::vector<Neighbor>> resset(nq);
 
     TimeRecorder rc("NsgIndex::search", 1);
     if (nq == 1) {
-        GetNeighbors(query, resset[0], nsg, &params);
+        FilteredGetNeighbors(query, resset[0], k, params, bitset);
     } else {
 #pragma omp parallel for
         for (unsigned int i = 0; i < nq; ++i) {
             const float* single_query = query + i * dim;
-            GetNeighbors(single_query, resset[i], nsg, &params);
+            FilteredGetNeighbors(single_query, resset[i], k, params, bitset);
         }
     }
     rc.RecordSection("search");
@@ -730,6 +730,30 @@ NsgIndex::Search(const float* query, const unsigned& nq, const unsigned& dim, co
     rc.RecordSection("merge");
 }
 
+void
+NsgIndex::FilteredGetNeighbors(const float* query, std::vector<Neighbor>& resset, const unsigned& k,
+                               const SearchParams& params, const faiss::ConcurrentBitsetPtr& bitset) {
+    SearchParams search_params = params;
+    while (true) {
+        GetNeighbors(query, resset, nsg, &search_params);
+        if (bitset == nullptr) {
+            return;
+        }
+
+        // deleted nodes still act as stepping stones during the walk, they are only removed from the result
+        auto is_deleted = [&](const Neighbor& n) {
+            return bitset->test((faiss::ConcurrentBitset::id_type_t)ids_[n.id]);
+        };
+        resset.erase(std::remove_if(resset.begin(), resset.end(), is_deleted), resset.end());
+
+        // too many candidates were deleted, widen the search pool and walk again
+        if (resset.size() >= k || search_params.search_length >= ntotal) {
+            return;
+        }
+        search_params.search_length = std::min(std::max(search_params.search_length * 2, (size_t)k), ntotal);
+    }
+}
+
 void
 NsgIndex::SetKnnGraph(Graph& g) {
     knng = std::move(g);
@@ -20,6 +20,7 @@
 
 #include "Distance.h"
 #include "Neighbor.h"
+#include "faiss/utils/ConcurrentBitset.h"
 #include "knowhere/common/Config.h"
 
 namespace knowhere {
@@ -77,7 +78,7 @@ class NsgIndex {
 
     void
     Search(const float* query, const unsigned& nq, const unsigned& dim, const unsigned& k, float* dist, int64_t* ids,
-           SearchParams& params);
+           SearchParams& params, const faiss::ConcurrentBitsetPtr& bitset = nullptr);
 
     // Not support yet.
     // virtual void Add() = 0;
@@ -109,6 +110,11 @@ class NsgIndex {
     void
     GetNeighbors(const float* query, std::vector<Neighbor>& resset, Graph& graph, SearchParams* param = nullptr);
 
+    // search, dropping the ids set in bitset from resset
+    void
+    FilteredGetNeighbors(const float* query, std::vector<Neighbor>& resset, const unsigned& k,
+                         const SearchParams& params, const faiss::ConcurrentBitsetPtr& bitset);
+
     void
     Link();
 
@@ -33,7 +33,8 @@ ClusteringParameters::ClusteringParameters ():
     frozen_centroids(false),
     min_points_per_centroid(39),
     max_points_per_centroid(256),
-    seed(1234)
+    seed(1234),
+    batch_size(0)
 {}
 // 39 corresponds to 10000 / 256 -> to avoid warnings on PQ tests with randu10k
 
@@ -162,6 +163,16 @@ void Clustering::train (idx_t nx, const float *x_in, Index & index) {
     }
     t0 = getmillisecs();
 
+    bool minibatch = batch_size > 0 && batch_size < nx;
+    std::vector<float> xbatch;
+    // nb of vectors each centroid has been moved toward
+    std::vector<int64_t> counts;
+    if (minibatch) {
+        xbatch.resize (batch_size * d);
+        if (verbose)
+            printf("  Mini-batch of %d points per iteration\n", batch_size);
+    }
+
     for (int redo = 0; redo < nredo; redo++) {
 
         if (verbose && nredo > 1) {
@@ -188,28 +199,52 @@ void Clustering::train (idx_t nx, const float *x_in, Index & index) {
         }
 
         index.add (k, centroids.data());
+        if (minibatch) {
+            counts.assign (k, 0);
+        }
         float err = 0;
         for (int i = 0; i < niter; i++) {
+            // the batches walk through the training set in random order
+            const float *xi = x;
+            idx_t ni = nx;
+            if (minibatch) {
+                ni = batch_size;
+#pragma omp parallel for
+                for (idx_t j = 0; j < ni; j++) {
+                    idx_t src = perm[(i * ni + j) % nx];
+                    memcpy (xbatch.data() + j * d, x + src * d,
+                            sizeof (float) * d);
+                }
+                xi = xbatch.data();
+            }
+
             double t0s = getmillisecs();
-            index.search (nx, x, 1, dis, assign);
+            index.search (ni, xi, 1, dis, assign);
             InterruptCallback::check();
             t_search_tot += getmillisecs() - t0s;
 
             err = 0;
-            for (int j = 0; j < nx; j++)
+            for (int j = 0; j < ni; j++)
                 err += dis[j];
             obj.push_back (err);
 
-            int nsplit = km_update_centroids (
-                  x, centroids.data(),
-                  assign, d, k, nx, frozen_centroids ? n_input_centroids : 0);
+            int nsplit = 0;
+            if (minibatch) {
+                km_minibatch_update_centroids (
+                      xi, centroids.data(), assign, counts.data(),
+                      d, k, ni, frozen_centroids ? n_input_centroids : 0);
+            } else {
+                nsplit = km_update_centroids (
+                      x, centroids.data(),
+                      assign, d, k, nx, frozen_centroids ? n_input_centroids : 0);
+            }
 
             if (verbose) {
                 printf ("  Iteration %d (%.2f s, search %.2f s): "
                         "objective=%g imbalance=%.3f nsplit=%d       \r",
                         i, (getmillisecs() - t0) / 1000.0,
                         t_search_tot / 1000,
-                        err, imbalance_factor (nx, k, assign),
+                        err, imbalance_factor (ni, k, assign),
                         nsplit);
                 fflush (stdout);
             }
@@ -34,6 +34,11 @@ struct ClusteringParameters {
 
     int seed; ///< seed for the random number generator
 
+    /// vectors assigned per iteration by mini-batch k-means, each
+    /// centroid moves toward its vectors with a decreasing learning rate.
+    /// 0 assigns the whole training set per iteration
+    int batch_size;
+
     /// sets reasonable defaults
     ClusteringParameters ();
 };
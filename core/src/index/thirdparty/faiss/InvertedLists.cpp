@@ -435,6 +435,34 @@ void ReadOnlyInvertedLists::resize (size_t , size_t )
 }
 
 
+/*****************************************
+ * MappedInvertedLists implementation
+ ******************************************/
+
+MappedInvertedLists::MappedInvertedLists (size_t nlist, size_t code_size):
+    ReadOnlyInvertedLists (nlist, code_size),
+    list_sizes (nlist, 0), list_codes (nlist, nullptr), list_ids (nlist, nullptr)
+{}
+
+size_t MappedInvertedLists::list_size(size_t list_no) const
+{
+    assert (list_no < nlist);
+    return list_sizes[list_no];
+}
+
+const uint8_t * MappedInvertedLists::get_codes (size_t list_no) const
+{
+    assert (list_no < nlist);
+    return list_codes[list_no];
+}
+
+const InvertedLists::idx_t * MappedInvertedLists::get_ids (size_t list_no) const
+{
+    assert (list_no < nlist);
+    return list_ids[list_no];
+}
+
+
 
 /*****************************************
  * HStackInvertedLists implementation
@@ -299,6 +299,28 @@ struct ReadOnlyInvertedLists: InvertedLists {
 
 };
 
+/** Read-only inverted lists whose codes and ids live in an external
+ * buffer, e.g. an mmapped index file. Nothing is copied, the pages are
+ * loaded when a list is first scanned. owner keeps the buffer alive. */
+struct MappedInvertedLists: ReadOnlyInvertedLists {
+    std::vector <size_t> list_sizes;
+    std::vector <const uint8_t *> list_codes;
+    std::vector <const idx_t *> list_ids;
+    std::shared_ptr<const void> owner;
+
+    /// ids of all lists followed by codes of all lists, the layout of
+    /// ReadOnlyArrayInvertedLists that GPU indexes copy in one go.
+    /// nullptr when the lists are interleaved ("ilar" encoding)
+    const idx_t *all_ids = nullptr;
+    const uint8_t *all_codes = nullptr;
+
+    MappedInvertedLists (size_t nlist, size_t code_size);
+
+    size_t list_size(size_t list_no) const override;
+    const uint8_t * get_codes (size_t list_no) const override;
+    const idx_t * get_ids (size_t list_no) const override;
+};
+
 
 /// Horizontal stack of inverted lists
 struct HStackInvertedLists: ReadOnlyInvertedLists {
@@ -106,6 +106,14 @@ Index *Cloner::clone_Index (const Index *index)
         } else if (auto *ails = dynamic_cast<const ReadOnlyArrayInvertedLists*>(ivf->invlists)) {
             res->invlists = new ReadOnlyArrayInvertedLists(*ails);
             res->own_invlists = true;
+        } else if (auto *mils = dynamic_cast<const MappedInvertedLists*>(ivf->invlists)) {
+            // the clone owns its lists, copy them out of the mapped buffer
+            auto ails = new ArrayInvertedLists(mils->nlist, mils->code_size);
+            for (size_t i = 0; i < mils->nlist; i++) {
+                ails->add_entries(i, mils->list_size(i), mils->get_ids(i), mils->get_codes(i));
+            }
+            res->invlists = ails;
+            res->own_invlists = true;
         } else {
             FAISS_THROW_MSG( "clone not supported for this type of inverted lists");
         }
@@ -108,9 +108,14 @@ GpuIndexIVFSQHybrid::copyFrom(
                          memorySpace_);
 
     InvertedLists* ivf = index->invlists;
+    MappedInvertedLists* mil = dynamic_cast<MappedInvertedLists*>(ivf);
     if(ReadOnlyArrayInvertedLists* rol = dynamic_cast<ReadOnlyArrayInvertedLists*>(ivf)) {
         index_->copyCodeVectorsFromCpu((const float* )(rol->pin_readonly_codes->data),
                                        (const long *)(rol->pin_readonly_ids->data), rol->readonly_length);
+    } else if (mil != nullptr && mil->all_codes != nullptr) {
+        // mapped lists stored back to back, copied in one go like the read-only ones
+        index_->copyCodeVectorsFromCpu((const float* )(mil->all_codes),
+                                       (const long *)(mil->all_ids), mil->list_sizes);
     } else {
         for (size_t i = 0; i < ivf->nlist; ++i) {
             auto numVecs = ivf->list_size(i);
@@ -171,9 +176,14 @@ GpuIndexIVFSQHybrid::copyFrom(
                        memorySpace_);
 
   InvertedLists* ivf = index->invlists;
+  MappedInvertedLists* mil = dynamic_cast<MappedInvertedLists*>(ivf);
   if(ReadOnlyArrayInvertedLists* rol = dynamic_cast<ReadOnlyArrayInvertedLists*>(ivf)) {
       index_->copyCodeVectorsFromCpu((const float* )(rol->pin_readonly_codes->data),
                                      (const long *)(rol->pin_readonly_ids->data), rol->readonly_length);
+  } else if (mil != nullptr && mil->all_codes != nullptr) {
+      // mapped lists stored back to back, copied in one go like the read-only ones
+      index_->copyCodeVectorsFromCpu((const float* )(mil->all_codes),
+                                     (const long *)(mil->all_ids), mil->list_sizes);
   } else {
       for (size_t i = 0; i < ivf->nlist; ++i) {
           auto numVecs = ivf->list_size(i);
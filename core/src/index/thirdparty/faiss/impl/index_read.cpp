@@ -194,14 +194,91 @@ static void read_ArrayInvertedLists_sizes (
     }
 }
 
+/// reference the lists in place in the mapped buffer. Returns nullptr and
+/// leaves the reader where it was if some ids are not aligned to idx_t
+static InvertedLists *read_MappedInvertedLists (
+         uint32_t h, MappedIOReader *reader)
+{
+    typedef InvertedLists::idx_t idx_t;
+    IOReader *f = reader;
+    size_t rp0 = reader->rp;
+    size_t nlist, code_size;
+    READ1 (nlist);
+    READ1 (code_size);
+    std::unique_ptr<MappedInvertedLists> mils (
+        new MappedInvertedLists (nlist, code_size));
+    bool aligned = true;
+    auto is_aligned = [] (const uint8_t *p) {
+        return reinterpret_cast<uintptr_t>(p) % alignof (idx_t) == 0;
+    };
+    size_t o = 0;
+    if (h == fourcc ("ilar")) {
+        read_ArrayInvertedLists_sizes (f, mils->list_sizes);
+        o = reader->rp;
+        for (size_t i = 0; i < nlist; i++) {
+            size_t n = mils->list_sizes[i];
+            if (n > 0) {
+                mils->list_codes[i] = reader->data + o;
+                o += n * code_size;
+                aligned = aligned && is_aligned (reader->data + o);
+                mils->list_ids[i] = (const idx_t *) (reader->data + o);
+                o += n * sizeof(idx_t);
+            }
+        }
+    } else {
+        READVECTOR (mils->list_sizes);
+        FAISS_THROW_IF_NOT (mils->list_sizes.size() == nlist);
+        size_t n;
+        READ1 (n);
+        if (h == fourcc ("ilal")) {
+            size_t pad;
+            READ1 (pad);
+            FAISS_THROW_IF_NOT (pad < alignof (idx_t) &&
+                                reader->rp + pad <= reader->total);
+            reader->rp += pad;
+        }
+        aligned = is_aligned (reader->data + reader->rp);
+        mils->all_ids = (const idx_t *) (reader->data + reader->rp);
+        mils->all_codes = reader->data + reader->rp + n * sizeof(idx_t);
+        size_t offset = 0;
+        for (size_t i = 0; i < nlist; i++) {
+            mils->list_ids[i] = mils->all_ids + offset;
+            mils->list_codes[i] = mils->all_codes + offset * code_size;
+            offset += mils->list_sizes[i];
+        }
+        FAISS_THROW_IF_NOT (offset == n);
+        o = reader->rp + n * (sizeof(idx_t) + code_size);
+    }
+    FAISS_THROW_IF_NOT (o <= reader->total);
+    if (!aligned) {
+        // written without padding, e.g. by an older version
+        reader->rp = rp0;
+        return nullptr;
+    }
+    mils->owner = reader->owner;
+    reader->rp = o;
+    return mils.release();
+}
+
 InvertedLists *read_InvertedLists (IOReader *f, int io_flags) {
     uint32_t h;
     READ1 (h);
+    if ((h == fourcc ("ilar") || h == fourcc ("iloa") || h == fourcc ("ilal")) &&
+        (io_flags & IO_FLAG_MMAP) && dynamic_cast<MappedIOReader*>(f)) {
+        InvertedLists *mils = read_MappedInvertedLists (
+            h, dynamic_cast<MappedIOReader*>(f));
+        if (mils) {
+            return mils;
+        }
+        // unaligned ids, copy the lists out of the buffer
+        io_flags &= ~IO_FLAG_MMAP;
+    }
     if (h == fourcc ("il00")) {
         fprintf(stderr, "read_InvertedLists:"
                 " WARN! inverted lists not stored with IVF object\n");
         return nullptr;
-    } else if (h == fourcc ("iloa") && !(io_flags & IO_FLAG_MMAP)) {
+    } else if ((h == fourcc ("iloa") || h == fourcc ("ilal")) &&
+               !(io_flags & IO_FLAG_MMAP)) {
         size_t nlist;
         size_t code_size;
         std::vector <size_t> list_length;
@@ -211,6 +288,13 @@ InvertedLists *read_InvertedLists (IOReader *f, int io_flags) {
         auto ails = new ReadOnlyArrayInvertedLists(nlist, code_size, list_length);
         size_t n;
         READ1(n);
+        if (h == fourcc ("ilal")) {
+            size_t pad;
+            READ1(pad);
+            FAISS_THROW_IF_NOT (pad < alignof (InvertedLists::idx_t));
+            uint8_t padding[alignof (InvertedLists::idx_t)];
+            READANDCHECK(padding, pad);
+        }
 #ifdef USE_CPU
         ails->readonly_ids.resize(n);
         ails->readonly_codes.resize(n*code_size);
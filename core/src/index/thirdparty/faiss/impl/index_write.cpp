@@ -193,7 +193,27 @@ static void write_ScalarQuantizer (
     WRITEVECTOR (ivsc->trained);
 }
 
+namespace {
+
+// counts the bytes write_index would write. The list payloads are added
+// from the list sizes instead of being walked
+struct SizeIOWriter: IOWriter {
+    size_t total = 0;
+
+    size_t operator()(const void *, size_t size, size_t nitems) override {
+        total += size * nitems;
+        return nitems;
+    }
+
+    size_t tell() override {
+        return total;
+    }
+};
+
+} // namespace
+
 void write_InvertedLists (const InvertedLists *ils, IOWriter *f) {
+    auto size_writer = dynamic_cast<SizeIOWriter *>(f);
     if (ils == nullptr) {
         uint32_t h = fourcc ("il00");
         WRITE1 (h);
@@ -231,6 +251,14 @@ void write_InvertedLists (const InvertedLists *ils, IOWriter *f) {
             WRITEVECTOR (sizes);
         }
         // make a single contiguous data buffer (useful for mmapping)
+        if (size_writer) {
+            size_t n = 0;
+            for (size_t i = 0; i < ails->nlist; i++) {
+                n += ails->ids[i].size();
+            }
+            size_writer->total += n * (ails->code_size + sizeof (InvertedLists::idx_t));
+            return;
+        }
         for (size_t i = 0; i < ails->nlist; i++) {
             size_t n = ails->ids[i].size();
             if (n > 0) {
@@ -238,24 +266,37 @@ void write_InvertedLists (const InvertedLists *ils, IOWriter *f) {
                 WRITEANDCHECK (ails->ids[i].data(), n);
             }
         }
-    } else if (const auto & oa =
-            dynamic_cast<const ReadOnlyArrayInvertedLists *>(ils)) {
-        uint32_t h = fourcc("iloa");
+    } else if (dynamic_cast<const MappedInvertedLists *>(ils) ||
+               dynamic_cast<const ReadOnlyArrayInvertedLists *>(ils)) {
+        // all ids, then all codes. The ids are padded to idx_t alignment
+        // so that a mapped buffer can be used in place
+        uint32_t h = fourcc ("ilal");
         WRITE1 (h);
-        WRITE1 (oa->nlist);
-        WRITE1 (oa->code_size);
-        WRITEVECTOR(oa->readonly_length);
-#ifdef USE_CPU
-        size_t n = oa->readonly_ids.size();
-        WRITE1(n);
-        WRITEANDCHECK(oa->readonly_ids.data(), n);
-        WRITEANDCHECK(oa->readonly_codes.data(), n * oa->code_size);
-#else
-        size_t n = oa->pin_readonly_ids->size() / sizeof(InvertedLists::idx_t);
-        WRITE1(n);
-        WRITEANDCHECK((InvertedLists::idx_t *) oa->pin_readonly_ids->data, n);
-        WRITEANDCHECK((uint8_t *) oa->pin_readonly_codes->data, n * oa->code_size);
-#endif
+        WRITE1 (ils->nlist);
+        WRITE1 (ils->code_size);
+        std::vector<size_t> sizes;
+        size_t n = 0;
+        for (size_t i = 0; i < ils->nlist; i++) {
+            sizes.push_back (ils->list_size (i));
+            n += sizes.back();
+        }
+        WRITEVECTOR (sizes);
+        WRITE1 (n);
+        size_t align = alignof (InvertedLists::idx_t);
+        size_t pad = (align - (f->tell() + sizeof (size_t)) % align) % align;
+        WRITE1 (pad);
+        uint8_t zeros[alignof (InvertedLists::idx_t)] = {0};
+        WRITEANDCHECK (zeros, pad);
+        if (size_writer) {
+            size_writer->total += n * (sizeof (InvertedLists::idx_t) + ils->code_size);
+            return;
+        }
+        for (size_t i = 0; i < ils->nlist; i++) {
+            WRITEANDCHECK (ils->get_ids (i), sizes[i]);
+        }
+        for (size_t i = 0; i < ils->nlist; i++) {
+            WRITEANDCHECK (ils->get_codes (i), sizes[i] * ils->code_size);
+        }
     } else if (const auto & od =
                dynamic_cast<const OnDiskInvertedLists *>(ils)) {
         uint32_t h = fourcc ("ilod");
@@ -493,6 +534,12 @@ void write_index (const Index *idx, IOWriter *f) {
     }
 }
 
+size_t write_index_size (const Index *idx) {
+    SizeIOWriter writer;
+    write_index (idx, &writer);
+    return writer.total;
+}
+
 void write_index (const Index *idx, FILE *f) {
     FileIOWriter writer(f);
     write_index (idx, &writer);
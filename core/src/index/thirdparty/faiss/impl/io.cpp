@@ -32,6 +32,11 @@ int IOWriter::fileno ()
     FAISS_THROW_MSG ("IOWriter does not support memory mapping");
 }
 
+size_t IOWriter::tell ()
+{
+    return 0;
+}
+
 /***********************************************************************
  * IO Vector
  ***********************************************************************/
@@ -50,6 +55,11 @@ size_t VectorIOWriter::operator()(
     return nitems;
 }
 
+size_t VectorIOWriter::tell()
+{
+    return data.size();
+}
+
 size_t VectorIOReader::operator()(
                   void *ptr, size_t size, size_t nitems)
 {
@@ -63,6 +73,19 @@ size_t VectorIOReader::operator()(
     return nitems;
 }
 
+size_t MappedIOReader::operator()(
+                  void *ptr, size_t size, size_t nitems)
+{
+    if (rp >= total) return 0;
+    size_t nremain = (total - rp) / size;
+    if (nremain < nitems) nitems = nremain;
+    if (size * nitems > 0) {
+        memcpy (ptr, data + rp, size * nitems);
+        rp += size * nitems;
+    }
+    return nitems;
+}
+
 
 
 
@@ -132,6 +155,11 @@ int FileIOWriter::fileno()  {
     return ::fileno (f);
 }
 
+size_t FileIOWriter::tell()  {
+    long o = ftell (f);
+    return o < 0 ? 0 : o;
+}
+
 uint32_t fourcc (const char sx[4]) {
     assert(4 == strlen(sx));
     const unsigned char *x = (unsigned char*)sx;
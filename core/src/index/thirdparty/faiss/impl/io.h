@@ -15,6 +15,7 @@
 
 #include <string>
 #include <cstdio>
+#include <memory>
 #include <vector>
 
 #include <faiss/Index.h>
@@ -47,6 +48,10 @@ struct IOWriter {
     // return a file number that can be memory-mapped
     virtual int fileno ();
 
+    // number of bytes written so far, used to align data that is mapped
+    // on load. 0 if unknown, the data is then copied on load if unaligned
+    virtual size_t tell ();
+
     virtual ~IOWriter() {}
 };
 
@@ -60,6 +65,19 @@ struct VectorIOReader:IOReader {
 struct VectorIOWriter:IOWriter {
     std::vector<uint8_t> data;
     size_t operator()(const void *ptr, size_t size, size_t nitems) override;
+    size_t tell() override;
+};
+
+/** Reads from a buffer kept alive by owner (typically an mmapped file).
+ * With IO_FLAG_MMAP, read_index references the inverted lists in place
+ * instead of copying them. */
+struct MappedIOReader: IOReader {
+    const uint8_t *data = nullptr;
+    size_t total = 0;
+    size_t rp = 0;
+    std::shared_ptr<const void> owner;
+
+    size_t operator()(void *ptr, size_t size, size_t nitems) override;
 };
 
 struct FileIOReader: IOReader {
@@ -90,6 +108,8 @@ struct FileIOWriter: IOWriter {
     size_t operator()(const void *ptr, size_t size, size_t nitems) override;
 
     int fileno() override;
+
+    size_t tell() override;
 };
 
 /// cast a 4-character string to a uint32_t that can be written and read easily
@@ -37,6 +37,10 @@ void write_index (const Index *idx, const char *fname);
 void write_index (const Index *idx, FILE *f);
 void write_index (const Index *idx, IOWriter *writer);
 
+/// number of bytes write_index() writes for idx, without walking the
+/// data of the inverted lists
+size_t write_index_size (const Index *idx);
+
 void write_index_binary (const IndexBinary *idx, const char *fname);
 void write_index_binary (const IndexBinary *idx, FILE *f);
 void write_index_binary (const IndexBinary *idx, IOWriter *writer);
@@ -14,32 +14,68 @@
 // KIND, either express or implied.  See the License for the
 // specific language governing permissions and limitations
 // under the License.
-
 #include "ConcurrentBitset.h"
 
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
 namespace faiss {
 
-ConcurrentBitset::ConcurrentBitset(id_type_t size) : size_(size) {
-    id_type_t bytes_count = (size >> 3) + 1;
-    // bitset_.resize(bytes_count, 0);
-    for (auto i = 0; i < bytes_count; ++i) {
-        bitset_.emplace_back(0);
+namespace {
+constexpr size_t CACHE_LINE_SIZE = 64;
+}
+
+ConcurrentBitset::ConcurrentBitset(id_type_t size) : size_(size), word_count_((size + WORD_BITS - 1) / WORD_BITS) {
+    static_assert(sizeof(std::atomic<word_t>) == sizeof(word_t), "atomic word must be lock free and unpadded");
+
+    // always keep one word so that test(0) on an empty bitset stays in bound
+    size_t bytes = (word_count_ > 0 ? word_count_ : 1) * sizeof(word_t);
+    bytes = (bytes + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, CACHE_LINE_SIZE, bytes) != 0) {
+        throw std::bad_alloc();
+    }
+
+    words_ = static_cast<std::atomic<word_t>*>(ptr);
+    for (size_t i = 0; i < bytes / sizeof(word_t); ++i) {
+        new (&words_[i]) std::atomic<word_t>(0);
     }
 }
 
-bool
-ConcurrentBitset::test(id_type_t id) {
-    return bitset_[id >> 3].load() & (0x1 << (id & 0x7));
+ConcurrentBitset::~ConcurrentBitset() {
+    free(words_);
 }
 
-void
-ConcurrentBitset::set(id_type_t id) {
-    bitset_[id >> 3].fetch_or(0x1 << (id & 0x7));
+ConcurrentBitset::id_type_t
+ConcurrentBitset::count() const {
+    id_type_t ret = 0;
+    for (id_type_t i = 0; i < word_count_; ++i) {
+        ret += __builtin_popcountll(words_[i].load(std::memory_order_relaxed));
+    }
+    return ret;
 }
 
-void
-ConcurrentBitset::clear(id_type_t id) {
-    bitset_[id >> 3].fetch_and(~(0x1 << (id & 0x7)));
+ConcurrentBitset&
+ConcurrentBitset::operator&=(const ConcurrentBitset& other) {
+    if (other.size_ != size_) {
+        throw std::invalid_argument("ConcurrentBitset size mismatch");
+    }
+    for (id_type_t i = 0; i < word_count_; ++i) {
+        words_[i].fetch_and(other.word(i));
+    }
+    return *this;
+}
+
+ConcurrentBitset&
+ConcurrentBitset::operator|=(const ConcurrentBitset& other) {
+    if (other.size_ != size_) {
+        throw std::invalid_argument("ConcurrentBitset size mismatch");
+    }
+    for (id_type_t i = 0; i < word_count_; ++i) {
+        words_[i].fetch_or(other.word(i));
+    }
+    return *this;
 }
 
 }  // namespace faiss
@@ -14,37 +14,94 @@
 // KIND, either express or implied.  See the License for the
 // specific language governing permissions and limitations
 // under the License.
-
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
-#include <deque>
 
 namespace faiss {
 
+// Bitset stored in contiguous, cache line aligned 64-bit words. set/clear are atomic, so the bitset can be
+// updated while it is being read. Bits beyond size() are always unset.
 class ConcurrentBitset {
  public:
     using id_type_t = int64_t;
+    using word_t = uint64_t;
+
+    static constexpr id_type_t WORD_BITS = 64;
 
     explicit ConcurrentBitset(id_type_t size);
 
-    //    ConcurrentBitset(const ConcurrentBitset&) = delete;
-    //    ConcurrentBitset&
-    //    operator=(const ConcurrentBitset&) = delete;
+    ~ConcurrentBitset();
+
+    ConcurrentBitset(const ConcurrentBitset&) = delete;
+    ConcurrentBitset&
+    operator=(const ConcurrentBitset&) = delete;
 
     bool
-    test(id_type_t id);
+    test(id_type_t id) const {
+        return (words_[id >> 6].load(std::memory_order_relaxed) >> (id & 0x3f)) & 0x1;
+    }
 
     void
-    set(id_type_t id);
+    set(id_type_t id) {
+        words_[id >> 6].fetch_or(word_t(1) << (id & 0x3f));
+    }
 
     void
-    clear(id_type_t id);
+    clear(id_type_t id) {
+        words_[id >> 6].fetch_and(~(word_t(1) << (id & 0x3f)));
+    }
+
+    // Return the first unset id not less than id. Ids beyond size() are never set, so the result is id itself
+    // for those. Scans 64 ids at a time, so runs of set bits are skipped cheaply.
+    id_type_t
+    next_unset(id_type_t id) const {
+        if (id >= size_) {
+            return id;
+        }
+        id_type_t w = id >> 6;
+        word_t word = ~words_[w].load(std::memory_order_relaxed) & (~word_t(0) << (id & 0x3f));
+        while (word == 0) {
+            if (++w >= word_count_) {
+                return w << 6;
+            }
+            word = ~words_[w].load(std::memory_order_relaxed);
+        }
+        return (w << 6) + __builtin_ctzll(word);
+    }
+
+    // Number of set bits
+    id_type_t
+    count() const;
+
+    id_type_t
+    size() const {
+        return size_;
+    }
+
+    id_type_t
+    word_count() const {
+        return word_count_;
+    }
+
+    word_t
+    word(id_type_t index) const {
+        return words_[index].load(std::memory_order_relaxed);
+    }
+
+    // Bitwise operation with a bitset of the same size, each word is updated atomically
+    ConcurrentBitset&
+    operator&=(const ConcurrentBitset& other);
+
+    ConcurrentBitset&
+    operator|=(const ConcurrentBitset& other);
 
  private:
-    std::deque<std::atomic<unsigned char>> bitset_;
     id_type_t size_;
+    id_type_t word_count_;
+    std::atomic<word_t>* words_;
 };
 
 using ConcurrentBitsetPtr = std::shared_ptr<ConcurrentBitset>;
@@ -170,13 +170,17 @@ static void knn_inner_product_sse (const float * x,
             minheap_heapify (k, simi, idxi);
 
             for (size_t j = 0; j < ny; j++) {
-                if(!bitset || !bitset->test(j)){
-                    float ip = fvec_inner_product (x_i, y_j, d);
+                if (bitset && bitset->test(j)) {
+                    // jump over deleted vectors, a whole word at a time
+                    j = bitset->next_unset(j);
+                    if (j >= ny) break;
+                    y_j = y + j * d;
+                }
+                float ip = fvec_inner_product (x_i, y_j, d);
 
-                    if (ip > simi[0]) {
-                        minheap_pop (k, simi, idxi);
-                        minheap_push (k, simi, idxi, ip, j);
-                    }
+                if (ip > simi[0]) {
+                    minheap_pop (k, simi, idxi);
+                    minheap_push (k, simi, idxi, ip, j);
                 }
                 y_j += d;
             }
@@ -212,13 +216,17 @@ static void knn_L2sqr_sse (
 
             maxheap_heapify (k, simi, idxi);
             for (j = 0; j < ny; j++) {
-                if(!bitset || !bitset->test(j)){
-                    float disij = fvec_L2sqr (x_i, y_j, d);
+                if (bitset && bitset->test(j)) {
+                    // jump over deleted vectors, a whole word at a time
+                    j = bitset->next_unset(j);
+                    if (j >= ny) break;
+                    y_j = y + j * d;
+                }
+                float disij = fvec_L2sqr (x_i, y_j, d);
 
-                    if (disij < simi[0]) {
-                        maxheap_pop (k, simi, idxi);
-                        maxheap_push (k, simi, idxi, disij, j);
-                    }
+                if (disij < simi[0]) {
+                    maxheap_pop (k, simi, idxi);
+                    maxheap_push (k, simi, idxi, disij, j);
                 }
                 y_j += d;
             }
@@ -276,13 +284,16 @@ static void knn_inner_product_blas (
                 const float *ip_line = ip_block + (i - i0) * (j1 - j0);
 
                 for(size_t j = j0; j < j1; j++){
-                    if(!bitset || !bitset->test(j)){
-                        float dis = *ip_line;
+                    if (bitset && bitset->test(j)) {
+                        j = bitset->next_unset(j);
+                        if (j >= j1) break;
+                        ip_line = ip_block + (i - i0) * (j1 - j0) + (j - j0);
+                    }
+                    float dis = *ip_line;
 
-                        if(dis > simi[0]){
-                            minheap_pop(k, simi, idxi);
-                            minheap_push(k, simi, idxi, dis, j);
-                        }
+                    if(dis > simi[0]){
+                        minheap_pop(k, simi, idxi);
+                        minheap_push(k, simi, idxi, dis, j);
                     }
                     ip_line++;
                 }
@@ -347,20 +358,23 @@ static void knn_L2sqr_blas (const float * x,
                 const float *ip_line = ip_block + (i - i0) * (j1 - j0);
 
                 for (size_t j = j0; j < j1; j++) {
-                    if(!bitset || !bitset->test(j)){
-                        float ip = *ip_line;
-                        float dis = x_norms[i] + y_norms[j] - 2 * ip;
+                    if (bitset && bitset->test(j)) {
+                        j = bitset->next_unset(j);
+                        if (j >= j1) break;
+                        ip_line = ip_block + (i - i0) * (j1 - j0) + (j - j0);
+                    }
+                    float ip = *ip_line;
+                    float dis = x_norms[i] + y_norms[j] - 2 * ip;
 
-                        // negative values can occur for identical vectors
-                        // due to roundoff errors
-                        if (dis < 0) dis = 0;
+                    // negative values can occur for identical vectors
+                    // due to roundoff errors
+                    if (dis < 0) dis = 0;
 
-                        dis = corr (dis, i, j);
+                    dis = corr (dis, i, j);
 
-                        if (dis < simi[0]) {
-                            maxheap_pop (k, simi, idxi);
-                            maxheap_push (k, simi, idxi, dis, j);
-                        }
+                    if (dis < simi[0]) {
+                        maxheap_pop (k, simi, idxi);
+                        maxheap_push (k, simi, idxi, dis, j);
                     }
                     ip_line++;
                 }
@@ -308,6 +308,41 @@ int km_update_centroids (const float * x,
     return nsplit;
 }
 
+void km_minibatch_update_centroids (const float * x,
+                                    float * centroids,
+                                    const int64_t * assign,
+                                    int64_t * counts,
+                                    size_t d, size_t k, size_t n,
+                                    size_t k_frozen)
+{
+    k -= k_frozen;
+    centroids += k_frozen * d;
+    counts += k_frozen;
+
+#pragma omp parallel
+    {
+        int nt = omp_get_num_threads();
+        int rank = omp_get_thread_num();
+        // this thread is taking care of centroids c0:c1, vectors are
+        // visited in batch order so the result doesn't depend on nt
+        int64_t c0 = (k * rank) / nt;
+        int64_t c1 = (k * (rank + 1)) / nt;
+        const float *xi = x;
+
+        for (size_t i = 0; i < n; i++) {
+            int64_t ci = assign[i] - (int64_t)k_frozen;
+            if (ci >= c0 && ci < c1) {
+                float * c = centroids + ci * d;
+                counts[ci]++;
+                float eta = 1.0f / counts[ci];
+                for (size_t j = 0; j < d; j++)
+                    c[j] += eta * (xi[j] - c[j]);
+            }
+            xi += d;
+        }
+    }
+}
+
 #undef EPS
 
 
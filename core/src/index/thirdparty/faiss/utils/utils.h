@@ -80,6 +80,23 @@ int km_update_centroids (
         size_t d, size_t k, size_t n,
         size_t k_frozen);
 
+/** For mini-batch k-means, move each centroid toward the vectors assigned
+ * to it, with a learning rate of 1 / nb of vectors it has seen so far
+ *
+ * @param x          training vectors of the batch, size n * d
+ * @param centroids  centroid vectors (size k * d)
+ * @param assign     nearest centroid for each training vector (size n)
+ * @param counts     nb of vectors seen by each centroid (size k), updated
+ * @param k_frozen   do not update the k_frozen first centroids
+ */
+void km_minibatch_update_centroids (
+        const float * x,
+        float * centroids,
+        const int64_t * assign,
+        int64_t * counts,
+        size_t d, size_t k, size_t n,
+        size_t k_frozen);
+
 /** compute the Q of the QR decomposition for m > n
  * @param a   size n * m: input matrix and output Q
  */
@@ -2,12 +2,14 @@
 
 #include "visited_list_pool.h"
 #include "hnswlib.h"
+#include <algorithm>
 #include <random>
 #include <stdlib.h>
 #include <unordered_set>
 #include <list>
 
 #include "knowhere/index/vector_index/helpers/FaissIO.h"
+#include "faiss/utils/ConcurrentBitset.h"
 
 namespace hnswlib {
     typedef unsigned int tableint;
@@ -85,6 +87,31 @@ namespace hnswlib {
             }
         };
 
+        // scratch of one search thread, the visited list and the storage of the search queues are kept across
+        // the queries it runs instead of being taken and allocated per query
+        class SearchBuffer {
+        public:
+            explicit SearchBuffer(const HierarchicalNSW &index) : pool_(index.visited_list_pool_) {
+                visited_list_ = pool_->getFreeVisitedList();
+            }
+
+            ~SearchBuffer() {
+                pool_->releaseVisitedList(visited_list_);
+            }
+
+            SearchBuffer(const SearchBuffer &) = delete;
+            SearchBuffer &operator=(const SearchBuffer &) = delete;
+
+        private:
+            friend class HierarchicalNSW;
+
+            VisitedListPool *pool_;
+            VisitedList *visited_list_;
+            // binary heaps ordered by CompareByFirst
+            std::vector<std::pair<dist_t, tableint>> top_candidates_;
+            std::vector<std::pair<dist_t, tableint>> candidate_set_;
+        };
+
         ~HierarchicalNSW() {
 
             free(data_level0_memory_);
@@ -250,42 +277,62 @@ namespace hnswlib {
             return top_candidates;
         }
 
+        // a node filtered out is still expanded, it just never makes it into the result
+        bool isFiltered(tableint internalId, const faiss::ConcurrentBitsetPtr &bitset) const {
+            return isMarkedDeleted(internalId) || (bitset && bitset->test((faiss::ConcurrentBitset::id_type_t)getExternalLabel(internalId)));
+        }
+
         template <bool has_deletions>
         std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
-        searchBaseLayerST(tableint ep_id, const void *data_point, size_t ef) const {
-            VisitedList *vl = visited_list_pool_->getFreeVisitedList();
+        searchBaseLayerST(tableint ep_id, const void *data_point, size_t ef, const faiss::ConcurrentBitsetPtr &bitset = nullptr) const {
+            SearchBuffer buffer(*this);
+            searchBaseLayerST<has_deletions>(ep_id, data_point, ef, bitset, buffer);
+            return std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>(
+                    CompareByFirst(), std::move(buffer.top_candidates_));
+        }
+
+        // leaves the ef closest nodes in buffer.top_candidates_ as a heap, farthest on top
+        template <bool has_deletions>
+        void
+        searchBaseLayerST(tableint ep_id, const void *data_point, size_t ef, const faiss::ConcurrentBitsetPtr &bitset,
+                          SearchBuffer &buffer) const {
+            VisitedList *vl = buffer.visited_list_;
+            vl->reset();
             vl_type *visited_array = vl->mass;
             vl_type visited_array_tag = vl->curV;
 
-            std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates;
-            std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> candidate_set;
+            CompareByFirst comp;
+            auto &top_candidates = buffer.top_candidates_;
+            auto &candidate_set = buffer.candidate_set_;
+            top_candidates.clear();
+            candidate_set.clear();
 
             dist_t lowerBound;
-            if (!has_deletions || !isMarkedDeleted(ep_id)) {
+            if (!has_deletions || !isFiltered(ep_id, bitset)) {
                 dist_t dist = fstdistfunc_(data_point, getDataByInternalId(ep_id), dist_func_param_);
                 lowerBound = dist;
-                top_candidates.emplace(dist, ep_id);
-                candidate_set.emplace(-dist, ep_id);
+                top_candidates.emplace_back(dist, ep_id);
+                candidate_set.emplace_back(-dist, ep_id);
             } else {
                 lowerBound = std::numeric_limits<dist_t>::max();
-                candidate_set.emplace(-lowerBound, ep_id);
+                candidate_set.emplace_back(-lowerBound, ep_id);
             }
 
             visited_array[ep_id] = visited_array_tag;
 
             while (!candidate_set.empty()) {
 
-                std::pair<dist_t, tableint> current_node_pair = candidate_set.top();
+                std::pair<dist_t, tableint> current_node_pair = candidate_set.front();
 
                 if ((-current_node_pair.first) > lowerBound) {
                     break;
                 }
-                candidate_set.pop();
+                std::pop_heap(candidate_set.begin(), candidate_set.end(), comp);
+                candidate_set.pop_back();
 
                 tableint current_node_id = current_node_pair.second;
                 int *data = (int *) get_linklist0(current_node_id);
                 size_t size = getListCount((linklistsizeint*)data);
-//                bool cur_node_deleted = isMarkedDeleted(current_node_id);
 
 #ifdef USE_SSE
                 _mm_prefetch((char *) (visited_array + *(data + 1)), _MM_HINT_T0);
@@ -296,11 +343,10 @@ namespace hnswlib {
 
                 for (size_t j = 1; j <= size; j++) {
                     int candidate_id = *(data + j);
-//                    if (candidate_id == 0) continue;
 #ifdef USE_SSE
                     _mm_prefetch((char *) (visited_array + *(data + j + 1)), _MM_HINT_T0);
                     _mm_prefetch(data_level0_memory_ + (*(data + j + 1)) * size_data_per_element_ + offsetData_,
-                                 _MM_HINT_T0);////////////
+                                 _MM_HINT_T0);
 #endif
                     if (!(visited_array[candidate_id] == visited_array_tag)) {
 
@@ -310,28 +356,30 @@ namespace hnswlib {
                         dist_t dist = fstdistfunc_(data_point, currObj1, dist_func_param_);
 
                         if (top_candidates.size() < ef || lowerBound > dist) {
-                            candidate_set.emplace(-dist, candidate_id);
+                            candidate_set.emplace_back(-dist, candidate_id);
+                            std::push_heap(candidate_set.begin(), candidate_set.end(), comp);
 #ifdef USE_SSE
-                            _mm_prefetch(data_level0_memory_ + candidate_set.top().second * size_data_per_element_ +
-                                         offsetLevel0_,///////////
-                                         _MM_HINT_T0);////////////////////////
+                            _mm_prefetch(data_level0_memory_ + candidate_set.front().second * size_data_per_element_ +
+                                         offsetLevel0_,
+                                         _MM_HINT_T0);
 #endif
 
-                            if (!has_deletions || !isMarkedDeleted(candidate_id))
-                                top_candidates.emplace(dist, candidate_id);
+                            if (!has_deletions || !isFiltered(candidate_id, bitset)) {
+                                top_candidates.emplace_back(dist, candidate_id);
+                                std::push_heap(top_candidates.begin(), top_candidates.end(), comp);
+                            }
 
-                            if (top_candidates.size() > ef)
-                                top_candidates.pop();
+                            if (top_candidates.size() > ef) {
+                                std::pop_heap(top_candidates.begin(), top_candidates.end(), comp);
+                                top_candidates.pop_back();
+                            }
 
                             if (!top_candidates.empty())
-                                lowerBound = top_candidates.top().first;
+                                lowerBound = top_candidates.front().first;
                         }
                     }
                 }
             }
-
-            visited_list_pool_->releaseVisitedList(vl);
-            return top_candidates;
         }
 
         void getNeighborsByHeuristic2(
@@ -1084,9 +1132,49 @@ namespace hnswlib {
 
         std::priority_queue<std::pair<dist_t, labeltype >>
         searchKnn(const void *query_data, size_t k) const {
+            return searchKnn(query_data, k, faiss::ConcurrentBitsetPtr(nullptr));
+        }
+
+        // labels set in bitset are excluded from the result
+        std::priority_queue<std::pair<dist_t, labeltype >>
+        searchKnn(const void *query_data, size_t k, const faiss::ConcurrentBitsetPtr &bitset) const {
             std::priority_queue<std::pair<dist_t, labeltype >> result;
             if (cur_element_count == 0) return result;
 
+            SearchBuffer buffer(*this);
+            searchBaseLayerKnn(query_data, k, ef_, bitset, buffer);
+            for (auto &rez : buffer.top_candidates_) {
+                result.push(std::pair<dist_t, labeltype>(rez.first, getExternalLabel(rez.second)));
+            }
+            return result;
+        };
+
+        // searches with the ef of this call rather than ef_, so searches with different ef can share the index,
+        // the k results are written closest first, slots left without a result get label -1 and distance -1
+        void
+        searchKnn(const void *query_data, size_t k, size_t ef, const faiss::ConcurrentBitsetPtr &bitset,
+                  dist_t *distances, labeltype *labels, SearchBuffer &buffer) const {
+            size_t found = 0;
+            if (cur_element_count > 0) {
+                searchBaseLayerKnn(query_data, k, ef, bitset, buffer);
+
+                auto &top_candidates = buffer.top_candidates_;
+                found = top_candidates.size();
+                for (size_t i = found; i > 0; i--) {
+                    distances[i - 1] = top_candidates.front().first;
+                    labels[i - 1] = getExternalLabel(top_candidates.front().second);
+                    std::pop_heap(top_candidates.begin(), top_candidates.end(), CompareByFirst());
+                    top_candidates.pop_back();
+                }
+            }
+            for (size_t i = found; i < k; i++) {
+                distances[i] = -1;
+                labels[i] = -1;
+            }
+        }
+
+        // greedy walk down the upper layers, returns the entry node of the base layer
+        tableint searchUpperLayers(const void *query_data) const {
             tableint currObj = enterpoint_node_;
             dist_t curdist = fstdistfunc_(query_data, getDataByInternalId(enterpoint_node_), dist_func_param_);
 
@@ -1099,10 +1187,18 @@ namespace hnswlib {
                     data = (unsigned int *) get_linklist(currObj, level);
                     int size = getListCount(data);
                     tableint *datal = (tableint *) (data + 1);
+#ifdef USE_SSE
+                    if (size > 0)
+                        _mm_prefetch(getDataByInternalId(datal[0]), _MM_HINT_T0);
+#endif
                     for (int i = 0; i < size; i++) {
                         tableint cand = datal[i];
                         if (cand < 0 || cand > max_elements_)
                             throw std::runtime_error("cand error");
+#ifdef USE_SSE
+                        if (i + 1 < size)
+                            _mm_prefetch(getDataByInternalId(datal[i + 1]), _MM_HINT_T0);
+#endif
                         dist_t d = fstdistfunc_(query_data, getDataByInternalId(cand), dist_func_param_);
 
                         if (d < curdist) {
@@ -1113,36 +1209,43 @@ namespace hnswlib {
                     }
                 }
             }
+            return currObj;
+        }
 
-            std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates;
-            if (has_deletions_) {
-                std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates1=searchBaseLayerST<true>(
-                        currObj, query_data, std::max(ef_, k));
-                top_candidates.swap(top_candidates1);
+        // leaves the k closest nodes in buffer.top_candidates_ as a heap, farthest on top
+        void searchBaseLayerKnn(const void *query_data, size_t k, size_t ef, const faiss::ConcurrentBitsetPtr &bitset,
+                                SearchBuffer &buffer) const {
+            tableint currObj = searchUpperLayers(query_data);
+
+            auto &top_candidates = buffer.top_candidates_;
+            if (has_deletions_ || bitset) {
+                // when many neighbours are filtered out the beam may end with less than k results,
+                // grow ef and search again until k results are found or the whole graph is covered
+                size_t search_ef = std::max(ef, k);
+                while (true) {
+                    searchBaseLayerST<true>(currObj, query_data, search_ef, bitset, buffer);
+                    if (top_candidates.size() >= k || search_ef >= cur_element_count) {
+                        break;
+                    }
+                    search_ef *= 2;
+                }
             }
             else{
-                std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates1=searchBaseLayerST<false>(
-                        currObj, query_data, std::max(ef_, k));
-                top_candidates.swap(top_candidates1);
+                searchBaseLayerST<false>(currObj, query_data, std::max(ef, k), bitset, buffer);
             }
             while (top_candidates.size() > k) {
-                top_candidates.pop();
+                std::pop_heap(top_candidates.begin(), top_candidates.end(), CompareByFirst());
+                top_candidates.pop_back();
             }
-            while (top_candidates.size() > 0) {
-                std::pair<dist_t, tableint> rez = top_candidates.top();
-                result.push(std::pair<dist_t, labeltype>(rez.first, getExternalLabel(rez.second)));
-                top_candidates.pop();
-            }
-            return result;
-        };
+        }
 
         template <typename Comp>
         std::vector<std::pair<dist_t, labeltype>>
-        searchKnn(const void* query_data, size_t k, Comp comp) {
+        searchKnn(const void* query_data, size_t k, Comp comp, const faiss::ConcurrentBitsetPtr &bitset = nullptr) const {
             std::vector<std::pair<dist_t, labeltype>> result;
             if (cur_element_count == 0) return result;
 
-            auto ret = searchKnn(query_data, k);
+            auto ret = searchKnn(query_data, k, bitset);
 
             while (!ret.empty()) {
                 result.push_back(ret.top());
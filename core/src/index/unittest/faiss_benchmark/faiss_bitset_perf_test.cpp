@@ -0,0 +1,173 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include <gtest/gtest.h>
+
+#include <sys/time.h>
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+#include <faiss/utils/ConcurrentBitset.h>
+
+/*****************************************************
+ * Micro benchmark of faiss::ConcurrentBitset, compared
+ * with the former byte-wise std::deque implementation.
+ *****************************************************/
+
+namespace {
+
+double
+elapsed() {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+// the former implementation, kept here as baseline
+class DequeBitset {
+ public:
+    explicit DequeBitset(int64_t size) {
+        for (int64_t i = 0; i < (size >> 3) + 1; ++i) {
+            bitset_.emplace_back(0);
+        }
+    }
+
+    bool
+    test(int64_t id) {
+        return bitset_[id >> 3].load() & (0x1 << (id & 0x7));
+    }
+
+    void
+    set(int64_t id) {
+        bitset_[id >> 3].fetch_or(0x1 << (id & 0x7));
+    }
+
+ private:
+    std::deque<std::atomic<unsigned char>> bitset_;
+};
+
+const int64_t NB = 10000000;
+const int32_t LOOPS = 10;
+
+}  // namespace
+
+TEST(BITSET_PERF_TEST, BASIC_TEST) {
+    const int64_t size = 1000;
+    faiss::ConcurrentBitset bitset(size);
+    ASSERT_EQ(bitset.count(), 0);
+    ASSERT_EQ(bitset.next_unset(0), 0);
+
+    for (int64_t i = 0; i < size; i += 3) {
+        bitset.set(i);
+    }
+    for (int64_t i = 0; i < size; ++i) {
+        ASSERT_EQ(bitset.test(i), i % 3 == 0);
+    }
+    ASSERT_EQ(bitset.count(), (size + 2) / 3);
+    ASSERT_EQ(bitset.next_unset(0), 1);
+    ASSERT_EQ(bitset.next_unset(3), 4);
+
+    for (int64_t i = 0; i < 200; ++i) {
+        bitset.set(i);
+    }
+    ASSERT_EQ(bitset.next_unset(0), 200);
+    ASSERT_EQ(bitset.next_unset(size), size);
+
+    bitset.clear(100);
+    ASSERT_FALSE(bitset.test(100));
+    ASSERT_EQ(bitset.next_unset(0), 100);
+
+    faiss::ConcurrentBitset other(size);
+    other.set(0);
+    other.set(100);
+    bitset &= other;
+    ASSERT_EQ(bitset.count(), 1);
+    ASSERT_TRUE(bitset.test(0));
+    bitset |= other;
+    ASSERT_EQ(bitset.count(), 2);
+    ASSERT_TRUE(bitset.test(100));
+}
+
+TEST(BITSET_PERF_TEST, SCAN_TEST) {
+    const std::vector<int32_t> percentages = {0, 5, 50, 90, 100};
+
+    for (auto percentage : percentages) {
+        DequeBitset deque_bitset(NB);
+        faiss::ConcurrentBitset bitset(NB);
+        if (percentage != 0) {
+            // delete in contiguous runs, as ApplyDeletes on a heavily deleted segment does
+            int64_t run = 64 * percentage;
+            for (int64_t i = 0; i < NB; i += 6400) {
+                for (int64_t j = i; j < i + run && j < NB; ++j) {
+                    deque_bitset.set(j);
+                    bitset.set(j);
+                }
+            }
+        }
+
+        int64_t expect = 0, count = 0;
+        double t0 = elapsed();
+        for (int32_t loop = 0; loop < LOOPS; ++loop) {
+            for (int64_t i = 0; i < NB; ++i) {
+                if (!deque_bitset.test(i)) {
+                    ++expect;
+                }
+            }
+        }
+        double t_deque = elapsed() - t0;
+
+        count = 0;
+        t0 = elapsed();
+        for (int32_t loop = 0; loop < LOOPS; ++loop) {
+            for (int64_t i = 0; i < NB; ++i) {
+                if (!bitset.test(i)) {
+                    ++count;
+                }
+            }
+        }
+        double t_test = elapsed() - t0;
+        ASSERT_EQ(count, expect);
+
+        count = 0;
+        t0 = elapsed();
+        for (int32_t loop = 0; loop < LOOPS; ++loop) {
+            // the way search loops skip deleted vectors
+            for (int64_t i = 0; i < NB; ++i) {
+                if (bitset.test(i)) {
+                    i = bitset.next_unset(i);
+                    if (i >= NB) {
+                        break;
+                    }
+                }
+                ++count;
+            }
+        }
+        double t_next = elapsed() - t0;
+        ASSERT_EQ(count, expect);
+
+        t0 = elapsed();
+        for (int32_t loop = 0; loop < LOOPS; ++loop) {
+            count = bitset.count();
+        }
+        double t_count = elapsed() - t0;
+        ASSERT_EQ(count * LOOPS, NB * LOOPS - expect);
+
+        printf("deleted %3d%%: deque test %.3f s, test %.3f s, skip %.3f s, count %.3f s\n", percentage,
+               t_deque, t_test, t_next, t_count);
+    }
+}
@@ -0,0 +1,135 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include <gtest/gtest.h>
+
+#include <sys/time.h>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <faiss/IndexFlat.h>
+#include <faiss/IndexIVFFlat.h>
+
+/*****************************************************
+ * Build time vs recall of IVF_FLAT with k-means trained
+ * on all rows, on sampled rows, and with mini-batches.
+ *****************************************************/
+
+namespace {
+
+double
+elapsed() {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+const int64_t DIM = 64;
+const int64_t NB = 200000;
+const int64_t NQ = 1000;
+const int64_t NLIST = 1024;
+const int64_t NPROBE = 16;
+const int64_t TOPK = 10;
+const int64_t BLOBS = 4096;
+
+// gaussian blobs, so that the centroids found by k-means matter for recall
+void
+GenData(int64_t n, std::mt19937& rng, const std::vector<float>& centers, std::vector<float>& data) {
+    std::uniform_int_distribution<int64_t> blob(0, BLOBS - 1);
+    std::normal_distribution<float> noise(0.0f, 0.3f);
+    data.resize(n * DIM);
+    for (int64_t i = 0; i < n; ++i) {
+        const float* center = centers.data() + blob(rng) * DIM;
+        for (int64_t j = 0; j < DIM; ++j) {
+            data[i * DIM + j] = center[j] + noise(rng);
+        }
+    }
+}
+
+struct TrainConfig {
+    std::string name_;
+    int max_points_per_centroid_;
+    int batch_size_;
+};
+
+}  // namespace
+
+TEST(KMEANS_PERF_TEST, BUILD_RECALL_TEST) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+    std::vector<float> centers(BLOBS * DIM);
+    for (auto& value : centers) {
+        value = uniform(rng);
+    }
+
+    std::vector<float> xb, xq;
+    GenData(NB, rng, centers, xb);
+    GenData(NQ, rng, centers, xq);
+
+    faiss::IndexFlatL2 flat(DIM);
+    flat.add(NB, xb.data());
+    std::vector<float> gt_dis(NQ * TOPK);
+    std::vector<faiss::Index::idx_t> gt_ids(NQ * TOPK);
+    flat.search(NQ, xq.data(), TOPK, gt_dis.data(), gt_ids.data());
+
+    // max_points_per_centroid = NB trains on all rows, as knowhere did before sampling
+    const std::vector<TrainConfig> configs = {
+        {"all rows", NB, 0},
+        {"256 points per centroid", 256, 0},
+        {"64 points per centroid", 64, 0},
+        {"256 points per centroid, mini-batch 65536", 256, 65536},
+        {"64 points per centroid, mini-batch 16384", 64, 16384},
+    };
+
+    for (auto& config : configs) {
+        faiss::IndexFlatL2 quantizer(DIM);
+        faiss::IndexIVFFlat index(&quantizer, DIM, NLIST);
+        index.cp.max_points_per_centroid = config.max_points_per_centroid_;
+        index.cp.batch_size = config.batch_size_;
+
+        double t0 = elapsed();
+        index.train(NB, xb.data());
+        double t_train = elapsed() - t0;
+
+        t0 = elapsed();
+        index.add(NB, xb.data());
+        double t_add = elapsed() - t0;
+
+        index.nprobe = NPROBE;
+        std::vector<float> dis(NQ * TOPK);
+        std::vector<faiss::Index::idx_t> ids(NQ * TOPK);
+        index.search(NQ, xq.data(), TOPK, dis.data(), ids.data());
+
+        int64_t hit = 0;
+        for (int64_t i = 0; i < NQ; ++i) {
+            for (int64_t j = 0; j < TOPK; ++j) {
+                for (int64_t k = 0; k < TOPK; ++k) {
+                    if (ids[i * TOPK + j] == gt_ids[i * TOPK + k]) {
+                        ++hit;
+                        break;
+                    }
+                }
+            }
+        }
+        double recall = 1.0 * hit / (NQ * TOPK);
+
+        printf("%-45s train %.3f s, add %.3f s, recall@%ld %.4f (nprobe %ld)\n", config.name_.c_str(), t_train,
+               t_add, TOPK, recall, NPROBE);
+        ASSERT_GT(recall, 0.5);
+    }
+}
@@ -0,0 +1,110 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexHNSW.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+#include "unittest/utils.h"
+
+class HNSWTest : public DataGen, public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        Generate(64, 2000, 10);
+        index_ = std::make_shared<knowhere::IndexHNSW>();
+        conf = knowhere::Config{
+            {knowhere::meta::DIM, dim},
+            {knowhere::meta::TOPK, k},
+            {knowhere::IndexParams::M, 16},
+            {knowhere::IndexParams::efConstruction, 200},
+            {knowhere::IndexParams::ef, 64},
+            {knowhere::Metric::TYPE, knowhere::Metric::L2},
+        };
+    }
+
+ protected:
+    knowhere::Config conf;
+    std::shared_ptr<knowhere::IndexHNSW> index_ = nullptr;
+};
+
+TEST_F(HNSWTest, hnsw_basic) {
+    ASSERT_ANY_THROW(index_->Search(query_dataset, conf));
+
+    index_->Train(base_dataset, conf);
+    index_->Add(base_dataset, conf);
+    EXPECT_EQ(index_->Count(), nb);
+    EXPECT_EQ(index_->Dimension(), dim);
+
+    auto result = index_->Search(query_dataset, conf);
+    AssertAnns(result, nq, k);
+}
+
+TEST_F(HNSWTest, hnsw_blacklist) {
+    index_->Train(base_dataset, conf);
+    index_->Add(base_dataset, conf);
+    auto result = index_->Search(query_dataset, conf);
+    AssertAnns(result, nq, k);
+
+    // delete every vector found by the first search, none of them may show up again
+    auto bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+    auto ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        if (ids[i] >= 0) {
+            bitset->set(ids[i]);
+        }
+    }
+    index_->SetBlacklist(bitset);
+    faiss::ConcurrentBitsetPtr blacklist;
+    index_->GetBlacklist(blacklist);
+    ASSERT_EQ(blacklist, bitset);
+
+    auto filtered_result = index_->Search(query_dataset, conf);
+    AssertAnns(filtered_result, nq, k, CheckMode::CHECK_NOT_EQUAL);
+    auto filtered_ids = filtered_result->Get<int64_t*>(knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        ASSERT_GE(filtered_ids[i], 0);
+        ASSERT_FALSE(bitset->test(filtered_ids[i]));
+    }
+}
+
+TEST_F(HNSWTest, hnsw_blacklist_concurrent) {
+    index_->Train(base_dataset, conf);
+    index_->Add(base_dataset, conf);
+
+    // deletes replace the blacklist while searches read it
+    std::atomic<bool> stop(false);
+    std::thread setter([&]() {
+        int64_t round = 0;
+        while (!stop) {
+            auto bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+            bitset->set(round++ % nb);
+            index_->SetBlacklist(bitset);
+        }
+    });
+
+    for (int64_t i = 0; i < 100; ++i) {
+        auto result = index_->Search(query_dataset, conf);
+        auto ids = result->Get<int64_t*>(knowhere::meta::IDS);
+        for (int64_t j = 0; j < nq * k; ++j) {
+            EXPECT_GE(ids[j], 0);
+            EXPECT_LT(ids[j], nb);
+        }
+    }
+    stop = true;
+    setter.join();
+}
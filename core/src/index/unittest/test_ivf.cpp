@@ -13,12 +13,22 @@
 
 #include <fiu-control.h>
 #include <fiu-local.h>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <random>
 #include <thread>
 
+#include <faiss/IndexFlat.h>
+#include <faiss/IndexIVFFlat.h>
+#include <faiss/InvertedLists.h>
+#include <faiss/impl/io.h>
+#include <faiss/index_io.h>
+
 #ifdef MILVUS_GPU_VERSION
 
 #include <faiss/gpu/GpuIndexIVFFlat.h>
+#include <faiss/gpu/StandardGpuResources.h>
 
 #endif
 
@@ -215,6 +225,161 @@ TEST_P(IVFTest, ivf_serialize) {
         EXPECT_EQ(index_->Dimension(), dim);
         auto result = index_->Search(query_dataset, conf);
         AssertAnns(result, nq, conf[knowhere::meta::TOPK]);
+
+        // a cpu index streams the same binary, its size is known before it is written
+        if (index_type.find("GPU") == std::string::npos && index_type.find("Hybrid") == std::string::npos) {
+            faiss::VectorIOWriter writer;
+            index_->SerializeTo(&writer);
+            EXPECT_EQ(writer.data.size(), bin->size);
+            EXPECT_EQ(index_->SerializedSize(), (int64_t)writer.data.size());
+        }
+    }
+}
+
+TEST_P(IVFTest, ivf_compact) {
+    if (index_type.find("GPU") != std::string::npos || index_type.find("Hybrid") != std::string::npos) {
+        return;
+    }
+
+    auto model = index_->Train(base_dataset, conf);
+    index_->set_index_model(model);
+    index_->Add(base_dataset, conf);
+
+    // offset map shorter than the index
+    ASSERT_ANY_THROW(index_->Compact(std::vector<int64_t>(nb / 2, 0)));
+
+    // drop the vectors at odd offsets
+    std::vector<int64_t> offset_map(nb);
+    for (int64_t i = 0; i < nb; ++i) {
+        offset_map[i] = (i % 2 == 0) ? i / 2 : -1;
+    }
+    index_->Compact(offset_map);
+    EXPECT_EQ(index_->Count(), (nb + 1) / 2);
+    EXPECT_EQ(index_->Dimension(), dim);
+
+    auto result = index_->Search(query_dataset, conf);
+    int64_t k = conf[knowhere::meta::TOPK];
+    auto ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq; ++i) {
+        if (i % 2 == 0) {
+            ASSERT_EQ(ids[i * k], i / 2);
+        }
+        for (int64_t j = 0; j < k; ++j) {
+            ASSERT_LT(ids[i * k + j], index_->Count());
+        }
+    }
+}
+
+TEST_P(IVFTest, ivf_sampled_train) {
+    if (index_type.find("GPU") != std::string::npos || index_type.find("Hybrid") != std::string::npos) {
+        return;
+    }
+
+    // k-means on 40 rows per centroid with mini-batches of 1000 rows
+    auto train_conf = conf;
+    train_conf[knowhere::IndexParams::max_points_per_centroid] = 40;
+    train_conf[knowhere::IndexParams::kmeans_batch_size] = 1000;
+
+    auto model = index_->Train(base_dataset, train_conf);
+    index_->set_index_model(model);
+    index_->Add(base_dataset, conf);
+    EXPECT_EQ(index_->Count(), nb);
+
+    auto result = index_->Search(query_dataset, conf);
+    AssertAnns(result, nq, conf[knowhere::meta::TOPK]);
+}
+
+TEST(IVFMappedTest, mapped_lists) {
+    const int64_t dim = 16, nb = 2000, nq = 10, k = 5;
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> distrib(0, 1);
+    std::vector<float> xb(nb * dim);
+    for (auto& x : xb) {
+        x = distrib(rng);
+    }
+
+    faiss::IndexFlatL2 quantizer(dim);
+    faiss::IndexIVFFlat index(&quantizer, dim, 32);
+    index.train(nb, xb.data());
+    index.add(nb, xb.data());
+    index.nprobe = 4;
+
+    std::vector<faiss::Index::idx_t> expect_ids(nq * k);
+    std::vector<float> expect_dis(nq * k);
+    index.search(nq, xb.data(), k, expect_dis.data(), expect_ids.data());
+
+    // write after `prefix` bytes, then read from a buffer starting at that offset
+    auto load = [&](size_t prefix) {
+        faiss::VectorIOWriter writer;
+        writer.data.resize(prefix);
+        faiss::write_index(&index, &writer);
+        std::shared_ptr<uint8_t> data(new uint8_t[writer.data.size()], std::default_delete<uint8_t[]>());
+        memcpy(data.get(), writer.data.data(), writer.data.size());
+
+        faiss::MappedIOReader reader;
+        reader.data = data.get() + prefix;
+        reader.total = writer.data.size() - prefix;
+        reader.owner = data;
+        return std::unique_ptr<faiss::IndexIVF>(
+            dynamic_cast<faiss::IndexIVF*>(faiss::read_index(&reader, faiss::IO_FLAG_MMAP)));
+    };
+    auto check_search = [&](faiss::Index* loaded) {
+        std::vector<faiss::Index::idx_t> ids(nq * k);
+        std::vector<float> dis(nq * k);
+        loaded->search(nq, xb.data(), k, dis.data(), ids.data());
+        EXPECT_EQ(ids, expect_ids);
+        EXPECT_EQ(dis, expect_dis);
+    };
+    auto check_size = [&]() {
+        faiss::VectorIOWriter writer;
+        faiss::write_index(&index, &writer);
+        EXPECT_EQ(faiss::write_index_size(&index), writer.data.size());
+    };
+
+    {
+        check_size();
+
+        // "ilar" lists interleave codes and ids, all ids are shifted alike by the offset. They are mapped
+        // at one offset out of alignof(idx_t) and copied at the others
+        size_t mapped = 0;
+        for (size_t prefix = 0; prefix < alignof(faiss::Index::idx_t); ++prefix) {
+            auto loaded = load(prefix);
+            ASSERT_NE(loaded, nullptr);
+            auto mils = dynamic_cast<faiss::MappedInvertedLists*>(loaded->invlists);
+            if (mils != nullptr) {
+                ++mapped;
+                EXPECT_EQ(mils->all_ids, nullptr);
+            }
+            check_search(loaded.get());
+        }
+        EXPECT_EQ(mapped, 1);
+    }
+
+    // read-only lists are written as "ilal", ids of all lists padded to idx_t alignment
+    index.to_readonly();
+    check_size();
+    for (size_t prefix = 0; prefix < alignof(faiss::Index::idx_t); ++prefix) {
+        auto loaded = load(prefix);
+        ASSERT_NE(loaded, nullptr);
+        auto mils = dynamic_cast<faiss::MappedInvertedLists*>(loaded->invlists);
+        ASSERT_NE(mils, nullptr);
+        ASSERT_NE(mils->all_ids, nullptr);
+        ASSERT_NE(mils->all_codes, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(mils->all_ids) % alignof(faiss::Index::idx_t), 0);
+        check_search(loaded.get());
+
+#ifdef MILVUS_GPU_VERSION
+        // the back to back lists are copied to GPU in one go
+        faiss::gpu::StandardGpuResources res;
+        faiss::gpu::GpuIndexIVFFlat gpu_index(&res, dynamic_cast<faiss::IndexIVFFlat*>(loaded.get()));
+        EXPECT_EQ(gpu_index.ntotal, nb);
+        std::vector<faiss::Index::idx_t> ids(nq * k);
+        std::vector<float> dis(nq * k);
+        gpu_index.search(nq, xb.data(), k, dis.data(), ids.data());
+        for (int64_t i = 0; i < nq; ++i) {
+            EXPECT_EQ(ids[i * k], expect_ids[i * k]);
+        }
+#endif
     }
 }
 
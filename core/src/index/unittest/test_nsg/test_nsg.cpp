@@ -116,6 +116,33 @@ TEST_F(NSGInterfaceTest, basic_test) {
     });
 }
 
+TEST_F(NSGInterfaceTest, blacklist_test) {
+    train_conf[knowhere::meta::DEVICEID] = DEVICEID;
+    index_->Train(base_dataset, train_conf);
+    auto result = index_->Search(query_dataset, search_conf);
+    AssertAnns(result, nq, k);
+
+    // delete every vector found by the first search, none of them may show up again
+    auto bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+    auto ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        if (ids[i] >= 0) {
+            bitset->set(ids[i]);
+        }
+    }
+    index_->SetBlacklist(bitset);
+    faiss::ConcurrentBitsetPtr blacklist;
+    index_->GetBlacklist(blacklist);
+    ASSERT_EQ(blacklist, bitset);
+
+    auto filtered_result = index_->Search(query_dataset, search_conf);
+    auto filtered_ids = filtered_result->Get<int64_t*>(knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        ASSERT_GE(filtered_ids[i], 0);
+        ASSERT_FALSE(bitset->test(filtered_ids[i]));
+    }
+}
+
 TEST_F(NSGInterfaceTest, comparetest) {
     knowhere::algo::DistanceL2 distanceL2;
     knowhere::algo::DistanceIP distanceIP;
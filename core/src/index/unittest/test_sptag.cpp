@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include "knowhere/adapter/SptagAdapter.h"
 #include "knowhere/adapter/VectorAdapter.h"
@@ -101,6 +102,37 @@ TEST_P(SPTAGTest, sptag_basic) {
     }
 }
 
+TEST_P(SPTAGTest, sptag_blacklist) {
+    auto preprocessor = index_->BuildPreprocessor(base_dataset, conf);
+    index_->set_preprocessor(preprocessor);
+    auto model = index_->Train(base_dataset, conf);
+    index_->set_index_model(model);
+    index_->Add(base_dataset, conf);
+    auto result = index_->Search(query_dataset, conf);
+    AssertAnns(result, nq, k);
+
+    // delete every vector found by the first search, none of them may show up again
+    auto bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+    auto ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        if (ids[i] >= 0) {
+            bitset->set(ids[i]);
+        }
+    }
+    index_->SetBlacklist(bitset);
+    faiss::ConcurrentBitsetPtr blacklist;
+    index_->GetBlacklist(blacklist);
+    ASSERT_EQ(blacklist, bitset);
+
+    auto filtered_result = index_->Search(query_dataset, conf);
+    AssertAnns(filtered_result, nq, k, CheckMode::CHECK_NOT_EQUAL);
+    auto filtered_ids = filtered_result->Get<int64_t*>(knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        ASSERT_GE(filtered_ids[i], 0);
+        ASSERT_FALSE(bitset->test(filtered_ids[i]));
+    }
+}
+
 TEST_P(SPTAGTest, sptag_serialize) {
     assert(!xb.empty());
 
@@ -83,6 +83,14 @@ class MetricsBase {
     CacheAccessTotalIncrement(double value = 1) {
     }
 
+    virtual void
+    CacheLoadTotalIncrement(double value = 1) {
+    }
+
+    virtual void
+    CacheLoadWaitTotalIncrement(double value = 1) {
+    }
+
     virtual void
     MemTableMergeDurationSecondsHistogramObserve(double value) {
     }
@@ -146,6 +146,20 @@ class PrometheusMetrics : public MetricsBase {
         }
     }
 
+    void
+    CacheLoadTotalIncrement(double value = 1) override {
+        if (startup_) {
+            cache_load_total_.Increment(value);
+        }
+    }
+
+    void
+    CacheLoadWaitTotalIncrement(double value = 1) override {
+        if (startup_) {
+            cache_load_wait_total_.Increment(value);
+        }
+    }
+
     void
     MemTableMergeDurationSecondsHistogramObserve(double value) override {
         if (startup_) {
@@ -543,6 +557,14 @@ class PrometheusMetrics : public MetricsBase {
                                                                  .Register(*registry_);
     prometheus::Counter& cache_access_total_ = cache_access_.Add({});
 
+    // record cache misses loaded from disk, and the ones served by waiting on a load already in flight
+    prometheus::Family<prometheus::Counter>& cache_load_ = prometheus::BuildCounter()
+                                                               .Name("cache_load_total")
+                                                               .Help("the count of loading data into cache")
+                                                               .Register(*registry_);
+    prometheus::Counter& cache_load_total_ = cache_load_.Add({{"type", "loaded"}});
+    prometheus::Counter& cache_load_wait_total_ = cache_load_.Add({{"type", "waited"}});
+
     // record CPU cache usage and %
     prometheus::Family<prometheus::Gauge>& cpu_cache_usage_ =
         prometheus::BuildGauge().Name("cache_usage_bytes").Help("current cache usage by bytes").Register(*registry_);
@@ -28,7 +28,18 @@ namespace scheduler {
 
 class BuildMgr {
  public:
-    explicit BuildMgr(int64_t concurrent_limit) : available_(concurrent_limit) {
+    explicit BuildMgr(int64_t concurrent_limit) : concurrent_limit_(concurrent_limit), available_(concurrent_limit) {
+    }
+
+ public:
+    /*
+     * Change the number of build tasks loaded at the same time, the places already taken are kept;
+     */
+    void
+    SetLimit(int64_t concurrent_limit) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        available_ += concurrent_limit - concurrent_limit_;
+        concurrent_limit_ = concurrent_limit;
     }
 
  public:
@@ -55,6 +66,7 @@ class BuildMgr {
     }
 
  private:
+    std::int64_t concurrent_limit_;
     std::int64_t available_;
     std::mutex mutex_;
 };
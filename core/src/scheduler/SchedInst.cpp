@@ -38,19 +38,31 @@ std::mutex OptimizerInst::mutex_;
 BuildMgrPtr BuildMgrInst::instance = nullptr;
 std::mutex BuildMgrInst::mutex_;
 
+// build index tasks loaded ahead of the running ones
+constexpr int64_t BUILD_INDEX_PRELOAD = 3;
+
 void
 load_simple_config() {
     // create and connect
     ResMgrInst::GetInstance()->Add(ResourceFactory::Create("disk", "DISK", 0, false));
 
     auto io = Connection("io", 500);
-    ResMgrInst::GetInstance()->Add(ResourceFactory::Create("cpu", "CPU", 0));
+    auto cpu = ResourceFactory::Create("cpu", "CPU", 0);
+
+    // index builds on cpu run on their own threads, a few more raw files are loaded to keep them busy
+    server::Config& config = server::Config::GetInstance();
+    int64_t build_index_concurrency = 1, build_index_threads = 0;
+    config.GetEngineConfigBuildIndexConcurrency(build_index_concurrency);
+    config.GetEngineConfigBuildIndexThreads(build_index_threads);
+    cpu->EnableBuildExecutor(build_index_concurrency, build_index_threads);
+    BuildMgrInst::GetInstance()->SetLimit(build_index_concurrency + BUILD_INDEX_PRELOAD);
+
+    ResMgrInst::GetInstance()->Add(std::move(cpu));
     ResMgrInst::GetInstance()->Connect("disk", "cpu", io);
 
 // get resources
 #ifdef MILVUS_GPU_VERSION
     bool enable_gpu = false;
-    server::Config& config = server::Config::GetInstance();
     config.GetGpuResourceConfigEnable(enable_gpu);
     if (enable_gpu) {
         std::vector<int64_t> gpu_ids;
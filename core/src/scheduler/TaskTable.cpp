@@ -147,7 +147,7 @@ TaskTableItem::Dump() const {
 }
 
 std::vector<uint64_t>
-TaskTable::PickToLoad(uint64_t limit) {
+TaskTable::PickToLoad(uint64_t limit, bool count_build) {
 #if 1
     TimeRecorder rc("");
     std::vector<uint64_t> indexes;
@@ -164,6 +164,8 @@ TaskTable::PickToLoad(uint64_t limit) {
             table_.set_front(index);
         } else if (table_[index]->state == TaskTableItemState::LOADED) {
             cross = true;
+            if (not count_build && table_[index]->task->Type() == TaskType::BuildIndexTask)
+                continue;
             ++loaded_count;
             if (loaded_count > 2)
                 return std::vector<uint64_t>();
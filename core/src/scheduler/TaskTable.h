@@ -119,8 +119,13 @@ class TaskTable : public interface::dumpable {
     size_t
     TaskToExecute();
 
+    /*
+     * Pick tasks to load, at most 2 loaded tasks wait for the executor at a time;
+     * With count_build false, loaded build index tasks wait for build threads and
+     * don't hold back other tasks, BuildMgr bounds how many of them are loaded;
+     */
     std::vector<uint64_t>
-    PickToLoad(uint64_t limit);
+    PickToLoad(uint64_t limit, bool count_build = true);
 
     std::vector<uint64_t>
     PickToExecute(uint64_t limit);
@@ -11,11 +11,16 @@
 
 #include "scheduler/job/SearchJob.h"
 
+#include <algorithm>
+#include <queue>
+
 #include "utils/Log.h"
 
 namespace milvus {
 namespace scheduler {
 
+static constexpr size_t PARALLEL_MERGE_THRESHOLD = 10000;
+
 SearchJob::SearchJob(const std::shared_ptr<server::Context>& context, uint64_t topk, const milvus::json& extra_params,
                      const engine::VectorsData& vectors)
     : Job(JobType::SEARCH), context_(context), topk_(topk), extra_params_(extra_params), vectors_(vectors) {
@@ -31,6 +36,8 @@ SearchJob::AddIndexFile(const TableFileSchemaPtr& index_file) {
     SERVER_LOG_DEBUG << "SearchJob " << id() << " add index file: " << index_file->id_;
 
     index_files_[index_file->id_] = index_file;
+    result_slots_[index_file->id_] = search_results_.size();
+    search_results_.emplace_back();
     return true;
 }
 
@@ -45,11 +52,69 @@ void
 SearchJob::SearchDone(size_t index_id) {
     std::unique_lock<std::mutex> lock(mutex_);
     index_files_.erase(index_id);
+    SERVER_LOG_DEBUG << "SearchJob " << id() << " finish index file: " << index_id;
+
     if (index_files_.empty()) {
+        MergeSearchResults(search_results_, nq(), topk_, result_ids_, result_distances_);
         cv_.notify_all();
     }
+}
 
-    SERVER_LOG_DEBUG << "SearchJob " << id() << " finish index file: " << index_id;
+SearchResult&
+SearchJob::GetSearchResult(size_t index_id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return search_results_[result_slots_[index_id]];
+}
+
+void
+SearchJob::MergeSearchResults(const std::vector<SearchResult>& search_results, uint64_t nq, uint64_t topk,
+                              ResultIds& result_ids, ResultDistances& result_distances) {
+    std::vector<const SearchResult*> valid_results;
+    size_t total_k = 0;
+    for (auto& search_result : search_results) {
+        if (search_result.k_ > 0 && search_result.ids_.size() >= nq * topk) {
+            valid_results.push_back(&search_result);
+            total_k += search_result.k_;
+        }
+    }
+
+    // nothing searched, keep the initialized result set
+    if (valid_results.empty()) {
+        return;
+    }
+
+    bool ascending = valid_results.front()->ascending_;
+    size_t res_k = std::min(static_cast<size_t>(topk), total_k);
+    result_ids.assign(nq * res_k, -1);
+    result_distances.assign(nq * res_k, 0.0);
+
+    // cursor of a result: (distance, result index), the smallest one is popped first
+    using Cursor = std::pair<float, size_t>;
+
+#pragma omp parallel for if (nq * res_k >= PARALLEL_MERGE_THRESHOLD)
+    for (int64_t i = 0; i < static_cast<int64_t>(nq); i++) {
+        std::vector<size_t> offsets(valid_results.size(), 0);
+        std::priority_queue<Cursor, std::vector<Cursor>, std::greater<Cursor>> heap;
+        for (size_t r = 0; r < valid_results.size(); r++) {
+            float dis = valid_results[r]->distances_[i * topk];
+            heap.emplace(ascending ? dis : -dis, r);
+        }
+
+        size_t res_offset = i * res_k;
+        for (size_t j = 0; j < res_k && !heap.empty(); j++) {
+            size_t r = heap.top().second;
+            heap.pop();
+
+            size_t src_offset = i * topk + offsets[r];
+            result_ids[res_offset + j] = valid_results[r]->ids_[src_offset];
+            result_distances[res_offset + j] = valid_results[r]->distances_[src_offset];
+
+            if (++offsets[r] < valid_results[r]->k_) {
+                float dis = valid_results[r]->distances_[src_offset + 1];
+                heap.emplace(ascending ? dis : -dis, r);
+            }
+        }
+    }
 }
 
 ResultIds&
@@ -38,6 +38,14 @@ using Id2IndexMap = std::unordered_map<size_t, TableFileSchemaPtr>;
 using ResultIds = engine::ResultIds;
 using ResultDistances = engine::ResultDistances;
 
+// topk result of one index file, each query row takes topk slots and the first k_ of them are valid
+struct SearchResult {
+    ResultIds ids_;
+    ResultDistances distances_;
+    size_t k_ = 0;
+    bool ascending_ = true;
+};
+
 class SearchJob : public Job {
  public:
     SearchJob(const std::shared_ptr<server::Context>& context, uint64_t topk, const milvus::json& extra_params,
@@ -53,6 +61,9 @@ class SearchJob : public Job {
     void
     SearchDone(size_t index_id);
 
+    SearchResult&
+    GetSearchResult(size_t index_id);
+
     ResultIds&
     GetResultIds();
 
@@ -99,6 +110,11 @@ class SearchJob : public Job {
         return mutex_;
     }
 
+ public:
+    static void
+    MergeSearchResults(const std::vector<SearchResult>& search_results, uint64_t nq, uint64_t topk,
+                       ResultIds& result_ids, ResultDistances& result_distances);
+
  private:
     const std::shared_ptr<server::Context> context_;
 
@@ -108,6 +124,9 @@ class SearchJob : public Job {
     const engine::VectorsData& vectors_;
 
     Id2IndexMap index_files_;
+    // each index file writes its own result slot without lock, slots are merged after the last file is done
+    std::unordered_map<size_t, size_t> result_slots_;
+    std::vector<SearchResult> search_results_;
     // TODO: column-base better ?
     ResultIds result_ids_;
     ResultDistances result_distances_;
@@ -13,6 +13,11 @@
 #include "scheduler/SchedInst.h"
 #include "scheduler/Utils.h"
 
+#include <omp.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <utility>
@@ -20,6 +25,9 @@
 namespace milvus {
 namespace scheduler {
 
+// nice value of build threads, so searches get the cores first when both are busy
+constexpr int BUILD_THREAD_NICE = 10;
+
 std::ostream&
 operator<<(std::ostream& out, const Resource& resource) {
     out << resource.Dump();
@@ -59,6 +67,9 @@ Resource::Start() {
     loader_thread_ = std::thread(&Resource::loader_function, this);
     if (enable_executor_) {
         executor_thread_ = std::thread(&Resource::executor_function, this);
+        for (int64_t i = 0; i < build_concurrency_; ++i) {
+            build_threads_.emplace_back(&Resource::build_executor_function, this);
+        }
     }
 }
 
@@ -70,6 +81,10 @@ Resource::Stop() {
     if (enable_executor_) {
         WakeupExecutor();
         executor_thread_.join();
+        for (auto& build_thread : build_threads_) {
+            build_thread.join();
+        }
+        build_threads_.clear();
     }
 }
 
@@ -89,6 +104,20 @@ Resource::WakeupExecutor() {
         exec_flag_ = true;
     }
     exec_cv_.notify_one();
+
+    if (build_concurrency_ > 0) {
+        {
+            std::lock_guard<std::mutex> lock(build_mutex_);
+            ++build_wakeups_;
+        }
+        build_cv_.notify_all();
+    }
+}
+
+void
+Resource::EnableBuildExecutor(int64_t build_concurrency, int64_t build_threads) {
+    build_concurrency_ = build_concurrency;
+    build_omp_threads_ = build_threads > 0 ? std::max(build_threads / build_concurrency, (int64_t)1) : 0;
 }
 
 json
@@ -98,10 +127,11 @@ Resource::Dump() const {
         {"name", name_},
         {"type", ToString(type_)},
         {"task_average_cost", TaskAvgCost()},
-        {"task_total_cost", total_cost_},
-        {"total_tasks", total_task_},
+        {"task_total_cost", total_cost_.load()},
+        {"total_tasks", total_task_.load()},
         {"running", running_},
         {"enable_executor", enable_executor_},
+        {"build_concurrency", build_concurrency_},
     };
     return ret;
 }
@@ -113,7 +143,8 @@ Resource::NumOfTaskToExec() {
 
 TaskTableItemPtr
 Resource::pick_task_load() {
-    auto indexes = task_table_.PickToLoad(10);
+    // build index tasks loaded for the build threads don't keep other tasks from loading
+    auto indexes = task_table_.PickToLoad(10, build_concurrency_ == 0);
     for (auto index : indexes) {
         // try to set one task loading, then return
         if (task_table_.Load(index))
@@ -124,9 +155,17 @@ Resource::pick_task_load() {
 }
 
 TaskTableItemPtr
-Resource::pick_task_execute() {
+Resource::pick_task_execute(bool build_executor) {
     auto indexes = task_table_.PickToExecute(std::numeric_limits<uint64_t>::max());
     for (auto index : indexes) {
+        // with build threads, build index tasks go to them and the executor keeps the others
+        if (build_concurrency_ > 0) {
+            bool build_task = task_table_[index]->task->Type() == TaskType::BuildIndexTask;
+            if (build_task != build_executor) {
+                continue;
+            }
+        }
+
         // try to set one task executing, then return
         if (task_table_[index]->task->label()->Type() == TaskLabelType::SPECIFIED_RESOURCE) {
             if (task_table_[index]->task->path().Last() != name()) {
@@ -193,31 +232,62 @@ Resource::executor_function() {
         exec_flag_ = false;
         lock.unlock();
         while (true) {
-            auto task_item = pick_task_execute();
+            auto task_item = pick_task_execute(false);
             if (task_item == nullptr) {
                 break;
             }
-            auto start = get_current_timestamp();
-            Process(task_item->task);
-            auto finish = get_current_timestamp();
-            ++total_task_;
-            total_cost_ += finish - start;
-
-            task_item->Executed();
-
-            if (task_item->task->Type() == TaskType::BuildIndexTask) {
-                BuildMgrInst::GetInstance()->Put();
-                ResMgrInst::GetInstance()->GetResource("cpu")->WakeupLoader();
-                ResMgrInst::GetInstance()->GetResource("disk")->WakeupLoader();
-            }
+            execute_task(task_item);
+        }
+    }
+}
 
-            if (subscriber_) {
-                auto event = std::make_shared<FinishTaskEvent>(shared_from_this(), task_item);
-                subscriber_(std::static_pointer_cast<Event>(event));
+void
+Resource::build_executor_function() {
+    // the OpenMP team of a build is created by this thread, so it inherits both the thread number and priority
+    if (build_omp_threads_ > 0) {
+        omp_set_num_threads(build_omp_threads_);
+    }
+    if (setpriority(PRIO_PROCESS, syscall(SYS_gettid), BUILD_THREAD_NICE) != 0) {
+        SERVER_LOG_WARNING << name() << " fail to lower build thread priority";
+    }
+
+    uint64_t wakeups = 0;
+    while (running_) {
+        std::unique_lock<std::mutex> lock(build_mutex_);
+        build_cv_.wait(lock, [&] { return build_wakeups_ != wakeups; });
+        wakeups = build_wakeups_;
+        lock.unlock();
+        while (true) {
+            auto task_item = pick_task_execute(true);
+            if (task_item == nullptr) {
+                break;
             }
+            execute_task(task_item);
         }
     }
 }
 
+void
+Resource::execute_task(const TaskTableItemPtr& task_item) {
+    auto start = get_current_timestamp();
+    Process(task_item->task);
+    auto finish = get_current_timestamp();
+    ++total_task_;
+    total_cost_ += finish - start;
+
+    task_item->Executed();
+
+    if (task_item->task->Type() == TaskType::BuildIndexTask) {
+        BuildMgrInst::GetInstance()->Put();
+        ResMgrInst::GetInstance()->GetResource("cpu")->WakeupLoader();
+        ResMgrInst::GetInstance()->GetResource("disk")->WakeupLoader();
+    }
+
+    if (subscriber_) {
+        auto event = std::make_shared<FinishTaskEvent>(shared_from_this(), task_item);
+        subscriber_(std::static_pointer_cast<Event>(event));
+    }
+}
+
 }  // namespace scheduler
 }  // namespace milvus
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <memory>
@@ -66,6 +67,14 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
     void
     WakeupExecutor();
 
+    /*
+     * Run build index tasks on a pool of build_concurrency threads instead of the executor;
+     * Each build uses build_threads / build_concurrency OpenMP threads, all cores if build_threads is 0;
+     * Call before Start;
+     */
+    void
+    EnableBuildExecutor(int64_t build_concurrency, int64_t build_threads);
+
     inline void
     RegisterSubscriber(std::function<void(EventPtr)> subscriber) {
         subscriber_ = std::move(subscriber);
@@ -101,6 +110,11 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
         return enable_executor_;
     }
 
+    inline int64_t
+    BuildConcurrency() const {
+        return build_concurrency_;
+    }
+
     // TODO(wxyu): const
     uint64_t
     NumOfTaskToExec();
@@ -152,7 +166,7 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
      * Pick by start time and priority;
      */
     TaskTableItemPtr
-    pick_task_execute();
+    pick_task_execute(bool build_executor);
 
  private:
     /*
@@ -167,6 +181,15 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
     void
     executor_function();
 
+    /*
+     * Only called by build threads;
+     */
+    void
+    build_executor_function();
+
+    void
+    execute_task(const TaskTableItemPtr& task_item);
+
  protected:
     uint64_t device_id_;
     std::string name_;
@@ -176,8 +199,8 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
 
     TaskTable task_table_;
 
-    uint64_t total_cost_ = 0;
-    uint64_t total_task_ = 0;
+    std::atomic<uint64_t> total_cost_{0};
+    std::atomic<uint64_t> total_task_{0};
 
     std::function<void(EventPtr)> subscriber_ = nullptr;
 
@@ -192,6 +215,13 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
     std::mutex exec_mutex_;
     std::condition_variable load_cv_;
     std::condition_variable exec_cv_;
+
+    int64_t build_concurrency_ = 0;
+    int64_t build_omp_threads_ = 0;
+    std::vector<std::thread> build_threads_;
+    uint64_t build_wakeups_ = 0;
+    std::mutex build_mutex_;
+    std::condition_variable build_cv_;
 };
 
 using ResourcePtr = std::shared_ptr<Resource>;
@@ -61,7 +61,11 @@ XBuildIndexTask::Load(milvus::scheduler::LoadType type, uint8_t device_id) {
         auto options = build_index_job->options();
         try {
             if (type == LoadType::DISK2CPU) {
-                stat = to_index_engine_->Load(options.insert_cache_immediately_);
+                build_in_chunks_ = options.build_index_chunk_size_ > 0 &&
+                                   to_index_engine_->CanBuildInChunks((EngineType)file_->engine_type_);
+                if (!build_in_chunks_) {
+                    stat = to_index_engine_->Load(options.insert_cache_immediately_);
+                }
                 type_str = "DISK2CPU";
             } else if (type == LoadType::CPU2GPU) {
                 stat = to_index_engine_->CopyToIndexFileToGpu(device_id);
@@ -142,7 +146,29 @@ XBuildIndexTask::Execute() {
         // step 3: build index
         try {
             ENGINE_LOG_DEBUG << "Begin build index for file:" + table_file.location_;
-            index = to_index_engine_->BuildIndex(table_file.location_, (EngineType)table_file.engine_type_);
+            std::string model_location;
+            if (build_index_job->options().shared_quantizer_) {
+                // partitions share the model of their owner table
+                engine::meta::TableSchema table_schema;
+                table_schema.table_id_ = table_file.table_id_;
+                status = meta_ptr->DescribeTable(table_schema);
+                if (!status.ok()) {
+                    throw Exception(DB_ERROR, "Failed to describe table: " + status.message());
+                }
+                std::string model_table_id =
+                    table_schema.owner_table_.empty() ? table_schema.table_id_ : table_schema.owner_table_;
+                model_location =
+                    engine::utils::GetTableIndexModelPath(build_index_job->options().meta_, model_table_id);
+            }
+            if (build_in_chunks_) {
+                index = to_index_engine_->BuildIndexInChunks(
+                    table_file.location_, (EngineType)table_file.engine_type_, model_location,
+                    build_index_job->options().build_index_chunk_size_,
+                    build_index_job->options().build_index_checkpoint_interval_);
+            } else {
+                index = to_index_engine_->BuildIndex(table_file.location_, (EngineType)table_file.engine_type_,
+                                                     model_location);
+            }
             fiu_do_on("XBuildIndexTask.Execute.build_index_fail", index = nullptr);
             if (index == nullptr) {
                 throw Exception(DB_ERROR, "index NULL");
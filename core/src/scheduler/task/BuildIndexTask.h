@@ -33,6 +33,8 @@ class XBuildIndexTask : public Task {
     TableFileSchema table_file_;
     size_t to_index_id_ = 0;
     int to_index_type_ = 0;
+    // the raw vectors are read chunk by chunk while building instead of loaded
+    bool build_in_chunks_ = false;
     ExecutionEnginePtr to_index_engine_ = nullptr;
 };
 
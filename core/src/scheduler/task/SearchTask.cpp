@@ -216,18 +216,18 @@ XSearchTask::Execute() {
 
     server::CollectDurationMetrics metrics(index_type_);
 
-    std::vector<int64_t> output_ids;
-    std::vector<float> output_distance;
-
     if (auto job = job_.lock()) {
         auto search_job = std::static_pointer_cast<scheduler::SearchJob>(job);
-        // step 1: allocate memory
+        // step 1: allocate memory, the result slot is owned by this task so no lock is needed
         uint64_t nq = search_job->nq();
         uint64_t topk = search_job->topk();
         const milvus::json& extra_params = search_job->extra_params();
         ENGINE_LOG_DEBUG << "Search job extra params: " << extra_params.dump();
         const engine::VectorsData& vectors = search_job->vectors();
 
+        SearchResult& search_result = search_job->GetSearchResult(index_id_);
+        std::vector<int64_t>& output_ids = search_result.ids_;
+        std::vector<float>& output_distance = search_result.distances_;
         output_ids.resize(topk * nq);
         output_distance.resize(topk * nq);
         std::string hdr =
@@ -264,29 +264,13 @@ XSearchTask::Execute() {
             double span = rc.RecordSection(hdr + ", do search");
             //            search_job->AccumSearchCost(span);
 
-            // step 3: pick up topk result
+            // step 3: mark valid topk result, they are merged when all files are done
             auto spec_k = file_->row_count_ < topk ? file_->row_count_ : topk;
             if (spec_k == 0) {
                 ENGINE_LOG_WARNING << "Searching in an empty file. file location = " << file_->location_;
             }
-
-            {
-                std::unique_lock<std::mutex> lock(search_job->mutex());
-
-                if (search_job->GetResultIds().size() > spec_k) {
-                    if (search_job->GetResultIds().front() == -1) {
-                        // initialized results set
-                        search_job->GetResultIds().resize(spec_k * nq);
-                        search_job->GetResultDistances().resize(spec_k * nq);
-                    }
-                }
-
-                XSearchTask::MergeTopkToResultSet(output_ids, output_distance, spec_k, nq, topk, ascending_reduce,
-                                                  search_job->GetResultIds(), search_job->GetResultDistances());
-            }
-
-            span = rc.RecordSection(hdr + ", reduce topk");
-            //            search_job->AccumReduceCost(span);
+            search_result.k_ = spec_k;
+            search_result.ascending_ = ascending_reduce;
         } catch (std::exception& ex) {
             ENGINE_LOG_ERROR << "SearchTask encounter exception: " << ex.what();
             //            search_job->IndexSearchDone(index_id_);//mark as done avoid dead lock, even search failed
@@ -0,0 +1,74 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "segment/IdIndex.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace milvus {
+namespace segment {
+
+IdIndex::IdIndex(const std::vector<doc_id_t>& uids) {
+    std::vector<offset_t> offsets(uids.size());
+    std::iota(offsets.begin(), offsets.end(), 0);
+    // stable sort keeps duplicated uids in offset order
+    std::stable_sort(offsets.begin(), offsets.end(), [&uids](offset_t a, offset_t b) { return uids[a] < uids[b]; });
+
+    sorted_uids_.reserve(uids.size());
+    for (auto offset : offsets) {
+        sorted_uids_.emplace_back(uids[offset]);
+    }
+    offsets_.swap(offsets);
+}
+
+IdIndex::IdIndex(std::vector<doc_id_t> sorted_uids, std::vector<offset_t> offsets)
+    : sorted_uids_(std::move(sorted_uids)), offsets_(std::move(offsets)) {
+}
+
+bool
+IdIndex::Get(doc_id_t uid, offset_t& offset) const {
+    auto found = std::lower_bound(sorted_uids_.begin(), sorted_uids_.end(), uid);
+    if (found == sorted_uids_.end() || *found != uid) {
+        return false;
+    }
+    offset = offsets_[std::distance(sorted_uids_.begin(), found)];
+    return true;
+}
+
+const std::vector<doc_id_t>&
+IdIndex::GetSortedUids() const {
+    return sorted_uids_;
+}
+
+const std::vector<offset_t>&
+IdIndex::GetOffsets() const {
+    return offsets_;
+}
+
+size_t
+IdIndex::GetCount() const {
+    return sorted_uids_.size();
+}
+
+size_t
+IdIndex::Size() const {
+    return sorted_uids_.size() * sizeof(doc_id_t) + offsets_.size() * sizeof(offset_t);
+}
+
+}  // namespace segment
+}  // namespace milvus
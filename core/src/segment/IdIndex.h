@@ -14,17 +14,55 @@
 // KIND, either express or implied.  See the License for the
 // specific language governing permissions and limitations
 // under the License.
-
 #pragma once
 
 #include <memory>
+#include <vector>
 
-#include "AttrIndex.h"
+#include "segment/DeletedDocs.h"
+#include "segment/Vectors.h"
 
 namespace milvus {
 namespace segment {
 
-class IdIndex : public AttrIndex {};
+// Maps uid to its offset in the segment. Uids are kept sorted along with their offsets so that a lookup is a binary
+// search instead of a scan over all uids of the segment.
+class IdIndex {
+ public:
+    explicit IdIndex(const std::vector<doc_id_t>& uids);
+
+    IdIndex(std::vector<doc_id_t> sorted_uids, std::vector<offset_t> offsets);
+
+    // Return false if uid is not in the segment. If uid appears more than once, the smallest offset is returned.
+    bool
+    Get(doc_id_t uid, offset_t& offset) const;
+
+    const std::vector<doc_id_t>&
+    GetSortedUids() const;
+
+    const std::vector<offset_t>&
+    GetOffsets() const;
+
+    size_t
+    GetCount() const;
+
+    // Size in bytes
+    size_t
+    Size() const;
+
+    // No copy and move
+    IdIndex(const IdIndex&) = delete;
+    IdIndex(IdIndex&&) = delete;
+
+    IdIndex&
+    operator=(const IdIndex&) = delete;
+    IdIndex&
+    operator=(IdIndex&&) = delete;
+
+ private:
+    std::vector<doc_id_t> sorted_uids_;
+    std::vector<offset_t> offsets_;
+};
 
 using IdIndexPtr = std::shared_ptr<IdIndex>;
 
@@ -71,6 +71,20 @@ SegmentReader::LoadVectors(off_t offset, size_t num_bytes, std::vector<uint8_t>&
     return Status::OK();
 }
 
+Status
+SegmentReader::LoadVectors(const std::function<uint8_t*(size_t)>& alloc) {
+    codec::DefaultCodec default_codec;
+    try {
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        default_codec.GetVectorsFormat()->read_vectors(fs_ptr_, alloc);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to load raw vectors: " + std::string(e.what());
+        ENGINE_LOG_ERROR << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
 Status
 SegmentReader::LoadUids(std::vector<doc_id_t>& uids) {
     codec::DefaultCodec default_codec;
@@ -119,5 +133,25 @@ SegmentReader::LoadDeletedDocs(segment::DeletedDocsPtr& deleted_docs_ptr) {
     return Status::OK();
 }
 
+Status
+SegmentReader::LoadIdIndex(segment::IdIndexPtr& id_index_ptr) {
+    codec::DefaultCodec default_codec;
+    try {
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        default_codec.GetIdIndexFormat()->read(fs_ptr_, id_index_ptr);
+        return Status::OK();
+    } catch (std::exception& e) {
+        ENGINE_LOG_DEBUG << "Id index not loaded, build it from uids: " << e.what();
+    }
+
+    std::vector<doc_id_t> uids;
+    auto status = LoadUids(uids);
+    if (!status.ok()) {
+        return status;
+    }
+    id_index_ptr = std::make_shared<IdIndex>(uids);
+    return Status::OK();
+}
+
 }  // namespace segment
 }  // namespace milvus
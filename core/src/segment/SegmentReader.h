@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -42,6 +43,10 @@ class SegmentReader {
     Status
     LoadVectors(off_t offset, size_t num_bytes, std::vector<uint8_t>& raw_vectors);
 
+    // read the raw vectors straight into the buffer returned by alloc, which is given their size in bytes
+    Status
+    LoadVectors(const std::function<uint8_t*(size_t)>& alloc);
+
     Status
     LoadUids(std::vector<doc_id_t>& uids);
 
@@ -51,6 +56,10 @@ class SegmentReader {
     Status
     LoadDeletedDocs(segment::DeletedDocsPtr& deleted_docs_ptr);
 
+    // Segments written before the id index existed have no id index file, the index is built from uids instead
+    Status
+    LoadIdIndex(segment::IdIndexPtr& id_index_ptr);
+
     Status
     GetSegment(SegmentPtr& segment_ptr);
 
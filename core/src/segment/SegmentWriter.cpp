@@ -19,6 +19,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "SegmentReader.h"
 #include "Vectors.h"
@@ -42,8 +44,17 @@ SegmentWriter::SegmentWriter(const std::string& directory) {
 Status
 SegmentWriter::AddVectors(const std::string& name, const std::vector<uint8_t>& data,
                           const std::vector<doc_id_t>& uids) {
-    segment_ptr_->vectors_ptr_->AddData(data);
-    segment_ptr_->vectors_ptr_->AddUids(uids);
+    return AddVectors(name, data.data(), data.size(), uids.data(), uids.size());
+}
+
+Status
+SegmentWriter::AddVectors(const std::string& name, const uint8_t* data, uint64_t data_size, const doc_id_t* uids,
+                          uint64_t uid_count) {
+    if (merged_) {
+        return Status(DB_ERROR, "Cannot add vectors to a merged segment");
+    }
+    segment_ptr_->vectors_ptr_->AddData(data, data_size);
+    segment_ptr_->vectors_ptr_->AddUids(uids, uid_count);
     segment_ptr_->vectors_ptr_->SetName(name);
 
     return Status::OK();
@@ -75,6 +86,17 @@ SegmentWriter::Serialize() {
 
     start = std::chrono::high_resolution_clock::now();
 
+    status = WriteIdIndex();
+    if (!status.ok()) {
+        return status;
+    }
+
+    end = std::chrono::high_resolution_clock::now();
+    diff = end - start;
+    ENGINE_LOG_DEBUG << "Writing id index took " << diff.count() << " s in total";
+
+    start = std::chrono::high_resolution_clock::now();
+
     // Write an empty deleted doc
     status = WriteDeletedDocs();
 
@@ -90,7 +112,12 @@ SegmentWriter::WriteVectors() {
     codec::DefaultCodec default_codec;
     try {
         fs_ptr_->operation_ptr_->CreateDirectory();
-        default_codec.GetVectorsFormat()->write(fs_ptr_, segment_ptr_->vectors_ptr_);
+        if (merged_) {
+            // raw vectors were written while merging
+            default_codec.GetVectorsFormat()->write_uids(fs_ptr_, segment_ptr_->vectors_ptr_);
+        } else {
+            default_codec.GetVectorsFormat()->write(fs_ptr_, segment_ptr_->vectors_ptr_);
+        }
     } catch (std::exception& e) {
         std::string err_msg = "Failed to write vectors: " + std::string(e.what());
         ENGINE_LOG_ERROR << err_msg;
@@ -139,6 +166,21 @@ SegmentWriter::WriteBloomFilter() {
     return Status::OK();
 }
 
+Status
+SegmentWriter::WriteIdIndex() {
+    codec::DefaultCodec default_codec;
+    try {
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        segment_ptr_->id_index_ptr_ = std::make_shared<IdIndex>(segment_ptr_->vectors_ptr_->GetUids());
+        default_codec.GetIdIndexFormat()->write(fs_ptr_, segment_ptr_->id_index_ptr_);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to write id index: " + std::string(e.what());
+        ENGINE_LOG_ERROR << err_msg;
+        return Status(SERVER_WRITE_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
 Status
 SegmentWriter::WriteDeletedDocs() {
     codec::DefaultCodec default_codec;
@@ -199,44 +241,57 @@ SegmentWriter::Merge(const std::string& dir_to_merge, const std::string& name) {
     if (dir_to_merge == fs_ptr_->operation_ptr_->GetDirectory()) {
         return Status(DB_ERROR, "Cannot Merge Self");
     }
+    if (!segment_ptr_->vectors_ptr_->GetData().empty()) {
+        return Status(DB_ERROR, "Cannot merge into a segment holding vectors not serialized");
+    }
 
     ENGINE_LOG_DEBUG << "Merging from " << dir_to_merge << " to " << fs_ptr_->operation_ptr_->GetDirectory();
 
     auto start = std::chrono::high_resolution_clock::now();
 
     SegmentReader segment_reader_to_merge(dir_to_merge);
-    bool in_cache;
-    auto status = segment_reader_to_merge.LoadCache(in_cache);
-    if (!in_cache) {
-        status = segment_reader_to_merge.Load();
-        if (!status.ok()) {
-            std::string msg = "Failed to load segment from " + dir_to_merge;
-            ENGINE_LOG_ERROR << msg;
-            return Status(DB_ERROR, msg);
-        }
+    DeletedDocsPtr deleted_docs_ptr;
+    auto status = segment_reader_to_merge.LoadDeletedDocs(deleted_docs_ptr);
+    if (!status.ok()) {
+        std::string msg = "Failed to load deleted docs from " + dir_to_merge;
+        ENGINE_LOG_ERROR << msg;
+        return Status(DB_ERROR, msg);
     }
-    SegmentPtr segment_to_merge;
-    segment_reader_to_merge.GetSegment(segment_to_merge);
-    auto& uids = segment_to_merge->vectors_ptr_->GetUids();
-
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> diff = end - start;
-    ENGINE_LOG_DEBUG << "Loading segment took " << diff.count() << " s";
-
-    if (segment_to_merge->deleted_docs_ptr_ != nullptr) {
-        auto offsets_to_delete = segment_to_merge->deleted_docs_ptr_->GetDeletedDocs();
-
-        // Erase from raw data
-        segment_to_merge->vectors_ptr_->Erase(offsets_to_delete);
+    std::vector<offset_t> offsets_to_delete;
+    if (deleted_docs_ptr != nullptr) {
+        offsets_to_delete = deleted_docs_ptr->GetDeletedDocs();
+        std::sort(offsets_to_delete.begin(), offsets_to_delete.end());
+        offsets_to_delete.erase(std::unique(offsets_to_delete.begin(), offsets_to_delete.end()),
+                                offsets_to_delete.end());
     }
 
-    start = std::chrono::high_resolution_clock::now();
+    // Raw vectors are streamed from the source files to the merged file, only uids are kept in memory
+    storage::IOReaderPtr reader_ptr = std::make_shared<storage::DiskIOReader>();
+    storage::IOWriterPtr writer_ptr = std::make_shared<storage::DiskIOWriter>();
+    storage::OperationPtr operation_ptr = std::make_shared<storage::DiskOperation>(dir_to_merge);
+    auto fs_to_merge = std::make_shared<storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
 
-    AddVectors(name, segment_to_merge->vectors_ptr_->GetData(), segment_to_merge->vectors_ptr_->GetUids());
+    auto& vectors_ptr = segment_ptr_->vectors_ptr_;
+    auto add_uids = [&](const doc_id_t* uids, size_t count) { vectors_ptr->AddUids(uids, count); };
+    auto count_before = vectors_ptr->GetCount();
+    size_t merged_bytes = 0;
+    codec::DefaultCodec default_codec;
+    try {
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        default_codec.GetVectorsFormat()->merge(fs_ptr_, name, fs_to_merge, offsets_to_delete, add_uids,
+                                                merged_bytes);
+    } catch (std::exception& e) {
+        std::string msg = "Failed to merge segment " + dir_to_merge + ": " + std::string(e.what());
+        ENGINE_LOG_ERROR << msg;
+        return Status(SERVER_WRITE_ERROR, msg);
+    }
+    vectors_ptr->SetName(name);
+    merged_ = true;
+    merged_data_size_ += merged_bytes;
 
-    end = std::chrono::high_resolution_clock::now();
-    diff = end - start;
-    ENGINE_LOG_DEBUG << "Adding " << segment_to_merge->vectors_ptr_->GetCount() << " vectors and uids took "
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> diff = end - start;
+    ENGINE_LOG_DEBUG << "Merging " << vectors_ptr->GetCount() - count_before << " vectors and uids took "
                      << diff.count() << " s";
 
     ENGINE_LOG_DEBUG << "Merging completed from " << dir_to_merge << " to " << fs_ptr_->operation_ptr_->GetDirectory();
@@ -247,7 +302,7 @@ SegmentWriter::Merge(const std::string& dir_to_merge, const std::string& name) {
 size_t
 SegmentWriter::Size() {
     // TODO(zhiru): switch to actual directory size
-    size_t ret = segment_ptr_->vectors_ptr_->Size();
+    size_t ret = segment_ptr_->vectors_ptr_->Size() + merged_data_size_;
     /*
     if (segment_ptr_->id_bloom_filter_ptr_) {
         ret += segment_ptr_->id_bloom_filter_ptr_->Size();
@@ -35,6 +35,10 @@ class SegmentWriter {
     Status
     AddVectors(const std::string& name, const std::vector<uint8_t>& data, const std::vector<doc_id_t>& uids);
 
+    Status
+    AddVectors(const std::string& name, const uint8_t* data, uint64_t data_size, const doc_id_t* uids,
+               uint64_t uid_count);
+
     Status
     WriteBloomFilter(const IdBloomFilterPtr& bloom_filter_ptr);
 
@@ -50,6 +54,8 @@ class SegmentWriter {
     Status
     GetSegment(SegmentPtr& segment_ptr);
 
+    // append the vectors of another segment except the deleted ones, raw vectors are streamed to the
+    // files of this segment, so the segment can't take AddVectors() afterwards
     Status
     Merge(const std::string& segment_dir_to_merge, const std::string& name);
 
@@ -69,9 +75,16 @@ class SegmentWriter {
     Status
     WriteDeletedDocs();
 
+    Status
+    WriteIdIndex();
+
  private:
     storage::FSHandlerPtr fs_ptr_;
     SegmentPtr segment_ptr_;
+
+    // raw vectors of merged segments go to disk directly, only their uids are held in segment_ptr_
+    bool merged_ = false;
+    size_t merged_data_size_ = 0;
 };
 
 using SegmentWriterPtr = std::shared_ptr<SegmentWriter>;
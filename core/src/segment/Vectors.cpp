@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <iostream>
 #include <utility>
 #include <vector>
@@ -34,14 +35,23 @@ Vectors::Vectors(std::vector<uint8_t> data, std::vector<doc_id_t> uids, const st
 
 void
 Vectors::AddData(const std::vector<uint8_t>& data) {
-    data_.reserve(data_.size() + data.size());
-    data_.insert(data_.end(), std::make_move_iterator(data.begin()), std::make_move_iterator(data.end()));
+    AddData(data.data(), data.size());
 }
 
 void
 Vectors::AddUids(const std::vector<doc_id_t>& uids) {
-    uids_.reserve(uids_.size() + uids.size());
-    uids_.insert(uids_.end(), std::make_move_iterator(uids.begin()), std::make_move_iterator(uids.end()));
+    AddUids(uids.data(), uids.size());
+}
+
+// no exact reserve() here, it defeats the geometric growth and copies the whole buffer on every append
+void
+Vectors::AddData(const uint8_t* data, size_t size) {
+    data_.insert(data_.end(), data, data + size);
+}
+
+void
+Vectors::AddUids(const doc_id_t* uids, size_t count) {
+    uids_.insert(uids_.end(), uids, uids + count);
 }
 
 void
@@ -77,42 +87,32 @@ Vectors::Erase(std::vector<int32_t>& offsets) {
     diff = end - start;
     ENGINE_LOG_DEBUG << "Deduplicating " << offsets.size() << " offsets to delete took " << diff.count() << " s";
 
-    // Reconstruct raw vectors and uids
+    // Move each run of vectors between two deleted offsets forward in place
     ENGINE_LOG_DEBUG << "Begin erasing...";
 
-    size_t new_size = uids_.size() - offsets.size();
-    std::vector<doc_id_t> new_uids(new_size);
     auto code_length = GetCodeLength();
-    std::vector<uint8_t> new_data(new_size * code_length);
-
-    auto count = 0;
-    auto skip = offsets.cbegin();
     auto loop_size = uids_.size();
-
-    for (size_t i = 0; i < loop_size;) {
-        while (i == *skip && skip != offsets.cend()) {
-            ++i;
-            ++skip;
+    size_t count = 0;
+    size_t run_begin = 0;
+    for (size_t i = 0; i <= offsets.size() && run_begin < loop_size; ++i) {
+        if (i < offsets.size() && offsets[i] < 0) {
+            continue;
         }
-
-        if (i == loop_size) {
-            break;
-        }
-
-        new_uids[count] = uids_[i];
-
-        for (size_t j = 0; j < code_length; ++j) {
-            new_data[count * code_length + j] = data_[i * code_length + j];
+        size_t run_end = (i < offsets.size()) ? std::min<size_t>(offsets[i], loop_size) : loop_size;
+        if (run_end > run_begin) {
+            auto run_length = run_end - run_begin;
+            if (count != run_begin) {
+                memmove(data_.data() + count * code_length, data_.data() + run_begin * code_length,
+                        run_length * code_length);
+                memmove(uids_.data() + count, uids_.data() + run_begin, run_length * sizeof(doc_id_t));
+            }
+            count += run_length;
         }
-
-        ++count;
-        ++i;
+        run_begin = run_end + 1;
     }
 
-    data_.clear();
-    uids_.clear();
-    data_.swap(new_data);
-    uids_.swap(new_uids);
+    data_.resize(count * code_length);
+    uids_.resize(count);
 
     end = std::chrono::high_resolution_clock::now();
     diff = end - start;
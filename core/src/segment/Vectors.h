@@ -38,6 +38,12 @@ class Vectors {
     void
     AddUids(const std::vector<doc_id_t>& uids);
 
+    void
+    AddData(const uint8_t* data, size_t size);
+
+    void
+    AddUids(const doc_id_t* uids, size_t count);
+
     void
     SetName(const std::string& name);
 
@@ -44,6 +44,14 @@ DBWrapper::StartService() {
         return s;
     }
 
+    int64_t merge_io_limit;
+    s = config.GetDBConfigMergeIoLimit(merge_io_limit);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+    opt.merge_io_limit_ = merge_io_limit * engine::ONE_GB;
+
     std::string path;
     s = config.GetStorageConfigPrimaryPath(path);
     if (!s.ok()) {
@@ -117,9 +125,70 @@ DBWrapper::StartService() {
             std::cerr << s.ToString() << std::endl;
             kill(0, SIGUSR1);
         }
+
+        s = config.GetWalConfigDurability(opt.wal_durability_);
+        if (!s.ok()) {
+            std::cerr << "ERROR! Failed to get durability configuration." << std::endl;
+            std::cerr << s.ToString() << std::endl;
+            kill(0, SIGUSR1);
+        }
+
+        s = config.GetWalConfigSyncInterval(opt.wal_sync_interval_);
+        if (!s.ok()) {
+            std::cerr << "ERROR! Failed to get sync_interval configuration." << std::endl;
+            std::cerr << s.ToString() << std::endl;
+            kill(0, SIGUSR1);
+        }
     }
 
     // engine config
+    s = config.GetEngineConfigSearchBatchWindow(opt.search_batch_window_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    if (opt.search_batch_window_ > 0) {
+        int64_t search_concurrency = 1;
+        s = config.GetEngineConfigSearchConcurrency(search_concurrency);
+        if (!s.ok()) {
+            std::cerr << s.ToString() << std::endl;
+            return s;
+        }
+
+        // searches are executed one by one, no query could join a batch but each one would wait the window
+        if (search_concurrency <= 1) {
+            SERVER_LOG_WARNING << "search_batch_window is ignored since search_concurrency is " << search_concurrency;
+            opt.search_batch_window_ = 0;
+        }
+    }
+
+    s = config.GetEngineConfigSearchUnflushed(opt.search_unflushed_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    s = config.GetEngineConfigSharedQuantizer(opt.shared_quantizer_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    int64_t build_index_chunk_size;
+    s = config.GetEngineConfigBuildIndexChunkSize(build_index_chunk_size);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+    opt.build_index_chunk_size_ = build_index_chunk_size * engine::ONE_MB;
+
+    s = config.GetEngineConfigBuildIndexCheckpointInterval(opt.build_index_checkpoint_interval_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
     int64_t omp_thread;
     s = config.GetEngineConfigOmpThreadNum(omp_thread);
     if (!s.ok()) {
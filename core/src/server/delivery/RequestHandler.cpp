@@ -44,9 +44,9 @@ namespace server {
 
 Status
 RequestHandler::CreateTable(const std::shared_ptr<Context>& context, const std::string& table_name, int64_t dimension,
-                            int64_t index_file_size, int64_t metric_type) {
+                            int64_t index_file_size, int64_t metric_type, const milvus::json& extra_params) {
     BaseRequestPtr request_ptr =
-        CreateTableRequest::Create(context, table_name, dimension, index_file_size, metric_type);
+        CreateTableRequest::Create(context, table_name, dimension, index_file_size, metric_type, extra_params);
     RequestScheduler::ExecRequest(request_ptr);
 
     return request_ptr->status();
@@ -28,7 +28,7 @@ class RequestHandler {
 
     Status
     CreateTable(const std::shared_ptr<Context>& context, const std::string& table_name, int64_t dimension,
-                int64_t index_file_size, int64_t metric_type);
+                int64_t index_file_size, int64_t metric_type, const milvus::json& extra_params);
 
     Status
     HasTable(const std::shared_ptr<Context>& context, const std::string& table_name, bool& has_table);
@@ -0,0 +1,81 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/RequestQueue.h"
+
+namespace milvus {
+namespace server {
+
+void
+RequestQueue::Put(const BaseRequestPtr& request_ptr) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (request_ptr == nullptr) {
+        stopped_ = true;
+        empty_.notify_all();
+        return;
+    }
+
+    full_.wait(lock, [this] { return (size_ < capacity_); });
+
+    std::string key = request_ptr->RequestKey();
+    auto& key_queue = key_queues_[key];
+    if (key_queue.empty()) {
+        ready_keys_.push_back(key);
+    }
+    key_queue.push(request_ptr);
+    ++size_;
+    empty_.notify_one();
+}
+
+BaseRequestPtr
+RequestQueue::Take() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    empty_.wait(lock, [this] { return (size_ > 0 || stopped_); });
+    if (size_ == 0) {
+        return nullptr;  // stopped and drained
+    }
+
+    std::string key = ready_keys_.front();
+    ready_keys_.pop_front();
+
+    auto iter = key_queues_.find(key);
+    BaseRequestPtr request_ptr = iter->second.front();
+    iter->second.pop();
+    if (iter->second.empty()) {
+        key_queues_.erase(iter);
+    } else {
+        ready_keys_.push_back(key);  // let other keys go first
+    }
+    --size_;
+    full_.notify_one();
+    return request_ptr;
+}
+
+size_t
+RequestQueue::Size() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return size_;
+}
+
+bool
+RequestQueue::Empty() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return size_ == 0;
+}
+
+void
+RequestQueue::SetCapacity(const size_t capacity) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    capacity_ = (capacity > 0 ? capacity : capacity_);
+}
+
+}  // namespace server
+}  // namespace milvus
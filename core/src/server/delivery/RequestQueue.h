@@ -0,0 +1,70 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "server/delivery/request/BaseRequest.h"
+
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <unordered_map>
+
+namespace milvus {
+namespace server {
+
+// Request queue shared by the executor threads of one request group.
+// Requests with the same RequestKey() are taken in FIFO order, different keys are served round-robin,
+// so that a burst of requests on one table cannot block requests on other tables.
+// Put a nullptr to stop the queue, Take() returns nullptr after all pending requests are taken.
+class RequestQueue {
+ public:
+    RequestQueue() = default;
+
+    RequestQueue(const RequestQueue& rhs) = delete;
+
+    RequestQueue&
+    operator=(const RequestQueue& rhs) = delete;
+
+    void
+    Put(const BaseRequestPtr& request_ptr);
+
+    BaseRequestPtr
+    Take();
+
+    size_t
+    Size();
+
+    bool
+    Empty();
+
+    void
+    SetCapacity(const size_t capacity);
+
+ private:
+    std::mutex mtx_;
+    std::condition_variable full_;
+    std::condition_variable empty_;
+
+    std::unordered_map<std::string, std::queue<BaseRequestPtr>> key_queues_;
+    std::list<std::string> ready_keys_;  // keys which have pending requests, in round-robin order
+    size_t size_ = 0;
+    size_t capacity_ = 32;
+    bool stopped_ = false;
+};
+
+using RequestQueuePtr = std::shared_ptr<RequestQueue>;
+
+}  // namespace server
+}  // namespace milvus
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/RequestScheduler.h"
+#include "config/Config.h"
 #include "utils/Log.h"
 
 #include <fiu-local.h>
@@ -138,16 +139,34 @@ RequestScheduler::PutToQueue(const BaseRequestPtr& request_ptr) {
         request_groups_.insert(std::make_pair(group_name, queue));
         fiu_do_on("RequestScheduler.PutToQueue.null_queue", queue = nullptr);
 
-        // start a thread
-        ThreadPtr thread = std::make_shared<std::thread>(&RequestScheduler::TakeToExecute, this, queue);
+        // start executor threads, they share the group queue
+        int64_t concurrency = GroupConcurrency(group_name);
+        for (int64_t i = 0; i < concurrency; ++i) {
+            ThreadPtr thread = std::make_shared<std::thread>(&RequestScheduler::TakeToExecute, this, queue);
 
-        fiu_do_on("RequestScheduler.PutToQueue.push_null_thread", execute_threads_.push_back(nullptr));
-        execute_threads_.push_back(thread);
-        SERVER_LOG_INFO << "Create new thread for request group: " << group_name;
+            fiu_do_on("RequestScheduler.PutToQueue.push_null_thread", execute_threads_.push_back(nullptr));
+            execute_threads_.push_back(thread);
+        }
+        SERVER_LOG_INFO << "Create " << concurrency << " thread(s) for request group: " << group_name;
     }
 
     return Status::OK();
 }
 
+int64_t
+RequestScheduler::GroupConcurrency(const std::string& group_name) {
+    // ddl/dml and info requests must keep their submission order
+    if (group_name != DQL_REQUEST_GROUP) {
+        return 1;
+    }
+
+    int64_t concurrency = 1;
+    Status s = Config::GetInstance().GetEngineConfigSearchConcurrency(concurrency);
+    if (!s.ok() || concurrency <= 0) {
+        concurrency = 1;
+    }
+    return concurrency;
+}
+
 }  // namespace server
 }  // namespace milvus
@@ -11,8 +11,8 @@
 
 #pragma once
 
+#include "server/delivery/RequestQueue.h"
 #include "server/delivery/request/BaseRequest.h"
-#include "utils/BlockingQueue.h"
 #include "utils/Status.h"
 
 #include <map>
@@ -24,8 +24,6 @@
 namespace milvus {
 namespace server {
 
-using RequestQueue = BlockingQueue<BaseRequestPtr>;
-using RequestQueuePtr = std::shared_ptr<RequestQueue>;
 using ThreadPtr = std::shared_ptr<std::thread>;
 
 class RequestScheduler {
@@ -59,6 +57,9 @@ class RequestScheduler {
     Status
     PutToQueue(const BaseRequestPtr& request_ptr);
 
+    static int64_t
+    GroupConcurrency(const std::string& group_name);
+
  private:
     mutable std::mutex queue_mtx_;
 
@@ -137,6 +137,12 @@ class BaseRequest {
         return request_group_;
     }
 
+    // requests of a group are scheduled round-robin by this key, see RequestQueue
+    virtual std::string
+    RequestKey() const {
+        return "";
+    }
+
     const Status&
     status() const {
         return status_;
@@ -25,19 +25,21 @@ namespace milvus {
 namespace server {
 
 CreateTableRequest::CreateTableRequest(const std::shared_ptr<Context>& context, const std::string& table_name,
-                                       int64_t dimension, int64_t index_file_size, int64_t metric_type)
+                                       int64_t dimension, int64_t index_file_size, int64_t metric_type,
+                                       const milvus::json& extra_params)
     : BaseRequest(context, DDL_DML_REQUEST_GROUP),
       table_name_(table_name),
       dimension_(dimension),
       index_file_size_(index_file_size),
-      metric_type_(metric_type) {
+      metric_type_(metric_type),
+      extra_params_(extra_params) {
 }
 
 BaseRequestPtr
 CreateTableRequest::Create(const std::shared_ptr<Context>& context, const std::string& table_name, int64_t dimension,
-                           int64_t index_file_size, int64_t metric_type) {
+                           int64_t index_file_size, int64_t metric_type, const milvus::json& extra_params) {
     return std::shared_ptr<BaseRequest>(
-        new CreateTableRequest(context, table_name, dimension, index_file_size, metric_type));
+        new CreateTableRequest(context, table_name, dimension, index_file_size, metric_type, extra_params));
 }
 
 Status
@@ -69,6 +71,12 @@ CreateTableRequest::OnExecute() {
             return status;
         }
 
+        int64_t merge_flag = 0;
+        status = ValidationUtil::ValidateTableMergePolicy(extra_params_, merge_flag);
+        if (!status.ok()) {
+            return status;
+        }
+
         rc.RecordSection("check validation");
 
         // step 2: construct table schema
@@ -77,6 +85,7 @@ CreateTableRequest::OnExecute() {
         table_info.dimension_ = static_cast<uint16_t>(dimension_);
         table_info.index_file_size_ = index_file_size_;
         table_info.metric_type_ = metric_type_;
+        table_info.flag_ = merge_flag;
 
         // some metric type only support binary vector, adapt the index type
         if (engine::utils::IsBinaryMetricType(metric_type_)) {
@@ -23,11 +23,11 @@ class CreateTableRequest : public BaseRequest {
  public:
     static BaseRequestPtr
     Create(const std::shared_ptr<Context>& context, const std::string& table_name, int64_t dimension,
-           int64_t index_file_size, int64_t metric_type);
+           int64_t index_file_size, int64_t metric_type, const milvus::json& extra_params);
 
  protected:
     CreateTableRequest(const std::shared_ptr<Context>& context, const std::string& table_name, int64_t dimension,
-                       int64_t index_file_size, int64_t metric_type);
+                       int64_t index_file_size, int64_t metric_type, const milvus::json& extra_params);
 
     Status
     OnExecute() override;
@@ -37,6 +37,7 @@ class CreateTableRequest : public BaseRequest {
     int64_t dimension_;
     int64_t index_file_size_;
     int64_t metric_type_;
+    milvus::json extra_params_;
 };
 
 }  // namespace server
@@ -24,6 +24,11 @@ class PreloadTableRequest : public BaseRequest {
     static BaseRequestPtr
     Create(const std::shared_ptr<Context>& context, const std::string& table_name);
 
+    std::string
+    RequestKey() const override {
+        return table_name_;
+    }
+
  protected:
     PreloadTableRequest(const std::shared_ptr<Context>& context, const std::string& table_name);
 
@@ -32,6 +32,11 @@ class SearchByIDRequest : public BaseRequest {
     Create(const std::shared_ptr<Context>& context, const std::string& table_name, int64_t vector_id, int64_t topk,
            const milvus::json& extra_params, const std::vector<std::string>& partition_list, TopKQueryResult& result);
 
+    std::string
+    RequestKey() const override {
+        return table_name_;
+    }
+
  protected:
     SearchByIDRequest(const std::shared_ptr<Context>& context, const std::string& table_name, int64_t vector_id,
                       int64_t topk, const milvus::json& extra_params, const std::vector<std::string>& partition_list,
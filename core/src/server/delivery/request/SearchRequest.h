@@ -27,6 +27,11 @@ class SearchRequest : public BaseRequest {
            int64_t topk, const milvus::json& extra_params, const std::vector<std::string>& partition_list,
            const std::vector<std::string>& file_id_list, TopKQueryResult& result);
 
+    std::string
+    RequestKey() const override {
+        return table_name_;
+    }
+
  protected:
     SearchRequest(const std::shared_ptr<Context>& context, const std::string& table_name,
                   const engine::VectorsData& vectors, int64_t topk, const milvus::json& extra_params,
@@ -921,10 +921,16 @@ WebRequestHandler::CreateTable(const TableRequestDto::ObjectWrapper& collection_
         RETURN_STATUS_DTO(ILLEGAL_METRIC_TYPE, "metric_type is illegal")
     }
 
+    milvus::json extra_params;
+    if (nullptr != collection_schema->merge_policy.get()) {
+        extra_params["merge_policy"] = collection_schema->merge_policy->std_str();
+    }
+
     auto status =
         request_handler_.CreateTable(context_ptr_, collection_schema->collection_name->std_str(),
                                      collection_schema->dimension, collection_schema->index_file_size,
-                                     static_cast<int64_t>(MetricNameMap.at(collection_schema->metric_type->std_str())));
+                                     static_cast<int64_t>(MetricNameMap.at(collection_schema->metric_type->std_str())),
+                                     extra_params);
 
     ASSIGN_RETURN_STATUS_DTO(status)
 }
@@ -0,0 +1,76 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "storage/disk/DiskMappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "utils/Log.h"
+
+namespace milvus {
+namespace storage {
+
+DiskMappedFile::~DiskMappedFile() {
+    close();
+}
+
+bool
+DiskMappedFile::open(const std::string& name) {
+    close();
+    name_ = name;
+
+    int fd = ::open(name_.c_str(), O_RDONLY);
+    if (fd == -1) {
+        STORAGE_LOG_ERROR << "Failed to open file: " << name_ << ", error: " << std::strerror(errno);
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) == -1) {
+        STORAGE_LOG_ERROR << "Failed to stat file: " << name_ << ", error: " << std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    length_ = st.st_size;
+    if (length_ > 0) {
+        void* addr = ::mmap(nullptr, length_, PROT_READ, MAP_SHARED, fd, 0);
+        if (addr == MAP_FAILED) {
+            STORAGE_LOG_ERROR << "Failed to mmap file: " << name_ << ", error: " << std::strerror(errno);
+            length_ = 0;
+            ::close(fd);
+            return false;
+        }
+        data_ = static_cast<uint8_t*>(addr);
+    }
+
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    return true;
+}
+
+void
+DiskMappedFile::close() {
+    if (data_ != nullptr) {
+        ::munmap(data_, length_);
+        data_ = nullptr;
+    }
+    length_ = 0;
+}
+
+}  // namespace storage
+}  // namespace milvus
@@ -0,0 +1,62 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace milvus {
+namespace storage {
+
+// Read-only memory mapping of a whole file. Pages are read from disk on first access and can be
+// dropped again by the kernel under memory pressure.
+class DiskMappedFile {
+ public:
+    DiskMappedFile() = default;
+    ~DiskMappedFile();
+
+    // No copy and move
+    DiskMappedFile(const DiskMappedFile&) = delete;
+    DiskMappedFile(DiskMappedFile&&) = delete;
+
+    DiskMappedFile&
+    operator=(const DiskMappedFile&) = delete;
+    DiskMappedFile&
+    operator=(DiskMappedFile&&) = delete;
+
+    bool
+    open(const std::string& name);
+
+    const uint8_t*
+    data() const {
+        return data_;
+    }
+
+    size_t
+    length() const {
+        return length_;
+    }
+
+    void
+    close();
+
+ private:
+    std::string name_;
+    uint8_t* data_ = nullptr;
+    size_t length_ = 0;
+};
+
+using DiskMappedFilePtr = std::shared_ptr<DiskMappedFile>;
+
+}  // namespace storage
+}  // namespace milvus
@@ -22,6 +22,7 @@
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
 
 namespace milvus {
@@ -81,6 +82,15 @@ class S3ClientMock : public Aws::S3::S3Client {
         }
     }
 
+    Aws::S3::Model::HeadObjectOutcome
+    HeadObject(const Aws::S3::Model::HeadObjectRequest& request) const override {
+        if (aws_map_.find(request.GetKey()) == aws_map_.end()) {
+            return Aws::S3::Model::HeadObjectOutcome();
+        }
+        Aws::S3::Model::HeadObjectResult result;
+        return Aws::S3::Model::HeadObjectOutcome(std::move(result));
+    }
+
     Aws::S3::Model::ListObjectsOutcome
     ListObjects(const Aws::S3::Model::ListObjectsRequest& request) const override {
         /* TODO: add object key list into ListObjectsOutcome */
@@ -48,6 +48,8 @@ class S3ClientWrapper {
     Status
     GetObjectStr(const std::string& object_key, std::string& content);
     Status
+    HeadObject(const std::string& object_key);
+    Status
     ListObjects(std::vector<std::string>& object_list, const std::string& marker = "");
     Status
     DeleteObject(const std::string& object_key);
@@ -0,0 +1,86 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "utils/CRC32C.h"
+
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+namespace milvus {
+
+namespace {
+
+constexpr uint32_t CRC32C_POLY = 0x82F63B78;  // reversed Castagnoli polynomial
+
+struct CRC32CTable {
+    uint32_t table_[256];
+
+    CRC32CTable() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int32_t k = 0; k < 8; ++k) {
+                crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLY : (crc >> 1);
+            }
+            table_[i] = crc;
+        }
+    }
+};
+
+uint32_t
+CRC32CSoftware(const uint8_t* data, size_t length, uint32_t crc) {
+    static const CRC32CTable table;
+    for (size_t i = 0; i < length; ++i) {
+        crc = table.table_[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2"))) uint32_t
+CRC32CHardware(const uint8_t* data, size_t length, uint32_t crc) {
+    uint64_t crc64 = crc;
+    for (; length >= 8; data += 8, length -= 8) {
+        uint64_t value;
+        memcpy(&value, data, 8);
+        crc64 = _mm_crc32_u64(crc64, value);
+    }
+    crc = (uint32_t)crc64;
+    for (; length > 0; ++data, --length) {
+        crc = _mm_crc32_u8(crc, *data);
+    }
+    return crc;
+}
+#endif
+
+using CRC32CFunc = uint32_t (*)(const uint8_t*, size_t, uint32_t);
+
+CRC32CFunc
+ChooseCRC32C() {
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("sse4.2")) {
+        return CRC32CHardware;
+    }
+#endif
+    return CRC32CSoftware;
+}
+
+}  // namespace
+
+uint32_t
+CRC32C(const void* data, size_t length, uint32_t crc) {
+    static const CRC32CFunc func = ChooseCRC32C();
+    return ~func(static_cast<const uint8_t*>(data), length, ~crc);
+}
+
+}  // namespace milvus
@@ -63,6 +63,7 @@ constexpr ErrorCode SERVER_CANNOT_CREATE_FILE = ToServerErrorCode(9);
 constexpr ErrorCode SERVER_CANNOT_DELETE_FOLDER = ToServerErrorCode(10);
 constexpr ErrorCode SERVER_CANNOT_DELETE_FILE = ToServerErrorCode(11);
 constexpr ErrorCode SERVER_BUILD_INDEX_ERROR = ToServerErrorCode(12);
+constexpr ErrorCode SERVER_CANNOT_READ_FILE = ToServerErrorCode(13);
 
 constexpr ErrorCode SERVER_TABLE_NOT_EXIST = ToServerErrorCode(100);
 constexpr ErrorCode SERVER_INVALID_TABLE_NAME = ToServerErrorCode(101);
@@ -105,6 +106,7 @@ constexpr ErrorCode WAL_ERROR = ToWalErrorCode(1);
 constexpr ErrorCode WAL_META_ERROR = ToWalErrorCode(2);
 constexpr ErrorCode WAL_FILE_ERROR = ToWalErrorCode(3);
 constexpr ErrorCode WAL_PATH_ERROR = ToWalErrorCode(4);
+constexpr ErrorCode WAL_DATA_ERROR = ToWalErrorCode(5);
 
 namespace server {
 class ServerException : public std::exception {
@@ -38,6 +38,11 @@ constexpr size_t TABLE_NAME_SIZE_LIMIT = 255;
 constexpr int64_t TABLE_DIMENSION_LIMIT = 32768;
 constexpr int32_t INDEX_FILE_SIZE_LIMIT = 4096;  // index trigger size max = 4096 MB
 
+constexpr const char* MERGE_POLICY = "merge_policy";
+constexpr const char* MERGE_POLICY_SIMPLE = "simple";
+constexpr const char* MERGE_POLICY_SIZE_TIERED = "size_tiered";
+constexpr const char* MERGE_POLICY_LEVELED = "leveled";
+
 Status
 CheckParameterRange(const milvus::json& json_params, const std::string& param_name, int64_t min, int64_t max,
                     bool min_close = true, bool max_closed = true) {
@@ -87,6 +92,24 @@ CheckParameterExistence(const milvus::json& json_params, const std::string& para
     return Status::OK();
 }
 
+// optional parameters of ivf k-means training
+Status
+CheckKmeansParameters(const milvus::json& json_params) {
+    if (json_params.find(knowhere::IndexParams::max_points_per_centroid) != json_params.end()) {
+        auto status = CheckParameterRange(json_params, knowhere::IndexParams::max_points_per_centroid, 1, 65536);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    if (json_params.find(knowhere::IndexParams::kmeans_batch_size) != json_params.end()) {
+        auto status = CheckParameterRange(json_params, knowhere::IndexParams::kmeans_batch_size, 0, 50000000);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    return Status::OK();
+}
+
 }  // namespace
 
 Status
@@ -178,6 +201,10 @@ ValidationUtil::ValidateIndexParams(const milvus::json& index_params, const engi
             if (!status.ok()) {
                 return status;
             }
+            status = CheckKmeansParameters(index_params);
+            if (!status.ok()) {
+                return status;
+            }
             break;
         }
         case (int32_t)engine::EngineType::FAISS_PQ: {
@@ -185,6 +212,10 @@ ValidationUtil::ValidateIndexParams(const milvus::json& index_params, const engi
             if (!status.ok()) {
                 return status;
             }
+            status = CheckKmeansParameters(index_params);
+            if (!status.ok()) {
+                return status;
+            }
 
             status = CheckParameterExistence(index_params, knowhere::IndexParams::m);
             if (!status.ok()) {
@@ -288,6 +319,35 @@ ValidationUtil::ValidateTableIndexMetricType(int32_t metric_type) {
     return Status::OK();
 }
 
+Status
+ValidationUtil::ValidateTableMergePolicy(const milvus::json& extra_params, int64_t& merge_flag) {
+    merge_flag = 0;
+    if (!extra_params.is_object() || extra_params.find(MERGE_POLICY) == extra_params.end()) {
+        return Status::OK();
+    }
+
+    std::string policy;
+    if (extra_params[MERGE_POLICY].is_string()) {
+        policy = extra_params[MERGE_POLICY].get<std::string>();
+    }
+
+    if (policy == MERGE_POLICY_SIMPLE) {
+        merge_flag = 0;
+    } else if (policy == MERGE_POLICY_SIZE_TIERED) {
+        merge_flag = engine::meta::FLAG_MASK_MERGE_SIZE_TIERED;
+    } else if (policy == MERGE_POLICY_LEVELED) {
+        merge_flag = engine::meta::FLAG_MASK_MERGE_LEVELED;
+    } else {
+        std::string msg = "Invalid merge policy: " + extra_params[MERGE_POLICY].dump() + ". " +
+                          "The merge policy must be one of: " + MERGE_POLICY_SIMPLE + ", " + MERGE_POLICY_SIZE_TIERED +
+                          ", " + MERGE_POLICY_LEVELED + ".";
+        SERVER_LOG_ERROR << msg;
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    return Status::OK();
+}
+
 Status
 ValidationUtil::ValidateSearchTopk(int64_t top_k, const engine::meta::TableSchema& table_schema) {
     if (top_k <= 0 || top_k > 2048) {
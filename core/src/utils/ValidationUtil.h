@@ -49,6 +49,10 @@ class ValidationUtil {
     static Status
     ValidateTableIndexMetricType(int32_t metric_type);
 
+    // convert the optional "merge_policy" of table creation into table flag bits
+    static Status
+    ValidateTableMergePolicy(const milvus::json& extra_params, int64_t& merge_flag);
+
     static Status
     ValidateSearchTopk(int64_t top_k, const engine::meta::TableSchema& table_schema);
 
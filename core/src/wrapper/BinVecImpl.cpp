@@ -135,6 +135,25 @@ BinVecImpl::SetBlacklist(faiss::ConcurrentBitsetPtr list) {
     return Status::OK();
 }
 
+Status
+BinVecImpl::Compact(const std::vector<int64_t>& offset_map) {
+    auto ivf_index = std::dynamic_pointer_cast<knowhere::BinaryIVF>(index_);
+    if (ivf_index == nullptr) {
+        return Status(KNOWHERE_ERROR, "Compact not support");
+    }
+
+    try {
+        ivf_index->Compact(offset_map);
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
+
 Status
 BinVecImpl::GetVectorById(const int64_t n, const int64_t* ids, uint8_t* x, const Config& cfg) {
     if (auto raw_index = std::dynamic_pointer_cast<knowhere::BinaryIVF>(index_)) {
@@ -287,5 +306,17 @@ BinBFIndex::AddWithoutIds(const int64_t& nb, const uint8_t* xb, const Config& cf
     std::static_pointer_cast<knowhere::BinaryIDMAP>(index_)->AddWithoutId(ret_ds, cfg);
     return Status::OK();
 }
+
+uint8_t*
+BinBFIndex::AllocRawVectors(const int64_t& nb) {
+    try {
+        return std::static_pointer_cast<knowhere::BinaryIDMAP>(index_)->AllocRawVectors(nb);
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+    }
+    return nullptr;
+}
 }  // namespace engine
 }  // namespace milvus
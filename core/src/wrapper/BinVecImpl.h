@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "VecImpl.h"
 
@@ -43,6 +44,9 @@ class BinVecImpl : public VecIndexImpl {
     Status
     GetBlacklist(faiss::ConcurrentBitsetPtr& list) override;
 
+    Status
+    Compact(const std::vector<int64_t>& offset_map) override;
+
     //    Status
     //    SearchById(const int64_t& nq, const uint8_t* xq, faiss::ConcurrentBitsetPtr bitset, float* dist, int64_t* ids,
     //               const Config& cfg) override;
@@ -78,6 +82,10 @@ class BinBFIndex : public BinVecImpl {
 
     Status
     AddWithoutIds(const int64_t& nb, const uint8_t* xb, const Config& cfg);
+
+    // storage for nb vectors inside the index, for the caller to fill in place
+    uint8_t*
+    AllocRawVectors(const int64_t& nb);
 };
 
 }  // namespace engine
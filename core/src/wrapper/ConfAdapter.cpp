@@ -99,6 +99,27 @@ MatchNlist(const int64_t& size, const int64_t& nlist, const int64_t& per_nlist)
     return nlist;
 }
 
+// optional sampling and mini-batch parameters of ivf k-means training
+bool
+CheckKmeansParams(milvus::json& oricfg) {
+    static int64_t DEFAULT_MAX_POINTS_PER_CENTROID = 256;
+    static int64_t MIN_POINTS_PER_CENTROID = 1;
+    static int64_t MAX_POINTS_PER_CENTROID = 65536;
+    static int64_t DEFAULT_KMEANS_BATCH_SIZE = 0;
+
+    if (!oricfg.contains(knowhere::IndexParams::max_points_per_centroid)) {
+        oricfg[knowhere::IndexParams::max_points_per_centroid] = DEFAULT_MAX_POINTS_PER_CENTROID;
+    }
+    CheckIntByRange(knowhere::IndexParams::max_points_per_centroid, MIN_POINTS_PER_CENTROID, MAX_POINTS_PER_CENTROID);
+
+    if (!oricfg.contains(knowhere::IndexParams::kmeans_batch_size)) {
+        oricfg[knowhere::IndexParams::kmeans_batch_size] = DEFAULT_KMEANS_BATCH_SIZE;
+    }
+    CheckIntByRange(knowhere::IndexParams::kmeans_batch_size, 0, DEFAULT_MAX_ROWS);
+
+    return true;
+}
+
 bool
 IVFConfAdapter::CheckTrain(milvus::json& oricfg) {
     static int64_t MAX_NLIST = 999999;
@@ -106,6 +127,9 @@ IVFConfAdapter::CheckTrain(milvus::json& oricfg) {
 
     CheckIntByRange(knowhere::IndexParams::nlist, MIN_NLIST, MAX_NLIST);
     CheckIntByRange(knowhere::meta::ROWS, DEFAULT_MIN_ROWS, DEFAULT_MAX_ROWS);
+    if (!CheckKmeansParams(oricfg)) {
+        return false;
+    }
 
     // int64_t nlist = oricfg[knowhere::IndexParams::nlist];
     // CheckIntByRange(knowhere::meta::ROWS, nlist, DEFAULT_MAX_ROWS);
@@ -169,6 +193,9 @@ IVFPQConfAdapter::CheckTrain(milvus::json& oricfg) {
     CheckIntByRange(knowhere::meta::DIM, DEFAULT_MIN_DIM, DEFAULT_MAX_DIM);
     CheckIntByRange(knowhere::meta::ROWS, DEFAULT_MIN_ROWS, DEFAULT_MAX_ROWS);
     CheckIntByRange(knowhere::IndexParams::nlist, MIN_NLIST, MAX_NLIST);
+    if (!CheckKmeansParams(oricfg)) {
+        return false;
+    }
 
     // int64_t nlist = oricfg[knowhere::IndexParams::nlist];
     // CheckIntByRange(knowhere::meta::ROWS, nlist, DEFAULT_MAX_ROWS);
@@ -14,7 +14,11 @@
 #include "DataTransfer.h"
 #include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexHNSW.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
+#include "knowhere/index/vector_index/IndexIVF.h"
+#include "knowhere/index/vector_index/IndexNSG.h"
+#include "knowhere/index/vector_index/IndexSPTAG.h"
 #include "utils/Log.h"
 #include "wrapper/WrapperException.h"
 #include "wrapper/gpu/GPUVecImpl.h"
@@ -36,6 +40,41 @@
 namespace milvus {
 namespace engine {
 
+namespace {
+
+// hands what faiss writes over to a function, only counts the bytes without one
+struct FunctionIOWriter : faiss::IOWriter {
+    explicit FunctionIOWriter(const std::function<void(const void*, size_t)>& write) : write_(write) {
+    }
+
+    size_t
+    operator()(const void* ptr, size_t size, size_t nitems) override {
+        write_(ptr, size * nitems);
+        total_ += size * nitems;
+        return nitems;
+    }
+
+    size_t
+    tell() override {
+        return total_;
+    }
+
+    const std::function<void(const void*, size_t)>& write_;
+    int64_t total_ = 0;
+};
+
+// the cpu ivf index behind the wrapper, nullptr for the other types
+std::shared_ptr<knowhere::IVF>
+GetCpuIVF(IndexType type, const std::shared_ptr<knowhere::VectorIndex>& index) {
+    if (type != IndexType::FAISS_IVFFLAT_CPU && type != IndexType::FAISS_IVFSQ8_CPU &&
+        type != IndexType::FAISS_IVFPQ_CPU) {
+        return nullptr;
+    }
+    return std::dynamic_pointer_cast<knowhere::IVF>(index);
+}
+
+}  // namespace
+
 Status
 VecIndexImpl::BuildAll(const int64_t& nb, const float* xb, const int64_t* ids, const Config& cfg, const int64_t& nt,
                        const float* xt) {
@@ -289,6 +328,12 @@ VecIndexImpl::SetBlacklist(faiss::ConcurrentBitsetPtr list) {
         raw_index->SetBlacklist(list);
     } else if (auto raw_index = std::dynamic_pointer_cast<knowhere::IDMAP>(index_)) {
         raw_index->SetBlacklist(list);
+    } else if (auto hnsw_index = std::dynamic_pointer_cast<knowhere::IndexHNSW>(index_)) {
+        hnsw_index->SetBlacklist(list);
+    } else if (auto nsg_index = std::dynamic_pointer_cast<knowhere::NSG>(index_)) {
+        nsg_index->SetBlacklist(list);
+    } else if (auto sptag_index = std::dynamic_pointer_cast<knowhere::CPUSPTAGRNG>(index_)) {
+        sptag_index->SetBlacklist(list);
     }
     return Status::OK();
 }
@@ -299,6 +344,168 @@ VecIndexImpl::GetBlacklist(faiss::ConcurrentBitsetPtr& list) {
         raw_index->GetBlacklist(list);
     } else if (auto raw_index = std::dynamic_pointer_cast<knowhere::IDMAP>(index_)) {
         raw_index->GetBlacklist(list);
+    } else if (auto hnsw_index = std::dynamic_pointer_cast<knowhere::IndexHNSW>(index_)) {
+        hnsw_index->GetBlacklist(list);
+    } else if (auto nsg_index = std::dynamic_pointer_cast<knowhere::NSG>(index_)) {
+        nsg_index->GetBlacklist(list);
+    } else if (auto sptag_index = std::dynamic_pointer_cast<knowhere::CPUSPTAGRNG>(index_)) {
+        sptag_index->GetBlacklist(list);
+    }
+    return Status::OK();
+}
+
+Status
+VecIndexImpl::Compact(const std::vector<int64_t>& offset_map) {
+    // the hybrid index keeps its quantizer on gpu, rebuild it instead
+    auto ivf_index = std::dynamic_pointer_cast<knowhere::IVF>(index_);
+    if (ivf_index == nullptr || type == IndexType::FAISS_IVFSQ8_HYBRID) {
+        return Status(KNOWHERE_ERROR, "Compact not support");
+    }
+
+    try {
+        ivf_index->Compact(offset_map);
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
+
+Status
+VecIndexImpl::Train(const int64_t& nb, const float* xb, const Config& cfg) {
+    // only the cpu ivf indexes can take a model trained elsewhere
+    if (type != IndexType::FAISS_IVFFLAT_CPU && type != IndexType::FAISS_IVFSQ8_CPU &&
+        type != IndexType::FAISS_IVFPQ_CPU) {
+        return Status(KNOWHERE_ERROR, "Train not support");
+    }
+
+    try {
+        dim = cfg[knowhere::meta::DIM];
+        auto dataset = GenDataset(nb, dim, xb);
+        auto model = index_->Train(dataset, cfg);
+        index_->set_index_model(model);
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
+
+Status
+VecIndexImpl::BuildWithModel(const VecIndexPtr& model, const int64_t& nb, const float* xb, const int64_t* ids,
+                             const Config& cfg) {
+    auto model_impl = std::dynamic_pointer_cast<VecIndexImpl>(model);
+    if (model_impl == nullptr || model_impl->type != type) {
+        return Status(KNOWHERE_INVALID_ARGUMENT, "Index model type mismatch");
+    }
+    auto trained = std::dynamic_pointer_cast<knowhere::IVF>(model_impl->index_);
+    if (trained == nullptr || trained->index_ == nullptr || !trained->index_->is_trained) {
+        return Status(KNOWHERE_INVALID_ARGUMENT, "Index model not trained");
+    }
+    if (trained->index_->d != cfg[knowhere::meta::DIM].get<int64_t>()) {
+        return Status(KNOWHERE_INVALID_ARGUMENT, "Index model dimension mismatch");
+    }
+
+    try {
+        dim = cfg[knowhere::meta::DIM];
+        auto dataset = GenDatasetWithIds(nb, dim, xb, ids);
+
+        auto preprocessor = index_->BuildPreprocessor(dataset, cfg);
+        index_->set_preprocessor(preprocessor);
+        // set_index_model deep copies, the model stays empty and can be shared
+        index_->set_index_model(std::make_shared<knowhere::IVFIndexModel>(trained->index_));
+        index_->Add(dataset, cfg);
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
+
+Status
+VecIndexImpl::SerializedSize(std::string& name, int64_t& size) {
+    auto ivf = GetCpuIVF(type, index_);
+    if (ivf == nullptr) {
+        return Status(KNOWHERE_ERROR, "SerializedSize not support");
+    }
+
+    try {
+        name = "IVF";
+        size = ivf->SerializedSize();
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
+
+Status
+VecIndexImpl::SerializeTo(const std::function<void(const void*, size_t)>& write) {
+    auto ivf = GetCpuIVF(type, index_);
+    if (ivf == nullptr) {
+        return Status(KNOWHERE_ERROR, "SerializeTo not support");
+    }
+
+    try {
+        FunctionIOWriter writer(write);
+        ivf->SerializeTo(&writer);
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
+
+Status
+VecIndexImpl::Checkpoint(const std::string& path) {
+    auto ivf = GetCpuIVF(type, index_);
+    if (ivf == nullptr) {
+        return Status(KNOWHERE_ERROR, "Checkpoint not support");
+    }
+
+    try {
+        ivf->Checkpoint(path);
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
+
+Status
+VecIndexImpl::Restore(const std::string& path) {
+    auto ivf = GetCpuIVF(type, index_);
+    if (ivf == nullptr) {
+        return Status(KNOWHERE_ERROR, "Restore not support");
+    }
+
+    try {
+        ivf->Restore(path);
+        dim = Dimension();
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
     }
     return Status::OK();
 }
@@ -375,5 +582,17 @@ BFIndex::AddWithoutIds(const int64_t& nb, const float* xb, const Config& cfg) {
     return Status::OK();
 }
 
+float*
+BFIndex::AllocRawVectors(const int64_t& nb) {
+    try {
+        return std::static_pointer_cast<knowhere::IDMAP>(index_)->AllocRawVectors(nb);
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+    }
+    return nullptr;
+}
+
 }  // namespace engine
 }  // namespace milvus
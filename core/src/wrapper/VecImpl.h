@@ -11,7 +11,9 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -76,6 +78,28 @@ class VecIndexImpl : public VecIndex {
     Status
     GetBlacklist(faiss::ConcurrentBitsetPtr& list) override;
 
+    Status
+    Compact(const std::vector<int64_t>& offset_map) override;
+
+    Status
+    Train(const int64_t& nb, const float* xb, const Config& cfg) override;
+
+    Status
+    BuildWithModel(const VecIndexPtr& model, const int64_t& nb, const float* xb, const int64_t* ids,
+                   const Config& cfg) override;
+
+    Status
+    SerializedSize(std::string& name, int64_t& size) override;
+
+    Status
+    SerializeTo(const std::function<void(const void*, size_t)>& write) override;
+
+    Status
+    Checkpoint(const std::string& path) override;
+
+    Status
+    Restore(const std::string& path) override;
+
     Status
     SetUids(std::vector<segment::doc_id_t>& uids) override;
 
@@ -111,6 +135,10 @@ class BFIndex : public VecIndexImpl {
 
     Status
     AddWithoutIds(const int64_t& nb, const float* xb, const Config& cfg);
+
+    // storage for nb vectors inside the index, for the caller to fill in place
+    float*
+    AllocRawVectors(const int64_t& nb);
 };
 
 class ToIndexData : public cache::DataObj {
@@ -11,6 +11,11 @@
 
 #include "wrapper/VecIndex.h"
 
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "config/Config.h"
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/IndexBinaryIDMAP.h"
@@ -22,8 +27,8 @@
 #include "knowhere/index/vector_index/IndexIVFSQ.h"
 #include "knowhere/index/vector_index/IndexNSG.h"
 #include "knowhere/index/vector_index/IndexSPTAG.h"
-#include "storage/disk/DiskIOReader.h"
 #include "storage/disk/DiskIOWriter.h"
+#include "storage/disk/DiskMappedFile.h"
 #include "storage/s3/S3IOReader.h"
 #include "storage/s3/S3IOWriter.h"
 #include "utils/Exception.h"
@@ -48,6 +53,97 @@
 namespace milvus {
 namespace engine {
 
+namespace {
+
+// Index file layout:
+//   header   : magic, version, index type, binary count
+//   entries  : name length, name, offset, size of each binary
+//   binaries : each one starts at a multiple of INDEX_FILE_ALIGNMENT, so it can be mmapped and used in place
+// Files written before the layout was versioned start with the index type, followed by
+// (name length, name, size, binary) of each binary.
+constexpr uint32_t INDEX_FILE_MAGIC = 0x5849564D;  // "MVIX"
+constexpr uint32_t INDEX_FILE_VERSION = 1;
+constexpr uint64_t INDEX_FILE_ALIGNMENT = 4096;
+
+uint64_t
+AlignIndexOffset(uint64_t offset) {
+    return (offset + INDEX_FILE_ALIGNMENT - 1) / INDEX_FILE_ALIGNMENT * INDEX_FILE_ALIGNMENT;
+}
+
+// the binaries share ownership of buffer instead of copying out of it
+bool
+ParseIndexFile(const std::shared_ptr<uint8_t>& buffer, size_t length, IndexType& type,
+               knowhere::BinarySet& binary_set) {
+    const uint8_t* data = buffer.get();
+    size_t rp = 0;
+    auto read_value = [&](void* ptr, size_t size) {
+        if (size > length - rp) {
+            return false;
+        }
+        memcpy(ptr, data + rp, size);
+        rp += size;
+        return true;
+    };
+    auto read_name = [&](std::string& name, uint64_t name_length) {
+        if (name_length > length - rp) {
+            return false;
+        }
+        name.assign(reinterpret_cast<const char*>(data + rp), name_length);
+        rp += name_length;
+        return true;
+    };
+    auto append_binary = [&](const std::string& name, uint64_t offset, uint64_t size) {
+        if (offset > length || size > length - offset) {
+            return false;
+        }
+        binary_set.Append(name, std::shared_ptr<uint8_t>(buffer, buffer.get() + offset), size);
+        return true;
+    };
+
+    uint32_t magic = 0;
+    if (length >= sizeof(magic)) {
+        memcpy(&magic, data, sizeof(magic));
+    }
+
+    if (magic != INDEX_FILE_MAGIC) {
+        if (!read_value(&type, sizeof(type))) {
+            return false;
+        }
+        while (rp < length) {
+            size_t meta_length = 0, bin_length = 0;
+            std::string meta;
+            if (!read_value(&meta_length, sizeof(meta_length)) || !read_name(meta, meta_length) ||
+                !read_value(&bin_length, sizeof(bin_length)) || !append_binary(meta, rp, bin_length)) {
+                return false;
+            }
+            rp += bin_length;
+        }
+        return true;
+    }
+
+    uint32_t version = 0, binary_count = 0;
+    if (!read_value(&magic, sizeof(magic)) || !read_value(&version, sizeof(version)) ||
+        !read_value(&type, sizeof(type)) || !read_value(&binary_count, sizeof(binary_count))) {
+        return false;
+    }
+    if (version > INDEX_FILE_VERSION) {
+        WRAPPER_LOG_ERROR << "Unsupported index file version " << version;
+        return false;
+    }
+    for (uint32_t i = 0; i < binary_count; ++i) {
+        uint64_t meta_length = 0, offset = 0, bin_length = 0;
+        std::string meta;
+        if (!read_value(&meta_length, sizeof(meta_length)) || !read_name(meta, meta_length) ||
+            !read_value(&offset, sizeof(offset)) || !read_value(&bin_length, sizeof(bin_length)) ||
+            !append_binary(meta, offset, bin_length)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
 int64_t
 VecIndex::Size() {
     if (size_ != 0) {
@@ -171,64 +267,44 @@ read_index(const std::string& location) {
     fiu_return_on("read_null_index", nullptr);
     fiu_do_on("vecIndex.throw_read_exception", throw std::exception());
     TimeRecorder recorder("read_index");
-    knowhere::BinarySet load_data_list;
 
     bool s3_enable = false;
     server::Config& config = server::Config::GetInstance();
     config.GetStorageConfigS3Enable(s3_enable);
 
-    std::shared_ptr<storage::IOReader> reader_ptr;
-    if (s3_enable) {
-        reader_ptr = std::make_shared<storage::S3IOReader>();
-    } else {
-        reader_ptr = std::make_shared<storage::DiskIOReader>();
-    }
-
     recorder.RecordSection("Start");
-    reader_ptr->open(location);
 
-    size_t length = reader_ptr->length();
-    if (length <= 0) {
-        return nullptr;
+    // the whole file as one buffer, the binaries reference it in place
+    std::shared_ptr<uint8_t> buffer;
+    size_t length = 0;
+    if (s3_enable) {
+        auto reader_ptr = std::make_shared<storage::S3IOReader>();
+        reader_ptr->open(location);
+        length = reader_ptr->length();
+        if (length <= 0) {
+            return nullptr;
+        }
+        buffer.reset(new uint8_t[length], std::default_delete<uint8_t[]>());
+        reader_ptr->seekg(0);
+        reader_ptr->read(buffer.get(), length);
+        reader_ptr->close();
+    } else {
+        // pages are read from disk when the index first touches them
+        auto file_ptr = std::make_shared<storage::DiskMappedFile>();
+        if (!file_ptr->open(location) || file_ptr->length() <= 0) {
+            return nullptr;
+        }
+        length = file_ptr->length();
+        buffer = std::shared_ptr<uint8_t>(file_ptr, const_cast<uint8_t*>(file_ptr->data()));
     }
 
-    size_t rp = 0;
-    reader_ptr->seekg(0);
-
+    knowhere::BinarySet load_data_list;
     auto current_type = IndexType::INVALID;
-    reader_ptr->read(&current_type, sizeof(current_type));
-    rp += sizeof(current_type);
-    reader_ptr->seekg(rp);
-
-    while (rp < length) {
-        size_t meta_length;
-        reader_ptr->read(&meta_length, sizeof(meta_length));
-        rp += sizeof(meta_length);
-        reader_ptr->seekg(rp);
-
-        auto meta = new char[meta_length];
-        reader_ptr->read(meta, meta_length);
-        rp += meta_length;
-        reader_ptr->seekg(rp);
-
-        size_t bin_length;
-        reader_ptr->read(&bin_length, sizeof(bin_length));
-        rp += sizeof(bin_length);
-        reader_ptr->seekg(rp);
-
-        auto bin = new uint8_t[bin_length];
-        reader_ptr->read(bin, bin_length);
-        rp += bin_length;
-        reader_ptr->seekg(rp);
-
-        auto binptr = std::make_shared<uint8_t>();
-        binptr.reset(bin);
-        load_data_list.Append(std::string(meta, meta_length), binptr, bin_length);
-        delete[] meta;
+    if (!ParseIndexFile(buffer, length, current_type, load_data_list)) {
+        WRAPPER_LOG_ERROR << "Invalid index file: " << location;
+        return nullptr;
     }
 
-    reader_ptr->close();
-
     double span = recorder.RecordSection("End");
     double rate = length * 1000000.0 / span / 1024 / 1024;
     STORAGE_LOG_DEBUG << "read_index(" << location << ") rate " << rate << "MB/s";
@@ -241,8 +317,24 @@ write_index(VecIndexPtr index, const std::string& location) {
     try {
         TimeRecorder recorder("write_index");
 
-        auto binaryset = index->Serialize();
-        auto index_type = index->GetType();
+        // an index able to write its binary piece by piece is never serialized in memory as a whole
+        IndexType index_type;
+        knowhere::BinarySet binaryset;
+        std::vector<std::pair<std::string, uint64_t>> binaries;
+        std::string stream_name;
+        int64_t stream_size = 0;
+        bool streaming = index->SerializedSize(stream_name, stream_size).ok();
+        if (streaming) {
+            binaries.emplace_back(stream_name, stream_size);
+            index_type = ConvertToCpuIndexType(index->GetType());
+        } else {
+            // Serialize() converts the type of a gpu index to its cpu type, read the type after it
+            binaryset = index->Serialize();
+            index_type = index->GetType();
+            for (auto& iter : binaryset.binary_map_) {
+                binaries.emplace_back(iter.first, iter.second->size);
+            }
+        }
 
         fiu_do_on("VecIndex.write_index.throw_knowhere_exception", throw knowhere::KnowhereException(""));
         fiu_do_on("VecIndex.write_index.throw_std_exception", throw std::exception());
@@ -263,18 +355,55 @@ write_index(VecIndexPtr index, const std::string& location) {
         recorder.RecordSection("Start");
         writer_ptr->open(location);
 
+        uint32_t magic = INDEX_FILE_MAGIC;
+        uint32_t version = INDEX_FILE_VERSION;
+        uint32_t binary_count = binaries.size();
+        uint64_t header_size = sizeof(magic) + sizeof(version) + sizeof(index_type) + sizeof(binary_count);
+        for (auto& binary : binaries) {
+            header_size += sizeof(uint64_t) * 3 + binary.first.length();
+        }
+
+        writer_ptr->write(&magic, sizeof(magic));
+        writer_ptr->write(&version, sizeof(version));
         writer_ptr->write(&index_type, sizeof(IndexType));
+        writer_ptr->write(&binary_count, sizeof(binary_count));
 
-        for (auto& iter : binaryset.binary_map_) {
-            auto meta = iter.first.c_str();
-            size_t meta_length = iter.first.length();
+        uint64_t offset = AlignIndexOffset(header_size);
+        for (auto& binary : binaries) {
+            uint64_t meta_length = binary.first.length();
             writer_ptr->write(&meta_length, sizeof(meta_length));
-            writer_ptr->write((void*)meta, meta_length);
+            writer_ptr->write((void*)binary.first.c_str(), meta_length);
 
-            auto binary = iter.second;
-            int64_t binary_length = binary->size;
+            uint64_t binary_length = binary.second;
+            writer_ptr->write(&offset, sizeof(offset));
             writer_ptr->write(&binary_length, sizeof(binary_length));
-            writer_ptr->write((void*)binary->data.get(), binary_length);
+            offset = AlignIndexOffset(offset + binary_length);
+        }
+
+        std::vector<uint8_t> padding(INDEX_FILE_ALIGNMENT, 0);
+        uint64_t pos = header_size;
+        for (auto& binary : binaries) {
+            uint64_t start = AlignIndexOffset(pos);
+            writer_ptr->write(padding.data(), start - pos);
+
+            if (streaming) {
+                uint64_t written = 0;
+                auto write = [&](const void* data, size_t size) {
+                    writer_ptr->write(const_cast<void*>(data), size);
+                    written += size;
+                };
+                auto status = index->SerializeTo(write);
+                if (!status.ok()) {
+                    throw Exception(status.code(), status.message());
+                }
+                if (written != binary.second) {
+                    throw Exception(SERVER_UNEXPECTED_ERROR, "Index binary size changed while written");
+                }
+            } else {
+                auto data = binaryset.GetByName(binary.first);
+                writer_ptr->write((void*)data->data.get(), data->size);
+            }
+            pos = start + binary.second;
         }
 
         writer_ptr->close();
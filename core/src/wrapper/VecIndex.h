@@ -13,6 +13,7 @@
 
 #include <faiss/utils/ConcurrentBitset.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <thirdparty/nlohmann/json.hpp>
@@ -202,8 +203,75 @@ class VecIndex : public cache::DataObj {
         ENGINE_LOG_ERROR << "GetUIDArray not support";
     }
 
+    // remove the vectors whose offset_map[offset] is negative from the built index and renumber the others,
+    // uids and blacklist of the compacted index have to be set again by the caller
+    virtual Status
+    Compact(const std::vector<int64_t>& offset_map) {
+        return Status(KNOWHERE_ERROR, "Compact not support");
+    }
+
+    // train the index without adding vectors, the trained index serves as model of BuildWithModel
+    virtual Status
+    Train(const int64_t& nb, const float* xb, const Config& cfg) {
+        return Status(KNOWHERE_ERROR, "Train not support");
+    }
+
+    // build from the quantizer and codebooks of a trained model instead of training again
+    virtual Status
+    BuildWithModel(const VecIndexPtr& model, const int64_t& nb, const float* xb, const int64_t* ids,
+                   const Config& cfg) {
+        return Status(KNOWHERE_ERROR, "BuildWithModel not support");
+    }
+
+    // name and size of the single binary Serialize() would return, for indexes able to write it out piece by piece
+    virtual Status
+    SerializedSize(std::string& name, int64_t& size) {
+        return Status(KNOWHERE_ERROR, "SerializedSize not support");
+    }
+
+    // write the binary of SerializedSize() through write, without a copy of it in memory
+    virtual Status
+    SerializeTo(const std::function<void(const void*, size_t)>& write) {
+        return Status(KNOWHERE_ERROR, "SerializeTo not support");
+    }
+
+    // save the index being built to a local file, Restore reads it back and more vectors can be added
+    virtual Status
+    Checkpoint(const std::string& path) {
+        return Status(KNOWHERE_ERROR, "Checkpoint not support");
+    }
+
+    virtual Status
+    Restore(const std::string& path) {
+        return Status(KNOWHERE_ERROR, "Restore not support");
+    }
+
+    // uid to offset lookup of the segment, cached together with the index
+    void
+    SetIdIndex(const segment::IdIndexPtr& id_index) {
+        std::atomic_store(&id_index_, id_index);
+    }
+
+    segment::IdIndexPtr
+    GetIdIndex() const {
+        return std::atomic_load(&id_index_);
+    }
+
+    // bloom filter of the segment, kept with the cached index once applying deletes has loaded it
+    void
+    SetBloomFilter(const segment::IdBloomFilterPtr& bloom_filter) {
+        std::atomic_store(&bloom_filter_, bloom_filter);
+    }
+
+    segment::IdBloomFilterPtr
+    GetBloomFilter() const {
+        return std::atomic_load(&bloom_filter_);
+    }
+
  private:
     int64_t size_ = 0;
+    segment::IdIndexPtr id_index_;
+    segment::IdBloomFilterPtr bloom_filter_;
 };
 
 extern Status
@@ -1163,6 +1163,56 @@ TEST_F(DBTestWALRecovery, RECOVERY_WITH_NO_ERROR) {
     ASSERT_EQ(result_ids.size() / topk, qb);
 }
 
+TEST_F(DBTestWALRecovery, RECOVERY_MULTI_TABLE_TEST) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::meta::TableSchema table_info_2 = BuildTableSchema();
+    table_info_2.table_id_ = TABLE_NAME + std::string("_2");
+    stat = db_->CreateTable(table_info_2);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t qb = 100;
+    for (int i = 0; i < 5; i++) {
+        milvus::engine::VectorsData qxb;
+        BuildVectors(qb, i, qxb);
+        stat = db_->InsertVectors(table_info.table_id_, "", qxb);
+        ASSERT_TRUE(stat.ok());
+
+        BuildVectors(qb, i, qxb);
+        stat = db_->InsertVectors(table_info_2.table_id_, "", qxb);
+        ASSERT_TRUE(stat.ok());
+    }
+
+    // the delete is replayed after the inserts of its table
+    milvus::engine::IDNumbers ids_to_delete;
+    for (int64_t i = 0; i < 10; i++) {
+        ids_to_delete.push_back(i);
+    }
+    stat = db_->DeleteVectors(table_info.table_id_, ids_to_delete);
+    ASSERT_TRUE(stat.ok());
+
+    fiu_init(0);
+    fiu_enable("DBImpl.ExexWalRecord.return", 1, nullptr, 0);
+    db_ = nullptr;
+    fiu_disable("DBImpl.ExexWalRecord.return");
+    auto options = GetOptions();
+    db_ = milvus::engine::DBFactory::Build(options);
+
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t row_count = 0;
+    stat = db_->GetTableRowCount(table_info.table_id_, row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, qb * 5 - ids_to_delete.size());
+
+    stat = db_->GetTableRowCount(table_info_2.table_id_, row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, qb * 5);
+}
+
 TEST_F(DBTestWALRecovery_Error, RECOVERY_WITH_INVALID_LOG_FILE) {
     milvus::engine::meta::TableSchema table_info = BuildTableSchema();
     auto stat = db_->CreateTable(table_info);
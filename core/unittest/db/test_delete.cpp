@@ -9,6 +9,7 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <chrono>
 #include <cmath>
@@ -18,7 +19,11 @@
 #include <random>
 #include <thread>
 
+#include "cache/CpuCacheMgr.h"
 #include "db/Constants.h"
+#define private public
+#include "db/DBImpl.h"
+#undef private
 #include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
 #include "db/insert/MemTable.h"
@@ -28,6 +33,7 @@
 #include "db/utils.h"
 #include "gtest/gtest.h"
 #include "metrics/Metrics.h"
+#include "wrapper/VecIndex.h"
 
 namespace {
 
@@ -495,6 +501,55 @@ TEST_F(DeleteTest, delete_multiple_times_with_index) {
     }
 }
 
+TEST_F(DeleteTest, delete_same_ids_twice_with_index) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    int64_t nb = 10000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    for (int64_t i = 0; i < nb; i++) {
+        xb.id_array_.push_back(i);
+    }
+
+    stat = db_->InsertVectors(table_info.table_id_, "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::TableIndex index;
+    index.engine_type_ = (int)milvus::engine::EngineType::FAISS_IVFFLAT;
+    index.extra_params_ = {{"nlist", 16}};
+    stat = db_->CreateIndex(table_info.table_id_, index);
+    ASSERT_TRUE(stat.ok());
+
+    // search once so the index, and the id index along with it, is in cache
+    milvus::engine::VectorsData search;
+    search.vector_count_ = 1;
+    search.float_data_.insert(search.float_data_.end(), xb.float_data_.begin(), xb.float_data_.begin() + TABLE_DIM);
+    std::vector<std::string> tags;
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    stat = db_->Query(dummy_context_, table_info.table_id_, tags, 10, {{"nprobe", 16}}, search, result_ids,
+                      result_distances);
+    ASSERT_TRUE(stat.ok());
+
+    // deleting ids already deleted changes nothing
+    milvus::engine::IDNumbers ids_to_delete{0, 10, 100, 1000};
+    for (int32_t round = 0; round < 2; ++round) {
+        stat = db_->DeleteVectors(table_info.table_id_, ids_to_delete);
+        ASSERT_TRUE(stat.ok());
+        stat = db_->Flush();
+        ASSERT_TRUE(stat.ok());
+
+        uint64_t row_count;
+        stat = db_->GetTableRowCount(table_info.table_id_, row_count);
+        ASSERT_TRUE(stat.ok());
+        ASSERT_EQ(row_count, nb - ids_to_delete.size());
+    }
+}
+
 TEST_F(DeleteTest, delete_single_vector) {
     milvus::engine::meta::TableSchema table_info = BuildTableSchema();
     auto stat = db_->CreateTable(table_info);
@@ -681,6 +736,79 @@ TEST_F(DeleteTest, delete_add_auto_flush) {
     ASSERT_EQ(result_distances[0], std::numeric_limits<float>::max());
 }
 
+TEST_F(DeleteTest, delete_across_segments) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    // each batch is flushed into its own segment
+    int64_t segment_count = 8;
+    int64_t nb = 1000;
+    for (int64_t i = 0; i < segment_count; i++) {
+        milvus::engine::VectorsData xb;
+        BuildVectors(nb, xb);
+        for (int64_t j = 0; j < nb; j++) {
+            xb.id_array_.push_back(i * nb + j);
+        }
+        stat = db_->InsertVectors(table_info.table_id_, "", xb);
+        ASSERT_TRUE(stat.ok());
+        stat = db_->Flush();
+        ASSERT_TRUE(stat.ok());
+    }
+
+    // the bloom filter and the id index of cached segments are used instead of loading them
+    stat = db_->PreloadTable(table_info.table_id_);
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::IDNumbers ids_to_delete;
+    for (int64_t i = 0; i < segment_count; i += 2) {
+        ids_to_delete.emplace_back(i * nb);
+        ids_to_delete.emplace_back(i * nb + nb - 1);
+    }
+    // not in any segment
+    ids_to_delete.emplace_back(segment_count * nb + 1);
+
+    stat = db_->DeleteVectors(table_info.table_id_, ids_to_delete);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t row_count;
+    stat = db_->GetTableRowCount(table_info.table_id_, row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, segment_count * nb - (ids_to_delete.size() - 1));
+
+    // the bloom filters kept in cache have the deleted ids removed
+    auto db_impl = std::static_pointer_cast<milvus::engine::DBImpl>(db_);
+    milvus::engine::meta::TableFilesSchema raw_files;
+    stat = db_impl->meta_ptr_->FilesByType(table_info.table_id_, {milvus::engine::meta::TableFileSchema::RAW},
+                                           raw_files);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(raw_files.size(), segment_count);
+    for (auto& file : raw_files) {
+        auto index = std::static_pointer_cast<milvus::engine::VecIndex>(
+            milvus::cache::CpuCacheMgr::GetInstance()->GetIndex(file.location_));
+        ASSERT_NE(index, nullptr);
+        auto bloom_filter = index->GetBloomFilter();
+        ASSERT_NE(bloom_filter, nullptr);
+        for (auto& id : ids_to_delete) {
+            ASSERT_FALSE(bloom_filter->Check(id));
+        }
+    }
+
+    for (auto& id : ids_to_delete) {
+        milvus::engine::VectorsData vector;
+        stat = db_->GetVectorByID(table_info.table_id_, id, vector);
+        ASSERT_TRUE(stat.ok());
+        ASSERT_TRUE(vector.float_data_.empty());
+    }
+
+    milvus::engine::VectorsData vector;
+    stat = db_->GetVectorByID(table_info.table_id_, 1, vector);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(vector.float_data_.size(), TABLE_DIM);
+}
+
 TEST_F(CompactTest, compact_basic) {
     milvus::engine::meta::TableSchema table_info = BuildTableSchema();
     auto stat = db_->CreateTable(table_info);
@@ -825,6 +953,105 @@ TEST_F(CompactTest, compact_with_index) {
     }
 }
 
+TEST_F(CompactTest, compact_ivf_index) {
+    auto db_impl = std::static_pointer_cast<milvus::engine::DBImpl>(db_);
+
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    table_info.index_file_size_ = 1;  // MB, so the compacted segment is large enough to be indexed
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    int64_t nb = 3000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    for (int64_t i = 0; i < nb; i++) {
+        xb.id_array_.push_back(i);
+    }
+
+    stat = db_->InsertVectors(table_info.table_id_, "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::TableIndex index;
+    index.engine_type_ = (int)milvus::engine::EngineType::FAISS_IVFFLAT;
+    index.extra_params_ = {{"nlist", 16}};
+    stat = db_->CreateIndex(table_info.table_id_, index);
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::meta::TableFilesSchema index_files;
+    stat = db_impl->meta_ptr_->FilesByType(table_info.table_id_, {milvus::engine::meta::TableFileSchema::INDEX},
+                                           index_files);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(index_files.size(), 1);
+
+    milvus::engine::IDNumbers ids_to_delete{0, 1, 10, 100, 1000, 2999};
+    stat = db_->DeleteVectors(table_info.table_id_, ids_to_delete);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    stat = db_->Compact(table_info.table_id_);
+    ASSERT_TRUE(stat.ok());
+
+    // the index is compacted along with the segment, the raw file is kept as its backup
+    milvus::engine::meta::TableFilesSchema compacted_index_files;
+    stat = db_impl->meta_ptr_->FilesByType(table_info.table_id_, {milvus::engine::meta::TableFileSchema::INDEX},
+                                           compacted_index_files);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(compacted_index_files.size(), 1);
+    ASSERT_NE(compacted_index_files[0].segment_id_, index_files[0].segment_id_);
+    ASSERT_EQ(compacted_index_files[0].engine_type_, index.engine_type_);
+    ASSERT_EQ(compacted_index_files[0].row_count_, nb - ids_to_delete.size());
+
+    milvus::engine::meta::TableFilesSchema backup_files;
+    stat = db_impl->meta_ptr_->FilesByType(table_info.table_id_, {milvus::engine::meta::TableFileSchema::BACKUP},
+                                           backup_files);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(backup_files.size(), 1);
+    ASSERT_EQ(backup_files[0].segment_id_, compacted_index_files[0].segment_id_);
+
+    milvus::engine::meta::TableFilesSchema to_index_files;
+    stat = db_impl->meta_ptr_->FilesByType(table_info.table_id_, {milvus::engine::meta::TableFileSchema::TO_INDEX},
+                                           to_index_files);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_TRUE(to_index_files.empty());
+
+    uint64_t row_count;
+    stat = db_->GetTableRowCount(table_info.table_id_, row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, nb - ids_to_delete.size());
+
+    // search the deleted vectors and some remaining ones with all the lists probed
+    const int64_t topk = 10;
+    milvus::json json_params = {{"nprobe", 16}};
+    milvus::engine::IDNumbers query_ids = ids_to_delete;
+    milvus::engine::IDNumbers remaining_ids{2, 11, 2998};
+    query_ids.insert(query_ids.end(), remaining_ids.begin(), remaining_ids.end());
+
+    milvus::engine::VectorsData search;
+    search.vector_count_ = query_ids.size();
+    for (auto id : query_ids) {
+        search.float_data_.insert(search.float_data_.end(), xb.float_data_.begin() + id * TABLE_DIM,
+                                  xb.float_data_.begin() + (id + 1) * TABLE_DIM);
+    }
+
+    std::vector<std::string> tags;
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    stat = db_->Query(dummy_context_, table_info.table_id_, tags, topk, json_params, search, result_ids,
+                      result_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(result_ids.size(), query_ids.size() * topk);
+    for (auto id : result_ids) {
+        ASSERT_EQ(std::find(ids_to_delete.begin(), ids_to_delete.end(), id), ids_to_delete.end());
+    }
+    for (size_t i = ids_to_delete.size(); i < query_ids.size(); ++i) {
+        ASSERT_EQ(result_ids[i * topk], query_ids[i]);
+        ASSERT_LT(result_distances[i * topk], 1e-4);
+    }
+}
+
 TEST_F(CompactTest, compact_non_existing_table) {
     auto status = db_->Compact("non_existing_table");
     ASSERT_FALSE(status.ok());
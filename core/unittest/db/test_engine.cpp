@@ -11,11 +11,15 @@
 
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
+#include <fstream>
+#include <string>
 #include <vector>
 
 #include "db/engine/EngineFactory.h"
 #include "db/engine/ExecutionEngineImpl.h"
+#include "db/engine/IndexModelMgr.h"
 #include "db/utils.h"
+#include "segment/SegmentWriter.h"
 #include <fiu-local.h>
 #include <fiu-control.h>
 
@@ -278,3 +282,146 @@ TEST_F(EngineTest, ENGINE_IMPL_THROW_EXCEPTION_TEST) {
 
     fiu_disable("vecIndex.throw_read_exception");
 }
+
+TEST_F(EngineTest, ENGINE_SHARED_INDEX_MODEL_TEST) {
+    std::string model_path = "/tmp/milvus_index_model";
+    boost::filesystem::remove(model_path);
+    boost::filesystem::remove(model_path + ".key");
+    milvus::engine::IndexModelMgr::GetInstance().Clear();
+
+    milvus::json index_params = {{"nlist", 10}};
+    auto engine_ptr = CreateExecEngine(index_params, milvus::engine::MetricType::L2);
+
+    // the first build trains and stores the model
+    auto engine_build =
+        engine_ptr->BuildIndex("/tmp/milvus_index_6", milvus::engine::EngineType::FAISS_IVFFLAT, model_path);
+    ASSERT_NE(engine_build, nullptr);
+    ASSERT_EQ(engine_build->Count(), ROW_COUNT);
+    ASSERT_TRUE(boost::filesystem::exists(model_path));
+    ASSERT_TRUE(boost::filesystem::exists(model_path + ".key"));
+
+    // the model is loaded from disk after restart
+    milvus::engine::IndexModelMgr::GetInstance().Clear();
+    auto engine_shared =
+        engine_ptr->BuildIndex("/tmp/milvus_index_7", milvus::engine::EngineType::FAISS_IVFFLAT, model_path);
+    ASSERT_NE(engine_shared, nullptr);
+    ASSERT_EQ(engine_shared->Count(), ROW_COUNT);
+
+    const int64_t nq = 10;
+    const int64_t topk = 5;
+    std::vector<float> query;
+    for (int64_t i = 0; i < nq; i++) {
+        for (uint16_t k = 0; k < DIMENSION; k++) {
+            query.push_back(i * 100 * DIMENSION + k);
+        }
+    }
+    milvus::json search_params = {{"nprobe", 10}};
+    std::vector<float> distances(nq * topk), shared_distances(nq * topk);
+    std::vector<int64_t> labels(nq * topk), shared_labels(nq * topk);
+    auto status = engine_build->Search(nq, query.data(), topk, search_params, distances.data(), labels.data(), false);
+    ASSERT_TRUE(status.ok());
+    status = engine_shared->Search(nq, query.data(), topk, search_params, shared_distances.data(),
+                                   shared_labels.data(), false);
+    ASSERT_TRUE(status.ok());
+    for (int64_t i = 0; i < nq; i++) {
+        ASSERT_EQ(labels[i * topk], i * 100);
+    }
+    ASSERT_EQ(labels, shared_labels);
+
+    // a model trained with other parameters is replaced
+    std::ifstream key_file(model_path + ".key");
+    std::string key((std::istreambuf_iterator<char>(key_file)), std::istreambuf_iterator<char>());
+    engine_ptr = CreateExecEngine({{"nlist", 20}}, milvus::engine::MetricType::L2);
+    engine_build =
+        engine_ptr->BuildIndex("/tmp/milvus_index_8", milvus::engine::EngineType::FAISS_IVFFLAT, model_path);
+    ASSERT_NE(engine_build, nullptr);
+    std::ifstream new_key_file(model_path + ".key");
+    std::string new_key((std::istreambuf_iterator<char>(new_key_file)), std::istreambuf_iterator<char>());
+    ASSERT_NE(key, new_key);
+}
+
+TEST_F(EngineTest, ENGINE_BUILD_IN_CHUNKS_TEST) {
+    fiu_init(0);
+    std::string segment_dir = "/tmp/milvus_chunk_segment";
+    boost::filesystem::remove_all(segment_dir);
+    boost::filesystem::create_directories(segment_dir);
+
+    std::vector<float> data;
+    std::vector<milvus::segment::doc_id_t> uids;
+    for (int64_t i = 0; i < ROW_COUNT; i++) {
+        uids.push_back(i);
+        for (uint16_t k = 0; k < DIMENSION; k++) {
+            data.push_back(i * DIMENSION + k);
+        }
+    }
+    milvus::segment::SegmentWriter segment_writer(segment_dir);
+    auto status = segment_writer.AddVectors("raw", reinterpret_cast<const uint8_t*>(data.data()),
+                                            data.size() * sizeof(float), uids.data(), uids.size());
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(segment_writer.Serialize().ok());
+
+    std::string raw_location = segment_dir + "/raw";
+    std::string index_location = segment_dir + "/index";
+    milvus::json index_params = {{"nlist", 10}};
+    auto engine_ptr = milvus::engine::EngineFactory::Build(DIMENSION, raw_location,
+                                                           milvus::engine::EngineType::FAISS_IDMAP,
+                                                           milvus::engine::MetricType::L2, index_params);
+    ASSERT_TRUE(engine_ptr->CanBuildInChunks(milvus::engine::EngineType::FAISS_IVFFLAT));
+    ASSERT_FALSE(engine_ptr->CanBuildInChunks(milvus::engine::EngineType::FAISS_IDMAP));
+
+    // chunks of 100 rows, the progress is saved after each of them
+    int64_t chunk_size = 100 * DIMENSION * sizeof(float);
+    std::string checkpoint = raw_location + ".build";
+    auto checkpoint_rows = [&]() -> int64_t {
+        auto index = milvus::engine::GetVecIndexFactory(milvus::engine::IndexType::FAISS_IVFFLAT_CPU);
+        EXPECT_TRUE(index->Restore(checkpoint).ok());
+        return index->Count();
+    };
+    fiu_enable("ExecutionEngineImpl.BuildIndexInChunks.interrupt", 1, NULL, 0);
+    ASSERT_ANY_THROW(engine_ptr->BuildIndexInChunks(index_location, milvus::engine::EngineType::FAISS_IVFFLAT, "",
+                                                    chunk_size, 0));
+    ASSERT_TRUE(boost::filesystem::exists(checkpoint));
+    ASSERT_EQ(checkpoint_rows(), 100);
+
+    // interrupted again, the build restored the first chunk and saved the progress after the second one
+    ASSERT_ANY_THROW(engine_ptr->BuildIndexInChunks(index_location, milvus::engine::EngineType::FAISS_IVFFLAT, "",
+                                                    chunk_size, 0));
+    fiu_disable("ExecutionEngineImpl.BuildIndexInChunks.interrupt");
+    ASSERT_EQ(checkpoint_rows(), 200);
+
+    // the build goes on from the checkpoint, which is removed once the index is saved
+    auto engine_build = engine_ptr->BuildIndexInChunks(index_location, milvus::engine::EngineType::FAISS_IVFFLAT,
+                                                       "", chunk_size, 0);
+    ASSERT_NE(engine_build, nullptr);
+    ASSERT_EQ(engine_build->Count(), ROW_COUNT);
+    ASSERT_TRUE(engine_build->Serialize().ok());
+    ASSERT_FALSE(boost::filesystem::exists(checkpoint));
+
+    // the index streamed to disk loads back the same
+    auto engine_load = milvus::engine::EngineFactory::Build(DIMENSION, index_location,
+                                                            milvus::engine::EngineType::FAISS_IVFFLAT,
+                                                            milvus::engine::MetricType::L2, index_params);
+    ASSERT_TRUE(engine_load->Load(false).ok());
+    ASSERT_EQ(engine_load->Count(), ROW_COUNT);
+
+    const int64_t nq = 10;
+    const int64_t topk = 5;
+    std::vector<float> query;
+    for (int64_t i = 0; i < nq; i++) {
+        for (uint16_t k = 0; k < DIMENSION; k++) {
+            query.push_back(i * 100 * DIMENSION + k);
+        }
+    }
+    milvus::json search_params = {{"nprobe", 10}};
+    std::vector<float> distances(nq * topk), load_distances(nq * topk);
+    std::vector<int64_t> labels(nq * topk), load_labels(nq * topk);
+    status = engine_build->Search(nq, query.data(), topk, search_params, distances.data(), labels.data(), false);
+    ASSERT_TRUE(status.ok());
+    status = engine_load->Search(nq, query.data(), topk, search_params, load_distances.data(), load_labels.data(),
+                                 false);
+    ASSERT_TRUE(status.ok());
+    for (int64_t i = 0; i < nq; i++) {
+        ASSERT_EQ(labels[i * topk], i * 100);
+    }
+    ASSERT_EQ(labels, load_labels);
+}
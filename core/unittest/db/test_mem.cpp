@@ -15,6 +15,7 @@
 #include <fstream>
 #include <iostream>
 #include <random>
+#include <set>
 #include <thread>
 #include <fiu-control.h>
 #include <fiu-local.h>
@@ -109,6 +110,48 @@ TEST_F(MemManagerTest, VECTOR_SOURCE_TEST) {
     ASSERT_EQ(vectors.id_array_.size(), 100);
 }
 
+TEST_F(MemManagerTest, VECTOR_SOURCE_RAW_DATA_TEST) {
+    milvus::engine::meta::TableSchema table_schema = BuildTableSchema();
+    auto status = impl_->CreateTable(table_schema);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::TableFileSchema table_file_schema;
+    table_file_schema.table_id_ = GetTableName();
+    status = impl_->CreateTableFile(table_file_schema);
+    ASSERT_TRUE(status.ok());
+
+    int64_t n = 100;
+    milvus::engine::VectorsData vectors;
+    BuildVectors(n, vectors);
+    for (int64_t i = 0; i < n; i++) {
+        vectors.id_array_.push_back(i);
+    }
+
+    // the source reads the caller's buffers directly
+    milvus::engine::VectorSource source(n, vectors.id_array_.data(), vectors.float_data_.data());
+
+    std::string directory;
+    milvus::engine::utils::GetParentPath(table_file_schema.location_, directory);
+    auto segment_writer_ptr = std::make_shared<milvus::segment::SegmentWriter>(directory);
+
+    size_t num_vectors_added;
+    status = source.Add(segment_writer_ptr, table_file_schema, 30, num_vectors_added);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(num_vectors_added, 30);
+    status = source.Add(segment_writer_ptr, table_file_schema, 100, num_vectors_added);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(num_vectors_added, 70);
+    ASSERT_TRUE(source.AllAdded());
+    ASSERT_EQ(source.GetVectorIds(), vectors.id_array_);
+
+    milvus::segment::SegmentPtr segment_ptr;
+    segment_writer_ptr->GetSegment(segment_ptr);
+    auto& data = segment_ptr->vectors_ptr_->GetData();
+    ASSERT_EQ(data.size(), vectors.float_data_.size() * sizeof(float));
+    ASSERT_EQ(memcmp(data.data(), vectors.float_data_.data(), data.size()), 0);
+    ASSERT_EQ(segment_ptr->vectors_ptr_->GetUids(), vectors.id_array_);
+}
+
 TEST_F(MemManagerTest, MEM_TABLE_FILE_TEST) {
     auto options = GetOptions();
     fiu_init(0);
@@ -244,6 +287,126 @@ TEST_F(MemManagerTest, MEM_TABLE_TEST) {
     fiu_disable("SqliteMetaImpl.UpdateTableFile.throw_exception");
 }
 
+TEST_F(MemManagerTest, MEM_TABLE_SEARCH_TEST) {
+    auto options = GetOptions();
+
+    milvus::engine::meta::TableSchema table_schema = BuildTableSchema();
+    auto status = impl_->CreateTable(table_schema);
+    ASSERT_TRUE(status.ok());
+
+    int64_t nb = 100;
+    milvus::engine::VectorsData vectors;
+    BuildVectors(nb, vectors);
+
+    milvus::engine::VectorSourcePtr source = std::make_shared<milvus::engine::VectorSource>(vectors);
+    milvus::engine::MemTable mem_table(GetTableName(), impl_, options);
+    status = mem_table.Add(source);
+    ASSERT_TRUE(status.ok());
+    auto vector_ids = source->GetVectorIds();
+
+    // query with the first vectors, each should find itself first
+    const uint64_t nq = 5;
+    const uint64_t topk = 10;
+    milvus::engine::VectorsData query;
+    query.vector_count_ = nq;
+    query.float_data_.assign(vectors.float_data_.begin(), vectors.float_data_.begin() + nq * TABLE_DIM);
+
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    status = mem_table.Search(topk, query, true, result_ids, result_distances);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(result_ids.size(), nq * topk);
+    for (uint64_t i = 0; i < nq; ++i) {
+        ASSERT_EQ(result_ids[i * topk], vector_ids[i]);
+        ASSERT_LT(result_distances[i * topk], 1e-5);
+    }
+
+    // deleted vectors are not found any more, and reported for the segments on disk
+    status = mem_table.Delete(vector_ids[0]);
+    ASSERT_TRUE(status.ok());
+    result_ids.clear();
+    result_distances.clear();
+    status = mem_table.Search(topk, query, true, result_ids, result_distances);
+    ASSERT_TRUE(status.ok());
+    ASSERT_NE(result_ids[0], vector_ids[0]);
+    ASSERT_EQ(result_ids[topk], vector_ids[1]);
+
+    std::set<milvus::segment::doc_id_t> deleted_ids;
+    mem_table.GetDeletedIds(deleted_ids);
+    ASSERT_EQ(deleted_ids.size(), 1);
+    ASSERT_EQ(*deleted_ids.begin(), vector_ids[0]);
+
+    // wrong dimension
+    milvus::engine::VectorsData wrong_query;
+    wrong_query.vector_count_ = 1;
+    wrong_query.float_data_.resize(TABLE_DIM / 2);
+    status = mem_table.Search(topk, wrong_query, true, result_ids, result_distances);
+    ASSERT_FALSE(status.ok());
+}
+
+TEST_F(SearchUnflushedTest, SEARCH_UNFLUSHED_TEST) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    int64_t nb = 100;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    for (int64_t i = 0; i < nb; i++) {
+        xb.id_array_.push_back(i);
+    }
+    stat = db_->InsertVectors(GetTableName(), "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    // insert the first vectors again without flush, they are found both in memory and on disk
+    const int64_t dup_count = 10;
+    milvus::engine::VectorsData dup;
+    dup.vector_count_ = dup_count;
+    dup.float_data_.assign(xb.float_data_.begin(), xb.float_data_.begin() + dup_count * TABLE_DIM);
+    dup.id_array_.assign(xb.id_array_.begin(), xb.id_array_.begin() + dup_count);
+    stat = db_->InsertVectors(GetTableName(), "", dup);
+    ASSERT_TRUE(stat.ok());
+
+    // pending deletes of a vector in memory and on disk, and of a vector only on disk
+    const int64_t deleted_dup_id = 5;
+    const int64_t deleted_flushed_id = 20;
+    stat = db_->DeleteVectors(GetTableName(), {deleted_dup_id, deleted_flushed_id});
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::VectorsData query;
+    query.vector_count_ = dup_count + 1;
+    query.float_data_.assign(xb.float_data_.begin(), xb.float_data_.begin() + dup_count * TABLE_DIM);
+    query.float_data_.insert(query.float_data_.end(), xb.float_data_.begin() + deleted_flushed_id * TABLE_DIM,
+                             xb.float_data_.begin() + (deleted_flushed_id + 1) * TABLE_DIM);
+
+    const int64_t topk = 10;
+    std::vector<std::string> tags;
+    milvus::json json_params = {{"nprobe", 1}};
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    stat = db_->Query(dummy_context_, GetTableName(), tags, topk, json_params, query, result_ids, result_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(result_ids.size(), query.vector_count_ * topk);
+
+    for (int64_t i = 0; i < query.vector_count_; ++i) {
+        int64_t query_id = (i < dup_count) ? i : deleted_flushed_id;
+        std::set<int64_t> ids;
+        for (int64_t j = i * topk; j < (i + 1) * topk; ++j) {
+            ASSERT_NE(result_ids[j], deleted_dup_id);
+            ASSERT_NE(result_ids[j], deleted_flushed_id);
+            // the files are searched for more than topk, the removed hits are replaced by the next ones
+            ASSERT_GE(result_ids[j], 0);
+            ASSERT_TRUE(ids.insert(result_ids[j]).second);
+        }
+        if (query_id != deleted_dup_id && query_id != deleted_flushed_id) {
+            ASSERT_EQ(result_ids[i * topk], query_id);
+            ASSERT_LT(result_distances[i * topk], 1e-4);
+        }
+    }
+}
+
 TEST_F(MemManagerTest2, SERIAL_INSERT_SEARCH_TEST) {
     milvus::engine::meta::TableSchema table_info = BuildTableSchema();
     auto stat = db_->CreateTable(table_info);
@@ -0,0 +1,266 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "db/Constants.h"
+#define private public
+#include "db/DBImpl.h"
+#undef private
+#include "db/merge/LeveledMergePolicy.h"
+#include "db/merge/MergeManager.h"
+#include "db/merge/SimpleMergePolicy.h"
+#include "db/merge/SizeTieredMergePolicy.h"
+#include "db/utils.h"
+
+namespace {
+
+static const char* TABLE_NAME = "test_merge";
+static constexpr int64_t TABLE_DIM = 256;
+
+milvus::engine::meta::TableFilesSchema
+BuildFiles(const std::vector<int64_t>& sizes) {
+    milvus::engine::meta::TableFilesSchema files;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        milvus::engine::meta::TableFileSchema file;
+        file.segment_id_ = "segment_" + std::to_string(i);
+        file.file_size_ = sizes[i];
+        file.file_type_ = milvus::engine::meta::TableFileSchema::RAW;
+        files.emplace_back(file);
+    }
+    // FilesToMerge returns files in descending order of size
+    std::sort(files.begin(), files.end(),
+              [](const milvus::engine::meta::TableFileSchema& a, const milvus::engine::meta::TableFileSchema& b) {
+                  return a.file_size_ > b.file_size_;
+              });
+    return files;
+}
+
+int64_t
+GroupSize(const milvus::engine::meta::TableFilesSchema& group) {
+    int64_t size = 0;
+    for (auto& file : group) {
+        size += file.file_size_;
+    }
+    return size;
+}
+
+void
+BuildVectors(uint64_t n, uint64_t batch_index, milvus::engine::VectorsData& vectors) {
+    vectors.vector_count_ = n;
+    vectors.float_data_.clear();
+    vectors.float_data_.resize(n * TABLE_DIM);
+    float* data = vectors.float_data_.data();
+    for (uint64_t i = 0; i < n; i++) {
+        for (int64_t j = 0; j < TABLE_DIM; j++) data[TABLE_DIM * i + j] = drand48();
+        vectors.id_array_.push_back(n * batch_index + i);
+    }
+}
+
+}  // namespace
+
+TEST(MergeTest, SIMPLE_POLICY_TEST) {
+    const int64_t index_file_size = 1024 * milvus::engine::ONE_MB;
+    milvus::engine::SimpleMergePolicy policy(2);
+    milvus::engine::MergeFilesGroups groups;
+
+    auto status = policy.Pick(BuildFiles({100}), index_file_size, groups);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(groups.empty());
+
+    // the largest files are merged until index_file_size is reached
+    int64_t mb = milvus::engine::ONE_MB;
+    status = policy.Pick(BuildFiles({600 * mb, 500 * mb, 10 * mb, 1 * mb}), index_file_size, groups);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(groups.size(), 1);
+    ASSERT_EQ(groups[0].size(), 2);
+    ASSERT_EQ(GroupSize(groups[0]), 1100 * mb);
+}
+
+TEST(MergeTest, SIZE_TIERED_POLICY_TEST) {
+    const int64_t mb = milvus::engine::ONE_MB;
+    const int64_t index_file_size = 1024 * mb;
+    milvus::engine::SizeTieredMergePolicy policy(4);
+    milvus::engine::MergeFilesGroups groups;
+
+    // a large file is not merged with the small ones
+    std::vector<int64_t> sizes{900 * mb, 2 * mb, 3 * mb, 4 * mb, 5 * mb};
+    auto status = policy.Pick(BuildFiles(sizes), index_file_size, groups);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(groups.size(), 1);
+    ASSERT_EQ(groups[0].size(), 4);
+    ASSERT_EQ(GroupSize(groups[0]), 14 * mb);
+
+    // two tiers of similar sizes, the 300M tier has too few files
+    sizes = {100 * mb, 110 * mb, 120 * mb, 90 * mb, 300 * mb, 310 * mb};
+    status = policy.Pick(BuildFiles(sizes), index_file_size, groups);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(groups.size(), 1);
+    ASSERT_EQ(GroupSize(groups[0]), 420 * mb);
+
+    // not enough files in any tier
+    status = policy.Pick(BuildFiles({100 * mb, 300 * mb, 900 * mb}), index_file_size, groups);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(groups.empty());
+}
+
+TEST(MergeTest, LEVELED_POLICY_TEST) {
+    const int64_t mb = milvus::engine::ONE_MB;
+    const int64_t index_file_size = 1000 * mb;
+    milvus::engine::LeveledMergePolicy policy(10, 3);
+    milvus::engine::MergeFilesGroups groups;
+
+    // levels: [100M, 1000M), [10M, 100M), [0, 10M)
+    // level 2 holds 12M in 4 files, more than 10M, level 1 holds 60M which is less than 100M
+    std::vector<int64_t> sizes{3 * mb, 3 * mb, 3 * mb, 3 * mb, 20 * mb, 40 * mb, 500 * mb};
+    auto status = policy.Pick(BuildFiles(sizes), index_file_size, groups);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(groups.size(), 1);
+    ASSERT_EQ(groups[0].size(), 4);
+    ASSERT_EQ(GroupSize(groups[0]), 12 * mb);
+
+    // fanout files in a level are merged even if they are small
+    sizes.assign(10, 1 * mb);
+    status = policy.Pick(BuildFiles(sizes), index_file_size, groups);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(groups.size(), 1);
+    ASSERT_EQ(groups[0].size(), 10);
+
+    // level 0 is filled up to index_file_size
+    sizes = {400 * mb, 300 * mb, 350 * mb, 200 * mb};
+    status = policy.Pick(BuildFiles(sizes), index_file_size, groups);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(groups.size(), 1);
+    ASSERT_GE(GroupSize(groups[0]), index_file_size);
+}
+
+TEST(MergeTest, POLICY_BY_FLAG_TEST) {
+    milvus::engine::DBOptions options;
+    auto policy = milvus::engine::MergeManager::CreatePolicy(0, options);
+    ASSERT_NE(std::dynamic_pointer_cast<milvus::engine::SimpleMergePolicy>(policy), nullptr);
+
+    int64_t flag = milvus::engine::meta::FLAG_MASK_HAS_USERID | milvus::engine::meta::FLAG_MASK_MERGE_SIZE_TIERED;
+    policy = milvus::engine::MergeManager::CreatePolicy(flag, options);
+    ASSERT_NE(std::dynamic_pointer_cast<milvus::engine::SizeTieredMergePolicy>(policy), nullptr);
+
+    flag = milvus::engine::meta::FLAG_MASK_NO_USERID | milvus::engine::meta::FLAG_MASK_MERGE_LEVELED;
+    policy = milvus::engine::MergeManager::CreatePolicy(flag, options);
+    ASSERT_NE(std::dynamic_pointer_cast<milvus::engine::LeveledMergePolicy>(policy), nullptr);
+}
+
+TEST(MergeTest, WRITE_AMPLIFICATION_TEST) {
+    milvus::engine::DBOptions options;
+    milvus::engine::MergeManager merge_mgr(nullptr, options);
+    ASSERT_EQ(merge_mgr.GetStats("table").WriteAmplification(), 0.0);
+
+    // 4 flushed files merged into 2, then the 2 merged into 1
+    auto files = BuildFiles({100, 100, 100, 100});
+    milvus::engine::meta::TableFileSchema merged_a;
+    merged_a.segment_id_ = "merged_a";
+    merged_a.file_size_ = 200;
+    merged_a.index_file_size_ = 1000;
+    merged_a.file_type_ = milvus::engine::meta::TableFileSchema::RAW;
+    auto merged_b = merged_a;
+    merged_b.segment_id_ = "merged_b";
+    merge_mgr.RecordMerge("table", {files[0], files[1]}, merged_a);
+    merge_mgr.RecordMerge("table", {files[2], files[3]}, merged_b);
+
+    milvus::engine::meta::TableFileSchema merged_c = merged_a;
+    merged_c.segment_id_ = "merged_c";
+    merged_c.file_size_ = 400;
+    merge_mgr.RecordMerge("table", {merged_a, merged_b}, merged_c);
+
+    auto stats = merge_mgr.GetStats("table");
+    ASSERT_EQ(stats.merge_count_, 3);
+    ASSERT_EQ(stats.ingested_bytes_, 400);
+    ASSERT_EQ(stats.read_bytes_, 800);
+    ASSERT_EQ(stats.written_bytes_, 800);
+    ASSERT_DOUBLE_EQ(stats.WriteAmplification(), 3.0);
+
+    // merged segments are tracked per table, a segment with the same id in another table is flushed data
+    merge_mgr.RecordMerge("other_table", {merged_c}, merged_a);
+    ASSERT_EQ(merge_mgr.GetStats("other_table").ingested_bytes_, 400);
+
+    // a deleted merged segment is forgotten, its id counts as flushed data again
+    merge_mgr.EraseSegment("other_table", "merged_a");
+    merge_mgr.RecordMerge("other_table", {merged_a}, merged_b);
+    ASSERT_EQ(merge_mgr.GetStats("other_table").ingested_bytes_, 600);
+
+    // dropping a table forgets its statistics and leaves the others alone
+    merge_mgr.DropTable("other_table");
+    ASSERT_EQ(merge_mgr.GetStats("other_table").merge_count_, 0);
+    ASSERT_EQ(merge_mgr.GetStats("table").merge_count_, 3);
+    merge_mgr.RecordMerge("table", {merged_c}, merged_a);
+    ASSERT_EQ(merge_mgr.GetStats("table").ingested_bytes_, 400);
+}
+
+TEST_F(DBTestMerge, MERGE_POLICY_IO_LIMIT_TEST) {
+    auto db_impl = std::static_pointer_cast<milvus::engine::DBImpl>(db_);
+
+    milvus::engine::meta::TableSchema table_info;
+    table_info.table_id_ = TABLE_NAME;
+    table_info.dimension_ = TABLE_DIM;
+    table_info.index_file_size_ = 1;  // MB
+    table_info.flag_ = milvus::engine::meta::FLAG_MASK_MERGE_SIZE_TIERED;
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    // 6 flushed files of about 400KB, every 3 of them fill an index file
+    const int64_t FILE_COUNT = 6;
+    const int64_t BATCH = 400;
+    for (int64_t i = 0; i < FILE_COUNT; i++) {
+        milvus::engine::VectorsData xb;
+        BuildVectors(BATCH, i, xb);
+        stat = db_->InsertVectors(TABLE_NAME, "", xb);
+        ASSERT_TRUE(stat.ok());
+        stat = db_->Flush();
+        ASSERT_TRUE(stat.ok());
+    }
+
+    milvus::engine::meta::TableFilesSchema files;
+    stat = db_impl->meta_ptr_->FilesToMerge(TABLE_NAME, files);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(files.size(), FILE_COUNT);
+
+    // the simple policy merges one group a round, the size tiered policy set by the table flag picks two
+    milvus::engine::MergeFilesGroups groups;
+    stat = db_impl->merge_mgr_ptr_->PickFiles(TABLE_NAME, groups);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(groups.size(), 2);
+
+    // the io limit defers the second group to the next round
+    db_impl->options_.merge_io_limit_ = 1;
+    stat = db_impl->BackgroundMergeFiles(TABLE_NAME);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(db_impl->merge_mgr_ptr_->GetStats(TABLE_NAME).merge_count_, 1);
+
+    stat = db_impl->meta_ptr_->FilesToMerge(TABLE_NAME, files);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(files.size(), FILE_COUNT - groups[0].size());
+
+    db_impl->options_.merge_io_limit_ = 0;
+    stat = db_impl->BackgroundMergeFiles(TABLE_NAME);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(db_impl->merge_mgr_ptr_->GetStats(TABLE_NAME).merge_count_, 2);
+
+    stat = db_impl->meta_ptr_->FilesToMerge(TABLE_NAME, files);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_TRUE(files.empty());
+
+    uint64_t row_count = 0;
+    stat = db_->GetTableRowCount(TABLE_NAME, row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, FILE_COUNT * BATCH);
+}
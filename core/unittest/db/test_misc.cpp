@@ -15,6 +15,8 @@
 #include <thread>
 #include <vector>
 
+#include "codecs/default/DefaultIdIndexFormat.h"
+#include "codecs/default/DefaultVectorsFormat.h"
 #include "db/IDGenerator.h"
 #include "db/IndexFailedChecker.h"
 #include "db/OngoingFileChecker.h"
@@ -22,6 +24,11 @@
 #include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
 #include "db/meta/SqliteMetaImpl.h"
+#include "segment/SegmentReader.h"
+#include "segment/SegmentWriter.h"
+#include "storage/disk/DiskIOReader.h"
+#include "storage/disk/DiskIOWriter.h"
+#include "storage/disk/DiskOperation.h"
 #include "utils/Exception.h"
 #include "utils/Status.h"
 
@@ -249,3 +256,183 @@ TEST(DBMiscTest, IDGENERATOR_TEST) {
 
     ASSERT_EQ(ids.size(), unique_ids.size());
 }
+
+TEST(DBMiscTest, ID_INDEX_TEST) {
+    std::vector<milvus::segment::doc_id_t> uids = {30, 10, 50, 20, 10, 40};
+    milvus::segment::IdIndex id_index(uids);
+    ASSERT_EQ(id_index.GetCount(), uids.size());
+
+    milvus::segment::offset_t offset;
+    for (size_t i = 0; i < uids.size(); i++) {
+        ASSERT_TRUE(id_index.Get(uids[i], offset));
+        ASSERT_EQ(uids[offset], uids[i]);
+    }
+    // duplicated uid returns the first offset
+    ASSERT_TRUE(id_index.Get(10, offset));
+    ASSERT_EQ(offset, 1);
+    ASSERT_FALSE(id_index.Get(0, offset));
+    ASSERT_FALSE(id_index.Get(35, offset));
+    ASSERT_FALSE(id_index.Get(60, offset));
+
+    // id index is written at serialize and read back by segment reader
+    std::string segment_dir = "/tmp/milvus_test/id_index_test";
+    boost::filesystem::remove_all(segment_dir);
+    boost::filesystem::create_directories(segment_dir);
+    milvus::segment::SegmentWriter segment_writer(segment_dir);
+    std::vector<uint8_t> data(uids.size() * sizeof(float), 0);
+    ASSERT_TRUE(segment_writer.AddVectors("id_index_test", data, uids).ok());
+    ASSERT_TRUE(segment_writer.Serialize().ok());
+    ASSERT_TRUE(boost::filesystem::exists(segment_dir + "/id_index"));
+
+    milvus::segment::SegmentReader segment_reader(segment_dir);
+    milvus::segment::IdIndexPtr id_index_ptr;
+    ASSERT_TRUE(segment_reader.LoadIdIndex(id_index_ptr).ok());
+    ASSERT_EQ(id_index_ptr->GetSortedUids(), id_index.GetSortedUids());
+    ASSERT_EQ(id_index_ptr->GetOffsets(), id_index.GetOffsets());
+
+    // a truncated id index is a read error, the segment reader rebuilds it from uids
+    boost::filesystem::resize_file(segment_dir + "/id_index", sizeof(size_t) + sizeof(milvus::segment::doc_id_t));
+    milvus::storage::IOReaderPtr reader_ptr = std::make_shared<milvus::storage::DiskIOReader>();
+    milvus::storage::IOWriterPtr writer_ptr = std::make_shared<milvus::storage::DiskIOWriter>();
+    milvus::storage::OperationPtr operation_ptr = std::make_shared<milvus::storage::DiskOperation>(segment_dir);
+    auto fs_ptr = std::make_shared<milvus::storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+    milvus::codec::DefaultIdIndexFormat id_index_format;
+    try {
+        id_index_format.read(fs_ptr, id_index_ptr);
+        FAIL() << "truncated id index read without error";
+    } catch (milvus::Exception& e) {
+        ASSERT_EQ(e.code(), milvus::SERVER_CANNOT_READ_FILE);
+    }
+    ASSERT_TRUE(segment_reader.LoadIdIndex(id_index_ptr).ok());
+    ASSERT_EQ(id_index_ptr->GetSortedUids(), id_index.GetSortedUids());
+
+    // segment without id index file falls back to uids
+    boost::filesystem::remove(segment_dir + "/id_index");
+    ASSERT_TRUE(segment_reader.LoadIdIndex(id_index_ptr).ok());
+    ASSERT_TRUE(id_index_ptr->Get(50, offset));
+    ASSERT_EQ(offset, 2);
+
+    boost::filesystem::remove_all(segment_dir);
+}
+
+TEST(DBMiscTest, SEGMENT_MERGE_TEST) {
+    const size_t dim = 4;
+    auto make_data = [&](const std::vector<milvus::segment::doc_id_t>& uids) {
+        std::vector<float> vectors(uids.size() * dim);
+        for (size_t i = 0; i < vectors.size(); ++i) {
+            vectors[i] = uids[i / dim] + (i % dim) * 0.1f;
+        }
+        auto begin = reinterpret_cast<uint8_t*>(vectors.data());
+        return std::vector<uint8_t>(begin, begin + vectors.size() * sizeof(float));
+    };
+
+    // erase runs between deleted offsets in place
+    std::vector<milvus::segment::doc_id_t> uids = {0, 1, 2, 3, 4, 5, 6, 7};
+    milvus::segment::Vectors vectors(make_data(uids), uids, "erase_test");
+    std::vector<int32_t> offsets = {6, 0, 3, 3, 100};
+    vectors.Erase(offsets);
+    std::vector<milvus::segment::doc_id_t> expect_uids = {1, 2, 4, 5, 7};
+    ASSERT_EQ(vectors.GetUids(), expect_uids);
+    ASSERT_EQ(vectors.GetData(), make_data(expect_uids));
+
+    // merged segments skip deleted vectors
+    std::string root_dir = "/tmp/milvus_test/segment_merge_test";
+    boost::filesystem::remove_all(root_dir);
+    std::vector<std::vector<milvus::segment::doc_id_t>> segment_uids = {{10, 11, 12, 13, 14}, {20, 21, 22}};
+    std::vector<std::string> segment_dirs;
+    for (size_t i = 0; i < segment_uids.size(); ++i) {
+        segment_dirs.push_back(root_dir + "/segment_" + std::to_string(i));
+        boost::filesystem::create_directories(segment_dirs.back());
+        milvus::segment::SegmentWriter segment_writer(segment_dirs.back());
+        ASSERT_TRUE(segment_writer.AddVectors("segment_" + std::to_string(i), make_data(segment_uids[i]),
+                                              segment_uids[i]).ok());
+        ASSERT_TRUE(segment_writer.Serialize().ok());
+    }
+    auto deleted_docs = std::make_shared<milvus::segment::DeletedDocs>(std::vector<int32_t>{4, 0, 2});
+    milvus::segment::SegmentWriter(segment_dirs[0]).WriteDeletedDocs(deleted_docs);
+
+    std::string merged_dir = root_dir + "/merged";
+    boost::filesystem::create_directories(merged_dir);
+    milvus::segment::SegmentWriter merged_writer(merged_dir);
+    for (auto& segment_dir : segment_dirs) {
+        ASSERT_TRUE(merged_writer.Merge(segment_dir, "merged").ok());
+    }
+    ASSERT_FALSE(merged_writer.AddVectors("merged", make_data({30}), {30}).ok());
+    ASSERT_TRUE(merged_writer.Serialize().ok());
+    expect_uids = {11, 13, 20, 21, 22};
+    ASSERT_EQ(merged_writer.VectorCount(), expect_uids.size());
+    ASSERT_EQ(merged_writer.Size(), expect_uids.size() * (dim * sizeof(float) + sizeof(milvus::segment::doc_id_t)));
+
+    milvus::segment::SegmentReader segment_reader(merged_dir);
+    ASSERT_TRUE(segment_reader.Load().ok());
+    milvus::segment::SegmentPtr segment_ptr;
+    segment_reader.GetSegment(segment_ptr);
+    ASSERT_EQ(segment_ptr->vectors_ptr_->GetUids(), expect_uids);
+    ASSERT_EQ(segment_ptr->vectors_ptr_->GetData(), make_data(expect_uids));
+
+    boost::filesystem::remove_all(root_dir);
+}
+
+TEST(DBMiscTest, SEGMENT_MERGE_CHUNK_TEST) {
+    const size_t dim = 4;
+    const size_t code_length = dim * sizeof(float);
+    auto make_data = [&](const std::vector<milvus::segment::doc_id_t>& uids) {
+        std::vector<float> vectors(uids.size() * dim);
+        for (size_t i = 0; i < vectors.size(); ++i) {
+            vectors[i] = uids[i / dim] + (i % dim) * 0.1f;
+        }
+        auto begin = reinterpret_cast<uint8_t*>(vectors.data());
+        return std::vector<uint8_t>(begin, begin + vectors.size() * sizeof(float));
+    };
+    auto make_fs = [](const std::string& dir) {
+        milvus::storage::IOReaderPtr reader_ptr = std::make_shared<milvus::storage::DiskIOReader>();
+        milvus::storage::IOWriterPtr writer_ptr = std::make_shared<milvus::storage::DiskIOWriter>();
+        milvus::storage::OperationPtr operation_ptr = std::make_shared<milvus::storage::DiskOperation>(dir);
+        return std::make_shared<milvus::storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+    };
+
+    std::string root_dir = "/tmp/milvus_test/segment_merge_chunk_test";
+    boost::filesystem::remove_all(root_dir);
+    std::string src_dir = root_dir + "/source";
+    boost::filesystem::create_directories(src_dir);
+    std::vector<milvus::segment::doc_id_t> uids = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    milvus::segment::SegmentWriter segment_writer(src_dir);
+    ASSERT_TRUE(segment_writer.AddVectors("source", make_data(uids), uids).ok());
+    ASSERT_TRUE(segment_writer.Serialize().ok());
+
+    // 4 vectors a chunk, the runs of deleted offsets 3~4 and 7~8 straddle the chunk boundaries
+    milvus::codec::DefaultVectorsFormat format(4 * code_length);
+    std::vector<int32_t> deleted_offsets = {0, 3, 4, 7, 8};
+    std::vector<milvus::segment::doc_id_t> merged_uids;
+    auto add_uids = [&](const milvus::segment::doc_id_t* ids, size_t count) {
+        merged_uids.insert(merged_uids.end(), ids, ids + count);
+    };
+
+    std::string merged_dir = root_dir + "/merged";
+    boost::filesystem::create_directories(merged_dir);
+    auto merged_fs = make_fs(merged_dir);
+    size_t merged_bytes = 0;
+    format.merge(merged_fs, "merged", make_fs(src_dir), deleted_offsets, add_uids, merged_bytes);
+    std::vector<milvus::segment::doc_id_t> expect_uids = {1, 2, 5, 6, 9};
+    ASSERT_EQ(merged_uids, expect_uids);
+    ASSERT_EQ(merged_bytes, expect_uids.size() * code_length);
+
+    std::vector<uint8_t> raw_vectors;
+    format.read_vectors(merged_fs, 0, INT64_MAX, raw_vectors);
+    ASSERT_EQ(raw_vectors, make_data(expect_uids));
+
+    // merging only empty sources still writes the raw vector file
+    std::string empty_dir = root_dir + "/empty";
+    boost::filesystem::create_directories(empty_dir);
+    auto empty_fs = make_fs(empty_dir);
+    merged_uids.clear();
+    std::vector<int32_t> all_offsets = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    format.merge(empty_fs, "empty", make_fs(src_dir), all_offsets, add_uids, merged_bytes);
+    ASSERT_TRUE(merged_uids.empty());
+    ASSERT_EQ(merged_bytes, 0);
+    ASSERT_TRUE(boost::filesystem::exists(empty_dir + "/empty.rv"));
+    format.read_vectors(empty_fs, 0, INT64_MAX, raw_vectors);
+    ASSERT_TRUE(raw_vectors.empty());
+
+    boost::filesystem::remove_all(root_dir);
+}
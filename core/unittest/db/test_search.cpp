@@ -10,9 +10,15 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <cmath>
+#include <thread>
 #include <vector>
 
+#include <opentracing/mocktracer/in_memory_recorder.h>
+#include <opentracing/mocktracer/tracer.h>
+
+#include "db/QueryBatcher.h"
 #include "scheduler/job/SearchJob.h"
 #include "scheduler/task/SearchTask.h"
 #include "utils/TimeRecorder.h"
@@ -162,6 +168,48 @@ TEST(DBSearchTest, MERGE_RESULT_SET_TEST) {
     MergeTopkToResultSetTest(TOP_K / 2, TOP_K / 3, NQ, TOP_K, false);
 }
 
+void
+MergeSearchResultsTest(size_t topk_1, size_t topk_2, size_t nq, size_t topk, bool ascending) {
+    std::vector<ms::SearchResult> results(2);
+    BuildResult(results[0].ids_, results[0].distances_, topk_1, topk, nq, ascending);
+    BuildResult(results[1].ids_, results[1].distances_, topk_2, topk, nq, ascending);
+    results[0].k_ = topk_1;
+    results[1].k_ = topk_2;
+    results[0].ascending_ = results[1].ascending_ = ascending;
+
+    ms::ResultIds result_ids;
+    ms::ResultDistances result_distances;
+    ms::SearchJob::MergeSearchResults(results, nq, topk, result_ids, result_distances);
+    CheckTopkResult(results[0].ids_, results[0].distances_, topk_1, results[1].ids_, results[1].distances_, topk_2,
+                    topk, nq, ascending, result_ids, result_distances);
+}
+
+TEST(DBSearchTest, MERGE_SEARCH_RESULTS_TEST) {
+    size_t NQ = 15;
+    size_t TOP_K = 64;
+
+    MergeSearchResultsTest(TOP_K, 0, NQ, TOP_K, true);
+    MergeSearchResultsTest(TOP_K, 0, NQ, TOP_K, false);
+    MergeSearchResultsTest(TOP_K, TOP_K, NQ, TOP_K, true);
+    MergeSearchResultsTest(TOP_K, TOP_K, NQ, TOP_K, false);
+    MergeSearchResultsTest(TOP_K / 2, TOP_K, NQ, TOP_K, true);
+    MergeSearchResultsTest(TOP_K / 2, TOP_K, NQ, TOP_K, false);
+    MergeSearchResultsTest(TOP_K / 2, TOP_K / 3, NQ, TOP_K, true);
+    MergeSearchResultsTest(TOP_K / 2, TOP_K / 3, NQ, TOP_K, false);
+
+    /* large nq goes through the parallel merge */
+    MergeSearchResultsTest(TOP_K / 2, TOP_K / 3, 1000, TOP_K, true);
+    MergeSearchResultsTest(TOP_K, TOP_K, 1000, TOP_K, false);
+
+    /* all files empty, result keeps untouched */
+    std::vector<ms::SearchResult> empty_results(3);
+    ms::ResultIds result_ids(NQ * TOP_K, -1);
+    ms::ResultDistances result_distances(NQ * TOP_K, 0.0);
+    ms::SearchJob::MergeSearchResults(empty_results, NQ, TOP_K, result_ids, result_distances);
+    ASSERT_EQ(result_ids.size(), NQ * TOP_K);
+    ASSERT_EQ(result_ids[0], -1);
+}
+
 //void MergeTopkArrayTest(size_t topk_1, size_t topk_2, size_t nq, size_t topk, bool ascending) {
 //    std::vector<int64_t> ids1, ids2;
 //    std::vector<float> dist1, dist2;
@@ -392,3 +440,84 @@ TEST(DBSearchTest, REDUCE_PERF_TEST) {
         }
     }
 }
+
+TEST(DBSearchTest, QUERY_BATCH_TEST) {
+    const int64_t dim = 4;
+    const uint64_t topk = 3;
+    const int32_t query_count = 8;
+    std::atomic<int32_t> call_count(0);
+    std::atomic<uint64_t> merged_nq(0);
+
+    // fake search: the result ids of each row are derived from the first element of the query vector
+    auto query_func = [&](const std::shared_ptr<milvus::server::Context>& context, const std::string& table_id,
+                          const std::vector<std::string>& partition_tags, uint64_t k,
+                          const milvus::json& extra_params, const milvus::engine::VectorsData& vectors,
+                          milvus::engine::ResultIds& result_ids, milvus::engine::ResultDistances& result_distances) {
+        ++call_count;
+        merged_nq = vectors.vector_count_;
+        for (uint64_t i = 0; i < vectors.vector_count_; ++i) {
+            for (uint64_t j = 0; j < k; ++j) {
+                result_ids.push_back((int64_t)vectors.float_data_[i * dim] * 100 + j);
+                result_distances.push_back((float)j);
+            }
+        }
+        return milvus::Status::OK();
+    };
+
+    // the window never expires in this test, the batch is closed by the last query filling it up to max nq
+    milvus::engine::QueryBatcher batcher(3600 * 1000, query_count, query_func);
+
+    milvus::engine::VectorsData id_vectors;
+    id_vectors.vector_count_ = 1;
+    id_vectors.id_array_.push_back(1);
+    ASSERT_FALSE(batcher.Batchable(id_vectors));
+
+    // each query traces into a recorder of its own
+    std::vector<opentracing::mocktracer::InMemoryRecorder*> recorders;
+    std::vector<std::shared_ptr<milvus::server::Context>> contexts;
+    for (int32_t n = 0; n < query_count; ++n) {
+        auto recorder = new opentracing::mocktracer::InMemoryRecorder();
+        recorders.push_back(recorder);
+        opentracing::mocktracer::MockTracerOptions tracer_options;
+        tracer_options.recorder.reset(recorder);
+        auto mock_tracer =
+            std::shared_ptr<opentracing::Tracer>{new opentracing::mocktracer::MockTracer{std::move(tracer_options)}};
+        auto mock_span = mock_tracer->StartSpan("mock_span");
+        auto context = std::make_shared<milvus::server::Context>("query_batch_test_" + std::to_string(n));
+        context->SetTraceContext(std::make_shared<milvus::tracing::TraceContext>(mock_span));
+        contexts.push_back(context);
+    }
+
+    std::vector<milvus::engine::ResultIds> ids_array(query_count);
+    std::vector<milvus::engine::ResultDistances> distances_array(query_count);
+    std::vector<std::thread> threads;
+    for (int32_t n = 0; n < query_count; ++n) {
+        threads.emplace_back([&, n]() {
+            milvus::engine::VectorsData vectors;
+            vectors.vector_count_ = 1;
+            vectors.float_data_.resize(dim, (float)n);
+            ASSERT_TRUE(batcher.Batchable(vectors));
+            auto status = batcher.Query(contexts[n], "test_table", {}, topk, milvus::json(), vectors, ids_array[n],
+                                        distances_array[n]);
+            ASSERT_TRUE(status.ok());
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // all queries are merged into one search
+    ASSERT_EQ(call_count, 1);
+    ASSERT_EQ(merged_nq, (uint64_t)query_count);
+    for (int32_t n = 0; n < query_count; ++n) {
+        ASSERT_EQ(ids_array[n].size(), topk);
+        ASSERT_EQ(distances_array[n].size(), topk);
+        for (uint64_t j = 0; j < topk; ++j) {
+            ASSERT_EQ(ids_array[n][j], n * 100 + j);
+        }
+
+        // the shared search is traced by every query, not only by the leader
+        ASSERT_EQ(recorders[n]->size(), 1u);
+        ASSERT_EQ(recorders[n]->top().operation_name, "QueryBatch");
+    }
+}
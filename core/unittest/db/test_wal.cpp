@@ -15,10 +15,12 @@
 #include <stdlib.h>
 #include <time.h>
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <thread>
 
+#include "db/WalApplier.h"
 #include "db/meta/SqliteMetaImpl.h"
 #include "db/wal/WalBuffer.h"
 #include "db/wal/WalFileHandler.h"
@@ -411,6 +413,81 @@ TEST(WalTest, BUFFER_TEST) {
     }
 }
 
+TEST(WalTest, BUFFER_LEGACY_RECORD_TEST) {
+    MakeEmptyTestPath();
+
+    // records as written before they had a magic and a checksum
+    uint32_t file_no = 3;
+    std::string file_data;
+    std::vector<uint64_t> lsns;
+    auto append_legacy = [&](milvus::engine::wal::MXLogType type, const std::string& table_id, uint32_t vector_num,
+                             uint32_t data_size) {
+        milvus::engine::wal::MXLogLegacyRecordHeader head;
+        head.mxl_type = (uint8_t)type;
+        head.table_id_size = table_id.size();
+        head.partition_tag_size = 0;
+        head.vector_num = vector_num;
+        head.data_size = data_size;
+        uint32_t end_offset = file_data.size() + milvus::engine::wal::SizeOfMXLogLegacyRecordHeader +
+                              table_id.size() + vector_num * sizeof(milvus::engine::IDNumber) + data_size;
+        head.mxl_lsn = (uint64_t)file_no << 32 | end_offset;
+        file_data.append((const char*)&head, milvus::engine::wal::SizeOfMXLogLegacyRecordHeader);
+        file_data.append(table_id);
+        for (uint32_t i = 0; i < vector_num; ++i) {
+            milvus::engine::IDNumber id = i;
+            file_data.append((const char*)&id, sizeof(id));
+        }
+        file_data.append(data_size, 'v');
+        lsns.push_back(head.mxl_lsn);
+    };
+    append_legacy(milvus::engine::wal::MXLogType::InsertVector, "legacy_table", 4, 4 * sizeof(float));
+    append_legacy(milvus::engine::wal::MXLogType::Delete, "legacy_table", 2, 0);
+
+    FILE* fi = fopen(WAL_GTEST_PATH "3.wal", "w");
+    fwrite(file_data.data(), 1, file_data.size(), fi);
+    fclose(fi);
+
+    milvus::engine::wal::MXLogBuffer buffer(WAL_GTEST_PATH, 32);
+    ASSERT_TRUE(buffer.Init((uint64_t)file_no << 32, lsns.back()));
+
+    // records appended after an upgrade follow the legacy ones in the same file
+    milvus::engine::wal::MXLogRecord record;
+    std::vector<milvus::engine::IDNumber> ids{7};
+    record.type = milvus::engine::wal::MXLogType::Delete;
+    record.table_id = "legacy_table";
+    record.partition_tag = "";
+    record.length = ids.size();
+    record.ids = ids.data();
+    record.data_size = 0;
+    record.data = nullptr;
+    ASSERT_EQ(buffer.Append(record), milvus::WAL_SUCCESS);
+    lsns.push_back(record.lsn);
+
+    milvus::engine::wal::MXLogRecord read_rst;
+    ASSERT_EQ(buffer.Next(lsns.back(), read_rst), milvus::WAL_SUCCESS);
+    ASSERT_EQ(read_rst.type, milvus::engine::wal::MXLogType::InsertVector);
+    ASSERT_EQ(read_rst.lsn, lsns[0]);
+    ASSERT_EQ(read_rst.table_id, "legacy_table");
+    ASSERT_EQ(read_rst.partition_tag, "");
+    ASSERT_EQ(read_rst.length, 4);
+    ASSERT_EQ(read_rst.ids[3], 3);
+    ASSERT_EQ(read_rst.data_size, 4 * sizeof(float));
+
+    ASSERT_EQ(buffer.Next(lsns.back(), read_rst), milvus::WAL_SUCCESS);
+    ASSERT_EQ(read_rst.type, milvus::engine::wal::MXLogType::Delete);
+    ASSERT_EQ(read_rst.lsn, lsns[1]);
+    ASSERT_EQ(read_rst.length, 2);
+    ASSERT_EQ(read_rst.data, nullptr);
+
+    ASSERT_EQ(buffer.Next(lsns.back(), read_rst), milvus::WAL_SUCCESS);
+    ASSERT_EQ(read_rst.type, milvus::engine::wal::MXLogType::Delete);
+    ASSERT_EQ(read_rst.lsn, lsns[2]);
+    ASSERT_EQ(read_rst.ids[0], 7);
+
+    ASSERT_EQ(buffer.Next(lsns.back(), read_rst), milvus::WAL_SUCCESS);
+    ASSERT_EQ(read_rst.type, milvus::engine::wal::MXLogType::None);
+}
+
 TEST(WalTest, MANAGER_INIT_TEST) {
     MakeEmptyTestPath();
 
@@ -686,6 +763,301 @@ TEST(WalTest, MANAGER_SAME_NAME_TABLE) {
     }
 }
 
+TEST(WalTest, MANAGER_GROUP_COMMIT_TEST) {
+    std::vector<milvus::engine::wal::MXLogDurability> durabilities = {
+        milvus::engine::wal::MXLogDurability::None, milvus::engine::wal::MXLogDurability::Flush,
+        milvus::engine::wal::MXLogDurability::Fsync, milvus::engine::wal::MXLogDurability::FsyncInterval};
+
+    const int64_t thread_count = 8;
+    const int64_t insert_count = 32;
+    const int64_t row_count = 16;
+    std::string table_id = "table";
+
+    for (auto durability : durabilities) {
+        MakeEmptyTestPath();
+
+        milvus::engine::DBMetaOptions opt = {WAL_GTEST_PATH};
+        milvus::engine::meta::MetaPtr meta = std::make_shared<milvus::engine::meta::TestWalMeta>(opt);
+
+        milvus::engine::meta::TableSchema schema;
+        schema.table_id_ = table_id;
+        schema.flush_lsn_ = 0;
+        meta->CreateTable(schema);
+
+        milvus::engine::wal::MXLogConfiguration wal_config;
+        wal_config.mxlog_path = WAL_GTEST_PATH;
+        wal_config.buffer_size = 64;
+        wal_config.recovery_error_ignore = false;
+        wal_config.durability = durability;
+        wal_config.sync_interval = 10;
+
+        std::shared_ptr<milvus::engine::wal::WalManager> manager =
+            std::make_shared<milvus::engine::wal::WalManager>(wal_config);
+        ASSERT_EQ(manager->Init(meta), milvus::WAL_SUCCESS);
+
+        // adjest the buffer size for test, let the wal file switch
+        manager->mxlog_config_.buffer_size = 8192;
+        manager->p_buffer_->mxlog_buffer_size_ = 8192;
+
+        // concurrent writers share the file writes and syncs
+        std::vector<std::thread> threads;
+        for (int64_t t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&, t]() {
+                std::vector<int64_t> ids(row_count);
+                std::vector<float> data_float(row_count * 8, (float)t);
+                for (int64_t i = 0; i < insert_count; ++i) {
+                    for (int64_t j = 0; j < row_count; ++j) {
+                        ids[j] = (t * insert_count + i) * row_count + j;
+                    }
+                    ASSERT_TRUE(manager->Insert(table_id, "", ids, data_float));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        uint64_t last_lsn = manager->last_applied_lsn_;
+        if (durability == milvus::engine::wal::MXLogDurability::Fsync) {
+            ASSERT_EQ(manager->synced_lsn_, last_lsn);
+        } else if (durability != milvus::engine::wal::MXLogDurability::None) {
+            ASSERT_EQ(manager->written_lsn_, last_lsn);
+        }
+
+        // the rest is written when the manager stops
+        manager = std::make_shared<milvus::engine::wal::WalManager>(wal_config);
+        ASSERT_EQ(manager->Init(meta), milvus::WAL_SUCCESS);
+        ASSERT_EQ(manager->last_applied_lsn_, last_lsn);
+
+        std::vector<bool> found(thread_count * insert_count * row_count, false);
+        milvus::engine::wal::MXLogRecord record;
+        while (1) {
+            ASSERT_EQ(manager->GetNextRecovery(record), milvus::WAL_SUCCESS);
+            if (record.type == milvus::engine::wal::MXLogType::None) {
+                break;
+            }
+            ASSERT_EQ(record.type, milvus::engine::wal::MXLogType::InsertVector);
+            ASSERT_EQ(record.table_id, table_id);
+            for (uint32_t i = 0; i < record.length; ++i) {
+                found[record.ids[i]] = true;
+            }
+        }
+        ASSERT_EQ(std::count(found.begin(), found.end(), true), (int64_t)found.size());
+    }
+}
+
+TEST(WalTest, MANAGER_TORN_RECORD_TEST) {
+    MakeEmptyTestPath();
+
+    milvus::engine::DBMetaOptions opt = {WAL_GTEST_PATH};
+    milvus::engine::meta::MetaPtr meta = std::make_shared<milvus::engine::meta::TestWalMeta>(opt);
+
+    milvus::engine::meta::TableSchema schema;
+    schema.table_id_ = "table";
+    schema.flush_lsn_ = 0;
+    meta->CreateTable(schema);
+
+    milvus::engine::wal::MXLogConfiguration wal_config;
+    wal_config.mxlog_path = WAL_GTEST_PATH;
+    wal_config.buffer_size = 64;
+    wal_config.recovery_error_ignore = false;
+
+    std::vector<int64_t> ids(16, 0);
+    std::vector<float> data_float(16 * 8, 0);
+    std::vector<uint64_t> lsns;
+
+    std::shared_ptr<milvus::engine::wal::WalManager> manager =
+        std::make_shared<milvus::engine::wal::WalManager>(wal_config);
+    ASSERT_EQ(manager->Init(meta), milvus::WAL_SUCCESS);
+    for (int64_t i = 0; i < 4; ++i) {
+        ASSERT_TRUE(manager->Insert(schema.table_id_, "", ids, data_float));
+        lsns.push_back(manager->last_applied_lsn_);
+    }
+    manager = nullptr;
+
+    auto count_records = [&]() -> int64_t {
+        int64_t count = 0;
+        milvus::engine::wal::MXLogRecord record;
+        while (1) {
+            EXPECT_EQ(manager->GetNextRecovery(record), milvus::WAL_SUCCESS);
+            if (record.type == milvus::engine::wal::MXLogType::None) {
+                break;
+            }
+            EXPECT_EQ(record.lsn, lsns[count]);
+            ++count;
+        }
+        return count;
+    };
+
+    // a torn write breaks the last record
+    FILE* fi = fopen(WAL_GTEST_PATH "0.wal", "r+");
+    ASSERT_NE(fi, nullptr);
+    fseek(fi, (lsns[3] & LSN_OFFSET_MASK) - 1, SEEK_SET);
+    fputc(0x5A, fi);
+    fclose(fi);
+
+    // recovery stops before the bad record
+    manager = std::make_shared<milvus::engine::wal::WalManager>(wal_config);
+    ASSERT_EQ(manager->Init(meta), milvus::WAL_SUCCESS);
+    ASSERT_EQ(count_records(), 3);
+    ASSERT_EQ(manager->last_applied_lsn_, lsns[2]);
+
+    // new record takes the place of the bad one
+    ASSERT_TRUE(manager->Insert(schema.table_id_, "", ids, data_float));
+    ASSERT_EQ(manager->last_applied_lsn_, lsns[3]);
+    manager = nullptr;
+
+    manager = std::make_shared<milvus::engine::wal::WalManager>(wal_config);
+    ASSERT_EQ(manager->Init(meta), milvus::WAL_SUCCESS);
+    ASSERT_EQ(count_records(), 4);
+}
+
+namespace {
+
+class TestWalMemManager : public milvus::engine::MemManager {
+ public:
+    milvus::Status
+    InsertVectors(const std::string& table_id, int64_t length, const milvus::engine::IDNumber* vector_ids, int64_t dim,
+                  const float* vectors, uint64_t lsn, std::set<std::string>& flushed_tables) override {
+        return milvus::Status::OK();
+    }
+
+    milvus::Status
+    InsertVectors(const std::string& table_id, int64_t length, const milvus::engine::IDNumber* vector_ids, int64_t dim,
+                  const uint8_t* vectors, uint64_t lsn, std::set<std::string>& flushed_tables) override {
+        return milvus::Status::OK();
+    }
+
+    milvus::Status
+    DeleteVector(const std::string& table_id, milvus::engine::IDNumber vector_id, uint64_t lsn) override {
+        return milvus::Status::OK();
+    }
+
+    milvus::Status
+    DeleteVectors(const std::string& table_id, int64_t length, const milvus::engine::IDNumber* vector_ids,
+                  uint64_t lsn) override {
+        return milvus::Status::OK();
+    }
+
+    milvus::Status
+    Flush(const std::string& table_id, bool apply_delete) override {
+        return milvus::Status::OK();
+    }
+
+    milvus::Status
+    Flush(std::set<std::string>& table_ids, bool apply_delete) override {
+        return milvus::Status::OK();
+    }
+
+    milvus::Status
+    Search(const std::string& table_id, uint64_t k, const milvus::engine::VectorsData& vectors, bool ascending,
+           milvus::engine::ResultIds& result_ids, milvus::engine::ResultDistances& result_distances,
+           std::set<milvus::engine::IDNumber>& deleted_ids) override {
+        return milvus::Status::OK();
+    }
+
+    milvus::Status
+    EraseMemVector(const std::string& table_id) override {
+        return milvus::Status::OK();
+    }
+
+    size_t
+    GetCurrentMutableMem() override {
+        return mem_size_;
+    }
+
+    size_t
+    GetCurrentImmutableMem() override {
+        return 0;
+    }
+
+    size_t
+    GetCurrentMem() override {
+        return mem_size_;
+    }
+
+    std::atomic<size_t> mem_size_{0};
+};
+
+}  // namespace
+
+TEST(WalTest, APPLIER_TEST) {
+    const int64_t table_count = 4;
+    const int64_t record_count = 200;
+    auto mem_mgr = std::make_shared<TestWalMemManager>();
+
+    std::mutex mutex;
+    std::map<std::string, std::vector<uint64_t>> applied_lsns;
+    std::vector<milvus::engine::IDNumber> applied_ids;
+    uint64_t applied_count = 0;
+    uint64_t dispatched_count = 0;
+    bool barrier_ok = true;
+    auto apply_func = [&](const milvus::engine::wal::MXLogRecord& record) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (record.type == milvus::engine::wal::MXLogType::Flush) {
+            // every record before the flush is applied
+            barrier_ok = barrier_ok && (applied_count == dispatched_count);
+            return milvus::Status::OK();
+        }
+        applied_lsns[record.table_id].push_back(record.lsn);
+        applied_ids.push_back(record.ids[0]);
+        ++applied_count;
+        return milvus::Status::OK();
+    };
+
+    {
+        milvus::engine::WalApplier applier(4, apply_func, mem_mgr, 1024 * 1024);
+        std::vector<float> data(16);
+        for (int64_t i = 0; i < record_count; i++) {
+            // the caller buffer is reused for every record
+            milvus::engine::IDNumber id = i;
+            milvus::engine::wal::MXLogRecord record;
+            record.lsn = i + 1;
+            record.type = (i % 50 == 49) ? milvus::engine::wal::MXLogType::Flush
+                                         : milvus::engine::wal::MXLogType::InsertVector;
+            record.table_id = "table_" + std::to_string(i % table_count);
+            record.partition_tag = "";
+            record.length = 1;
+            record.ids = &id;
+            record.data_size = data.size() * sizeof(float);
+            record.data = data.data();
+            if (record.type != milvus::engine::wal::MXLogType::Flush) {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++dispatched_count;
+            }
+            ASSERT_TRUE(applier.Apply(record).ok());
+        }
+
+        // the insert buffer is full, the record is applied in place
+        mem_mgr->mem_size_ = 1024 * 1024;
+        milvus::engine::IDNumber id = record_count;
+        milvus::engine::wal::MXLogRecord record;
+        record.lsn = record_count + 1;
+        record.type = milvus::engine::wal::MXLogType::InsertVector;
+        record.table_id = "table_0";
+        record.length = 1;
+        record.ids = &id;
+        record.data_size = 0;
+        record.data = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++dispatched_count;
+        }
+        ASSERT_TRUE(applier.Apply(record).ok());
+        std::lock_guard<std::mutex> lock(mutex);
+        ASSERT_EQ(applied_count, dispatched_count);
+    }
+
+    ASSERT_TRUE(barrier_ok);
+    ASSERT_EQ(applied_lsns.size(), table_count);
+    for (auto& pair : applied_lsns) {
+        ASSERT_TRUE(std::is_sorted(pair.second.begin(), pair.second.end()));
+    }
+    std::sort(applied_ids.begin(), applied_ids.end());
+    ASSERT_EQ(applied_ids.size(), record_count - record_count / 50 + 1);
+    ASSERT_EQ(applied_ids.back(), record_count);
+}
+
 #if 0
 TEST(WalTest, LargeScaleRecords) {
     std::string data_path = "/home/zilliz/workspace/data/";
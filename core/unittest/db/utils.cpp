@@ -214,6 +214,25 @@ DBTest2::GetOptions() {
     return options;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+milvus::engine::DBOptions
+DBTestMerge::GetOptions() {
+    auto options = BaseTest::GetOptions();
+    // disable auto flush, so that no background merge is triggered
+    options.auto_flush_interval_ = 0;
+    return options;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+milvus::engine::DBOptions
+SearchUnflushedTest::GetOptions() {
+    auto options = BaseTest::GetOptions();
+    options.search_unflushed_ = true;
+    // disable auto flush, so that the inserted and deleted vectors stay in memory
+    options.auto_flush_interval_ = 0;
+    return options;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 milvus::engine::DBOptions
 DBTestWAL::GetOptions() {
@@ -81,6 +81,13 @@ class DBTest2 : public DBTest {
     GetOptions() override;
 };
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class DBTestMerge : public DBTest {
+ protected:
+    milvus::engine::DBOptions
+    GetOptions() override;
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class DBTestWAL : public DBTest {
  protected:
@@ -145,6 +152,13 @@ class MemManagerTest : public MetaTest {};
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class MemManagerTest2 : public DBTest {};
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class SearchUnflushedTest : public DBTest {
+ protected:
+    milvus::engine::DBOptions
+    GetOptions() override;
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class DeleteTest : public DBTest {};
 
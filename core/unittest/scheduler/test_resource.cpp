@@ -10,8 +10,13 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
 
 #include "scheduler/ResourceFactory.h"
+#include "scheduler/SchedInst.h"
 #include "scheduler/resource/CpuResource.h"
 #include "scheduler/resource/DiskResource.h"
 #include "scheduler/resource/GpuResource.h"
@@ -65,6 +70,16 @@ TEST_F(ResourceBaseTest, HAS_EXECUTOR) {
     ASSERT_FALSE(disable_executor_->HasExecutor());
 }
 
+TEST_F(ResourceBaseTest, BUILD_EXECUTOR) {
+    ASSERT_EQ(enable_executor_->BuildConcurrency(), 0);
+    enable_executor_->EnableBuildExecutor(2, 4);
+    ASSERT_EQ(enable_executor_->BuildConcurrency(), 2);
+
+    // build threads exit with the executor
+    enable_executor_->Start();
+    enable_executor_->Stop();
+}
+
 TEST_F(ResourceBaseTest, DUMP) {
     ASSERT_FALSE(enable_executor_->Dump().empty());
     ASSERT_FALSE(disable_executor_->Dump().empty());
@@ -274,6 +289,127 @@ TEST_F(ResourceAdvanceTest, TEST_RESOURCE_TEST) {
     ASSERT_EQ(null_resource, nullptr);
 }
 
+/************ BuildExecutorTest ************/
+// build index task held in Execute() until the gate opens
+class GatedBuildTask : public Task {
+ public:
+    struct Gate {
+        bool open_ = false;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+    };
+
+    GatedBuildTask(TaskLabelPtr label, std::shared_ptr<Gate> gate)
+        : Task(TaskType::BuildIndexTask, std::move(label)), gate_(std::move(gate)) {
+    }
+
+    void
+    Load(LoadType type, uint8_t device_id) override {
+    }
+
+    void
+    Execute() override {
+        std::unique_lock<std::mutex> lock(gate_->mutex_);
+        gate_->cv_.wait(lock, [&] { return gate_->open_; });
+        ++exec_count_;
+    }
+
+    std::atomic<uint64_t> exec_count_{0};
+
+ private:
+    std::shared_ptr<Gate> gate_;
+};
+
+class BuildExecutorTest : public testing::Test {
+ protected:
+    void
+    SetUp() override {
+        // a finished build wakes the loaders of "disk" and "cpu" through ResMgrInst
+        disk_resource_ = ResourceFactory::Create("disk", "DISK", 0, false);
+        cpu_resource_ = ResourceFactory::Create("cpu", "CPU", 0);
+        cpu_resource_->EnableBuildExecutor(1, 0);
+        ResMgrInst::GetInstance()->Add(ResourcePtr(disk_resource_));
+        ResMgrInst::GetInstance()->Add(ResourcePtr(cpu_resource_));
+
+        // stands in for the scheduler, which is not running here
+        cpu_resource_->RegisterSubscriber([&](EventPtr event) {
+            if (event->Type() == EventType::LOAD_COMPLETED) {
+                cpu_resource_->WakeupExecutor();
+            }
+        });
+
+        disk_resource_->Start();
+        cpu_resource_->Start();
+    }
+
+    void
+    TearDown() override {
+        disk_resource_->Stop();
+        cpu_resource_->Stop();
+        ResMgrInst::GetInstance()->Clear();
+    }
+
+    ResourcePtr disk_resource_;
+    ResourcePtr cpu_resource_;
+};
+
+TEST_F(BuildExecutorTest, SEARCH_WHILE_BUILDING) {
+    // more build tasks than the loaded limit of the task table, all of them held by the gate
+    const uint64_t BUILD_NUM = 4;
+    auto gate = std::make_shared<GatedBuildTask::Gate>();
+    std::vector<std::string> path{cpu_resource_->name()};
+    std::vector<std::shared_ptr<GatedBuildTask>> build_tasks;
+    for (uint64_t i = 0; i < BUILD_NUM; ++i) {
+        auto label = std::make_shared<SpecResLabel>(cpu_resource_);
+        auto task = std::make_shared<GatedBuildTask>(label, gate);
+        task->path() = Path(path, 0);
+        build_tasks.push_back(task);
+        cpu_resource_->task_table().Put(task);
+    }
+
+    TableFileSchemaPtr dummy = nullptr;
+    auto label = std::make_shared<SpecResLabel>(cpu_resource_);
+    auto search_task = std::make_shared<TestTask>(std::make_shared<server::Context>("dummy_request_id"), dummy, label);
+    search_task->path() = Path(path, 0);
+    cpu_resource_->task_table().Put(search_task);
+
+    cpu_resource_->WakeupLoader();
+
+    // the search queued behind the builds finishes while none of them can
+    bool search_done = false;
+    {
+        std::unique_lock<std::mutex> lock(search_task->mutex_);
+        search_done = search_task->cv_.wait_for(lock, std::chrono::seconds(10), [&] { return search_task->done_; });
+    }
+    uint64_t built_before_search = 0;
+    for (auto& task : build_tasks) {
+        built_before_search += task->exec_count_;
+    }
+
+    // open the gate before asserting, the build threads have to finish for the resource to stop
+    {
+        std::lock_guard<std::mutex> lock(gate->mutex_);
+        gate->open_ = true;
+    }
+    gate->cv_.notify_all();
+    ASSERT_TRUE(search_done);
+    ASSERT_EQ(built_before_search, 0);
+
+    for (uint64_t i = 0; i < 1000; ++i) {
+        uint64_t executed = 0;
+        for (auto& task : build_tasks) {
+            executed += task->exec_count_;
+        }
+        if (executed == BUILD_NUM) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    for (auto& task : build_tasks) {
+        ASSERT_EQ(task->exec_count_, 1);
+    }
+}
+
 TEST(Connection_Test, CONNECTION_TEST) {
     std::string connection_name = "cpu";
     uint64_t speed = 982;
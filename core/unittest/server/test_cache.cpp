@@ -12,11 +12,17 @@
 #include <gtest/gtest.h>
 #include <fiu-control.h>
 #include <fiu-local.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
 #include "utils/Error.h"
 #include "wrapper/VecIndex.h"
 
 #include "cache/CpuCacheMgr.h"
 #include "cache/GpuCacheMgr.h"
+#include "cache/LRU.h"
 
 namespace {
 
@@ -33,6 +39,15 @@ class LessItemCacheMgr : public milvus::cache::CacheMgr<milvus::cache::DataObjPt
     }
 };
 
+class PinnedCacheMgr : public milvus::cache::CacheMgr<milvus::cache::DataObjPtr> {
+ public:
+    PinnedCacheMgr() {
+        cache_ = std::make_shared<milvus::cache::Cache<milvus::cache::DataObjPtr>>(10 * 1024, 1UL << 32);
+    }
+
+    using CacheMgr::SetPinnedTables;
+};
+
 class MockVecIndex : public milvus::engine::VecIndex {
  public:
     MockVecIndex(int64_t dim, int64_t total) : dimension_(dim), ntotal_(total) {
@@ -251,6 +266,151 @@ TEST(CacheTest, INVALID_TEST) {
     }
 }
 
+TEST(CacheTest, SINGLE_FLIGHT_LOAD_TEST) {
+    LessItemCacheMgr mgr;
+    const int32_t thread_count = 8;
+    std::atomic<int32_t> load_count(0);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+
+    // the first loader blocks until every thread has asked for the key, so they all pile up on one load
+    auto loader = [&](milvus::cache::DataObjPtr& obj) -> milvus::Status {
+        ++load_count;
+        released.wait();
+        obj = std::make_shared<MockVecIndex>(256, 2);
+        return milvus::Status::OK();
+    };
+
+    std::vector<milvus::cache::DataObjPtr> objs(thread_count);
+    std::vector<std::thread> threads;
+    for (int32_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back([&, i]() {
+            auto status = mgr.GetOrLoadItem("index_load", loader, true, objs[i]);
+            ASSERT_TRUE(status.ok());
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    release.set_value();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(load_count, 1);
+    ASSERT_TRUE(mgr.ItemExists("index_load"));
+    for (auto& obj : objs) {
+        ASSERT_NE(obj, nullptr);
+        ASSERT_EQ(obj, objs[0]);
+    }
+
+    // cached now, the loader is not called again
+    milvus::cache::DataObjPtr obj;
+    ASSERT_TRUE(mgr.GetOrLoadItem("index_load", loader, true, obj).ok());
+    ASSERT_EQ(obj, objs[0]);
+    ASSERT_EQ(load_count, 1);
+
+    // a failed load is reported to the caller and nothing is cached
+    auto failed_loader = [&](milvus::cache::DataObjPtr& obj) -> milvus::Status {
+        return milvus::Status(milvus::SERVER_UNEXPECTED_ERROR, "load failed");
+    };
+    ASSERT_FALSE(mgr.GetOrLoadItem("index_failed", failed_loader, true, obj).ok());
+    ASSERT_FALSE(mgr.ItemExists("index_failed"));
+}
+
+TEST(CacheTest, SCAN_RESISTANT_TEST) {
+    // each item is 1k byte, the cache holds 10 of them
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(10 * 1024, 1UL << 32);
+    auto make_item = []() -> milvus::cache::DataObjPtr { return std::make_shared<MockVecIndex>(256, 1); };
+
+    // hot items are inserted and then accessed again, which promotes them out of probation
+    for (int i = 0; i < 5; i++) {
+        cache.insert("hot_" + std::to_string(i), make_item());
+        ASSERT_NE(cache.get("hot_" + std::to_string(i)), nullptr);
+    }
+
+    // a scan touching each item only once must not flush the hot items
+    for (int i = 0; i < 50; i++) {
+        cache.insert("scan_" + std::to_string(i), make_item());
+    }
+    for (int i = 0; i < 5; i++) {
+        ASSERT_TRUE(cache.exists("hot_" + std::to_string(i)));
+    }
+    ASSERT_FALSE(cache.exists("scan_0"));
+    ASSERT_LE(cache.usage(), cache.capacity());
+
+    // an item evicted from probation and loaded again soon after is protected
+    cache.insert("scan_0", make_item());
+    for (int i = 50; i < 100; i++) {
+        cache.insert("scan_" + std::to_string(i), make_item());
+    }
+    ASSERT_TRUE(cache.exists("scan_0"));
+
+    cache.erase("scan_0");
+    ASSERT_FALSE(cache.exists("scan_0"));
+    cache.clear();
+    ASSERT_EQ(cache.size(), 0);
+    ASSERT_EQ(cache.usage(), 0);
+}
+
+TEST(CacheTest, PIN_TEST) {
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(10 * 1024, 1UL << 32);
+    auto make_item = []() -> milvus::cache::DataObjPtr { return std::make_shared<MockVecIndex>(256, 1); };
+
+    cache.pin("/tables/pinned/");
+    for (int i = 0; i < 5; i++) {
+        cache.insert("/db/tables/pinned/" + std::to_string(i), make_item());
+    }
+    for (int i = 0; i < 50; i++) {
+        cache.insert("/db/tables/other/" + std::to_string(i), make_item());
+    }
+    for (int i = 0; i < 5; i++) {
+        ASSERT_TRUE(cache.exists("/db/tables/pinned/" + std::to_string(i)));
+    }
+
+    // pinned items alone may exceed the capacity, nothing else is kept then
+    for (int i = 5; i < 12; i++) {
+        cache.insert("/db/tables/pinned/" + std::to_string(i), make_item());
+    }
+    ASSERT_EQ(cache.size(), 12);
+    ASSERT_GT(cache.usage(), cache.capacity());
+
+    // once unpinned they are evicted as usual
+    cache.unpin("/tables/pinned/");
+    ASSERT_LE(cache.usage(), cache.capacity());
+}
+
+TEST(CacheTest, PIN_PARTITIONS_TEST) {
+    PinnedCacheMgr mgr;
+    auto make_item = []() -> milvus::cache::DataObjPtr { return std::make_shared<MockVecIndex>(256, 1); };
+
+    // the partitions of a pinned table are pinned with it
+    PinnedCacheMgr::SetPartitionsResolver([](const std::string& table_id) {
+        std::vector<std::string> partition_ids;
+        if (table_id == "pinned") {
+            partition_ids.push_back("pinned_partition");
+        }
+        return partition_ids;
+    });
+    mgr.SetPinnedTables("pinned");
+    PinnedCacheMgr::SetPartitionsResolver(nullptr);
+
+    for (int i = 0; i < 5; i++) {
+        mgr.InsertItem("/db/tables/pinned_partition/" + std::to_string(i), make_item());
+    }
+    for (int i = 0; i < 50; i++) {
+        mgr.InsertItem("/db/tables/other/" + std::to_string(i), make_item());
+    }
+    for (int i = 0; i < 5; i++) {
+        ASSERT_TRUE(mgr.ItemExists("/db/tables/pinned_partition/" + std::to_string(i)));
+    }
+
+    // unpinned with its table
+    mgr.SetPinnedTables("");
+    for (int i = 50; i < 100; i++) {
+        mgr.InsertItem("/db/tables/other/" + std::to_string(i), make_item());
+    }
+    ASSERT_FALSE(mgr.ItemExists("/db/tables/pinned_partition/0"));
+}
+
 TEST(CacheTest, PARTIAL_LRU_TEST) {
     constexpr int MAX_SIZE = 5;
     milvus::cache::LRU<int, int> lru(MAX_SIZE);
@@ -189,6 +189,11 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetDBConfigAutoFlushInterval(int64_val).ok());
     ASSERT_TRUE(int64_val == db_auto_flush_interval);
 
+    int64_t db_merge_io_limit = 2;
+    ASSERT_TRUE(config.SetDBConfigMergeIoLimit(std::to_string(db_merge_io_limit)).ok());
+    ASSERT_TRUE(config.GetDBConfigMergeIoLimit(int64_val).ok());
+    ASSERT_TRUE(int64_val == db_merge_io_limit);
+
     /* storage config */
     std::string storage_primary_path = "/home/zilliz";
     ASSERT_TRUE(config.SetStorageConfigPrimaryPath(storage_primary_path).ok());
@@ -267,6 +272,11 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetCacheConfigCacheInsertData(bool_val).ok());
     ASSERT_TRUE(bool_val == cache_insert_data);
 
+    std::string cache_pinned_tables = "table_1,table_2";
+    ASSERT_TRUE(config.SetCacheConfigPinnedTables(cache_pinned_tables).ok());
+    ASSERT_TRUE(config.GetCacheConfigPinnedTables(str_val).ok());
+    ASSERT_TRUE(str_val == cache_pinned_tables);
+
     /* engine config */
     int64_t engine_use_blas_threshold = 50;
     ASSERT_TRUE(config.SetEngineConfigUseBlasThreshold(std::to_string(engine_use_blas_threshold)).ok());
@@ -283,6 +293,47 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetEngineConfigUseAVX512(bool_val).ok());
     ASSERT_TRUE(bool_val == engine_use_avx512);
 
+    int64_t engine_search_concurrency = 1;
+    ASSERT_TRUE(config.SetEngineConfigSearchConcurrency(std::to_string(engine_search_concurrency)).ok());
+    ASSERT_TRUE(config.GetEngineConfigSearchConcurrency(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_search_concurrency);
+
+    int64_t engine_search_batch_window = 5;
+    ASSERT_TRUE(config.SetEngineConfigSearchBatchWindow(std::to_string(engine_search_batch_window)).ok());
+    ASSERT_TRUE(config.GetEngineConfigSearchBatchWindow(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_search_batch_window);
+
+    bool engine_search_unflushed = true;
+    ASSERT_TRUE(config.SetEngineConfigSearchUnflushed(std::to_string(engine_search_unflushed)).ok());
+    ASSERT_TRUE(config.GetEngineConfigSearchUnflushed(bool_val).ok());
+    ASSERT_TRUE(bool_val == engine_search_unflushed);
+
+    bool engine_shared_quantizer = true;
+    ASSERT_TRUE(config.SetEngineConfigSharedQuantizer(std::to_string(engine_shared_quantizer)).ok());
+    ASSERT_TRUE(config.GetEngineConfigSharedQuantizer(bool_val).ok());
+    ASSERT_TRUE(bool_val == engine_shared_quantizer);
+
+    int64_t engine_build_index_concurrency = 2;
+    ASSERT_TRUE(config.SetEngineConfigBuildIndexConcurrency(std::to_string(engine_build_index_concurrency)).ok());
+    ASSERT_TRUE(config.GetEngineConfigBuildIndexConcurrency(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_build_index_concurrency);
+
+    int64_t engine_build_index_threads = 1;
+    ASSERT_TRUE(config.SetEngineConfigBuildIndexThreads(std::to_string(engine_build_index_threads)).ok());
+    ASSERT_TRUE(config.GetEngineConfigBuildIndexThreads(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_build_index_threads);
+
+    int64_t engine_build_index_chunk_size = 64;
+    ASSERT_TRUE(config.SetEngineConfigBuildIndexChunkSize(std::to_string(engine_build_index_chunk_size)).ok());
+    ASSERT_TRUE(config.GetEngineConfigBuildIndexChunkSize(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_build_index_chunk_size);
+
+    int64_t engine_build_index_checkpoint_interval = 30;
+    ASSERT_TRUE(config.SetEngineConfigBuildIndexCheckpointInterval(
+                          std::to_string(engine_build_index_checkpoint_interval)).ok());
+    ASSERT_TRUE(config.GetEngineConfigBuildIndexCheckpointInterval(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_build_index_checkpoint_interval);
+
 #ifdef MILVUS_GPU_VERSION
     int64_t engine_gpu_search_threshold = 800;
     ASSERT_TRUE(config.SetEngineConfigGpuSearchThreshold(std::to_string(engine_gpu_search_threshold)).ok());
@@ -350,6 +401,16 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.SetWalConfigWalPath(wal_path).ok());
     ASSERT_TRUE(config.GetWalConfigWalPath(str_val).ok());
     ASSERT_TRUE(str_val == wal_path);
+
+    std::string wal_durability = "fsync";
+    ASSERT_TRUE(config.SetWalConfigDurability(wal_durability).ok());
+    ASSERT_TRUE(config.GetWalConfigDurability(str_val).ok());
+    ASSERT_TRUE(str_val == wal_durability);
+
+    int64_t wal_sync_interval = 200;
+    ASSERT_TRUE(config.SetWalConfigSyncInterval(std::to_string(wal_sync_interval)).ok());
+    ASSERT_TRUE(config.GetWalConfigSyncInterval(int64_val).ok());
+    ASSERT_TRUE(int64_val == wal_sync_interval);
 }
 
 std::string
@@ -580,6 +641,8 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
 
     ASSERT_FALSE(config.SetDBConfigAutoFlushInterval("0.1").ok());
 
+    ASSERT_FALSE(config.SetDBConfigMergeIoLimit("-1").ok());
+
     /* storage config */
     ASSERT_FALSE(config.SetStorageConfigPrimaryPath("").ok());
 
@@ -622,6 +685,8 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
 
     ASSERT_FALSE(config.SetCacheConfigCacheInsertData("N").ok());
 
+    ASSERT_FALSE(config.SetCacheConfigPinnedTables("table_1,table-2").ok());
+
     /* engine config */
     ASSERT_FALSE(config.SetEngineConfigUseBlasThreshold("0xff").ok());
 
@@ -631,6 +696,32 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
 
     ASSERT_FALSE(config.SetEngineConfigUseAVX512("N").ok());
 
+    ASSERT_FALSE(config.SetEngineConfigSearchConcurrency("a").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchConcurrency("0").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchConcurrency("10000").ok());
+
+    ASSERT_FALSE(config.SetEngineConfigSearchBatchWindow("a").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchBatchWindow("-1").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchBatchWindow("10000").ok());
+
+    ASSERT_FALSE(config.SetEngineConfigSearchUnflushed("A").ok());
+    ASSERT_FALSE(config.SetEngineConfigSharedQuantizer("A").ok());
+
+    ASSERT_FALSE(config.SetEngineConfigBuildIndexConcurrency("a").ok());
+    ASSERT_FALSE(config.SetEngineConfigBuildIndexConcurrency("0").ok());
+    ASSERT_FALSE(config.SetEngineConfigBuildIndexConcurrency("10000").ok());
+
+    ASSERT_FALSE(config.SetEngineConfigBuildIndexThreads("a").ok());
+    ASSERT_FALSE(config.SetEngineConfigBuildIndexThreads("-1").ok());
+    ASSERT_FALSE(config.SetEngineConfigBuildIndexThreads("10000").ok());
+
+    ASSERT_FALSE(config.SetEngineConfigBuildIndexChunkSize("a").ok());
+    ASSERT_FALSE(config.SetEngineConfigBuildIndexChunkSize("-1").ok());
+    ASSERT_FALSE(config.SetEngineConfigBuildIndexChunkSize("100000").ok());
+
+    ASSERT_FALSE(config.SetEngineConfigBuildIndexCheckpointInterval("a").ok());
+    ASSERT_FALSE(config.SetEngineConfigBuildIndexCheckpointInterval("-1").ok());
+
 #ifdef MILVUS_GPU_VERSION
     ASSERT_FALSE(config.SetEngineConfigGpuSearchThreshold("-1").ok());
 #endif
@@ -660,6 +751,9 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
     ASSERT_FALSE(config.SetWalConfigWalPath("").ok());
     ASSERT_FALSE(config.SetWalConfigBufferSize("-1").ok());
     ASSERT_FALSE(config.SetWalConfigBufferSize("a").ok());
+    ASSERT_FALSE(config.SetWalConfigDurability("always").ok());
+    ASSERT_FALSE(config.SetWalConfigSyncInterval("0").ok());
+    ASSERT_FALSE(config.SetWalConfigSyncInterval("a").ok());
 }
 
 TEST_F(ConfigTest, SERVER_CONFIG_TEST) {
@@ -900,6 +994,16 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_FAIL_TEST) {
     s = config.ValidateConfig();
     ASSERT_FALSE(s.ok());
     fiu_disable("check_wal_path_fail");
+
+    fiu_enable("check_config_wal_durability_fail", 1, NULL, 0);
+    s = config.ValidateConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_wal_durability_fail");
+
+    fiu_enable("check_config_wal_sync_interval_fail", 1, NULL, 0);
+    s = config.ValidateConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_wal_sync_interval_fail");
 }
 
 TEST_F(ConfigTest, SERVER_CONFIG_RESET_DEFAULT_CONFIG_FAIL_TEST) {
@@ -970,6 +1074,11 @@ TEST_F(ConfigTest, SERVER_CONFIG_RESET_DEFAULT_CONFIG_FAIL_TEST) {
     ASSERT_FALSE(s.ok());
     fiu_disable("check_config_auto_flush_interval_fail");
 
+    fiu_enable("check_config_merge_io_limit_fail", 1, NULL, 0);
+    s = config.ResetDefaultConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_merge_io_limit_fail");
+
     fiu_enable("check_config_insert_buffer_size_fail", 1, NULL, 0);
     s = config.ResetDefaultConfig();
     ASSERT_FALSE(s.ok());
@@ -1064,6 +1173,16 @@ TEST_F(ConfigTest, SERVER_CONFIG_RESET_DEFAULT_CONFIG_FAIL_TEST) {
     s = config.ResetDefaultConfig();
     ASSERT_FALSE(s.ok());
     fiu_disable("check_wal_path_fail");
+
+    fiu_enable("check_config_wal_durability_fail", 1, NULL, 0);
+    s = config.ResetDefaultConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_wal_durability_fail");
+
+    fiu_enable("check_config_wal_sync_interval_fail", 1, NULL, 0);
+    s = config.ResetDefaultConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_wal_sync_interval_fail");
 }
 
 TEST_F(ConfigTest, SERVER_CONFIG_OTHER_CONFIGS_FAIL_TEST) {
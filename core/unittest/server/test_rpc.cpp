@@ -18,6 +18,7 @@
 #include "config/Config.h"
 #include "server/Server.h"
 #include "server/grpc_impl/GrpcRequestHandler.h"
+#include "server/delivery/RequestQueue.h"
 #include "server/delivery/RequestScheduler.h"
 #include "server/delivery/request/BaseRequest.h"
 #include "server/delivery/RequestHandler.h"
@@ -813,6 +814,59 @@ TEST_F(RpcSchedulerTest, BASE_TASK_TEST) {
     milvus::server::RequestScheduler::GetInstance().Stop();
 }
 
+namespace {
+class KeyedDummyRequest : public milvus::server::BaseRequest {
+ public:
+    explicit KeyedDummyRequest(const std::string& key)
+        : BaseRequest(std::make_shared<milvus::server::Context>("keyed_dummy_request"), "dql"), key_(key) {
+        Done();
+    }
+
+    std::string
+    RequestKey() const override {
+        return key_;
+    }
+
+    milvus::Status
+    OnExecute() override {
+        return milvus::Status::OK();
+    }
+
+ private:
+    std::string key_;
+};
+}  // namespace
+
+TEST_F(RpcSchedulerTest, REQUEST_QUEUE_TEST) {
+    milvus::server::RequestQueue queue;
+    auto a1 = std::make_shared<KeyedDummyRequest>("a");
+    auto a2 = std::make_shared<KeyedDummyRequest>("a");
+    auto a3 = std::make_shared<KeyedDummyRequest>("a");
+    auto b1 = std::make_shared<KeyedDummyRequest>("b");
+    auto c1 = std::make_shared<KeyedDummyRequest>("c");
+    queue.Put(a1);
+    queue.Put(a2);
+    queue.Put(a3);
+    queue.Put(b1);
+    queue.Put(c1);
+    ASSERT_EQ(queue.Size(), 5);
+
+    // keys are served round-robin, requests of one key keep their order
+    ASSERT_EQ(queue.Take(), a1);
+    ASSERT_EQ(queue.Take(), b1);
+    ASSERT_EQ(queue.Take(), c1);
+    ASSERT_EQ(queue.Take(), a2);
+    ASSERT_EQ(queue.Take(), a3);
+    ASSERT_TRUE(queue.Empty());
+
+    // stopped queue is drained before returning null
+    queue.Put(b1);
+    queue.Put(nullptr);
+    ASSERT_EQ(queue.Take(), b1);
+    ASSERT_EQ(queue.Take(), nullptr);
+    ASSERT_EQ(queue.Take(), nullptr);
+}
+
 TEST(RpcTest, RPC_SERVER_TEST) {
     using GrpcServer =  milvus::server::grpc::GrpcServer;
     GrpcServer& server = GrpcServer::GetInstance();
@@ -11,6 +11,7 @@
 
 #include "db/engine/ExecutionEngine.h"
 #include "utils/BlockingQueue.h"
+#include "utils/CRC32C.h"
 #include "utils/CommonUtil.h"
 #include "utils/Error.h"
 #include "utils/LogUtil.h"
@@ -271,6 +272,25 @@ TEST(UtilTest, TIMERECOREDRAUTO_TEST) {
     rc.RecordSection("end");
 }
 
+TEST(UtilTest, CRC32C_TEST) {
+    std::string check = "123456789";
+    ASSERT_EQ(milvus::CRC32C(check.data(), check.size()), 0xE3069283);
+    ASSERT_EQ(milvus::CRC32C(check.data(), 0), 0);
+
+    // checksum in pieces
+    std::vector<uint8_t> data(1000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = (uint8_t)(i * 7);
+    }
+    uint32_t crc = milvus::CRC32C(data.data(), data.size());
+    uint32_t crc_pieces = milvus::CRC32C(data.data(), 13);
+    crc_pieces = milvus::CRC32C(data.data() + 13, data.size() - 13, crc_pieces);
+    ASSERT_EQ(crc, crc_pieces);
+
+    data[500] ^= 1;
+    ASSERT_NE(milvus::CRC32C(data.data(), data.size()), crc);
+}
+
 TEST(UtilTest, STATUS_TEST) {
     auto status = milvus::Status::OK();
     std::string str = status.ToString();
@@ -434,6 +454,27 @@ TEST(ValidationUtilTest, VALIDATE_INDEX_PARAMS_TEST) {
                                                             (int32_t)milvus::engine::EngineType::FAISS_IVFFLAT);
     ASSERT_TRUE(status.ok());
 
+    json_params = {{"nlist", 32}, {"max_points_per_centroid", 0}};
+    status =
+        milvus::server::ValidationUtil::ValidateIndexParams(json_params,
+                                                            table_schema,
+                                                            (int32_t)milvus::engine::EngineType::FAISS_IVFFLAT);
+    ASSERT_FALSE(status.ok());
+
+    json_params = {{"nlist", 32}, {"max_points_per_centroid", 64}, {"kmeans_batch_size", -1}};
+    status =
+        milvus::server::ValidationUtil::ValidateIndexParams(json_params,
+                                                            table_schema,
+                                                            (int32_t)milvus::engine::EngineType::FAISS_IVFSQ8);
+    ASSERT_FALSE(status.ok());
+
+    json_params = {{"nlist", 32}, {"max_points_per_centroid", 64}, {"kmeans_batch_size", 1024}};
+    status =
+        milvus::server::ValidationUtil::ValidateIndexParams(json_params,
+                                                            table_schema,
+                                                            (int32_t)milvus::engine::EngineType::FAISS_IVFSQ8);
+    ASSERT_TRUE(status.ok());
+
     json_params = {{"nlist", -1}};
     status =
         milvus::server::ValidationUtil::ValidateIndexParams(json_params,
@@ -68,9 +68,15 @@ TEST_F(StorageTest, S3_CLIENT_TEST) {
         ASSERT_TRUE(content_out == content);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    /* check HeadObject() */
+    ASSERT_TRUE(storage_inst.HeadObject(objname).ok());
+    ASSERT_FALSE(storage_inst.HeadObject(objname_dummy).ok());
+
     ///////////////////////////////////////////////////////////////////////////
     ASSERT_TRUE(storage_inst.DeleteObject(filename).ok());
     ASSERT_TRUE(storage_inst.DeleteObject(objname).ok());
+    ASSERT_FALSE(storage_inst.HeadObject(objname).ok());
 
     ASSERT_TRUE(storage_inst.DeleteObjects("/tmp").ok());
 
@@ -184,6 +190,10 @@ TEST_F(StorageTest, S3_FAIL_TEST) {
     }
 
     ///////////////////////////////////////////////////////////////////////////
+    fiu_enable("S3ClientWrapper.HeadObject.outcome.fail", 1, NULL, 0);
+    ASSERT_FALSE(storage_inst.HeadObject(objname).ok());
+    fiu_disable("S3ClientWrapper.HeadObject.outcome.fail");
+
     fiu_enable("S3ClientWrapper.DeleteObject.outcome.fail", 1, NULL, 0);
     ASSERT_FALSE(storage_inst.DeleteObject(filename).ok());
     fiu_disable("S3ClientWrapper.DeleteObject.outcome.fail");
@@ -21,6 +21,8 @@
 #include <fiu-control.h>
 #include <fiu-local.h>
 #include <gtest/gtest.h>
+#include <fstream>
+#include <thread>
 
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "wrapper/VecIndex.h"
@@ -228,6 +230,33 @@ TEST_P(KnowhereWrapperTest, SERIALIZE_TEST) {
         AssertResult(res_ids, res_dis);
     }
 
+    {
+        // index files written before the layout was versioned are still readable
+        std::string file_location = "/tmp/knowhere_legacy";
+        auto binaryset = index_->Serialize();
+        auto type = index_->GetType();
+        std::fstream fs(file_location, std::ios::out | std::ios::binary);
+        fs.write(reinterpret_cast<char*>(&type), sizeof(type));
+        for (auto& iter : binaryset.binary_map_) {
+            size_t meta_length = iter.first.length();
+            fs.write(reinterpret_cast<char*>(&meta_length), sizeof(meta_length));
+            fs.write(iter.first.c_str(), meta_length);
+            int64_t binary_length = iter.second->size;
+            fs.write(reinterpret_cast<char*>(&binary_length), sizeof(binary_length));
+            fs.write(reinterpret_cast<char*>(iter.second->data.get()), binary_length);
+        }
+        fs.close();
+
+        auto new_index = milvus::engine::read_index(file_location);
+        ASSERT_NE(new_index, nullptr);
+        EXPECT_EQ(new_index->Count(), index_->Count());
+
+        std::vector<int64_t> res_ids(elems);
+        std::vector<float> res_dis(elems);
+        new_index->Search(nq, xq.data(), res_dis.data(), res_ids.data(), searchconf);
+        AssertResult(res_ids, res_dis);
+    }
+
     {
         std::string file_location = "/tmp/knowhere_gpu_file";
         fiu_init(0);
@@ -332,6 +361,73 @@ TEST(BFIndex, test_bf_index_fail) {
     fiu_disable("BFIndex.Build.throw_std_exception");
 }
 
+TEST(BFIndex, test_bf_index_alloc_raw_vectors) {
+    const int64_t dim = 16;
+    const int64_t nb = 100;
+    auto bf_ptr = std::static_pointer_cast<milvus::engine::BFIndex>(
+        milvus::engine::GetVecIndexFactory(milvus::engine::IndexType::FAISS_IDMAP));
+    milvus::engine::Config config{{knowhere::meta::DIM, dim}, {knowhere::Metric::TYPE, knowhere::Metric::L2}};
+    ASSERT_EQ(bf_ptr->Build(config), milvus::KNOWHERE_SUCCESS);
+
+    float* xb = bf_ptr->AllocRawVectors(nb);
+    ASSERT_NE(xb, nullptr);
+    for (int64_t i = 0; i < nb * dim; ++i) {
+        xb[i] = (float)(i / dim);
+    }
+    ASSERT_EQ(bf_ptr->Count(), nb);
+    ASSERT_EQ(bf_ptr->GetRawVectors(), xb);
+
+    // vectors written in place are searchable, ids are their offsets
+    const int64_t k = 1;
+    std::vector<float> dis(k);
+    std::vector<int64_t> ids(k);
+    milvus::engine::Config search_config{{knowhere::meta::TOPK, k}};
+    ASSERT_TRUE(bf_ptr->Search(1, xb + 42 * dim, dis.data(), ids.data(), search_config).ok());
+    ASSERT_EQ(ids[0], 42);
+}
+
+TEST(HNSWIndex, test_hnsw_concurrent_search_ef) {
+    DataGenBase data;
+    data.GenData(data.dim, data.nb, data.nq, data.xb, data.xq, data.ids, data.k, data.gt_ids, data.gt_dis);
+
+    auto index = milvus::engine::GetVecIndexFactory(milvus::engine::IndexType::HNSW);
+    milvus::engine::Config build_config{{knowhere::meta::DIM, data.dim},
+                                        {knowhere::Metric::TYPE, knowhere::Metric::L2},
+                                        {knowhere::IndexParams::M, 12},
+                                        {knowhere::IndexParams::efConstruction, 100}};
+    ASSERT_TRUE(index->BuildAll(data.nb, data.xb.data(), data.ids.data(), build_config).ok());
+
+    auto search = [&](int64_t ef, std::vector<float>& dis, std::vector<int64_t>& ids) {
+        dis.resize(data.nq * data.k);
+        ids.resize(data.nq * data.k);
+        milvus::engine::Config search_config{{knowhere::meta::TOPK, data.k}, {knowhere::IndexParams::ef, ef}};
+        ASSERT_TRUE(index->Search(data.nq, data.xq.data(), dis.data(), ids.data(), search_config).ok());
+    };
+
+    std::vector<float> small_dis, large_dis;
+    std::vector<int64_t> small_ids, large_ids;
+    search(data.k, small_dis, small_ids);
+    search(data.k * 20, large_dis, large_ids);
+    data.AssertResult(large_ids, large_dis);
+
+    // ef belongs to each search, searches running together with different ef return what they return alone
+    std::vector<std::thread> threads;
+    for (int64_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            std::vector<float> dis;
+            std::vector<int64_t> ids;
+            for (int64_t r = 0; r < 5; ++r) {
+                search(t % 2 ? data.k * 20 : data.k, dis, ids);
+                ASSERT_EQ(ids, t % 2 ? large_ids : small_ids);
+                ASSERT_EQ(dis, t % 2 ? large_dis : small_dis);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
 // #include "knowhere/index/vector_index/IndexIDMAP.h"
 // #include "src/wrapper/VecImpl.h"
 // #include "src/index/unittest/utils.h"
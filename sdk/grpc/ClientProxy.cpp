@@ -186,6 +186,11 @@ ClientProxy::CreateCollection(const CollectionParam& param) {
         schema.set_dimension(param.dimension);
         schema.set_index_file_size(param.index_file_size);
         schema.set_metric_type(static_cast<int32_t>(param.metric_type));
+        if (!param.extra_params.empty()) {
+            milvus::grpc::KeyValuePair* kv = schema.add_extra_params();
+            kv->set_key(EXTRA_PARAM_KEY);
+            kv->set_value(param.extra_params);
+        }
 
         return client_ptr_->CreateTable(schema);
     } catch (std::exception& ex) {
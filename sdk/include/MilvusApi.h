@@ -63,6 +63,7 @@ struct CollectionParam {
     int64_t dimension = 0;                    ///< Vector dimension, must be a positive value
     int64_t index_file_size = 1024;           ///< Index file size, must be a positive value, unit: MB
     MetricType metric_type = MetricType::L2;  ///< Index metric type
+    std::string extra_params;                 ///< Extra parameters in json format, e.g. {"merge_policy": "leveled"}
 };
 
 /**